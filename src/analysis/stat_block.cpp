@@ -28,14 +28,21 @@
 #define BLOCKSIZE 100
 
 #include <fstream>
+#include <cfloat>
+#include <cmath>
 
 /**
  * Constructor
  * @param comm communicator on which StatBlock is defined
  * @param nrows number of rows in data array
  * @param ncols number of columns in data array
+ * @param streaming if true, accumulate statistics as columns are added
+ *        instead of storing the complete table
+ * @param max_mask largest mask value that is tracked separately in
+ *        streaming mode
  */
-stb::StatBlock(const parallel::Communicator &comm, int nrows, int ncols)
+stb::StatBlock(const parallel::Communicator &comm, int nrows, int ncols,
+    bool streaming, int max_mask)
 {
   int one = 1;
   int two = 2;
@@ -50,24 +57,45 @@ stb::StatBlock(const parallel::Communicator &comm, int nrows, int ncols)
   p_comm = static_cast<MPI_Comm>(comm);
   p_GAgrp = comm.getGroup();
   p_branch_flag = false;
+  p_streaming = streaming;
+  p_base_set = false;
 
-  // Create data and mask arrays
-  dims[0] = nrows;
-  dims[1] = ncols;
-  chunk[0] = -1;
-  chunk[1] = -1;
+  if (p_streaming) {
+    // Create accumulators for each row and mask value. Only columns added
+    // on this process are folded into them
+    if (max_mask < 0) max_mask = 0;
+    p_nslots = max_mask+1;
+    int nacc = p_nrows*p_nslots;
+    p_count.assign(nacc,0.0);
+    p_mean.assign(nacc,0.0);
+    p_m2.assign(nacc,0.0);
+    p_min.assign(nacc,DBL_MAX);
+    p_max.assign(nacc,-DBL_MAX);
+    p_jmin.assign(nacc,p_ncols);
+    p_jmax.assign(nacc,p_ncols);
+    p_colsum.assign(p_ncols*p_nslots,0.0);
+    p_data = 0;
+    p_mask = 0;
+  } else {
+    // Create data and mask arrays
+    p_nslots = 0;
+    dims[0] = nrows;
+    dims[1] = ncols;
+    chunk[0] = -1;
+    chunk[1] = -1;
 
-  p_data = GA_Create_handle();
-  GA_Set_data(p_data,two,dims,C_DBL);
-  GA_Set_chunk(p_data,chunk);
-  GA_Set_pgroup(p_data,p_GAgrp);
-  GA_Allocate(p_data);
+    p_data = GA_Create_handle();
+    GA_Set_data(p_data,two,dims,C_DBL);
+    GA_Set_chunk(p_data,chunk);
+    GA_Set_pgroup(p_data,p_GAgrp);
+    GA_Allocate(p_data);
 
-  p_mask = GA_Create_handle();
-  GA_Set_data(p_mask,two,dims,C_INT);
-  GA_Set_chunk(p_mask,chunk);
-  GA_Set_pgroup(p_mask,p_GAgrp);
-  GA_Allocate(p_mask);
+    p_mask = GA_Create_handle();
+    GA_Set_data(p_mask,two,dims,C_INT);
+    GA_Set_chunk(p_mask,chunk);
+    GA_Set_pgroup(p_mask,p_GAgrp);
+    GA_Allocate(p_mask);
+  }
 
 
   p_type = NGA_Register_type(sizeof(index_set));
@@ -91,8 +119,10 @@ stb::StatBlock(const parallel::Communicator &comm, int nrows, int ncols)
 stb::~StatBlock(void)
 {
   NGA_Deregister_type(p_type);
-  GA_Destroy(p_data);
-  GA_Destroy(p_mask);
+  if (!p_streaming) {
+    GA_Destroy(p_data);
+    GA_Destroy(p_mask);
+  }
   GA_Destroy(p_tags);
   GA_Destroy(p_bounds);
 }
@@ -105,7 +135,35 @@ stb::~StatBlock(void)
  */
 void stb::addColumnValues(int idx, std::vector<double> vals, std::vector<int> mask)
 {
-  if (idx <p_ncols && idx >= 0) {
+  if (idx <p_ncols && idx >= 0 && p_streaming) {
+    if (idx == 0) {
+      p_base = vals;
+      p_base_set = true;
+    }
+    int i;
+    for (i=0; i<p_nrows; i++) {
+      int slot = mask[i];
+      if (slot < 0) continue;
+      if (slot >= p_nslots) slot = p_nslots-1;
+      int k = i*p_nslots+slot;
+      double val = vals[i];
+      // Update running mean and sum of squared deviations
+      p_count[k] += 1.0;
+      double delta = val - p_mean[k];
+      p_mean[k] += delta/p_count[k];
+      p_m2[k] += delta*(val-p_mean[k]);
+      // Ties are resolved in favor of the lowest column index
+      if (val < p_min[k] || (val == p_min[k] && idx < p_jmin[k])) {
+        p_min[k] = val;
+        p_jmin[k] = idx;
+      }
+      if (val > p_max[k] || (val == p_max[k] && idx < p_jmax[k])) {
+        p_max[k] = val;
+        p_jmax[k] = idx;
+      }
+      p_colsum[idx*p_nslots+slot] += val;
+    }
+  } else if (idx <p_ncols && idx >= 0) {
     int lo[2];
     int hi[2];
     int ld = 1;
@@ -295,7 +353,8 @@ void stb::writeMeanAndRMS(std::string filename, int mval, bool flag)
   int hi[2];
   int ld;
   int i, j; 
-  while (itask < nblock) {
+  if (p_streaming) streamMeanAndRMS(g_buf, mval);
+  while (!p_streaming && itask < nblock) {
     // Buffers to hold blocks of data
     int blocksize;
     if (BLOCKSIZE > p_nrows) {
@@ -476,7 +535,8 @@ void stb::writeMinAndMax(std::string filename, int mval, bool flag)
   int hi[2];
   int ld;
   int i, j; 
-  while (itask < nblock) {
+  if (p_streaming) streamMinAndMax(g_buf, mval);
+  while (!p_streaming && itask < nblock) {
     // Buffers to hold blocks of data
     int blocksize;
     if (BLOCKSIZE > p_nrows) {
@@ -673,7 +733,8 @@ void stb::writeMaskValueCount(std::string filename, int mval, bool flag)
   int hi[2];
   int ld;
   int i, j; 
-  while (itask < nblock) {
+  if (p_streaming) streamMaskValueCount(g_buf, mval);
+  while (!p_streaming && itask < nblock) {
     // Buffers to hold blocks of data
     int blocksize;
     if (BLOCKSIZE > p_nrows) {
@@ -787,7 +848,8 @@ void stb::sumColumnValues(std::string filename, int mval)
   int hi[2];
   int ld;
   int i, j; 
-  while (itask < nblock) {
+  if (p_streaming) streamColumnValues(g_buf, mval);
+  while (!p_streaming && itask < nblock) {
     // Buffers to hold blocks of data
     int blocksize;
     if (BLOCKSIZE > p_ncols) {
@@ -857,3 +919,257 @@ void stb::sumColumnValues(std::string filename, int mval)
   GA_Destroy(g_buf);
   GA_Pgroup_sync(p_GAgrp);
 }
+
+/**
+ * Return the first accumulator slot that contains mask values greater
+ * than or equal to mval in streaming mode
+ * @param mval mask value
+ * @return slot index
+ */
+int stb::streamSlot(int mval)
+{
+  if (mval < 0) return 0;
+  if (mval >= p_nslots) {
+    if (p_me == 0) {
+      printf("StatBlock: mask value %d exceeds maximum tracked value %d\n",
+          mval,p_nslots-1);
+    }
+    return p_nslots-1;
+  }
+  return mval;
+}
+
+/**
+ * Return base case values (column 0) on all processes in streaming mode
+ * @param base base case value for each row
+ */
+void stb::streamBase(std::vector<double> &base)
+{
+  // Only the process that added column 0 has the base values, so sum
+  // contributions from all processes
+  std::vector<double> lbase(p_nrows+1,0.0);
+  if (p_base_set) {
+    int i;
+    for (i=0; i<p_nrows; i++) lbase[i] = p_base[i];
+    lbase[p_nrows] = 1.0;
+  }
+  base.resize(p_nrows+1);
+  MPI_Allreduce(&lbase[0],&base[0],p_nrows+1,MPI_DOUBLE,MPI_SUM,p_comm);
+  if (base[p_nrows] != 1.0 && p_me == 0) {
+    printf("StatBlock: base case column has not been added exactly once\n");
+  }
+  base.resize(p_nrows);
+}
+
+/**
+ * Combine streaming accumulators from all processes and evaluate mean
+ * value, RMS deviation and RMS deviation from base case for each row.
+ * Results are stored in g_buf, using the same layout as in
+ * writeMeanAndRMS
+ * @param g_buf global array for results
+ * @param mval only include values with this mask value or greater
+ */
+void stb::streamMeanAndRMS(int g_buf, int mval)
+{
+  if (p_nrows == 0) return;
+  std::vector<double> base;
+  streamBase(base);
+  int smin = streamSlot(mval);
+  // Convert local accumulators to sums of deviations from the base case.
+  // These can be added across processes and remain accurate when values
+  // are close to the base case
+  std::vector<double> lsum(3*p_nrows,0.0);
+  int i, k;
+  for (i=0; i<p_nrows; i++) {
+    for (k=smin; k<p_nslots; k++) {
+      int idx = i*p_nslots+k;
+      double n = p_count[idx];
+      if (n == 0.0) continue;
+      double shift = p_mean[idx]-base[i];
+      lsum[3*i] += n;
+      lsum[3*i+1] += n*shift;
+      lsum[3*i+2] += p_m2[idx]+n*shift*shift;
+    }
+  }
+  std::vector<double> sum;
+  if (p_me == 0) sum.resize(3*p_nrows);
+  MPI_Reduce(&lsum[0],(p_me==0?&sum[0]:NULL),3*p_nrows,MPI_DOUBLE,MPI_SUM,
+      0,p_comm);
+  if (p_me == 0 && p_nrows > 0) {
+    std::vector<double> vbuf(3*p_nrows);
+    for (i=0; i<p_nrows; i++) {
+      double n = sum[3*i];
+      double s1 = sum[3*i+1];
+      double s2 = sum[3*i+2];
+      double avg = 0.0;
+      double avg2 = 0.0;
+      double diff2 = 0.0;
+      if (n > 0.0) avg = base[i]+s1/n;
+      if (n > 1.0) {
+        avg2 = (s2-s1*s1/n)/(n-1.0);
+        diff2 = s2/(n-1.0);
+      }
+      if (avg2 > 0.0) {
+        avg2 = sqrt(avg2);
+      } else {
+        avg2 = 0.0;
+      }
+      if (diff2 > 0.0) {
+        diff2 = sqrt(diff2);
+      } else {
+        diff2 = 0.0;
+      }
+      vbuf[3*i] = avg;
+      vbuf[3*i+1] = avg2;
+      vbuf[3*i+2] = diff2;
+    }
+    int lo[2], hi[2];
+    int ld = 3;
+    lo[0] = 0;
+    hi[0] = p_nrows-1;
+    lo[1] = 0;
+    hi[1] = 2;
+    NGA_Put(g_buf,lo,hi,&vbuf[0],&ld);
+  }
+}
+
+/**
+ * Combine streaming accumulators from all processes and evaluate base
+ * value, minimum and maximum for each row. Results are stored in g_buf,
+ * using the same layout as in writeMinAndMax
+ * @param g_buf global array for results
+ * @param mval only include values with this mask value or greater
+ */
+void stb::streamMinAndMax(int g_buf, int mval)
+{
+  if (p_nrows == 0) return;
+  // Layout matches MPI_DOUBLE_INT
+  typedef struct {
+    double val;
+    int idx;
+  } val_loc;
+  std::vector<double> base;
+  streamBase(base);
+  int smin = streamSlot(mval);
+  int nbytes = p_nrows*sizeof(val_loc);
+  val_loc *lmin = (val_loc*)malloc(nbytes);
+  val_loc *lmax = (val_loc*)malloc(nbytes);
+  val_loc *gmin = (val_loc*)malloc(nbytes);
+  val_loc *gmax = (val_loc*)malloc(nbytes);
+  int i, k;
+  for (i=0; i<p_nrows; i++) {
+    lmin[i].val = DBL_MAX;
+    lmin[i].idx = p_ncols;
+    lmax[i].val = -DBL_MAX;
+    lmax[i].idx = p_ncols;
+    for (k=smin; k<p_nslots; k++) {
+      int idx = i*p_nslots+k;
+      if (p_count[idx] == 0.0) continue;
+      if (p_min[idx] < lmin[i].val ||
+          (p_min[idx] == lmin[i].val && p_jmin[idx] < lmin[i].idx)) {
+        lmin[i].val = p_min[idx];
+        lmin[i].idx = p_jmin[idx];
+      }
+      if (p_max[idx] > lmax[i].val ||
+          (p_max[idx] == lmax[i].val && p_jmax[idx] < lmax[i].idx)) {
+        lmax[i].val = p_max[idx];
+        lmax[i].idx = p_jmax[idx];
+      }
+    }
+  }
+  // MINLOC and MAXLOC pick the lowest column index for equal values
+  MPI_Reduce(lmin,gmin,p_nrows,MPI_DOUBLE_INT,MPI_MINLOC,0,p_comm);
+  MPI_Reduce(lmax,gmax,p_nrows,MPI_DOUBLE_INT,MPI_MAXLOC,0,p_comm);
+  if (p_me == 0 && p_nrows > 0) {
+    // The base case value is the starting point for the search, so it is
+    // kept unless another value is strictly smaller or larger
+    std::vector<double> vbuf(5*p_nrows);
+    for (i=0; i<p_nrows; i++) {
+      vbuf[5*i] = base[i];
+      vbuf[5*i+1] = base[i];
+      vbuf[5*i+2] = base[i];
+      vbuf[5*i+3] = 0.0;
+      vbuf[5*i+4] = 0.0;
+      if (gmin[i].val < base[i]) {
+        vbuf[5*i+1] = gmin[i].val;
+        vbuf[5*i+3] = static_cast<double>(gmin[i].idx);
+      }
+      if (gmax[i].val > base[i]) {
+        vbuf[5*i+2] = gmax[i].val;
+        vbuf[5*i+4] = static_cast<double>(gmax[i].idx);
+      }
+    }
+    int lo[2], hi[2];
+    int ld = 5;
+    lo[0] = 0;
+    hi[0] = p_nrows-1;
+    lo[1] = 0;
+    hi[1] = 4;
+    NGA_Put(g_buf,lo,hi,&vbuf[0],&ld);
+  }
+  free(lmin);
+  free(lmax);
+  free(gmin);
+  free(gmax);
+}
+
+/**
+ * Combine streaming mask counts from all processes. Results are stored
+ * in g_buf, using the same layout as in writeMaskValueCount
+ * @param g_buf global array for results
+ * @param mval count number of times this mask value occurs
+ */
+void stb::streamMaskValueCount(int g_buf, int mval)
+{
+  if (p_nrows == 0) return;
+  std::vector<int> lcnt(p_nrows,0);
+  int i;
+  if (mval >= 0) {
+    int slot = streamSlot(mval);
+    for (i=0; i<p_nrows; i++) {
+      lcnt[i] = static_cast<int>(p_count[i*p_nslots+slot]);
+    }
+  } else if (p_me == 0) {
+    printf("StatBlock: negative mask values are not counted in streaming"
+        " mode\n");
+  }
+  std::vector<int> cnt;
+  if (p_me == 0) cnt.resize(p_nrows);
+  MPI_Reduce(&lcnt[0],(p_me==0?&cnt[0]:NULL),p_nrows,MPI_INT,MPI_SUM,0,
+      p_comm);
+  if (p_me == 0 && p_nrows > 0) {
+    int lo = 0;
+    int hi = p_nrows-1;
+    int one = 1;
+    NGA_Put(g_buf,&lo,&hi,&cnt[0],&one);
+  }
+}
+
+/**
+ * Combine streaming column sums from all processes. Results are stored
+ * in g_buf, using the same layout as in sumColumnValues
+ * @param g_buf global array for results
+ * @param mval only include values with this mask value or greater
+ */
+void stb::streamColumnValues(int g_buf, int mval)
+{
+  if (p_ncols == 0) return;
+  int smin = streamSlot(mval);
+  std::vector<double> lsum(p_ncols,0.0);
+  int j, k;
+  for (j=0; j<p_ncols; j++) {
+    for (k=smin; k<p_nslots; k++) {
+      lsum[j] += p_colsum[j*p_nslots+k];
+    }
+  }
+  std::vector<double> sum;
+  if (p_me == 0) sum.resize(p_ncols);
+  MPI_Reduce(&lsum[0],(p_me==0?&sum[0]:NULL),p_ncols,MPI_DOUBLE,MPI_SUM,0,
+      p_comm);
+  if (p_me == 0 && p_ncols > 0) {
+    int lo = 0;
+    int hi = p_ncols-1;
+    int one = 1;
+    NGA_Put(g_buf,&lo,&hi,&sum[0],&one);
+  }
+}
@@ -15,6 +15,13 @@
  * distributed table of data that can subsequently be use for statistical
  * analysis. Values in the table are masked so that only values that have been
  * deemed relevant according to some criteria are included in the analysis.
+ *
+ * In streaming mode the table is not stored. Each column is folded into
+ * running accumulators (count, mean, sum of squared deviations, min and
+ * max) for every row and mask value on the process that adds the column,
+ * and the accumulators are combined across processes when results are
+ * written. Memory use is then proportional to the number of rows and does
+ * not depend on the number of columns.
  * 
  */
 
@@ -47,8 +54,14 @@ public:
    * @param comm communicator on which StatBlock is defined
    * @param nrows number of rows in data array
    * @param ncols number of columns in data array
+   * @param streaming if true, accumulate statistics as columns are added
+   *        instead of storing the complete table
+   * @param max_mask largest mask value that is tracked separately in
+   *        streaming mode. Larger mask values are treated as max_mask and
+   *        negative mask values are ignored
    */
-  StatBlock(const parallel::Communicator &comm, int nrows, int ncols);
+  StatBlock(const parallel::Communicator &comm, int nrows, int ncols,
+      bool streaming = false, int max_mask = 2);
 
   /**
    * Default destructor
@@ -125,6 +138,55 @@ public:
   void sumColumnValues(std::string filename, int mval=1);
 private:
 
+  /**
+   * Return the first accumulator slot that contains mask values greater
+   * than or equal to mval in streaming mode
+   * @param mval mask value
+   * @return slot index
+   */
+  int streamSlot(int mval);
+
+  /**
+   * Combine streaming accumulators from all processes and evaluate mean
+   * value, RMS deviation and RMS deviation from base case for each row.
+   * Results are stored in g_buf, using the same layout as in
+   * writeMeanAndRMS
+   * @param g_buf global array for results
+   * @param mval only include values with this mask value or greater
+   */
+  void streamMeanAndRMS(int g_buf, int mval);
+
+  /**
+   * Combine streaming accumulators from all processes and evaluate base
+   * value, minimum and maximum for each row. Results are stored in g_buf,
+   * using the same layout as in writeMinAndMax
+   * @param g_buf global array for results
+   * @param mval only include values with this mask value or greater
+   */
+  void streamMinAndMax(int g_buf, int mval);
+
+  /**
+   * Combine streaming mask counts from all processes. Results are stored
+   * in g_buf, using the same layout as in writeMaskValueCount
+   * @param g_buf global array for results
+   * @param mval count number of times this mask value occurs
+   */
+  void streamMaskValueCount(int g_buf, int mval);
+
+  /**
+   * Combine streaming column sums from all processes. Results are stored
+   * in g_buf, using the same layout as in sumColumnValues
+   * @param g_buf global array for results
+   * @param mval only include values with this mask value or greater
+   */
+  void streamColumnValues(int g_buf, int mval);
+
+  /**
+   * Return base case values (column 0) on all processes in streaming mode
+   * @param base base case value for each row
+   */
+  void streamBase(std::vector<double> &base);
+
   int p_data;
   int p_mask;
   int p_type;
@@ -144,6 +206,20 @@ private:
 
   MPI_Comm p_comm;
 
+  // Streaming mode data. Accumulators are stored for each row and mask
+  // value on the process that added the columns
+  bool p_streaming;
+  int p_nslots;
+  std::vector<double> p_count;
+  std::vector<double> p_mean;
+  std::vector<double> p_m2;
+  std::vector<double> p_min;
+  std::vector<double> p_max;
+  std::vector<int> p_jmin;
+  std::vector<int> p_jmax;
+  std::vector<double> p_colsum;
+  std::vector<double> p_base;
+  bool p_base_set;
 };
 
 
@@ -0,0 +1,155 @@
+/*
+ *     Copyright (c) 2013 Battelle Memorial Institute
+ *     Licensed under modified BSD License. A copy of this license can be found
+ *     in the LICENSE file in the top level directory of this distribution.
+ */
+// -------------------------------------------------------------
+/**
+ * @file   stat_block_test.cpp
+ * @author Bruce Palmer
+ * @date   2018-09-11
+ * 
+ * @brief  Check that a StatBlock in streaming mode writes the same
+ * statistics as a StatBlock that stores the complete table
+ * 
+ * 
+ */
+
+// -------------------------------------------------------------
+
+#include <cstdio>
+#include <cstdlib>
+#include <cmath>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <ga.h>
+#include "gridpack/parallel/parallel.hpp"
+#include "gridpack/analysis/stat_block.hpp"
+
+#define NROWS  7
+#define NCOLS  40
+
+// -------------------------------------------------------------
+// compareFiles
+// Compare two output files token by token. Numerical tokens only need to
+// agree to the precision of the output format, since the streaming
+// accumulators sum in a different order than the dense table.
+// -------------------------------------------------------------
+static bool
+compareFiles(const std::string &dense, const std::string &stream)
+{
+  std::ifstream fd(dense.c_str());
+  std::ifstream fs(stream.c_str());
+  if (!fd.is_open() || !fs.is_open()) {
+    printf("Could not open %s or %s\n",dense.c_str(),stream.c_str());
+    return false;
+  }
+  std::string ld, ls;
+  int line = 0;
+  while (true) {
+    bool gd = static_cast<bool>(std::getline(fd,ld));
+    bool gs = static_cast<bool>(std::getline(fs,ls));
+    line++;
+    if (gd != gs) {
+      printf("%s and %s have different lengths\n",dense.c_str(),stream.c_str());
+      return false;
+    }
+    if (!gd) break;
+    std::istringstream sd(ld), ss(ls);
+    std::string td, ts;
+    while (true) {
+      bool kd = static_cast<bool>(sd >> td);
+      bool ks = static_cast<bool>(ss >> ts);
+      bool ok = (kd == ks);
+      if (ok && kd && td != ts) {
+        char *ed, *es;
+        double vd = strtod(td.c_str(),&ed);
+        double vs = strtod(ts.c_str(),&es);
+        ok = (*ed == '\0' && *es == '\0' &&
+            fabs(vd-vs) <= 1.0e-7*(fabs(vd)+fabs(vs)+1.0e-12));
+      }
+      if (!ok) {
+        printf("Mismatch at line %d of %s and %s\n  dense:  %s\n  stream: %s\n",
+            line,dense.c_str(),stream.c_str(),ld.c_str(),ls.c_str());
+        return false;
+      }
+      if (!kd) break;
+    }
+  }
+  return true;
+}
+
+// -------------------------------------------------------------
+//  Main Program
+// -------------------------------------------------------------
+int
+main(int argc, char **argv)
+{
+  gridpack::parallel::Environment env(argc, argv);
+  int ok = 1;
+  // Create an artificial scope so that all objects call their destructors
+  // before GA_Terminate is called
+  if (1) {
+    gridpack::parallel::Communicator world;
+    int me = world.rank();
+    int nproc = world.size();
+    if (me == 0) {
+      printf("Testing StatBlock streaming mode on %d processors\n\n",nproc);
+    }
+    gridpack::analysis::StatBlock dense(world,NROWS,NCOLS);
+    gridpack::analysis::StatBlock stream(world,NROWS,NCOLS,true,2);
+
+    std::vector<int> ids;
+    std::vector<std::string> tags;
+    int i, j;
+    for (i=0; i<NROWS; i++) {
+      ids.push_back(i+10);
+      tags.push_back("1 ");
+    }
+    dense.addRowLabels(ids,tags);
+    stream.addRowLabels(ids,tags);
+
+    // Columns are spread over processes. Row 3 is constant, row 5 is
+    // never selected by the mask and the remaining rows use mask values
+    // 0, 1 and 2.
+    for (j=me; j<NCOLS; j+=nproc) {
+      std::vector<double> vals(NROWS);
+      std::vector<int> mask(NROWS);
+      for (i=0; i<NROWS; i++) {
+        vals[i] = 1.0+0.01*static_cast<double>((3*i+7*j)%11);
+        if (i == 3) vals[i] = 1.0;
+        mask[i] = (i+j)%3;
+        if (i == 5) mask[i] = 0;
+      }
+      dense.addColumnValues(j,vals,mask);
+      stream.addColumnValues(j,vals,mask);
+    }
+
+    dense.writeMeanAndRMS("dense_mean_rms.txt",1,false);
+    stream.writeMeanAndRMS("stream_mean_rms.txt",1,false);
+    dense.writeMinAndMax("dense_min_max.txt",1);
+    stream.writeMinAndMax("stream_min_max.txt",1);
+    dense.writeMaskValueCount("dense_mask_count.txt",2);
+    stream.writeMaskValueCount("stream_mask_count.txt",2);
+    dense.sumColumnValues("dense_col_sum.txt",1);
+    stream.sumColumnValues("stream_col_sum.txt",1);
+    world.sync();
+
+    if (me == 0) {
+      if (!compareFiles("dense_mean_rms.txt","stream_mean_rms.txt")) ok = 0;
+      if (!compareFiles("dense_min_max.txt","stream_min_max.txt")) ok = 0;
+      if (!compareFiles("dense_mask_count.txt","stream_mask_count.txt")) ok = 0;
+      if (!compareFiles("dense_col_sum.txt","stream_col_sum.txt")) ok = 0;
+      if (ok) {
+        printf("Streaming statistics OK\n");
+      } else {
+        printf("Error found in streaming statistics\n");
+      }
+    }
+    if (me != 0) ok = 0;
+    world.sum(&ok,1);
+  }
+  return ok ? 0 : 1;
+}
@@ -38,6 +38,8 @@ gridpack::powerflow::PFBus::PFBus(void)
   p_shunt_bs = 0.0;
   p_v = 0.0;
   p_a = 0.0;
+  p_save_v = 0.0;
+  p_save_a = 0.0;
   p_theta = 0.0;
   p_angle = 0.0;
   p_voltage = 0.0;
@@ -55,6 +57,8 @@ gridpack::powerflow::PFBus::PFBus(void)
   p_ignore = false;
   p_vMag_ptr = NULL;
   p_vAng_ptr = NULL;
+  p_dcAng_ptr = NULL;
+  p_dc_inj = 0.0;
   p_PV_ptr = NULL;
 }
 
@@ -94,6 +98,11 @@ bool gridpack::powerflow::PFBus::matrixDiagSize(int *isize, int *jsize) const
     } else {
       return false;
     }
+  } else if (p_mode == DCFlow) {
+    if (isIsolated() || getReferenceBus()) return false;
+    *isize = 1;
+    *jsize = 1;
+    return true;
   } else if (p_mode == YBus) {
     return YMBus::matrixDiagSize(isize,jsize);
   }
@@ -119,6 +128,11 @@ bool gridpack::powerflow::PFBus::matrixDiagValues(ComplexType *values)
     } else  {
       return true;
     }
+  } else if (p_mode == DCFlow) {
+    double rval;
+    if (!matrixDiagValues(&rval)) return false;
+    values[0] = rval;
+    return true;
   }
   return false;
 }
@@ -132,6 +146,18 @@ bool gridpack::powerflow::PFBus::matrixDiagValues(RealType *values)
     } else  {
       return true;
     }
+  } else if (p_mode == DCFlow) {
+    if (isIsolated() || getReferenceBus()) return false;
+    gridpack::component::ComponentSpan<BaseComponent> branches =
+      getBranchSpan();
+    int i;
+    values[0] = 0.0;
+    for (i=0; i<branches.size(); i++) {
+      gridpack::powerflow::PFBranch *branch
+        = branches.get<gridpack::powerflow::PFBranch>(i);
+      values[0] += branch->getDCSusceptance();
+    }
+    return true;
   }
   return false;
 }
@@ -162,6 +188,9 @@ bool gridpack::powerflow::PFBus::vectorSize(int *size) const
     } else {
       return false;
     }
+  } else if (p_mode == DCFlow) {
+    if (isIsolated() || getReferenceBus()) return false;
+    *size = 1;
   } else if (p_mode == S_Cal){
     *size = 1;
   } else {
@@ -197,12 +226,19 @@ bool gridpack::powerflow::PFBus::vectorValues(ComplexType *values)
     } else {
       return true;
     }
+  } else if (p_mode == DCFlow) {
+    values[0] = p_dc_inj;
+    return true;
   }
   return false;
 }
 
 bool gridpack::powerflow::PFBus::vectorValues(RealType *values)
 {
+  if (p_mode == DCFlow) {
+    values[0] = p_dc_inj;
+    return true;
+  }
   if (p_mode == State) {
     values[0] = p_v;
     values[1] = p_a;
@@ -241,8 +277,8 @@ bool gridpack::powerflow::PFBus::chkQlim(void)
       }
     }
 //    printf(" PV Check: Gen %d =, p_ql = %f, QMAX = %f\n", getOriginalIndex(),p_ql, qmax);
-    std::vector<boost::shared_ptr<BaseComponent> > branches;
-    getNeighborBranches(branches);
+    gridpack::component::ComponentSpan<BaseComponent> branches =
+      getBranchSpan();
     int size = branches.size();
     int i;
     double P, Q, p, q;
@@ -250,7 +286,7 @@ bool gridpack::powerflow::PFBus::chkQlim(void)
     Q = 0.0;
     for (i=0; i<size; i++) {
       gridpack::powerflow::PFBranch *branch
-        = dynamic_cast<gridpack::powerflow::PFBranch*>(branches[i].get());
+        = branches.get<gridpack::powerflow::PFBranch>(i);
       branch->getPQ(this, &p, &q);
       P += p;
       Q += q;
@@ -327,6 +363,10 @@ void gridpack::powerflow::PFBus::clearQlim()
  */
 void gridpack::powerflow::PFBus::setValues(gridpack::ComplexType *values)
 {
+  if (p_mode == DCFlow) {
+    *p_dcAng_ptr = real(values[0]);
+    return;
+  }
   double vt = p_v;
   double at = p_a;
   p_a -= real(values[0]);
@@ -344,6 +384,10 @@ void gridpack::powerflow::PFBus::setValues(gridpack::ComplexType *values)
 
 void gridpack::powerflow::PFBus::setValues(gridpack::RealType *values)
 {
+  if (p_mode == DCFlow) {
+    *p_dcAng_ptr = values[0];
+    return;
+  }
   double vt = p_v;
   double at = p_a;
   p_a -= values[0];
@@ -366,7 +410,7 @@ void gridpack::powerflow::PFBus::setValues(gridpack::RealType *values)
  */
 int gridpack::powerflow::PFBus::getXCBufSize(void)
 {
-  return (2*sizeof(double)+sizeof(bool));
+  return (3*sizeof(double)+sizeof(bool));
 }
 
 /**
@@ -376,7 +420,8 @@ void gridpack::powerflow::PFBus::setXCBuf(void *buf)
 {
   p_vAng_ptr = static_cast<double*>(buf);
   p_vMag_ptr = p_vAng_ptr+1;
-  void *ptr = static_cast<void*>(p_vMag_ptr+1);
+  p_dcAng_ptr = p_vMag_ptr+1;
+  void *ptr = static_cast<void*>(p_dcAng_ptr+1);
   p_PV_ptr = static_cast<bool*>(ptr);
   // Note: we are assuming that the load function has been called BEFORE
   // the factory setExchange method, so p_a and p_v are set with their initial
@@ -384,6 +429,7 @@ void gridpack::powerflow::PFBus::setXCBuf(void *buf)
   double pi = 4.0*atan(1.0);
   *p_vAng_ptr = fmod(p_a,pi);
   *p_vMag_ptr = p_v;
+  *p_dcAng_ptr = 0.0;
   *p_PV_ptr = p_isPV;
   
 }
@@ -583,6 +629,75 @@ void gridpack::powerflow::PFBus::resetVoltage(void)
   *p_vAng_ptr = fmod(p_a,pi);
 }
 
+/**
+ * Store current voltage magnitude and phase angle so that they can be
+ * used as the starting point of a subsequent calculation
+ */
+void gridpack::powerflow::PFBus::saveVoltage(void)
+{
+  p_save_v = *p_vMag_ptr;
+  p_save_a = *p_vAng_ptr;
+}
+
+/**
+ * Reset voltage and phase angle to values stored by saveVoltage
+ */
+void gridpack::powerflow::PFBus::restoreVoltage(void)
+{
+  p_v = p_save_v;
+  p_a = p_save_a;
+  *p_vMag_ptr = p_v;
+  double pi = 4.0*atan(1.0);
+  *p_vAng_ptr = fmod(p_a,pi);
+}
+
+/**
+ * Set real power injection used when building the right hand side of
+ * the DC power flow equations in DCFlow mode
+ * @param value injected power
+ */
+void gridpack::powerflow::PFBus::setDCInjection(double value)
+{
+  p_dc_inj = value;
+}
+
+/**
+ * Add real power injection of a generator to the DC power flow
+ * injection on this bus
+ * @param gen_id generator ID
+ * @param sign multiplier applied to generator output
+ */
+void gridpack::powerflow::PFBus::addDCGenInjection(std::string gen_id,
+    double sign)
+{
+  int i;
+  int gsize = p_gid.size();
+  for (i=0; i<gsize; i++) {
+    if (gen_id == p_gid[i] && p_gstatus[i]) {
+      p_dc_inj += sign*p_pg[i];
+    }
+  }
+}
+
+/**
+ * Set DC phase angle on bus
+ * @param value phase angle
+ */
+void gridpack::powerflow::PFBus::setDCAngle(double value)
+{
+  *p_dcAng_ptr = value;
+}
+
+/**
+ * Get DC phase angle on bus. This is the value obtained from the most
+ * recent DC power flow solution
+ * @return phase angle
+ */
+double gridpack::powerflow::PFBus::getDCAngle(void)
+{
+  return *p_dcAng_ptr;
+}
+
 /**
  * Set voltage limits on bus
  * @param vmin lower value of voltage
@@ -1283,8 +1398,8 @@ int gridpack::powerflow::PFBus::rhsValues(double *rvals)
   if (!isIsolated()) {
     if (!getReferenceBus()) {
       int nvals;
-      std::vector<boost::shared_ptr<BaseComponent> > branches;
-      getNeighborBranches(branches);
+      gridpack::component::ComponentSpan<BaseComponent> branches =
+        getBranchSpan();
       int size = branches.size();
       int i;
       double P, Q, p, q;
@@ -1292,7 +1407,7 @@ int gridpack::powerflow::PFBus::rhsValues(double *rvals)
       Q = 0.0;
       for (i=0; i<size; i++) {
         gridpack::powerflow::PFBranch *branch
-          = dynamic_cast<gridpack::powerflow::PFBranch*>(branches[i].get());
+          = branches.get<gridpack::powerflow::PFBranch>(i);
         branch->getPQ(this, &p, &q);
         P += p;
         Q += q;
@@ -1322,8 +1437,8 @@ int gridpack::powerflow::PFBus::rhsValues(double *rvals)
       return nvals;
     } else {
 #ifdef LARGE_MATRIX
-      std::vector<boost::shared_ptr<BaseComponent> > branches;
-      getNeighborBranches(branches);
+      gridpack::component::ComponentSpan<BaseComponent> branches =
+        getBranchSpan();
       int size = branches.size();
       int i;
       double P, Q, p, q;
@@ -1331,7 +1446,7 @@ int gridpack::powerflow::PFBus::rhsValues(double *rvals)
       Q = 0.0;
       for (i=0; i<size; i++) {
         gridpack::powerflow::PFBranch *branch
-          = dynamic_cast<gridpack::powerflow::PFBranch*>(branches[i].get());
+          = branches.get<gridpack::powerflow::PFBranch>(i);
         branch->getPQ(this, &p, &q);
         P += p;
         Q += q;
@@ -1453,9 +1568,9 @@ bool gridpack::powerflow::PFBranch::matrixForwardSize(int *isize, int *jsize) co
 {
   if (p_mode == Jacobian) {
     gridpack::powerflow::PFBus *bus1
-      = dynamic_cast<gridpack::powerflow::PFBus*>(getBus1().get());
+      = getBusSpan().get<gridpack::powerflow::PFBus>(0);
     gridpack::powerflow::PFBus *bus2
-      = dynamic_cast<gridpack::powerflow::PFBus*>(getBus2().get());
+      = getBusSpan().get<gridpack::powerflow::PFBus>(1);
     bool ok = !bus1->getReferenceBus();
     ok = ok && !bus2->getReferenceBus();
     ok = ok && !bus1->isIsolated();
@@ -1490,6 +1605,23 @@ bool gridpack::powerflow::PFBranch::matrixForwardSize(int *isize, int *jsize) co
     } else {
       return false;
     }
+  } else if (p_mode == DCFlow) {
+    gridpack::powerflow::PFBus *bus1
+      = getBusSpan().get<gridpack::powerflow::PFBus>(0);
+    gridpack::powerflow::PFBus *bus2
+      = getBusSpan().get<gridpack::powerflow::PFBus>(1);
+    bool ok = !bus1->getReferenceBus();
+    ok = ok && !bus2->getReferenceBus();
+    ok = ok && !bus1->isIsolated();
+    ok = ok && !bus2->isIsolated();
+    ok = ok && (p_active);
+    if (ok) {
+      *isize = 1;
+      *jsize = 1;
+      return true;
+    } else {
+      return false;
+    }
   } else if (p_mode == YBus) {
     return YMBranch::matrixForwardSize(isize,jsize);
   }
@@ -1499,9 +1631,9 @@ bool gridpack::powerflow::PFBranch::matrixReverseSize(int *isize, int *jsize) co
 {
   if (p_mode == Jacobian) {
     gridpack::powerflow::PFBus *bus1
-      = dynamic_cast<gridpack::powerflow::PFBus*>(getBus1().get());
+      = getBusSpan().get<gridpack::powerflow::PFBus>(0);
     gridpack::powerflow::PFBus *bus2
-      = dynamic_cast<gridpack::powerflow::PFBus*>(getBus2().get());
+      = getBusSpan().get<gridpack::powerflow::PFBus>(1);
     bool ok = !bus1->getReferenceBus();
     ok = ok && !bus2->getReferenceBus();
     ok = ok && !bus1->isIsolated();
@@ -1536,6 +1668,23 @@ bool gridpack::powerflow::PFBranch::matrixReverseSize(int *isize, int *jsize) co
     } else {
       return false;
     }
+  } else if (p_mode == DCFlow) {
+    gridpack::powerflow::PFBus *bus1
+      = getBusSpan().get<gridpack::powerflow::PFBus>(0);
+    gridpack::powerflow::PFBus *bus2
+      = getBusSpan().get<gridpack::powerflow::PFBus>(1);
+    bool ok = !bus1->getReferenceBus();
+    ok = ok && !bus2->getReferenceBus();
+    ok = ok && !bus1->isIsolated();
+    ok = ok && !bus2->isIsolated();
+    ok = ok && (p_active);
+    if (ok) {
+      *isize = 1;
+      *jsize = 1;
+      return true;
+    } else {
+      return false;
+    }
   } else if (p_mode == YBus) {
     return YMBranch::matrixReverseSize(isize,jsize);
   }
@@ -1559,6 +1708,9 @@ bool gridpack::powerflow::PFBranch::matrixForwardValues(ComplexType *values)
     } else {
       return true;
     }
+  } else if (p_mode == DCFlow) {
+    values[0] = -getDCSusceptance();
+    return true;
   } else if (p_mode == YBus) {
     return YMBranch::matrixForwardValues(values);
   }
@@ -1574,6 +1726,9 @@ bool gridpack::powerflow::PFBranch::matrixForwardValues(RealType *values)
     } else {
       return true;
     }
+  } else if (p_mode == DCFlow) {
+    values[0] = -getDCSusceptance();
+    return true;
   }
   return false;
 }
@@ -1589,6 +1744,9 @@ bool gridpack::powerflow::PFBranch::matrixReverseValues(ComplexType *values)
     } else {
       return true;
     }
+  } else if (p_mode == DCFlow) {
+    values[0] = -getDCSusceptance();
+    return true;
   } else if (p_mode == YBus) {
     return YMBranch::matrixForwardValues(values);
   }
@@ -1604,6 +1762,9 @@ bool gridpack::powerflow::PFBranch::matrixReverseValues(RealType *values)
     } else {
       return true;
     }
+  } else if (p_mode == DCFlow) {
+    values[0] = -getDCSusceptance();
+    return true;
   }
   return false;
 }
@@ -1622,9 +1783,9 @@ void gridpack::powerflow::PFBranch::setYBus(void)
   // Not really a contribution to the admittance matrix but might as well
   // calculate phase angle difference between buses at each end of branch
   gridpack::powerflow::PFBus *bus1 =
-    dynamic_cast<gridpack::powerflow::PFBus*>(getBus1().get());
+    getBusSpan().get<gridpack::powerflow::PFBus>(0);
   gridpack::powerflow::PFBus *bus2 =
-    dynamic_cast<gridpack::powerflow::PFBus*>(getBus2().get());
+    getBusSpan().get<gridpack::powerflow::PFBus>(1);
   double pi = 4.0*atan(1.0);
   p_theta = (bus1->getPhase() - bus2->getPhase());
 }
@@ -1740,17 +1901,18 @@ void gridpack::powerflow::PFBranch::getJacobian(gridpack::powerflow::PFBus *bus,
   double v;
   double cs, sn;
   double ybusr, ybusi;
-  if (bus == getBus1().get()) {
+  gridpack::component::ComponentSpan<BaseComponent> buses = getBusSpan();
+  if (bus == buses[0]) {
     gridpack::powerflow::PFBus *bus2 =
-      dynamic_cast<gridpack::powerflow::PFBus*>(getBus2().get());
+      buses.get<gridpack::powerflow::PFBus>(1);
     v = bus2->getVoltage();
     cs = cos(p_theta);
     sn = sin(p_theta);
     ybusr = p_ybusr_frwd;
     ybusi = p_ybusi_frwd;
-  } else if (bus == getBus2().get()) {
+  } else if (bus == buses[1]) {
     gridpack::powerflow::PFBus *bus1 =
-      dynamic_cast<gridpack::powerflow::PFBus*>(getBus1().get());
+      buses.get<gridpack::powerflow::PFBus>(0);
     v = bus1->getVoltage();
     cs = cos(-p_theta);
     sn = sin(-p_theta);
@@ -1774,10 +1936,10 @@ void gridpack::powerflow::PFBranch::getJacobian(gridpack::powerflow::PFBus *bus,
 void gridpack::powerflow::PFBranch::getPQ(gridpack::powerflow::PFBus *bus, double *p, double *q)
 {
   gridpack::powerflow::PFBus *bus1 = 
-    dynamic_cast<gridpack::powerflow::PFBus*>(getBus1().get());
+    getBusSpan().get<gridpack::powerflow::PFBus>(0);
   double v1 = bus1->getVoltage();
   gridpack::powerflow::PFBus *bus2 =
-    dynamic_cast<gridpack::powerflow::PFBus*>(getBus2().get());
+    getBusSpan().get<gridpack::powerflow::PFBus>(1);
   double v2 = bus2->getVoltage();
   double cs, sn;
   double ybusr, ybusi;
@@ -1994,6 +2156,46 @@ void gridpack::powerflow::PFBranch::setBranchStatus(std::string tag, bool status
   }
 }
 
+/**
+ * Return susceptance of branch used in the DC power flow equations. This
+ * is the sum over all in-service line elements
+ * @return DC susceptance
+ */
+double gridpack::powerflow::PFBranch::getDCSusceptance(void)
+{
+  double ret = 0.0;
+  if (!p_active) return ret;
+  int i;
+  int bsize = p_ckt.size();
+  for (i=0; i<bsize; i++) {
+    if (p_branch_status[i] && p_reactance[i] != 0.0) {
+      ret += 1.0/p_reactance[i];
+    }
+  }
+  return ret;
+}
+
+/**
+ * Return susceptance of individual line element used in the DC power
+ * flow equations
+ * @param tag identifier of line element
+ * @return DC susceptance
+ */
+double gridpack::powerflow::PFBranch::getDCSusceptance(std::string tag)
+{
+  int i;
+  int bsize = p_ckt.size();
+  for (i=0; i<bsize; i++) {
+    if (tag == p_ckt[i]) {
+      if (p_active && p_branch_status[i] && p_reactance[i] != 0.0) {
+        return 1.0/p_reactance[i];
+      }
+      return 0.0;
+    }
+  }
+  return 0.0;
+}
+
 /**
  * get branch rating value
  * @param tag transmission element ID
@@ -2092,9 +2294,9 @@ bool gridpack::powerflow::PFBranch::getIgnore(std::string tag)
 int gridpack::powerflow::PFBranch::forwardJacobianValues(double *rvals)
 {
   gridpack::powerflow::PFBus *bus1
-    = dynamic_cast<gridpack::powerflow::PFBus*>(getBus1().get());
+    = getBusSpan().get<gridpack::powerflow::PFBus>(0);
   gridpack::powerflow::PFBus *bus2
-    = dynamic_cast<gridpack::powerflow::PFBus*>(getBus2().get());
+    = getBusSpan().get<gridpack::powerflow::PFBus>(1);
   bool ok = !bus1->getReferenceBus();
   ok = ok && !bus2->getReferenceBus();
   ok = ok && !bus1->isIsolated();
@@ -2167,9 +2369,9 @@ int gridpack::powerflow::PFBranch::forwardJacobianValues(double *rvals)
 int gridpack::powerflow::PFBranch::reverseJacobianValues(double *rvals)
 {
   gridpack::powerflow::PFBus *bus1
-    = dynamic_cast<gridpack::powerflow::PFBus*>(getBus1().get());
+    = getBusSpan().get<gridpack::powerflow::PFBus>(0);
   gridpack::powerflow::PFBus *bus2
-    = dynamic_cast<gridpack::powerflow::PFBus*>(getBus2().get());
+    = getBusSpan().get<gridpack::powerflow::PFBus>(1);
   bool ok = !bus1->getReferenceBus();
   ok = ok && !bus2->getReferenceBus();
   ok = ok && !bus1->isIsolated();
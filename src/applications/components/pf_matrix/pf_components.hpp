@@ -27,7 +27,7 @@
 namespace gridpack {
 namespace powerflow {
 
-enum PFMode{YBus, Jacobian, RHS, S_Cal, State};
+enum PFMode{YBus, Jacobian, RHS, S_Cal, State, DCFlow};
 
 class PFBus
   : public gridpack::ymatrix::YMBus
@@ -132,6 +132,45 @@ class PFBus
      */
     void resetVoltage(void);
 
+    /**
+     * Store current voltage magnitude and phase angle so that they can be
+     * used as the starting point of a subsequent calculation
+     */
+    void saveVoltage(void);
+
+    /**
+     * Reset voltage and phase angle to values stored by saveVoltage
+     */
+    void restoreVoltage(void);
+
+    /**
+     * Set real power injection used when building the right hand side of
+     * the DC power flow equations in DCFlow mode
+     * @param value injected power
+     */
+    void setDCInjection(double value);
+
+    /**
+     * Add real power injection of a generator to the DC power flow
+     * injection on this bus
+     * @param gen_id generator ID
+     * @param sign multiplier applied to generator output
+     */
+    void addDCGenInjection(std::string gen_id, double sign);
+
+    /**
+     * Set DC phase angle on bus
+     * @param value phase angle
+     */
+    void setDCAngle(double value);
+
+    /**
+     * Get DC phase angle on bus. This is the value obtained from the most
+     * recent DC power flow solution
+     * @return phase angle
+     */
+    double getDCAngle(void);
+
     /**
      * Set voltage limits on bus
      * @param vmin lower value of voltage
@@ -357,6 +396,8 @@ class PFBus
     // p_v and p_a are initialized to p_voltage and p_angle respectively,
     // but may be subject to change during the NR iterations
     double p_v, p_a;
+    // voltage and phase angle stored by saveVoltage
+    double p_save_v, p_save_a;
     double p_theta; //phase angle difference
     double p_ybusr, p_ybusi;
     double p_P0, p_Q0; //double p_sbusr, p_sbusi;
@@ -391,6 +432,10 @@ class PFBus
      */
     double* p_vMag_ptr;
     double* p_vAng_ptr;
+    double* p_dcAng_ptr;
+
+    // real power injection for DC power flow
+    double p_dc_inj;
     
     /**
      * Cache a pointer to DataCollection object
@@ -412,7 +457,7 @@ private:
       & p_load
       & p_mode
       & p_ignore
-      & p_v & p_a & p_theta
+      & p_v & p_a & p_save_v & p_save_a & p_theta
       & p_ybusr & p_ybusi
       & p_P0 & p_Q0
       & p_angle & p_voltage
@@ -425,6 +470,7 @@ private:
       & p_lstatus & p_lid
       & p_sbase
       & p_Pinj & p_Qinj
+      & p_dc_inj
       & p_vmin & p_vmax
       & p_isPV
       & p_saveisPV
@@ -586,6 +632,21 @@ class PFBranch
     int forwardJacobianValues(double *rvals);
     int reverseJacobianValues(double *rvals);
 
+    /**
+     * Return susceptance of branch used in the DC power flow equations. This
+     * is the sum over all in-service line elements
+     * @return DC susceptance
+     */
+    double getDCSusceptance(void);
+
+    /**
+     * Return susceptance of individual line element used in the DC power
+     * flow equations
+     * @param tag identifier of line element
+     * @return DC susceptance
+     */
+    double getDCSusceptance(std::string tag);
+
   private:
     std::vector<bool> p_ignore;
     std::vector<double> p_reactance;
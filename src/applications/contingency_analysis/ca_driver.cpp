@@ -204,6 +204,28 @@ void gridpack::contingency_analysis::CADriver::execute(int argc, char** argv)
   if (!cursor->get("checkQLimit",&check_Qlim)) {
     check_Qlim = false;
   }
+  // Start each contingency from the converged base case and keep the
+  // power flow solver objects alive between contingencies
+  bool warm_start;
+  if (!cursor->get("warmStart",&warm_start)) {
+    warm_start = false;
+  }
+  // Screen contingencies using DC sensitivity factors before running full
+  // AC power flow calculations
+  bool screening;
+  if (!cursor->get("screening",&screening)) {
+    screening = false;
+  }
+  double screen_threshold;
+  if (!cursor->get("screeningThreshold",&screen_threshold)) {
+    screen_threshold = 0.9;
+  }
+  // Accumulate statistics as contingencies complete instead of storing
+  // results for every contingency
+  bool stream_stats;
+  if (!cursor->get("streamingStatistics",&stream_stats)) {
+    stream_stats = false;
+  }
   gridpack::parallel::Communicator task_comm = world.divide(grp_size);
 
   // Keep track of failed calculations
@@ -227,6 +249,7 @@ void gridpack::contingency_analysis::CADriver::execute(int argc, char** argv)
   pf_app.initialize();
   //  Set minimum and maximum voltage limits on all buses
   pf_app.setVoltageLimits(Vmin, Vmax);
+  pf_app.setContingencyMode(warm_start);
   // Solve the base power flow calculation. This calculation is replicated on
   // all task communicators
   pf_app.solve();
@@ -234,6 +257,8 @@ void gridpack::contingency_analysis::CADriver::execute(int argc, char** argv)
   if (check_Qlim && !pf_app.checkQlimViolations()) {
     pf_app.solve();
   }
+  // Save base case voltages as starting point for contingencies
+  if (warm_start) pf_app.saveVoltages();
   // Some buses may violate the voltage limits in the base problem. Flag these
   // buses to ignore voltage violations on them.
   pf_app.ignoreVoltageViolations();
@@ -331,8 +356,10 @@ void gridpack::contingency_analysis::CADriver::execute(int argc, char** argv)
   // Create StatBlock objects for voltage magnitude and angles and add
   // bus IDs to it
 #ifdef USE_STATBLOCK
-  gridpack::analysis::StatBlock vmag_stats(world,nmags,ntasks+1);
-  gridpack::analysis::StatBlock vang_stats(world,nbus,ntasks+1);
+  gridpack::analysis::StatBlock vmag_stats(world,nmags,ntasks+1,
+      stream_stats);
+  gridpack::analysis::StatBlock vang_stats(world,nbus,ntasks+1,
+      stream_stats);
 #endif
   // Add bus IDs and tags to StatBlock objects as well as base case values of
   // voltage magnitude and angle
@@ -376,8 +403,10 @@ void gridpack::contingency_analysis::CADriver::execute(int argc, char** argv)
   // Create StatBlock objects for Pg and Qg and add labels as well as values for
   // base case
 #ifdef USE_STATBLOCK
-  gridpack::analysis::StatBlock pgen_stats(world,nsize,ntasks+1);
-  gridpack::analysis::StatBlock qgen_stats(world,nsize,ntasks+1);
+  gridpack::analysis::StatBlock pgen_stats(world,nsize,ntasks+1,
+      stream_stats);
+  gridpack::analysis::StatBlock qgen_stats(world,nsize,ntasks+1,
+      stream_stats);
   if (world.rank() == 0) {
     pgen_stats.addRowLabels(ids, tags);
     qgen_stats.addRowLabels(ids, tags);
@@ -431,9 +460,12 @@ void gridpack::contingency_analysis::CADriver::execute(int argc, char** argv)
   // Create StatBlock objects for flow parameters and add labels and base case
   // values
 #ifdef USE_STATBLOCK
-  gridpack::analysis::StatBlock pflow_stats(world,nsize,ntasks+1);
-  gridpack::analysis::StatBlock qflow_stats(world,nsize,ntasks+1);
-  gridpack::analysis::StatBlock perf_stats(world,nsize,ntasks+1);
+  gridpack::analysis::StatBlock pflow_stats(world,nsize,ntasks+1,
+      stream_stats);
+  gridpack::analysis::StatBlock qflow_stats(world,nsize,ntasks+1,
+      stream_stats);
+  gridpack::analysis::StatBlock perf_stats(world,nsize,ntasks+1,
+      stream_stats);
   if (world.rank() == 0) {
     pflow_stats.addRowLabels(id1, id2, tags);
     qflow_stats.addRowLabels(id1, id2, tags);
@@ -450,13 +482,99 @@ void gridpack::contingency_analysis::CADriver::execute(int argc, char** argv)
 #endif
   if (check_Qlim) pf_app.clearQlimViolations();
 
+  // Screen contingencies using DC power transfer and line outage
+  // distribution factors. Contingencies are distributed over task
+  // communicators using a separate task manager. Only contingencies that
+  // may overload a line, or that cannot be evaluated using DC sensitivities,
+  // are passed on to the full AC power flow calculation. Screening results
+  // are written to screening.txt
+  std::vector<int> ac_tasks;
+  std::vector<int> skip_idx;
+  if (screening && ntasks > 0) {
+    int t_screen = timer->createCategory("Contingency Screening");
+    timer->start(t_screen);
+    gridpack::parallel::TaskManager screenmgr(world);
+    screenmgr.set(ntasks);
+    std::vector<int> scr_idx;
+    std::vector<double> scr_load;
+    std::vector<int> scr_over;
+    std::vector<int> scr_stat;
+    gridpack::parallel::GlobalVector<double> ca_load(world);
+    gridpack::parallel::GlobalVector<int> ca_over(world);
+    gridpack::parallel::GlobalVector<int> ca_stat(world);
+    int scr_id;
+    while (screenmgr.nextTask(task_comm, &scr_id)) {
+      double load;
+      int nover;
+      bool ok = pf_app.screenContingency(events[scr_id], screen_threshold,
+          &load, &nover);
+      scr_idx.push_back(scr_id);
+      scr_load.push_back(load);
+      scr_over.push_back(nover);
+      // status is 0 if contingency passes screening, 1 if it may overload
+      // lines and 2 if it could not be screened
+      if (!ok) {
+        scr_stat.push_back(2);
+      } else if (nover > 0) {
+        scr_stat.push_back(1);
+      } else {
+        scr_stat.push_back(0);
+      }
+    }
+    if (task_comm.rank() == 0) {
+      ca_load.addElements(scr_idx, scr_load);
+      ca_over.addElements(scr_idx, scr_over);
+      ca_stat.addElements(scr_idx, scr_stat);
+    }
+    ca_load.upload();
+    ca_over.upload();
+    ca_stat.upload();
+    std::vector<int> all_idx;
+    for (i=0; i<ntasks; i++) all_idx.push_back(i);
+    ca_load.getData(all_idx, scr_load);
+    ca_over.getData(all_idx, scr_over);
+    ca_stat.getData(all_idx, scr_stat);
+    for (i=0; i<ntasks; i++) {
+      if (scr_stat[i] != 0) {
+        ac_tasks.push_back(i);
+      } else {
+        skip_idx.push_back(i);
+      }
+    }
+    if (world.rank() == 0) {
+      std::ofstream fout;
+      fout.open("screening.txt");
+      for (i=0; i<ntasks; i++) {
+        char buf[256];
+        sprintf(buf,"contingency: %d name: %s max_loading: %12.6f overloads: %d",
+            i+1,events[i].p_name.c_str(),scr_load[i],scr_over[i]);
+        fout << buf;
+        if (scr_stat[i] == 0) {
+          fout << " action: skipped" << std::endl;
+        } else if (scr_stat[i] == 1) {
+          fout << " action: ac" << std::endl;
+        } else {
+          fout << " action: ac (not screened)" << std::endl;
+        }
+      }
+      fout.close();
+      printf("Contingency screening: %d of %d contingencies passed to AC power flow\n",
+          static_cast<int>(ac_tasks.size()),ntasks);
+    }
+    screenmgr.printStats();
+    timer->stop(t_screen);
+  } else {
+    for (i=0; i<ntasks; i++) ac_tasks.push_back(i);
+  }
+  taskmgr.set(ac_tasks.size());
 
   // Evaluate contingencies using the task manager
-  int task_id;
+  int task_id, task_idx;
   char sbuf[128];
-  // nextTask returns the same task_id on all processors in task_comm. When the
-  // calculation runs out of task, nextTask will return false.
-  while (taskmgr.nextTask(task_comm, &task_id)) {
+  // nextTask returns the same task_idx on all processors in task_comm. When
+  // the calculation runs out of task, nextTask will return false.
+  while (taskmgr.nextTask(task_comm, &task_idx)) {
+    task_id = ac_tasks[task_idx];
     printf("Executing task %d on process %d\n",task_id,world.rank());
     sprintf(sbuf,"%s.out",events[task_id].p_name.c_str());
     // Open a new file, based on the contingency name, to store results from
@@ -490,8 +608,13 @@ void gridpack::contingency_analysis::CADriver::execute(int argc, char** argv)
       }
     }
     if (print_calcs) pf_app.writeHeader(sbuf);
-    // Reset all voltages back to their original values
-    pf_app.resetVoltages();
+    // Reset all voltages back to their original values or to the base
+    // case solution
+    if (warm_start) {
+      pf_app.restoreVoltages();
+    } else {
+      pf_app.resetVoltages();
+    }
     // Set contingency
     pf_app.setContingency(events[task_id]);
     // Solve power flow equations for this system
@@ -748,6 +871,14 @@ void gridpack::contingency_analysis::CADriver::execute(int argc, char** argv)
     ca_success.addElements(contingency_idx, contingency_success);
     ca_violation.addElements(contingency_idx, contingency_violation);
   }
+  // Contingencies that passed screening are not evaluated with AC power flow.
+  // These are marked with violation 0
+  if (world.rank() == 0) {
+    std::vector<bool> skip_success(skip_idx.size(),true);
+    std::vector<int> skip_violation(skip_idx.size(),0);
+    ca_success.addElements(skip_idx, skip_success);
+    ca_violation.addElements(skip_idx, skip_violation);
+  }
   ca_success.upload();
   ca_violation.upload();
   // Write out stats on successful calculations
@@ -764,7 +895,9 @@ void gridpack::contingency_analysis::CADriver::execute(int argc, char** argv)
     for (i=0; i<ntasks; i++) {
       if (contingency_success[i]) {
         fout << "contingency: " << i+1 << " success: true";
-        if (contingency_violation[i] == 1) {
+        if (contingency_violation[i] == 0) {
+          fout << " violation: none (screened)" << std::endl;
+        } else if (contingency_violation[i] == 1) {
           fout << " violation: none" << std::endl;
         } else if (contingency_violation[i] == 2) {
           fout << " violation: bus" << std::endl;
@@ -0,0 +1,96 @@
+/*
+ *     Copyright (c) 2013 Battelle Memorial Institute
+ *     Licensed under modified BSD License. A copy of this license can be found
+ *     in the LICENSE file in the top level directory of this distribution.
+ */
+// -----------------------------------------------------------
+/**
+ * @file   base_generator_batch.cpp
+ *
+ * @brief  Base class for engines that advance all generators of one
+ * model type together
+ *
+ */
+
+#include "boost/smart_ptr/shared_ptr.hpp"
+#include "base_generator_batch.hpp"
+
+/**
+ *  Basic constructor
+ */
+gridpack::dynamic_simulation::BaseGeneratorBatch::BaseGeneratorBatch(void)
+{
+}
+
+/**
+ *  Basic destructor
+ */
+gridpack::dynamic_simulation::BaseGeneratorBatch::~BaseGeneratorBatch(void)
+{
+}
+
+/**
+ * Add an initialized generator to the batch. The generator is marked
+ * as batched if it is added
+ * @param generator generator model
+ * @return false if generator is not of the model type handled by batch
+ */
+bool gridpack::dynamic_simulation::BaseGeneratorBatch::addGenerator(
+    boost::shared_ptr<BaseGeneratorModel> generator)
+{
+  return false;
+}
+
+/**
+ * Copy state back into generators and remove all generators from batch
+ */
+void gridpack::dynamic_simulation::BaseGeneratorBatch::clear()
+{
+}
+
+/**
+ * Number of generators in batch
+ * @return number of generators
+ */
+int gridpack::dynamic_simulation::BaseGeneratorBatch::size()
+{
+  return 0;
+}
+
+/**
+ * Predictor part calculate current injections for all generators
+ * @param flag initial step if true
+ */
+void gridpack::dynamic_simulation::BaseGeneratorBatch::predictor_currentInjection(
+    bool flag)
+{
+}
+
+/**
+ * Corrector part calculate current injections for all generators
+ * @param flag initial step if true
+ */
+void gridpack::dynamic_simulation::BaseGeneratorBatch::corrector_currentInjection(
+    bool flag)
+{
+}
+
+/**
+ * Predict new state variables for time step for all generators
+ * @param t_inc time step increment
+ * @param flag initial step if true
+ */
+void gridpack::dynamic_simulation::BaseGeneratorBatch::predictor(
+    double t_inc, bool flag)
+{
+}
+
+/**
+ * Correct state variables for time step for all generators
+ * @param t_inc time step increment
+ * @param flag initial step if true
+ */
+void gridpack::dynamic_simulation::BaseGeneratorBatch::corrector(
+    double t_inc, bool flag)
+{
+}
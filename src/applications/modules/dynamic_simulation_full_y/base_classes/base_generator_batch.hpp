@@ -0,0 +1,87 @@
+/*
+ *     Copyright (c) 2013 Battelle Memorial Institute
+ *     Licensed under modified BSD License. A copy of this license can be found
+ *     in the LICENSE file in the top level directory of this distribution.
+ */
+// -------------------------------------------------------------
+/**
+ * @file   base_generator_batch.hpp
+ *
+ * @brief  Base class for engines that hold all generators of one model
+ * type on a process and advance them together. Parameters and state
+ * variables are stored in arrays with one entry per generator and each
+ * integration stage is a single loop over the arrays. Generators that
+ * have been added to a batch are skipped by the bus-level integration
+ * loops, but still exchange voltages and Norton currents with their bus.
+ *
+ */
+
+#ifndef _base_generator_batch_h_
+#define _base_generator_batch_h_
+
+#include "boost/smart_ptr/shared_ptr.hpp"
+#include "base_generator_model.hpp"
+
+namespace gridpack {
+namespace dynamic_simulation {
+class BaseGeneratorBatch
+{
+  public:
+    /**
+     * Basic constructor
+     */
+    BaseGeneratorBatch();
+
+    /**
+     * Basic destructor
+     */
+    virtual ~BaseGeneratorBatch();
+
+    /**
+     * Add an initialized generator to the batch. The generator is marked
+     * as batched if it is added
+     * @param generator generator model
+     * @return false if generator is not of the model type handled by batch
+     */
+    virtual bool addGenerator(boost::shared_ptr<BaseGeneratorModel> generator);
+
+    /**
+     * Copy state back into generators and remove all generators from batch
+     */
+    virtual void clear();
+
+    /**
+     * Number of generators in batch
+     * @return number of generators
+     */
+    virtual int size();
+
+    /**
+     * Predictor part calculate current injections for all generators
+     * @param flag initial step if true
+     */
+    virtual void predictor_currentInjection(bool flag);
+
+    /**
+     * Corrector part calculate current injections for all generators
+     * @param flag initial step if true
+     */
+    virtual void corrector_currentInjection(bool flag);
+
+    /**
+     * Predict new state variables for time step for all generators
+     * @param t_inc time step increment
+     * @param flag initial step if true
+     */
+    virtual void predictor(double t_inc, bool flag);
+
+    /**
+     * Correct state variables for time step for all generators
+     * @param t_inc time step increment
+     * @param flag initial step if true
+     */
+    virtual void corrector(double t_inc, bool flag);
+};
+}  // dynamic_simulation
+}  // gridpack
+#endif
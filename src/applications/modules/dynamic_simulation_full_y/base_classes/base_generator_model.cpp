@@ -29,6 +29,7 @@ gridpack::dynamic_simulation::BaseGeneratorModel::BaseGeneratorModel(void)
   p_hasExciter = false;
   p_hasGovernor = false;
   bStatus = true;
+  p_batched = false;
 }
 
 /**
@@ -238,6 +239,24 @@ void gridpack::dynamic_simulation::BaseGeneratorModel::SetGenServiceStatus (bool
 	bStatus = sta;
 }
 
+/**
+ * Mark generator as advanced by a batched kernel. Batched generators
+ * are skipped by the bus-level integration loops
+ * @param flag true if generator belongs to a batch
+ */
+void gridpack::dynamic_simulation::BaseGeneratorModel::setBatched(bool flag)
+{
+  p_batched = flag;
+}
+
+/**
+ * return the boolean indicating whether the gen belongs to a batch
+ */
+bool gridpack::dynamic_simulation::BaseGeneratorModel::getBatched()
+{
+  return p_batched;
+}
+
 /**
  * return a vector containing any generator values that are being
  * watched
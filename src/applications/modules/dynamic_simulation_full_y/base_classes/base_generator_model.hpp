@@ -152,6 +152,18 @@ class BaseGeneratorModel
      */
     void SetGenServiceStatus (bool sta);
 
+    /**
+     * Mark generator as advanced by a batched kernel. Batched generators
+     * are skipped by the bus-level integration loops
+     * @param flag true if generator belongs to a batch
+     */
+    void setBatched(bool flag);
+
+    /**
+     * return the boolean indicating whether the gen belongs to a batch
+     */
+    bool getBatched();
+
     /**
      * return a vector containing any generator values that are being
      * watched
@@ -167,6 +179,7 @@ class BaseGeneratorModel
     boost::shared_ptr<BaseExciterModel> p_exciter;
     bool p_watch;
 	bool bStatus;
+    bool p_batched;
     std::vector< boost::shared_ptr<BaseRelayModel> > vp_relay;  //renke add, relay vector
 
 };
@@ -191,6 +191,17 @@ bool gridpack::dynamic_simulation::BaseLoadModel::getWatch()
   return p_watch;
 }
 
+/**
+ * return a vector containing any load values that are being
+ * watched
+ * @param vals vector of watched values
+ */
+void gridpack::dynamic_simulation::BaseLoadModel::getWatchValues(
+    std::vector<double> &vals)
+{
+  vals.clear();
+}
+
 void gridpack::dynamic_simulation::BaseLoadModel::setDynLoadP(double pl)
 {
 	dyn_p = pl;
@@ -150,6 +150,13 @@ class BaseLoadModel
      */
     bool getWatch();
 
+    /**
+     * return a vector containing any load values that are being
+     * watched
+     * @param vals vector of watched values
+     */
+    virtual void getWatchValues(std::vector<double> &vals);
+
   private:
 	
 	double dyn_p;   // initial value of the dynamic load model real power P
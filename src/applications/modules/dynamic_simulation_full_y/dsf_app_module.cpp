@@ -425,22 +425,22 @@ void gridpack::dynamic_simulation::DSFullApp::solve(
 
   timer->stop(t_init);
 #ifdef USE_TIMESTAMP
-  if (p_generatorWatch) p_generatorIO->header("t, t_stamp");//bus_id,ckt,x1d_1,x2w_1,x3Eqp_1,x4Psidp_1,x5Psiqpp_1");
+  if (p_generatorWatch && !p_generatorSeries) p_generatorIO->header("t, t_stamp");//bus_id,ckt,x1d_1,x2w_1,x3Eqp_1,x4Psidp_1,x5Psiqpp_1");
 //#  if (p_generatorWatch) p_generatorIO->header("t, t_stamp,bus_id,ckt,x1d_1,x2w_1,x3Eqp_1,x4Psidp_1,x5Psiqpp_1");
-  if (p_generatorWatch) p_generatorIO->write("watch_header");
-  if (p_generatorWatch) p_generatorIO->header("\n");
+  if (p_generatorWatch && !p_generatorSeries) p_generatorIO->write("watch_header");
+  if (p_generatorWatch && !p_generatorSeries) p_generatorIO->header("\n");
 
-  if (p_loadWatch) p_loadIO->header("t, t_stamp");
-  if (p_loadWatch) p_loadIO->write("load_watch_header");
-  if (p_loadWatch) p_loadIO->header("\n");
+  if (p_loadWatch && !p_loadSeries) p_loadIO->header("t, t_stamp");
+  if (p_loadWatch && !p_loadSeries) p_loadIO->write("load_watch_header");
+  if (p_loadWatch && !p_loadSeries) p_loadIO->header("\n");
 #else
-  if (p_generatorWatch) p_generatorIO->header("t");
-  if (p_generatorWatch) p_generatorIO->write("watch_header");
-  if (p_generatorWatch) p_generatorIO->header("\n");
+  if (p_generatorWatch && !p_generatorSeries) p_generatorIO->header("t");
+  if (p_generatorWatch && !p_generatorSeries) p_generatorIO->write("watch_header");
+  if (p_generatorWatch && !p_generatorSeries) p_generatorIO->header("\n");
 
-  if (p_loadWatch) p_loadIO->header("t");
-  if (p_loadWatch) p_loadIO->write("load_watch_header");
-  if (p_loadWatch) p_loadIO->header("\n");
+  if (p_loadWatch && !p_loadSeries) p_loadIO->header("t");
+  if (p_loadWatch && !p_loadSeries) p_loadIO->write("load_watch_header");
+  if (p_loadWatch && !p_loadSeries) p_loadIO->header("\n");
 #endif
 #ifdef USE_GOSS
   if (p_generatorWatch) p_generatorIO->dumpChannel();
@@ -893,7 +893,9 @@ void gridpack::dynamic_simulation::DSFullApp::solve(
     }
     int t_secure = timer->createCategory("DS Solve: Check Security");
     timer->start(t_secure);
-    if (p_generatorWatch && I_Steps%p_generatorWatchFrequency == 0) {
+    if (p_generatorSeries && I_Steps%p_generatorWatchFrequency == 0) {
+      writeWatchSeries(static_cast<double>(I_Steps)*p_time_step, false);
+    } else if (p_generatorWatch && I_Steps%p_generatorWatchFrequency == 0) {
       char tbuf[32];
 #ifdef USE_TIMESTAMP
       sprintf(tbuf,"%8.4f, %20.4f",static_cast<double>(I_Steps)*p_time_step,
@@ -918,7 +920,9 @@ void gridpack::dynamic_simulation::DSFullApp::solve(
       if (p_generatorWatch) p_generatorIO->dumpChannel();
 #endif
     }
-    if (p_loadWatch && I_Steps%p_loadWatchFrequency == 0) {
+    if (p_loadSeries && I_Steps%p_loadWatchFrequency == 0) {
+      writeWatchSeries(static_cast<double>(I_Steps)*p_time_step, true);
+    } else if (p_loadWatch && I_Steps%p_loadWatchFrequency == 0) {
       char tbuf[32];
 #ifdef USE_TIMESTAMP
       sprintf(tbuf,"%8.4f, %20.4f",static_cast<double>(I_Steps)*p_time_step,
@@ -1351,19 +1355,24 @@ void gridpack::dynamic_simulation::DSFullApp::openGeneratorWatchFile()
   cursor = p_config->getCursor("Configuration.Dynamic_simulation");
 #ifndef USE_GOSS
   std::string filename;
-  if (!p_internal_watch_file_name) {
-    if (cursor->get("generatorWatchFileName",&filename)) {
-      p_generatorIO.reset(new gridpack::serial_io::SerialBusIO<DSFullNetwork>(128,
-            p_network));
-      p_generatorIO->open(filename.c_str());
-    } else {
-      p_busIO->header("No Generator Watch File Name Found\n");
-      p_generatorWatch = false;
-    }
+  bool parallelIO = cursor->get("parallelWatchFiles",false);
+  bool asyncIO = cursor->get("asyncWatchFiles",false);
+  std::string format = cursor->get("watchFileFormat",std::string("text"));
+  bool found = true;
+  if (p_internal_watch_file_name) {
+    filename = p_gen_watch_file;
+  } else if (!cursor->get("generatorWatchFileName",&filename)) {
+    found = false;
+  }
+  if (!found) {
+    p_busIO->header("No Generator Watch File Name Found\n");
+    p_generatorWatch = false;
+  } else if (format == "binary") {
+    openWatchSeries(filename, false, asyncIO);
   } else {
     p_generatorIO.reset(new gridpack::serial_io::SerialBusIO<DSFullNetwork>(128,
           p_network));
-    p_generatorIO->open(p_gen_watch_file.c_str());
+    p_generatorIO->open(filename.c_str(),parallelIO,asyncIO);
   }
 #else
   std::string topic, URI, username, passwd;
@@ -1398,7 +1407,12 @@ void gridpack::dynamic_simulation::DSFullApp::closeGeneratorWatchFile()
 {
   if (p_generatorWatch) {
 #ifndef USE_GOSS
-    p_generatorIO->close();
+    if (p_generatorSeries) {
+      p_generatorSeries->close();
+      p_generatorSeries.reset();
+    } else {
+      p_generatorIO->close();
+    }
 #else
     p_generatorIO->closeChannel();
 #endif
@@ -1414,10 +1428,17 @@ void gridpack::dynamic_simulation::DSFullApp::openLoadWatchFile()
   cursor = p_config->getCursor("Configuration.Dynamic_simulation");
 #ifndef USE_GOSS
   std::string filename;
+  bool parallelIO = cursor->get("parallelWatchFiles",false);
+  bool asyncIO = cursor->get("asyncWatchFiles",false);
+  std::string format = cursor->get("watchFileFormat",std::string("text"));
   if (cursor->get("loadWatchFileName",&filename)) {
-    p_loadIO.reset(new gridpack::serial_io::SerialBusIO<DSFullNetwork>(128,
-          p_network));
-    p_loadIO->open(filename.c_str());
+    if (format == "binary") {
+      openWatchSeries(filename, true, asyncIO);
+    } else {
+      p_loadIO.reset(new gridpack::serial_io::SerialBusIO<DSFullNetwork>(128,
+            p_network));
+      p_loadIO->open(filename.c_str(),parallelIO,asyncIO);
+    }
   } else {
     p_busIO->header("No Load Watch File Name Found\n");
     p_loadWatch = false;
@@ -1452,9 +1473,92 @@ void gridpack::dynamic_simulation::DSFullApp::closeLoadWatchFile()
 {
   if (p_loadWatch) {
 #ifndef USE_GOSS
-    p_loadIO->close();
+    if (p_loadSeries) {
+      p_loadSeries->close();
+      p_loadSeries.reset();
+    } else {
+      p_loadIO->close();
+    }
 #else
     p_loadIO->closeChannel();
 #endif
   }
 }
+
+/**
+ * Open a binary time series file for generator or load watch results.
+ * The columns in the file are the watched values on each active bus,
+ * so the buses that contribute values are found here and reused for
+ * every time step
+ * @param filename name of time series file
+ * @param loads if true, the file is for load results, otherwise it is
+ * for generator results
+ * @param async if true, write from a background thread
+ */
+void gridpack::dynamic_simulation::DSFullApp::openWatchSeries(
+    const std::string &filename, bool loads, bool async)
+{
+  std::vector<int> &buses = (loads ? p_loadSeriesBuses : p_generatorSeriesBuses);
+  std::vector<std::string> names;
+  buses.clear();
+  int nbus = p_network->numBuses();
+  int i, j;
+  gridpack::dynamic_simulation::DSFullBus *bus;
+  for (i=0; i<nbus; i++) {
+    if (p_network->getActiveBus(i)) {
+      bus = dynamic_cast<gridpack::dynamic_simulation::DSFullBus*>
+        (p_network->getBus(i).get());
+      std::vector<std::string> bus_names;
+      if (loads) {
+        bus_names = bus->getWatchedLoadValueNames();
+      } else {
+        bus_names = bus->getWatchedValueNames();
+      }
+      if (bus_names.size() > 0) {
+        buses.push_back(i);
+        for (j=0; j<bus_names.size(); j++) names.push_back(bus_names[j]);
+      }
+    }
+  }
+  boost::shared_ptr<gridpack::serial_io::TimeSeriesWriter>
+    series(new gridpack::serial_io::TimeSeriesWriter(p_network->communicator(),
+          256, async));
+  series->open(filename.c_str(), names);
+  if (loads) {
+    p_loadSeries = series;
+  } else {
+    p_generatorSeries = series;
+  }
+}
+
+/**
+ * Append current generator or load watch values to binary time series
+ * file
+ * @param time current simulation time
+ * @param loads if true, write load results, otherwise write generator
+ * results
+ */
+void gridpack::dynamic_simulation::DSFullApp::writeWatchSeries(
+    double time, bool loads)
+{
+  std::vector<int> &buses = (loads ? p_loadSeriesBuses : p_generatorSeriesBuses);
+  std::vector<double> values;
+  int i, j;
+  gridpack::dynamic_simulation::DSFullBus *bus;
+  for (i=0; i<buses.size(); i++) {
+    bus = dynamic_cast<gridpack::dynamic_simulation::DSFullBus*>
+      (p_network->getBus(buses[i]).get());
+    std::vector<double> vals;
+    if (loads) {
+      vals = bus->getWatchedLoadValues();
+    } else {
+      vals = bus->getWatchedValues();
+    }
+    for (j=0; j<vals.size(); j++) values.push_back(vals[j]);
+  }
+  if (loads) {
+    p_loadSeries->write(time, values);
+  } else {
+    p_generatorSeries->write(time, values);
+  }
+}
@@ -21,6 +21,7 @@
 #include "boost/smart_ptr/shared_ptr.hpp"
 #include "gridpack/configuration/configuration.hpp"
 #include "gridpack/serial_io/serial_io.hpp"
+#include "gridpack/serial_io/time_series.hpp"
 #include "dsf_factory.hpp"
 
 
@@ -197,6 +198,25 @@ class DSFullApp
      */
     void closeLoadWatchFile();
 
+    /**
+     * Open a binary time series file for generator or load watch results
+     * @param filename name of time series file
+     * @param loads if true, the file is for load results, otherwise it is
+     * for generator results
+     * @param async if true, write from a background thread
+     */
+    void openWatchSeries(const std::string &filename, bool loads,
+        bool async);
+
+    /**
+     * Append current generator or load watch values to binary time series
+     * file
+     * @param time current simulation time
+     * @param loads if true, write load results, otherwise write generator
+     * results
+     */
+    void writeWatchSeries(double time, bool loads);
+
     /**
      * Save time series data for watched generators
      */
@@ -279,6 +299,17 @@ class DSFullApp
     boost::shared_ptr<gridpack::serial_io::SerialBusIO<DSFullNetwork> >
       p_loadIO;
 
+    // binary time series files used for generator and load results
+    // instead of p_generatorIO and p_loadIO if watchFileFormat is binary
+    boost::shared_ptr<gridpack::serial_io::TimeSeriesWriter>
+      p_generatorSeries;
+    boost::shared_ptr<gridpack::serial_io::TimeSeriesWriter>
+      p_loadSeries;
+
+    // local indices of buses that contribute to binary time series files
+    std::vector<int> p_generatorSeriesBuses;
+    std::vector<int> p_loadSeriesBuses;
+
    // Keep track of whether or not systsem is secure
    int p_insecureAt;
 
@@ -22,6 +22,7 @@
 
 #include "boost/smart_ptr/shared_ptr.hpp"
 #include "gridpack/parser/dictionary.hpp"
+#include "gridpack/utilities/string_utils.hpp"
 #include "dsf_components.hpp"
 #include "lvshbl.hpp"
 
@@ -414,6 +415,7 @@ void gridpack::dynamic_simulation::DSFullBus::predictor_currentInjection(bool fl
 	//if (!p_generators[i]->getGenStatus()) {
 	//	continue;
 	//}
+    if (p_generators[i]->getBatched()) continue;
     p_generators[i]->predictor_currentInjection(flag);
   }
   
@@ -494,6 +496,7 @@ void gridpack::dynamic_simulation::DSFullBus::predictor(double t_inc, bool flag)
 	//if (!p_generators[i]->getGenStatus()) {
 	//	continue;
 	//}
+    if (p_generators[i]->getBatched()) continue;
     p_generators[i]->predictor(t_inc,flag);
   }
   
@@ -520,6 +523,7 @@ void gridpack::dynamic_simulation::DSFullBus::corrector_currentInjection(bool fl
 	//if (!p_generators[i]->getGenStatus()) {
 	//	continue
 	//}  
+    if (p_generators[i]->getBatched()) continue;
     p_generators[i]->corrector_currentInjection(flag);
   }
   
@@ -596,6 +600,7 @@ void gridpack::dynamic_simulation::DSFullBus::corrector(double t_inc, bool flag)
 	//if (!p_generators[i]->getGenStatus()) {
 	//	continue;
 	//}
+    if (p_generators[i]->getBatched()) continue;
     p_generators[i]->corrector(t_inc,flag);
   }
   
@@ -1796,6 +1801,17 @@ int gridpack::dynamic_simulation::DSFullBus::getNumGen(void)
   return p_ngen;
 }
 
+/**
+ * Return a generator on this bus
+ * @param idx index of generator on bus
+ * @return pointer to generator model
+ */
+boost::shared_ptr<gridpack::dynamic_simulation::BaseGeneratorModel>
+  gridpack::dynamic_simulation::DSFullBus::getGenerator(int idx)
+{
+  return p_generators[idx];
+}
+
 void gridpack::dynamic_simulation::DSFullBus::setIFunc(void)
 {
 }
@@ -2026,6 +2042,56 @@ void gridpack::dynamic_simulation::DSFullBus::setLoadRealPower(
   data->setValue(LOAD_PL,value,0);
 }
 
+/**
+ * Estimate the relative cost of integrating the dynamic models on this bus
+ * @param data data collection associated with bus
+ * @return estimated workload
+ */
+int gridpack::dynamic_simulation::DSFullBus::getWorkload(
+    const boost::shared_ptr<gridpack::component::DataCollection> &data) const
+{
+  // Rough costs relative to a bus with no dynamic models
+  const int gen_cost = 4;
+  const int exciter_cost = 2;
+  const int governor_cost = 2;
+  const int load_cost = 2;
+  const int composite_load_cost = 10;
+  int i, ngen, nload;
+  int workload = 1;
+  if (data->getValue(GENERATOR_NUMBER, &ngen)) {
+    for (i=0; i<ngen; i++) {
+      int stat = 1;
+      data->getValue(GENERATOR_STAT, &stat, i);
+      if (stat != 1) continue;
+      workload += gen_cost;
+      std::string model;
+      if (data->getValue(GENERATOR_MODEL, &model, i)) {
+        bool has_ex = false;
+        bool has_gov = false;
+        data->getValue(HAS_EXCITER, &has_ex, i);
+        data->getValue(HAS_GOVERNOR, &has_gov, i);
+        if (has_ex) workload += exciter_cost;
+        if (has_gov) workload += governor_cost;
+      } else {
+        workload += exciter_cost + governor_cost;
+      }
+    }
+  }
+  if (data->getValue(LOAD_NUMBER, &nload)) {
+    for (i=0; i<nload; i++) {
+      std::string model;
+      if (data->getValue(LOAD_MODEL, &model, i)) {
+        if (model == "CMLDBLU1") {
+          workload += composite_load_cost;
+        } else {
+          workload += load_cost;
+        }
+      }
+    }
+  }
+  return workload;
+}
+
 #ifdef USE_FNCS
 /**
  * Retrieve an opaque data item from component.
@@ -2095,6 +2161,84 @@ std::vector<double> gridpack::dynamic_simulation::DSFullBus::getWatchedValues()
   return ret;
 }
 
+/**
+ * Return names of the values returned by getWatchedValues. Names are
+ * of the form busID_tag_angle, busID_tag_speed
+ * @return list of names of watched generator values
+ */
+std::vector<std::string>
+gridpack::dynamic_simulation::DSFullBus::getWatchedValueNames()
+{
+  std::vector<std::string> ret;
+  int i, j;
+  char buf[128];
+  gridpack::utility::StringUtils util;
+  for (i=0; i<p_genid.size(); i++) {
+    if (p_generators[i]->getWatch()) {
+      std::vector<double> vals;
+      p_generators[i]->getWatchValues(vals);
+      std::string tag = util.trimQuotes(p_genid[i]);
+      for (j=0; j<vals.size(); j++) {
+        if (j == 0) {
+          sprintf(buf,"%d_%s_angle",getOriginalIndex(),tag.c_str());
+        } else if (j == 1) {
+          sprintf(buf,"%d_%s_speed",getOriginalIndex(),tag.c_str());
+        } else {
+          sprintf(buf,"%d_%s_%d",getOriginalIndex(),tag.c_str(),j);
+        }
+        ret.push_back(buf);
+      }
+    }
+  }
+  return ret;
+}
+
+/**
+ * Return a vector of watched load values
+ * @return values for all watched dynamic loads on bus
+ */
+std::vector<double> gridpack::dynamic_simulation::DSFullBus::getWatchedLoadValues()
+{
+  std::vector<double> ret;
+  int i, j;
+  for (i=0; i<p_ndyn_load; i++) {
+    if (p_loadmodels[i]->getWatch()) {
+      std::vector<double> vals;
+      p_loadmodels[i]->getWatchValues(vals);
+      for (j=0; j<vals.size(); j++) ret.push_back(vals[j]);
+    }
+  }
+  return ret;
+}
+
+/**
+ * Return names of the values returned by getWatchedLoadValues. Names
+ * are of the form busID_tag_n, where n is the index of the value
+ * for that load
+ * @return list of names of watched load values
+ */
+std::vector<std::string>
+gridpack::dynamic_simulation::DSFullBus::getWatchedLoadValueNames()
+{
+  std::vector<std::string> ret;
+  int i, j;
+  char buf[128];
+  gridpack::utility::StringUtils util;
+  for (i=0; i<p_ndyn_load; i++) {
+    if (p_loadmodels[i]->getWatch()) {
+      std::vector<double> vals;
+      p_loadmodels[i]->getWatchValues(vals);
+      std::string tag = p_loadmodels[i]->getDynLoadID();
+      tag = util.trimQuotes(tag);
+      for (j=0; j<vals.size(); j++) {
+        sprintf(buf,"%d_%s_%d",getOriginalIndex(),tag.c_str(),j);
+        ret.push_back(buf);
+      }
+    }
+  }
+  return ret;
+}
+
 /**
  *  Simple constructor
  */
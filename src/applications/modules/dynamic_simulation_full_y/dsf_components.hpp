@@ -265,6 +265,13 @@ class DSFullBus
      */
     int getNumGen(void);
 
+    /**
+     * Return a generator on this bus
+     * @param idx index of generator on bus
+     * @return pointer to generator model
+     */
+    boost::shared_ptr<BaseGeneratorModel> getGenerator(int idx);
+
     /**
      * Return whether or not a bus is isolated
      * @return true if bus is isolated
@@ -371,6 +378,39 @@ class DSFullBus
      */
     std::vector<double> getWatchedValues();
 
+    /**
+     * Return names of the values returned by getWatchedValues. Names are
+     * of the form busID_tag_angle, busID_tag_speed
+     * @return list of names of watched generator values
+     */
+    std::vector<std::string> getWatchedValueNames();
+
+    /**
+     * Return a vector of watched load values
+     * @return values for all watched dynamic loads on bus
+     */
+    std::vector<double> getWatchedLoadValues();
+
+    /**
+     * Return names of the values returned by getWatchedLoadValues. Names
+     * are of the form busID_tag_n, where n is the index of the value
+     * for that load
+     * @return list of names of watched load values
+     */
+    std::vector<std::string> getWatchedLoadValueNames();
+
+    /**
+     * Estimate the relative cost of integrating the dynamic models on this
+     * bus. Generators count more if they have exciters and governors, and
+     * composite loads count more than simple dynamic loads. If the dynamic
+     * models have not been read yet, each in-service generator is assumed
+     * to have an exciter and governor
+     * @param data data collection associated with bus
+     * @return estimated workload
+     */
+    int getWorkload(
+        const boost::shared_ptr<gridpack::component::DataCollection> &data) const;
+
 #ifdef USE_FNCS
     /**
      * Retrieve an opaque data item from component.
@@ -46,6 +46,8 @@ DSFullFactory::DSFullFactory(DSFullFactory::NetworkPtr network)
   for (i=0; i<p_numBranch; i++) {
     p_branches[i] = dynamic_cast<DSFullBranch*>(p_network->getBranch(i).get());
   }
+  GeneratorFactory genFactory;
+  genFactory.createGeneratorBatches(p_genBatches);
 #ifdef USE_FNCS
   p_hash = new gridpack::hash_distr::HashDistribution<DSFullNetwork,
                gridpack::ComplexType,gridpack::ComplexType>
@@ -160,17 +162,36 @@ bool gridpack::dynamic_simulation::DSFullFactory::checkGen(void)
 }
 
 /**
- * Initialize init vectors for integration
+ * Initialize init vectors for integration. Generators with a batched
+ * implementation are added to batches after they are initialized
  * @param ts time step
  */
 void gridpack::dynamic_simulation::DSFullFactory::initDSVect(double ts)
 {
-  int i;
+  int i, j, k;
+  int nbatch = p_genBatches.size();
+
+  // Release generators from previous simulation so that they are
+  // initialized individually
+  for (k=0; k<nbatch; k++) {
+    p_genBatches[k]->clear();
+  }
 
   // Invoke initDSVect method on all bus objects
   for (i=0; i<p_numBus; i++) {
     p_buses[i]->initDSVect(ts);
   }
+
+  // Move generators into the batch for their model type
+  for (i=0; i<p_numBus; i++) {
+    int ngen = p_buses[i]->getNumGen();
+    for (j=0; j<ngen; j++) {
+      boost::shared_ptr<BaseGeneratorModel> gen = p_buses[i]->getGenerator(j);
+      for (k=0; k<nbatch; k++) {
+        if (p_genBatches[k]->addGenerator(gen)) break;
+      }
+    }
+  }
 }
 
 /**
@@ -179,6 +200,12 @@ void gridpack::dynamic_simulation::DSFullFactory::initDSVect(double ts)
 void gridpack::dynamic_simulation::DSFullFactory::predictor_currentInjection(bool flag)
 {
   int i;
+  int nbatch = p_genBatches.size();
+
+  // Advance batched generators one model type at a time
+  for (i=0; i<nbatch; i++) {
+    p_genBatches[i]->predictor_currentInjection(flag);
+  }
 
   // Invoke method on all bus objects
   for (i=0; i<p_numBus; i++) {
@@ -192,6 +219,12 @@ void gridpack::dynamic_simulation::DSFullFactory::predictor_currentInjection(boo
 void gridpack::dynamic_simulation::DSFullFactory::predictor(double t_inc, bool flag)
 {
   int i;
+  int nbatch = p_genBatches.size();
+
+  // Advance batched generators one model type at a time
+  for (i=0; i<nbatch; i++) {
+    p_genBatches[i]->predictor(t_inc,flag);
+  }
 
   // Invoke updateDSVect method on all bus objects
   for (i=0; i<p_numBus; i++) {
@@ -205,6 +238,12 @@ void gridpack::dynamic_simulation::DSFullFactory::predictor(double t_inc, bool f
 void gridpack::dynamic_simulation::DSFullFactory::corrector_currentInjection(bool flag)
 {
   int i;
+  int nbatch = p_genBatches.size();
+
+  // Advance batched generators one model type at a time
+  for (i=0; i<nbatch; i++) {
+    p_genBatches[i]->corrector_currentInjection(flag);
+  }
 
   // Invoke method on all bus objects
   for (i=0; i<p_numBus; i++) {
@@ -218,6 +257,12 @@ void gridpack::dynamic_simulation::DSFullFactory::corrector_currentInjection(boo
 void gridpack::dynamic_simulation::DSFullFactory::corrector(double t_inc, bool flag)
 {
   int i;
+  int nbatch = p_genBatches.size();
+
+  // Advance batched generators one model type at a time
+  for (i=0; i<nbatch; i++) {
+    p_genBatches[i]->corrector(t_inc,flag);
+  }
 
   // Invoke updateDSVect method on all bus objects
   for (i=0; i<p_numBus; i++) {
@@ -22,6 +22,7 @@
 #include "boost/smart_ptr/shared_ptr.hpp"
 #include "gridpack/factory/base_factory.hpp"
 #include "dsf_components.hpp"
+#include "base_classes/base_generator_batch.hpp"
 
 namespace gridpack {
 namespace dynamic_simulation {
@@ -69,7 +70,8 @@ class DSFullFactory
     bool checkGen(void);
 
     /**
-     * Initialize init vectors for integration
+     * Initialize init vectors for integration. Generators with a batched
+     * implementation are added to batches after they are initialized
      * @param ts time step
      */
     void initDSVect(double ts);
@@ -173,6 +175,9 @@ class DSFullFactory
     int p_numBranch;
 
     DSFullBranch **p_branches;
+
+    // Batches of generators that are integrated together, one per model type
+    std::vector<boost::shared_ptr<BaseGeneratorBatch> > p_genBatches;
 };
 
 } // dynamic_simulation
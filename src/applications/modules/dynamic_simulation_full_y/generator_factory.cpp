@@ -18,6 +18,7 @@
 #include "classical.hpp"
 #include "gensal.hpp"
 #include "genrou.hpp"
+#include "genrou_batch.hpp"
 #include "wsieg1.hpp"
 #include "exdc1.hpp"
 #include "esst1a.hpp"
@@ -131,3 +132,17 @@ gridpack::dynamic_simulation::GeneratorFactory::createGovernorModel(
   return ret;
 
 }
+
+/**
+ * Create an empty batch for each generator model type that can be
+ * integrated by a batched kernel
+ * @param batches list of new batches
+ */
+void gridpack::dynamic_simulation::GeneratorFactory::createGeneratorBatches(
+    std::vector<boost::shared_ptr<BaseGeneratorBatch> > &batches)
+{
+  batches.clear();
+  boost::shared_ptr<BaseGeneratorBatch> genrou(
+      new gridpack::dynamic_simulation::GenrouBatch);
+  batches.push_back(genrou);
+}
@@ -17,8 +17,10 @@
 #ifndef generator_factory_h_
 #define generator_factory_h_
 
+#include <vector>
 #include "boost/smart_ptr/shared_ptr.hpp"
 #include "base_classes/base_generator_model.hpp"
+#include "base_classes/base_generator_batch.hpp"
 #include "base_classes/base_exciter_model.hpp"
 #include "base_classes/base_governor_model.hpp"
 #include "gridpack/utilities/string_utils.hpp"
@@ -62,6 +64,14 @@ class GeneratorFactory
      */
     BaseGovernorModel* createGovernorModel(std::string model);
 
+    /**
+     * Create an empty batch for each generator model type that can be
+     * integrated by a batched kernel
+     * @param batches list of new batches
+     */
+    void createGeneratorBatches(
+        std::vector<boost::shared_ptr<BaseGeneratorBatch> > &batches);
+
   private:
 
     gridpack::utility::StringUtils p_util;
@@ -862,3 +862,29 @@ bool gridpack::dynamic_simulation::AcmotorLoad::serialWrite(
 		
   return false;
 }
+
+/**
+ * return a vector containing any load values that are being
+ * watched. These are the same values written to the load watch
+ * file
+ * @param vals vector of watched values
+ */
+void gridpack::dynamic_simulation::AcmotorLoad::getWatchValues(
+    std::vector<double> &vals)
+{
+  vals.clear();
+  if (getWatch()) {
+    vals.push_back(volt_measured);
+    vals.push_back(freq_measured);
+    vals.push_back(temperatureA);
+    vals.push_back(temperatureB);
+    vals.push_back(presentMag);
+    vals.push_back(presentFreq);
+    vals.push_back(static_cast<double>(statusA));
+    vals.push_back(static_cast<double>(statusB));
+    vals.push_back(Pmotor);
+    vals.push_back(Qmotor);
+    vals.push_back(FthA);
+    vals.push_back(FthB);
+  }
+}
@@ -120,6 +120,14 @@ class AcmotorLoad : public BaseLoadModel
      */
     bool serialWrite(char* string, const int bufsize, const char* signal);
 
+    /**
+     * return a vector containing any load values that are being
+     * watched. These are the same values written to the load watch
+     * file
+     * @param vals vector of watched values
+     */
+    void getWatchValues(std::vector<double> &vals);
+
   private:
 
     double p_sbase;
@@ -22,6 +22,8 @@
 
 namespace gridpack {
 namespace dynamic_simulation {
+class Exdc1Batch;
+
 class Exdc1Model : public BaseExciterModel
 {
   public:
@@ -135,6 +137,8 @@ class Exdc1Model : public BaseExciterModel
     double Vterminal, w; 
 
     //boost::shared_ptr<BaseGeneratorModel> p_generator;
+
+    friend class Exdc1Batch;
 };
 }  // dynamic_simulation
 }  // gridpack
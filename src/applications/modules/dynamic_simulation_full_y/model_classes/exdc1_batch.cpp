@@ -0,0 +1,344 @@
+/*
+ *     Copyright (c) 2013 Battelle Memorial Institute
+ *     Licensed under modified BSD License. A copy of this license can be found
+ *     in the LICENSE file in the top level directory of this distribution.
+ */
+// -----------------------------------------------------------
+/**
+ * @file   exdc1_batch.cpp
+ *
+ * @brief  Batched integration of EXDC1 exciters attached to batched
+ * generators
+ *
+ */
+
+#include <vector>
+#include <cmath>
+
+#include "exdc1_batch.hpp"
+
+#define TS_THRESHOLD 1
+
+/**
+ *  Basic constructor
+ */
+gridpack::dynamic_simulation::Exdc1Batch::Exdc1Batch(void)
+{
+  p_size = 0;
+}
+
+/**
+ *  Basic destructor
+ */
+gridpack::dynamic_simulation::Exdc1Batch::~Exdc1Batch(void)
+{
+  clear();
+}
+
+/**
+ * Add an initialized exciter to the batch. Parameters and state of
+ * the exciter are copied into the batch
+ * @param exciter exciter model
+ * @return index of exciter in batch or -1 if exciter is not an EXDC1
+ * model
+ */
+int gridpack::dynamic_simulation::Exdc1Batch::addExciter(
+    BaseExciterModel *exciter)
+{
+  Exdc1Model *exc = dynamic_cast<Exdc1Model*>(exciter);
+  if (exc == NULL) return -1;
+  p_exciters.push_back(exc);
+
+  p_TR.push_back(exc->TR);
+  p_KA.push_back(exc->KA);
+  p_TA.push_back(exc->TA);
+  p_TB.push_back(exc->TB);
+  p_TC.push_back(exc->TC);
+  p_Vrmax.push_back(exc->Vrmax);
+  p_Vrmin.push_back(exc->Vrmin);
+  p_KE.push_back(exc->KE);
+  p_KF.push_back(exc->KF);
+  p_TF.push_back(exc->TF);
+  // Coefficients of exponential saturation function
+  double B = log(exc->SE2 / exc->SE1) / (exc->E2 - exc->E1);
+  p_satA.push_back(exc->SE1 / exp(B * exc->E1));
+  p_satB.push_back(B);
+  p_Vref.push_back(exc->Vref);
+
+  p_x1.push_back(exc->x1);
+  p_x2.push_back(exc->x2);
+  p_x3.push_back(exc->x3);
+  p_x4.push_back(exc->x4);
+  p_x5.push_back(exc->x5);
+  p_x1_1.push_back(exc->x1_1);
+  p_x2_1.push_back(exc->x2_1);
+  p_x3_1.push_back(exc->x3_1);
+  p_x4_1.push_back(exc->x4_1);
+  p_x5_1.push_back(exc->x5_1);
+  p_dx1.push_back(exc->dx1);
+  p_dx2.push_back(exc->dx2);
+  p_dx3.push_back(exc->dx3);
+  p_dx4.push_back(exc->dx4);
+  p_dx5.push_back(exc->dx5);
+  p_dx1_1.push_back(exc->dx1_1);
+  p_dx2_1.push_back(exc->dx2_1);
+  p_dx3_1.push_back(exc->dx3_1);
+  p_dx4_1.push_back(exc->dx4_1);
+  p_dx5_1.push_back(exc->dx5_1);
+  p_Efd.push_back(exc->Efd);
+  p_Vterminal.push_back(exc->Vterminal);
+  p_w.push_back(exc->w);
+
+  p_size++;
+  return p_size-1;
+}
+
+/**
+ * Copy state back into exciters and remove all exciters from batch
+ */
+void gridpack::dynamic_simulation::Exdc1Batch::clear()
+{
+  int i;
+  for (i = 0; i < p_size; i++) {
+    syncExciter(i);
+  }
+  p_size = 0;
+  p_exciters.clear();
+
+  p_TR.clear();
+  p_KA.clear();
+  p_TA.clear();
+  p_TB.clear();
+  p_TC.clear();
+  p_Vrmax.clear();
+  p_Vrmin.clear();
+  p_KE.clear();
+  p_KF.clear();
+  p_TF.clear();
+  p_satA.clear();
+  p_satB.clear();
+  p_Vref.clear();
+
+  p_x1.clear();
+  p_x2.clear();
+  p_x3.clear();
+  p_x4.clear();
+  p_x5.clear();
+  p_x1_1.clear();
+  p_x2_1.clear();
+  p_x3_1.clear();
+  p_x4_1.clear();
+  p_x5_1.clear();
+  p_dx1.clear();
+  p_dx2.clear();
+  p_dx3.clear();
+  p_dx4.clear();
+  p_dx5.clear();
+  p_dx1_1.clear();
+  p_dx2_1.clear();
+  p_dx3_1.clear();
+  p_dx4_1.clear();
+  p_dx5_1.clear();
+  p_Efd.clear();
+  p_Vterminal.clear();
+  p_w.clear();
+}
+
+/**
+ * Number of exciters in batch
+ * @return number of exciters
+ */
+int gridpack::dynamic_simulation::Exdc1Batch::size()
+{
+  return p_size;
+}
+
+/**
+ * Set inputs of an exciter for the next stage
+ * @param idx index of exciter in batch
+ * @param omega rotor speed deviation of generator
+ * @param mag terminal voltage magnitude
+ */
+void gridpack::dynamic_simulation::Exdc1Batch::setInputs(int idx,
+    double omega, double mag)
+{
+  p_w[idx] = omega;
+  p_Vterminal[idx] = mag;
+}
+
+/**
+ * Get the value of the field voltage of an exciter
+ * @param idx index of exciter in batch
+ * @return value of field voltage
+ */
+double gridpack::dynamic_simulation::Exdc1Batch::getFieldVoltage(int idx)
+{
+  return p_Efd[idx];
+}
+
+/**
+ * Predict new state variables for time step for all exciters
+ * @param t_inc time step increment
+ * @param flag initial step if true
+ */
+void gridpack::dynamic_simulation::Exdc1Batch::predictor(
+    double t_inc, bool flag)
+{
+  if (p_size == 0) return;
+  if (!flag) {
+    p_x1 = p_x1_1;
+    p_x2 = p_x2_1;
+    p_x3 = p_x3_1;
+    p_x4 = p_x4_1;
+    p_x5 = p_x5_1;
+  }
+  int i;
+  for (i = 0; i < p_size; i++) {
+    double TB = p_TB[i];
+    double TC = p_TC[i];
+    double TF = p_TF[i];
+    double KA = p_KA[i];
+    double Feedback;
+    // State 2
+    if (p_TR[i] > TS_THRESHOLD * t_inc) {
+      p_dx2[i] = (p_Vterminal[i] - p_x2[i]) / p_TR[i];
+    } else {
+      p_x2[i] = p_Vterminal[i];
+    }
+    // State 5
+    if (TF > TS_THRESHOLD * t_inc) {
+      p_dx5[i] = (p_x1[i] * p_KF[i] / TF - p_x5[i]) / TF;
+      Feedback = p_x1[i] * p_KF[i] / TF - p_x5[i];
+    } else {
+      p_x5[i] = 0;
+      Feedback = 0;
+    }
+    // State 3
+    double LeadLagIN = p_Vref[i] - p_x2[i] - Feedback;
+    double LeadLagOUT;
+    if (TB > (TS_THRESHOLD * t_inc)) {
+      p_dx3[i] = (LeadLagIN * (1 - TC / TB) - p_x3[i]) / TB;
+      LeadLagOUT = LeadLagIN * TC / TB + p_x3[i];
+    } else {
+      LeadLagOUT = LeadLagIN;
+    }
+    // State 4
+    if (p_x4[i] > p_Vrmax[i]) p_x4[i] = p_Vrmax[i];
+    if (p_x4[i] < p_Vrmin[i]) p_x4[i] = p_Vrmin[i];
+    if (p_TA[i] > (TS_THRESHOLD * t_inc)) {
+      p_dx4[i] = (LeadLagOUT * KA - p_x4[i]) / p_TA[i];
+    } else {
+      p_dx4[i] = 0;
+      p_x4[i] = LeadLagOUT * KA;
+    }
+    if (p_dx4[i] > 0 && p_x4[i] >= p_Vrmax[i]) p_dx4[i] = 0;
+    if (p_dx4[i] < 0 && p_x4[i] <= p_Vrmin[i]) p_dx4[i] = 0;
+    // State 1
+    double sat = p_satA[i] * exp(p_satB[i] * p_x1[i]);
+    p_dx1[i] = p_x4[i] - p_x1[i] * (p_KE[i] + sat);
+
+    p_x1_1[i] = p_x1[i] + p_dx1[i] * t_inc;
+    p_x2_1[i] = p_x2[i] + p_dx2[i] * t_inc;
+    p_x3_1[i] = p_x3[i] + p_dx3[i] * t_inc;
+    p_x4_1[i] = p_x4[i] + p_dx4[i] * t_inc;
+    p_x5_1[i] = p_x5[i] + p_dx5[i] * t_inc;
+
+    p_Efd[i] = p_x1_1[i] * (1 + p_w[i]);
+  }
+}
+
+/**
+ * Correct state variables for time step for all exciters
+ * @param t_inc time step increment
+ * @param flag initial step if true
+ */
+void gridpack::dynamic_simulation::Exdc1Batch::corrector(
+    double t_inc, bool flag)
+{
+  int i;
+  for (i = 0; i < p_size; i++) {
+    double TB = p_TB[i];
+    double TC = p_TC[i];
+    double TF = p_TF[i];
+    double KA = p_KA[i];
+    double Feedback;
+    // State 2
+    if (p_TR[i] > TS_THRESHOLD * t_inc) {
+      p_dx2_1[i] = (p_Vterminal[i] - p_x2_1[i]) / p_TR[i];
+    } else {
+      p_x2_1[i] = p_Vterminal[i];
+    }
+    // State 5
+    if (TF > TS_THRESHOLD * t_inc) {
+      p_dx5_1[i] = (p_x1_1[i] * p_KF[i] / TF - p_x5_1[i]) / TF;
+      Feedback = p_x1_1[i] * p_KF[i] / TF - p_x5_1[i];
+    } else {
+      p_x5_1[i] = 0;
+      Feedback = 0;
+    }
+    // State 3
+    double LeadLagIN = p_Vref[i] - p_x2_1[i] - Feedback;
+    double LeadLagOUT;
+    if (TB > (TS_THRESHOLD * t_inc)) {
+      p_dx3_1[i] = (LeadLagIN * (1 - TC / TB) - p_x3_1[i]) / TB;
+      LeadLagOUT = LeadLagIN * TC / TB + p_x3_1[i];
+    } else {
+      LeadLagOUT = LeadLagIN;
+    }
+    // State 4
+    if (p_x4_1[i] > p_Vrmax[i]) p_x4_1[i] = p_Vrmax[i];
+    if (p_x4_1[i] < p_Vrmin[i]) p_x4_1[i] = p_Vrmin[i];
+    if (p_TA[i] > (TS_THRESHOLD * t_inc)) {
+      p_dx4_1[i] = (LeadLagOUT * KA - p_x4_1[i]) / p_TA[i];
+    } else {
+      p_dx4_1[i] = 0;
+      p_x4_1[i] = LeadLagOUT * KA;
+    }
+    if (p_dx4_1[i] > 0 && p_x4_1[i] >= p_Vrmax[i]) p_dx4_1[i] = 0;
+    if (p_dx4_1[i] < 0 && p_x4_1[i] <= p_Vrmin[i]) p_dx4_1[i] = 0;
+    // State 1. Saturation is evaluated at the start of step state, as in
+    // Exdc1Model::corrector()
+    double sat = p_satA[i] * exp(p_satB[i] * p_x1[i]);
+    p_dx1_1[i] = p_x4_1[i] - p_x1_1[i] * (p_KE[i] + sat);
+
+    p_x1_1[i] = p_x1[i] + (p_dx1[i] + p_dx1_1[i]) / 2.0 * t_inc;
+    p_x2_1[i] = p_x2[i] + (p_dx2[i] + p_dx2_1[i]) / 2.0 * t_inc;
+    p_x3_1[i] = p_x3[i] + (p_dx3[i] + p_dx3_1[i]) / 2.0 * t_inc;
+    p_x4_1[i] = p_x4[i] + (p_dx4[i] + p_dx4_1[i]) / 2.0 * t_inc;
+    p_x5_1[i] = p_x5[i] + (p_dx5[i] + p_dx5_1[i]) / 2.0 * t_inc;
+
+    p_Efd[i] = p_x1_1[i] * (1 + p_w[i]);
+  }
+}
+
+/**
+ * Copy state of an exciter from the batch back into the exciter object
+ * @param idx index of exciter in batch
+ */
+void gridpack::dynamic_simulation::Exdc1Batch::syncExciter(int idx)
+{
+  Exdc1Model *exc = p_exciters[idx];
+  exc->x1 = p_x1[idx];
+  exc->x2 = p_x2[idx];
+  exc->x3 = p_x3[idx];
+  exc->x4 = p_x4[idx];
+  exc->x5 = p_x5[idx];
+  exc->x1_1 = p_x1_1[idx];
+  exc->x2_1 = p_x2_1[idx];
+  exc->x3_1 = p_x3_1[idx];
+  exc->x4_1 = p_x4_1[idx];
+  exc->x5_1 = p_x5_1[idx];
+  exc->dx1 = p_dx1[idx];
+  exc->dx2 = p_dx2[idx];
+  exc->dx3 = p_dx3[idx];
+  exc->dx4 = p_dx4[idx];
+  exc->dx5 = p_dx5[idx];
+  exc->dx1_1 = p_dx1_1[idx];
+  exc->dx2_1 = p_dx2_1[idx];
+  exc->dx3_1 = p_dx3_1[idx];
+  exc->dx4_1 = p_dx4_1[idx];
+  exc->dx5_1 = p_dx5_1[idx];
+  exc->Efd = p_Efd[idx];
+  exc->Vterminal = p_Vterminal[idx];
+  exc->w = p_w[idx];
+}
@@ -0,0 +1,113 @@
+/*
+ *     Copyright (c) 2013 Battelle Memorial Institute
+ *     Licensed under modified BSD License. A copy of this license can be found
+ *     in the LICENSE file in the top level directory of this distribution.
+ */
+// -------------------------------------------------------------
+/**
+ * @file   exdc1_batch.hpp
+ *
+ * @brief  Batched integration of EXDC1 exciters attached to batched
+ * generators. Parameters and state variables of the exciters are held in
+ * separate arrays and each stage is evaluated in a single loop over the
+ * arrays.
+ *
+ */
+
+#ifndef _exdc1_batch_h_
+#define _exdc1_batch_h_
+
+#include <vector>
+#include "base_exciter_model.hpp"
+#include "exdc1.hpp"
+
+namespace gridpack {
+namespace dynamic_simulation {
+class Exdc1Batch
+{
+  public:
+    /**
+     * Basic constructor
+     */
+    Exdc1Batch();
+
+    /**
+     * Basic destructor
+     */
+    ~Exdc1Batch();
+
+    /**
+     * Add an initialized exciter to the batch. Parameters and state of
+     * the exciter are copied into the batch
+     * @param exciter exciter model
+     * @return index of exciter in batch or -1 if exciter is not an EXDC1
+     * model
+     */
+    int addExciter(BaseExciterModel *exciter);
+
+    /**
+     * Copy state back into exciters and remove all exciters from batch
+     */
+    void clear();
+
+    /**
+     * Number of exciters in batch
+     * @return number of exciters
+     */
+    int size();
+
+    /**
+     * Set inputs of an exciter for the next stage
+     * @param idx index of exciter in batch
+     * @param omega rotor speed deviation of generator
+     * @param mag terminal voltage magnitude
+     */
+    void setInputs(int idx, double omega, double mag);
+
+    /**
+     * Get the value of the field voltage of an exciter
+     * @param idx index of exciter in batch
+     * @return value of field voltage
+     */
+    double getFieldVoltage(int idx);
+
+    /**
+     * Predict new state variables for time step for all exciters
+     * @param t_inc time step increment
+     * @param flag initial step if true
+     */
+    void predictor(double t_inc, bool flag);
+
+    /**
+     * Correct state variables for time step for all exciters
+     * @param t_inc time step increment
+     * @param flag initial step if true
+     */
+    void corrector(double t_inc, bool flag);
+
+    /**
+     * Copy state of an exciter from the batch back into the exciter object
+     * @param idx index of exciter in batch
+     */
+    void syncExciter(int idx);
+
+  private:
+
+    int p_size;
+
+    std::vector<Exdc1Model*> p_exciters;
+
+    // Parameters
+    std::vector<double> p_TR, p_KA, p_TA, p_TB, p_TC, p_Vrmax, p_Vrmin;
+    std::vector<double> p_KE, p_KF, p_TF, p_satA, p_satB, p_Vref;
+
+    // State
+    std::vector<double> p_x1, p_x2, p_x3, p_x4, p_x5;
+    std::vector<double> p_x1_1, p_x2_1, p_x3_1, p_x4_1, p_x5_1;
+    std::vector<double> p_dx1, p_dx2, p_dx3, p_dx4, p_dx5;
+    std::vector<double> p_dx1_1, p_dx2_1, p_dx3_1, p_dx4_1, p_dx5_1;
+    std::vector<double> p_Efd, p_Vterminal, p_w;
+};
+}  // dynamic_simulation
+}  // gridpack
+#endif
@@ -23,6 +23,7 @@
 #include "gridpack/parser/dictionary.hpp"
 #include "base_generator_model.hpp"
 #include "genrou.hpp"
+#include "genrou_batch.hpp"
 //#include "exdc1.hpp"
 
 /**
@@ -42,6 +43,9 @@ gridpack::dynamic_simulation::GenrouGenerator::GenrouGenerator(void)
     dx4Psidp_1 = 0;
     dx5Psiqp_1 = 0;;
     dx6Edp_1 = 0;;
+    Xqpp = 0.0; // not set by load() until GENERATOR_XQPP is parsed
+    p_batch = NULL;
+    p_batch_idx = -1;
 }
 
 /**
@@ -175,6 +179,7 @@ void gridpack::dynamic_simulation::GenrouGenerator::init(double mag,
  */
 gridpack::ComplexType gridpack::dynamic_simulation::GenrouGenerator::INorton()
 {
+  if (p_batch) return p_batch->INorton(p_batch_idx);
   return p_INorton;
 }
 
@@ -414,6 +419,10 @@ void gridpack::dynamic_simulation::GenrouGenerator::corrector(
 void gridpack::dynamic_simulation::GenrouGenerator::setVoltage(
     gridpack::ComplexType voltage)
 {
+  if (p_batch) {
+    p_batch->setVoltage(p_batch_idx, voltage);
+    return;
+  }
   presentMag = abs(voltage);
   presentAng = atan2(imag(voltage), real(voltage));  
 }
@@ -435,6 +444,7 @@ double gridpack::dynamic_simulation::GenrouGenerator::getFieldVoltage()
 void gridpack::dynamic_simulation::GenrouGenerator::write(
     const char* signal, char *string)
 {
+  if (p_batch) p_batch->syncGenerator(p_batch_idx);
   if (!strcmp(signal,"standard")) {
     //sprintf(string,"      %8d            %2s    %12.6f    %12.6f    %12.6f    %12.6f\n",
     //    p_bus_id,p_ckt.c_str(),real(p_mac_ang_s1),real(p_mac_spd_s1),real(p_mech),
@@ -454,7 +464,21 @@ void gridpack::dynamic_simulation::GenrouGenerator::getWatchValues(
 {
   vals.clear();
   if (getWatch()) {
+    if (p_batch) p_batch->syncGenerator(p_batch_idx);
     vals.push_back(x1d_1+1.0);
     vals.push_back(x2w_1);
   }
 }
+
+/**
+ * Attach generator to a batch that holds its state. While attached,
+ * Norton current and terminal voltage are exchanged through the batch
+ * @param batch batch holding generator state (NULL to detach)
+ * @param idx index of generator in batch
+ */
+void gridpack::dynamic_simulation::GenrouGenerator::setBatch(
+    GenrouBatch *batch, int idx)
+{
+  p_batch = batch;
+  p_batch_idx = idx;
+}
@@ -22,6 +22,8 @@
 
 namespace gridpack {
 namespace dynamic_simulation {
+class GenrouBatch;
+
 class GenrouGenerator : public BaseGeneratorModel
 {
   public:
@@ -121,6 +123,14 @@ class GenrouGenerator : public BaseGeneratorModel
      */
     void getWatchValues(std::vector<double> &vals);
 
+    /**
+     * Attach generator to a batch that holds its state. While attached,
+     * Norton current and terminal voltage are exchanged through the batch
+     * @param batch batch holding generator state (NULL to detach)
+     * @param idx index of generator in batch
+     */
+    void setBatch(GenrouBatch *batch, int idx);
+
   private:
 
     double p_sbase;
@@ -159,6 +169,11 @@ class GenrouGenerator : public BaseGeneratorModel
     std::string p_ckt;
     int p_bus_id;
 
+    GenrouBatch *p_batch;
+    int p_batch_idx;
+
+    friend class GenrouBatch;
+
     friend class boost::serialization::access;
 
     template<class Archive>
@@ -0,0 +1,531 @@
+/*
+ *     Copyright (c) 2013 Battelle Memorial Institute
+ *     Licensed under modified BSD License. A copy of this license can be found
+ *     in the LICENSE file in the top level directory of this distribution.
+ */
+// -----------------------------------------------------------
+/**
+ * @file   genrou_batch.cpp
+ *
+ * @brief  Batched integration of all GENROU generators on a process
+ *
+ */
+
+#include <vector>
+#include <cmath>
+
+#include "boost/smart_ptr/shared_ptr.hpp"
+#include "genrou_batch.hpp"
+
+namespace {
+
+// Norton current injection of a GENROU generator in the network reference
+// frame, evaluated from the flux linkages x3Eqp, x4Psidp, x5Psiqp and x6Edp,
+// the speed deviation x2w and the rotor angle x1d. Also returns the d-q
+// axis currents Id and Iq.
+inline void genrouNorton(double Xdp, double Xdpp, double Xl, double Xqp,
+    double Xqpp, double B, double G, double scale, double Vr, double Vi,
+    double x1d, double x2w, double x3Eqp, double x4Psidp, double x5Psiqp,
+    double x6Edp, double &Id, double &Iq, double &IrNorton, double &IiNorton)
+{
+  double Psiqpp = - x6Edp * (Xqpp - Xl) / (Xqp - Xl)
+                  - x5Psiqp * (Xqp - Xqpp) / (Xqp - Xl);
+  double Psidpp = + x3Eqp * (Xdpp - Xl) / (Xdp - Xl)
+                  + x4Psidp * (Xdp - Xdpp) / (Xdp - Xl);
+  double Vd = - Psiqpp * (1 + x2w);
+  double Vq = + Psidpp * (1 + x2w);
+  double sind = sin(x1d);
+  double cosd = cos(x1d);
+  double Vdterm = Vr * sind - Vi * cosd;
+  double Vqterm = Vr * cosd + Vi * sind;
+  Id = (Vd - Vdterm) * G - (Vq - Vqterm) * B;
+  Iq = (Vd - Vdterm) * B + (Vq - Vqterm) * G;
+  double Idnorton = Vd * G - Vq * B;
+  double Iqnorton = Vd * B + Vq * G;
+  IrNorton = (+ Idnorton * sind + Iqnorton * cosd) * scale;
+  IiNorton = (- Idnorton * cosd + Iqnorton * sind) * scale;
+}
+
+}
+
+/**
+ *  Basic constructor
+ */
+gridpack::dynamic_simulation::GenrouBatch::GenrouBatch(void)
+{
+  p_size = 0;
+}
+
+/**
+ *  Basic destructor
+ */
+gridpack::dynamic_simulation::GenrouBatch::~GenrouBatch(void)
+{
+  clear();
+}
+
+/**
+ * Add an initialized generator to the batch. Parameters and state of
+ * the generator are copied into the batch and the generator is marked
+ * as batched
+ * @param generator generator model
+ * @return false if generator is not a GENROU model
+ */
+bool gridpack::dynamic_simulation::GenrouBatch::addGenerator(
+    boost::shared_ptr<BaseGeneratorModel> generator)
+{
+  GenrouGenerator *gen = dynamic_cast<GenrouGenerator*>(generator.get());
+  if (gen == NULL) return false;
+  BaseExciterModel *exciter = generator->getExciter().get();
+  BaseGovernorModel *governor = generator->getGovernor().get();
+  if (exciter == NULL || governor == NULL) return false;
+
+  p_models.push_back(generator);
+  p_generators.push_back(gen);
+  p_exciters.push_back(exciter);
+  p_governors.push_back(governor);
+  p_exciterIdx.push_back(p_exdc1.addExciter(exciter));
+  p_governorIdx.push_back(p_wsieg1.addGovernor(governor));
+
+  p_H.push_back(gen->H);
+  p_D.push_back(gen->D);
+  p_Xd.push_back(gen->Xd);
+  p_Xq.push_back(gen->Xq);
+  p_Xdp.push_back(gen->Xdp);
+  p_Xdpp.push_back(gen->Xdpp);
+  p_Xl.push_back(gen->Xl);
+  p_Xqp.push_back(gen->Xqp);
+  p_Xqpp.push_back(gen->Xqpp);
+  p_Tdop.push_back(gen->Tdop);
+  p_Tdopp.push_back(gen->Tdopp);
+  p_Tqopp.push_back(gen->Tqopp);
+  // Coefficients of scaled quadratic saturation function
+  double a_ = gen->S12 / gen->S10 - 1.0 / 1.2;
+  double b_ = -2 * gen->S12 / gen->S10 + 2;
+  double c_ = gen->S12 / gen->S10 - 1.2;
+  double A = (-b_ - sqrt(b_ * b_ - 4 * a_ * c_)) / (2 * a_);
+  p_satA.push_back(A);
+  p_satB.push_back(gen->S10 / ((1.0 - A) * (1.0 - A)));
+  p_scale.push_back(gen->MVABase / gen->p_sbase);
+  double Ra = gen->Ra;
+  double Xdpp = gen->Xdpp;
+  p_B.push_back(-Xdpp / (Ra * Ra + Xdpp * Xdpp));
+  p_G.push_back(Ra / (Ra * Ra + Xdpp * Xdpp));
+
+  p_x1d.push_back(gen->x1d);
+  p_x2w.push_back(gen->x2w);
+  p_x3Eqp.push_back(gen->x3Eqp);
+  p_x4Psidp.push_back(gen->x4Psidp);
+  p_x5Psiqp.push_back(gen->x5Psiqp);
+  p_x6Edp.push_back(gen->x6Edp);
+  p_x1d_1.push_back(gen->x1d_1);
+  p_x2w_1.push_back(gen->x2w_1);
+  p_x3Eqp_1.push_back(gen->x3Eqp_1);
+  p_x4Psidp_1.push_back(gen->x4Psidp_1);
+  p_x5Psiqp_1.push_back(gen->x5Psiqp_1);
+  p_x6Edp_1.push_back(gen->x6Edp_1);
+  p_dx1d.push_back(gen->dx1d);
+  p_dx2w.push_back(gen->dx2w);
+  p_dx3Eqp.push_back(gen->dx3Eqp);
+  p_dx4Psidp.push_back(gen->dx4Psidp);
+  p_dx5Psiqp.push_back(gen->dx5Psiqp);
+  p_dx6Edp.push_back(gen->dx6Edp);
+  p_dx1d_1.push_back(gen->dx1d_1);
+  p_dx2w_1.push_back(gen->dx2w_1);
+  p_dx3Eqp_1.push_back(gen->dx3Eqp_1);
+  p_dx4Psidp_1.push_back(gen->dx4Psidp_1);
+  p_dx5Psiqp_1.push_back(gen->dx5Psiqp_1);
+  p_dx6Edp_1.push_back(gen->dx6Edp_1);
+  p_Id.push_back(gen->Id);
+  p_Iq.push_back(gen->Iq);
+  p_Efd.push_back(gen->Efd);
+  p_LadIfd.push_back(gen->LadIfd);
+  p_Pmech.push_back(gen->Pmech);
+
+  p_Vr.push_back(gen->presentMag * cos(gen->presentAng));
+  p_Vi.push_back(gen->presentMag * sin(gen->presentAng));
+  p_Vmag.push_back(gen->presentMag);
+  p_IrNorton.push_back(real(gen->p_INorton));
+  p_IiNorton.push_back(imag(gen->p_INorton));
+
+  gen->setBatch(this, p_size);
+  generator->setBatched(true);
+  p_size++;
+  return true;
+}
+
+/**
+ * Copy state back into generators and remove all generators from batch
+ */
+void gridpack::dynamic_simulation::GenrouBatch::clear()
+{
+  int i;
+  for (i = 0; i < p_size; i++) {
+    syncGenerator(i);
+    p_generators[i]->setBatch(NULL, -1);
+    p_models[i]->setBatched(false);
+  }
+  p_size = 0;
+  p_models.clear();
+  p_generators.clear();
+  p_exciters.clear();
+  p_governors.clear();
+  p_exdc1.clear();
+  p_wsieg1.clear();
+  p_exciterIdx.clear();
+  p_governorIdx.clear();
+
+  p_H.clear();
+  p_D.clear();
+  p_Xd.clear();
+  p_Xq.clear();
+  p_Xdp.clear();
+  p_Xdpp.clear();
+  p_Xl.clear();
+  p_Xqp.clear();
+  p_Xqpp.clear();
+  p_Tdop.clear();
+  p_Tdopp.clear();
+  p_Tqopp.clear();
+  p_satA.clear();
+  p_satB.clear();
+  p_scale.clear();
+  p_B.clear();
+  p_G.clear();
+
+  p_x1d.clear();
+  p_x2w.clear();
+  p_x3Eqp.clear();
+  p_x4Psidp.clear();
+  p_x5Psiqp.clear();
+  p_x6Edp.clear();
+  p_x1d_1.clear();
+  p_x2w_1.clear();
+  p_x3Eqp_1.clear();
+  p_x4Psidp_1.clear();
+  p_x5Psiqp_1.clear();
+  p_x6Edp_1.clear();
+  p_dx1d.clear();
+  p_dx2w.clear();
+  p_dx3Eqp.clear();
+  p_dx4Psidp.clear();
+  p_dx5Psiqp.clear();
+  p_dx6Edp.clear();
+  p_dx1d_1.clear();
+  p_dx2w_1.clear();
+  p_dx3Eqp_1.clear();
+  p_dx4Psidp_1.clear();
+  p_dx5Psiqp_1.clear();
+  p_dx6Edp_1.clear();
+  p_Id.clear();
+  p_Iq.clear();
+  p_Efd.clear();
+  p_LadIfd.clear();
+  p_Pmech.clear();
+
+  p_Vr.clear();
+  p_Vi.clear();
+  p_Vmag.clear();
+  p_IrNorton.clear();
+  p_IiNorton.clear();
+}
+
+/**
+ * Number of generators in batch
+ * @return number of generators
+ */
+int gridpack::dynamic_simulation::GenrouBatch::size()
+{
+  return p_size;
+}
+
+/**
+ * Copy arrays that hold state at the end of the last step into arrays
+ * that hold state at the start of the current step
+ */
+void gridpack::dynamic_simulation::GenrouBatch::resetState(void)
+{
+  p_x1d = p_x1d_1;
+  p_x2w = p_x2w_1;
+  p_x3Eqp = p_x3Eqp_1;
+  p_x4Psidp = p_x4Psidp_1;
+  p_x5Psiqp = p_x5Psiqp_1;
+  p_x6Edp = p_x6Edp_1;
+}
+
+/**
+ * Get field voltage and mechanical power of all generators from their
+ * exciters and governors
+ */
+void gridpack::dynamic_simulation::GenrouBatch::getControls(void)
+{
+  int i;
+  for (i = 0; i < p_size; i++) {
+    if (p_exciterIdx[i] >= 0) {
+      p_Efd[i] = p_exdc1.getFieldVoltage(p_exciterIdx[i]);
+    } else {
+      p_Efd[i] = p_exciters[i]->getFieldVoltage();
+    }
+    if (p_governorIdx[i] >= 0) {
+      p_Pmech[i] = p_wsieg1.getMechanicalPower(p_governorIdx[i]);
+    } else {
+      p_Pmech[i] = p_governors[i]->getMechanicalPower();
+    }
+  }
+}
+
+/**
+ * Predictor part calculate current injections for all generators
+ * @param flag initial step if true
+ */
+void gridpack::dynamic_simulation::GenrouBatch::predictor_currentInjection(
+    bool flag)
+{
+  if (p_size == 0) return;
+  if (!flag) resetState();
+  int i;
+  for (i = 0; i < p_size; i++) {
+    genrouNorton(p_Xdp[i], p_Xdpp[i], p_Xl[i], p_Xqp[i], p_Xqpp[i],
+        p_B[i], p_G[i], p_scale[i], p_Vr[i], p_Vi[i],
+        p_x1d[i], p_x2w[i], p_x3Eqp[i], p_x4Psidp[i], p_x5Psiqp[i],
+        p_x6Edp[i], p_Id[i], p_Iq[i], p_IrNorton[i], p_IiNorton[i]);
+  }
+}
+
+/**
+ * Corrector part calculate current injections for all generators
+ * @param flag initial step if true
+ */
+void gridpack::dynamic_simulation::GenrouBatch::corrector_currentInjection(
+    bool flag)
+{
+  int i;
+  for (i = 0; i < p_size; i++) {
+    genrouNorton(p_Xdp[i], p_Xdpp[i], p_Xl[i], p_Xqp[i], p_Xqpp[i],
+        p_B[i], p_G[i], p_scale[i], p_Vr[i], p_Vi[i],
+        p_x1d_1[i], p_x2w_1[i], p_x3Eqp[i], p_x4Psidp[i], p_x5Psiqp[i],
+        p_x6Edp[i], p_Id[i], p_Iq[i], p_IrNorton[i], p_IiNorton[i]);
+  }
+}
+
+/**
+ * Predict new state variables for time step for all generators
+ * @param t_inc time step increment
+ * @param flag initial step if true
+ */
+void gridpack::dynamic_simulation::GenrouBatch::predictor(
+    double t_inc, bool flag)
+{
+  if (p_size == 0) return;
+  int i;
+  getControls();
+
+  if (!flag) resetState();
+
+  double pi = 4.0*atan(1.0);
+  const double basrad = 2 * pi * 60; // nominal frequency of 60 Hz
+  for (i = 0; i < p_size; i++) {
+    double Xdp = p_Xdp[i];
+    double Xdpp = p_Xdpp[i];
+    double Xl = p_Xl[i];
+    double Xqp = p_Xqp[i];
+    double Xqpp = p_Xqpp[i];
+    double x2w = p_x2w[i];
+    double x3Eqp = p_x3Eqp[i];
+    double x4Psidp = p_x4Psidp[i];
+    double x5Psiqp = p_x5Psiqp[i];
+    double x6Edp = p_x6Edp[i];
+    double Id = p_Id[i];
+    double Iq = p_Iq[i];
+    double Psiqpp = - x6Edp * (Xqpp - Xl) / (Xqp - Xl)
+                    - x5Psiqp * (Xqp - Xqpp) / (Xqp - Xl);
+    double Psidpp = + x3Eqp * (Xdpp - Xl) / (Xdp - Xl)
+                    + x4Psidp * (Xdp - Xdpp) / (Xdp - Xl);
+    double Telec = Psidpp * Iq - Psiqpp * Id;
+    double TempD = (Xdp - Xdpp) / ((Xdp - Xl) * (Xdp - Xl))
+                 * (-x4Psidp - (Xdp - Xl) * Id + x3Eqp);
+    double sat = p_satB[i] * (x3Eqp - p_satA[i]) * (x3Eqp - p_satA[i])
+               / x3Eqp;
+    p_LadIfd[i] = x3Eqp * (1 + sat) + (p_Xd[i] - Xdp) * (Id + TempD);
+    p_dx1d[i] = x2w * basrad;
+    p_dx2w[i] = 1 / (2 * p_H[i]) * ((p_Pmech[i] - p_D[i] * x2w) / (1 + x2w)
+              - Telec);
+    p_dx3Eqp[i] = (p_Efd[i] - p_LadIfd[i]) / p_Tdop[i];
+    p_dx4Psidp[i] = (-x4Psidp - (Xdp - Xl) * Id + x3Eqp) / p_Tdopp[i];
+    p_dx5Psiqp[i] = (-x5Psiqp + (Xqp - Xl) * Iq + x6Edp) / p_Tqopp[i];
+    double TempQ = (Xqp - Xqpp) / ((Xqp - Xl) * (Xqp - Xl))
+                 * (-x5Psiqp + (Xqp - Xl) * Iq + x6Edp);
+    p_dx6Edp[i] = (-x6Edp + (p_Xq[i] - Xqp) * (Iq - TempQ)) / p_Tqopp[i];
+
+    p_x1d_1[i] = p_x1d[i] + p_dx1d[i] * t_inc;
+    p_x2w_1[i] = x2w + p_dx2w[i] * t_inc;
+    p_x3Eqp_1[i] = x3Eqp + p_dx3Eqp[i] * t_inc;
+    p_x4Psidp_1[i] = x4Psidp + p_dx4Psidp[i] * t_inc;
+    p_x5Psiqp_1[i] = x5Psiqp + p_dx5Psiqp[i] * t_inc;
+    p_x6Edp_1[i] = x6Edp + p_dx6Edp[i] * t_inc;
+  }
+
+  for (i = 0; i < p_size; i++) {
+    if (p_exciterIdx[i] >= 0) {
+      p_exdc1.setInputs(p_exciterIdx[i], p_x2w_1[i], p_Vmag[i]);
+    } else {
+      p_exciters[i]->setOmega(p_x2w_1[i]);
+      p_exciters[i]->setVterminal(p_Vmag[i]);
+      p_exciters[i]->predictor(t_inc, flag);
+    }
+
+    if (p_governorIdx[i] >= 0) {
+      p_wsieg1.setRotorSpeedDeviation(p_governorIdx[i], p_x2w[i]);
+    } else {
+      p_governors[i]->setRotorSpeedDeviation(p_x2w[i]);
+      p_governors[i]->predictor(t_inc, flag);
+    }
+  }
+  p_exdc1.predictor(t_inc, flag);
+  p_wsieg1.predictor(t_inc, flag);
+}
+
+/**
+ * Correct state variables for time step for all generators
+ * @param t_inc time step increment
+ * @param flag initial step if true
+ */
+void gridpack::dynamic_simulation::GenrouBatch::corrector(
+    double t_inc, bool flag)
+{
+  if (p_size == 0) return;
+  int i;
+  getControls();
+
+  double pi = 4.0*atan(1.0);
+  const double basrad = 2 * pi * 60; // nominal frequency of 60 Hz
+  for (i = 0; i < p_size; i++) {
+    double Xdp = p_Xdp[i];
+    double Xdpp = p_Xdpp[i];
+    double Xl = p_Xl[i];
+    double Xqp = p_Xqp[i];
+    double Xqpp = p_Xqpp[i];
+    double x2w_1 = p_x2w_1[i];
+    double x3Eqp_1 = p_x3Eqp_1[i];
+    double x4Psidp_1 = p_x4Psidp_1[i];
+    double x5Psiqp_1 = p_x5Psiqp_1[i];
+    double x6Edp_1 = p_x6Edp_1[i];
+    double Id = p_Id[i];
+    double Iq = p_Iq[i];
+    double Psiqpp = - x6Edp_1 * (Xqpp - Xl) / (Xqp - Xl)
+                    - x5Psiqp_1 * (Xqp - Xqpp) / (Xqp - Xl);
+    double Psidpp = + x3Eqp_1 * (Xdpp - Xl) / (Xdp - Xl)
+                    + x4Psidp_1 * (Xdp - Xdpp) / (Xdp - Xl);
+    double Telec = Psidpp * Iq - Psiqpp * Id;
+    double TempD = (Xdp - Xdpp) / ((Xdp - Xl) * (Xdp - Xl))
+                 * (-x4Psidp_1 - (Xdp - Xl) * Id + x3Eqp_1);
+    double sat = p_satB[i] * (x3Eqp_1 - p_satA[i]) * (x3Eqp_1 - p_satA[i])
+               / x3Eqp_1;
+    p_LadIfd[i] = x3Eqp_1 * (1 + sat) + (p_Xd[i] - Xdp) * (Id + TempD);
+    p_dx1d_1[i] = x2w_1 * basrad;
+    p_dx2w_1[i] = 1 / (2 * p_H[i]) * ((p_Pmech[i] - p_D[i] * x2w_1)
+                / (1 + x2w_1) - Telec);
+    p_dx3Eqp_1[i] = (p_Efd[i] - p_LadIfd[i]) / p_Tdop[i];
+    p_dx4Psidp_1[i] = (-x4Psidp_1 - (Xdp - Xl) * Id + x3Eqp_1) / p_Tdopp[i];
+    p_dx5Psiqp_1[i] = (-x5Psiqp_1 + (Xqp - Xl) * Iq + x6Edp_1) / p_Tqopp[i];
+    double TempQ = (Xqp - Xqpp) / ((Xqp - Xl) * (Xqp - Xl))
+                 * (-x5Psiqp_1 + (Xqp - Xl) * Iq + x6Edp_1);
+    p_dx6Edp_1[i] = (-x6Edp_1 + (p_Xq[i] - Xqp) * (Iq - TempQ)) / p_Tqopp[i];
+
+    p_x1d_1[i] = p_x1d[i] + (p_dx1d[i] + p_dx1d_1[i]) / 2.0 * t_inc;
+    p_x2w_1[i] = p_x2w[i] + (p_dx2w[i] + p_dx2w_1[i]) / 2.0 * t_inc;
+    p_x3Eqp_1[i] = p_x3Eqp[i] + (p_dx3Eqp[i] + p_dx3Eqp_1[i]) / 2.0 * t_inc;
+    p_x4Psidp_1[i] = p_x4Psidp[i]
+                   + (p_dx4Psidp[i] + p_dx4Psidp_1[i]) / 2.0 * t_inc;
+    p_x5Psiqp_1[i] = p_x5Psiqp[i]
+                   + (p_dx5Psiqp[i] + p_dx5Psiqp_1[i]) / 2.0 * t_inc;
+    p_x6Edp_1[i] = p_x6Edp[i] + (p_dx6Edp[i] + p_dx6Edp_1[i]) / 2.0 * t_inc;
+  }
+
+  for (i = 0; i < p_size; i++) {
+    if (p_exciterIdx[i] >= 0) {
+      p_exdc1.setInputs(p_exciterIdx[i], p_x2w_1[i], p_Vmag[i]);
+    } else {
+      p_exciters[i]->setOmega(p_x2w_1[i]);
+      p_exciters[i]->setVterminal(p_Vmag[i]);
+      p_exciters[i]->corrector(t_inc, flag);
+    }
+
+    if (p_governorIdx[i] >= 0) {
+      p_wsieg1.setRotorSpeedDeviation(p_governorIdx[i], p_x2w[i]);
+    } else {
+      p_governors[i]->setRotorSpeedDeviation(p_x2w[i]);
+      p_governors[i]->corrector(t_inc, flag);
+    }
+  }
+  p_exdc1.corrector(t_inc, flag);
+  p_wsieg1.corrector(t_inc, flag);
+}
+
+/**
+ * Return contribution to Norton current of a generator
+ * @param idx index of generator in batch
+ * @return contribution to Norton vector
+ */
+gridpack::ComplexType gridpack::dynamic_simulation::GenrouBatch::INorton(
+    int idx)
+{
+  return gridpack::ComplexType(p_IrNorton[idx], p_IiNorton[idx]);
+}
+
+/**
+ * Set terminal voltage of a generator
+ * @param idx index of generator in batch
+ * @param voltage complex voltage at generator bus
+ */
+void gridpack::dynamic_simulation::GenrouBatch::setVoltage(int idx,
+    gridpack::ComplexType voltage)
+{
+  p_Vr[idx] = real(voltage);
+  p_Vi[idx] = imag(voltage);
+  p_Vmag[idx] = abs(voltage);
+}
+
+/**
+ * Copy state of a generator from the batch back into the generator
+ * object
+ * @param idx index of generator in batch
+ */
+void gridpack::dynamic_simulation::GenrouBatch::syncGenerator(int idx)
+{
+  GenrouGenerator *gen = p_generators[idx];
+  gen->x1d = p_x1d[idx];
+  gen->x2w = p_x2w[idx];
+  gen->x3Eqp = p_x3Eqp[idx];
+  gen->x4Psidp = p_x4Psidp[idx];
+  gen->x5Psiqp = p_x5Psiqp[idx];
+  gen->x6Edp = p_x6Edp[idx];
+  gen->x1d_1 = p_x1d_1[idx];
+  gen->x2w_1 = p_x2w_1[idx];
+  gen->x3Eqp_1 = p_x3Eqp_1[idx];
+  gen->x4Psidp_1 = p_x4Psidp_1[idx];
+  gen->x5Psiqp_1 = p_x5Psiqp_1[idx];
+  gen->x6Edp_1 = p_x6Edp_1[idx];
+  gen->dx1d = p_dx1d[idx];
+  gen->dx2w = p_dx2w[idx];
+  gen->dx3Eqp = p_dx3Eqp[idx];
+  gen->dx4Psidp = p_dx4Psidp[idx];
+  gen->dx5Psiqp = p_dx5Psiqp[idx];
+  gen->dx6Edp = p_dx6Edp[idx];
+  gen->dx1d_1 = p_dx1d_1[idx];
+  gen->dx2w_1 = p_dx2w_1[idx];
+  gen->dx3Eqp_1 = p_dx3Eqp_1[idx];
+  gen->dx4Psidp_1 = p_dx4Psidp_1[idx];
+  gen->dx5Psiqp_1 = p_dx5Psiqp_1[idx];
+  gen->dx6Edp_1 = p_dx6Edp_1[idx];
+  gen->Id = p_Id[idx];
+  gen->Iq = p_Iq[idx];
+  gen->Efd = p_Efd[idx];
+  gen->LadIfd = p_LadIfd[idx];
+  gen->Pmech = p_Pmech[idx];
+  gen->B = p_B[idx];
+  gen->G = p_G[idx];
+  gen->presentMag = p_Vmag[idx];
+  gen->presentAng = atan2(p_Vi[idx], p_Vr[idx]);
+  gen->p_INorton = gridpack::ComplexType(p_IrNorton[idx], p_IiNorton[idx]);
+}
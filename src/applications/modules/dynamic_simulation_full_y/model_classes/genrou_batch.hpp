@@ -0,0 +1,156 @@
+/*
+ *     Copyright (c) 2013 Battelle Memorial Institute
+ *     Licensed under modified BSD License. A copy of this license can be found
+ *     in the LICENSE file in the top level directory of this distribution.
+ */
+// -------------------------------------------------------------
+/**
+ * @file   genrou_batch.hpp
+ *
+ * @brief  Batched integration of all GENROU generators on a process.
+ * Parameters and state variables of the generators are held in
+ * separate arrays and each stage of the predictor-corrector scheme is
+ * evaluated in a single loop over the arrays. EXDC1 exciters and WSIEG1
+ * governors attached to the generators are advanced in batches of their
+ * own. Other exciter and governor models are still updated through
+ * their own objects.
+ *
+ */
+
+#ifndef _genrou_batch_h_
+#define _genrou_batch_h_
+
+#include <vector>
+#include "boost/smart_ptr/shared_ptr.hpp"
+#include "base_generator_batch.hpp"
+#include "genrou.hpp"
+#include "exdc1_batch.hpp"
+#include "wsieg1_batch.hpp"
+
+namespace gridpack {
+namespace dynamic_simulation {
+class GenrouBatch : public BaseGeneratorBatch
+{
+  public:
+    /**
+     * Basic constructor
+     */
+    GenrouBatch();
+
+    /**
+     * Basic destructor
+     */
+    virtual ~GenrouBatch();
+
+    /**
+     * Add an initialized generator to the batch. Parameters and state of
+     * the generator are copied into the batch and the generator is marked
+     * as batched
+     * @param generator generator model
+     * @return false if generator is not a GENROU model
+     */
+    bool addGenerator(boost::shared_ptr<BaseGeneratorModel> generator);
+
+    /**
+     * Copy state back into generators and remove all generators from batch
+     */
+    void clear();
+
+    /**
+     * Number of generators in batch
+     * @return number of generators
+     */
+    int size();
+
+    /**
+     * Predictor part calculate current injections for all generators
+     * @param flag initial step if true
+     */
+    void predictor_currentInjection(bool flag);
+
+    /**
+     * Corrector part calculate current injections for all generators
+     * @param flag initial step if true
+     */
+    void corrector_currentInjection(bool flag);
+
+    /**
+     * Predict new state variables for time step for all generators
+     * @param t_inc time step increment
+     * @param flag initial step if true
+     */
+    void predictor(double t_inc, bool flag);
+
+    /**
+     * Correct state variables for time step for all generators
+     * @param t_inc time step increment
+     * @param flag initial step if true
+     */
+    void corrector(double t_inc, bool flag);
+
+    /**
+     * Return contribution to Norton current of a generator
+     * @param idx index of generator in batch
+     * @return contribution to Norton vector
+     */
+    gridpack::ComplexType INorton(int idx);
+
+    /**
+     * Set terminal voltage of a generator
+     * @param idx index of generator in batch
+     * @param voltage complex voltage at generator bus
+     */
+    void setVoltage(int idx, gridpack::ComplexType voltage);
+
+    /**
+     * Copy state of a generator from the batch back into the generator
+     * object
+     * @param idx index of generator in batch
+     */
+    void syncGenerator(int idx);
+
+  private:
+
+    // Copy arrays that hold state at the end of the last step into arrays
+    // that hold state at the start of the current step
+    void resetState(void);
+
+    // Get field voltage and mechanical power of all generators from their
+    // exciters and governors
+    void getControls(void);
+
+    int p_size;
+
+    std::vector<boost::shared_ptr<BaseGeneratorModel> > p_models;
+    std::vector<GenrouGenerator*> p_generators;
+    std::vector<BaseExciterModel*> p_exciters;
+    std::vector<BaseGovernorModel*> p_governors;
+
+    // Batched exciters and governors. The index of the exciter or
+    // governor of each generator in its batch is -1 if it is not batched
+    Exdc1Batch p_exdc1;
+    Wsieg1Batch p_wsieg1;
+    std::vector<int> p_exciterIdx, p_governorIdx;
+
+    // Parameters
+    std::vector<double> p_H, p_D, p_Xd, p_Xq, p_Xdp, p_Xdpp, p_Xl;
+    std::vector<double> p_Xqp, p_Xqpp, p_Tdop, p_Tdopp, p_Tqopp;
+    std::vector<double> p_satA, p_satB, p_scale, p_B, p_G;
+
+    // State
+    std::vector<double> p_x1d, p_x2w, p_x3Eqp, p_x4Psidp, p_x5Psiqp, p_x6Edp;
+    std::vector<double> p_x1d_1, p_x2w_1, p_x3Eqp_1, p_x4Psidp_1,
+      p_x5Psiqp_1, p_x6Edp_1;
+    std::vector<double> p_dx1d, p_dx2w, p_dx3Eqp, p_dx4Psidp, p_dx5Psiqp,
+      p_dx6Edp;
+    std::vector<double> p_dx1d_1, p_dx2w_1, p_dx3Eqp_1, p_dx4Psidp_1,
+      p_dx5Psiqp_1, p_dx6Edp_1;
+    std::vector<double> p_Id, p_Iq, p_Efd, p_LadIfd, p_Pmech;
+
+    // Terminal voltage and Norton current
+    std::vector<double> p_Vr, p_Vi, p_Vmag;
+    std::vector<double> p_IrNorton, p_IiNorton;
+};
+}  // dynamic_simulation
+}  // gridpack
+#endif
@@ -25,6 +25,8 @@
 
 namespace gridpack {
 namespace dynamic_simulation {
+class Wsieg1Batch;
+
 class Wsieg1Model : public BaseGovernorModel
 {
   public:
@@ -120,6 +122,7 @@ class Wsieg1Model : public BaseGovernorModel
     double Pref;
     double w;
 
+    friend class Wsieg1Batch;
 };
 }  // dynamic_simulation
 }  // gridpack
@@ -0,0 +1,410 @@
+/*
+ *     Copyright (c) 2013 Battelle Memorial Institute
+ *     Licensed under modified BSD License. A copy of this license can be found
+ *     in the LICENSE file in the top level directory of this distribution.
+ */
+// -----------------------------------------------------------
+/**
+ * @file   wsieg1_batch.cpp
+ *
+ * @brief  Batched integration of WSIEG1 governors attached to batched
+ * generators
+ *
+ */
+
+#include <vector>
+
+#include "wsieg1_batch.hpp"
+
+/**
+ *  Basic constructor
+ */
+gridpack::dynamic_simulation::Wsieg1Batch::Wsieg1Batch(void)
+{
+  p_size = 0;
+}
+
+/**
+ *  Basic destructor
+ */
+gridpack::dynamic_simulation::Wsieg1Batch::~Wsieg1Batch(void)
+{
+  clear();
+}
+
+/**
+ * Add an initialized governor to the batch. Parameters and state of
+ * the governor are copied into the batch
+ * @param governor governor model
+ * @return index of governor in batch or -1 if governor is not a WSIEG1
+ * model
+ */
+int gridpack::dynamic_simulation::Wsieg1Batch::addGovernor(
+    BaseGovernorModel *governor)
+{
+  Wsieg1Model *gov = dynamic_cast<Wsieg1Model*>(governor);
+  if (gov == NULL) return -1;
+  p_governors.push_back(gov);
+
+  p_K.push_back(gov->K);
+  p_T1.push_back(gov->T1);
+  p_T2.push_back(gov->T2);
+  p_T3.push_back(gov->T3);
+  p_Uo.push_back(gov->Uo);
+  p_Uc.push_back(gov->Uc);
+  p_Pmax.push_back(gov->Pmax);
+  p_Pmin.push_back(gov->Pmin);
+  p_T4.push_back(gov->T4);
+  p_T5.push_back(gov->T5);
+  p_T6.push_back(gov->T6);
+  p_T7.push_back(gov->T7);
+  p_K1.push_back(gov->K1);
+  p_K2.push_back(gov->K2);
+  p_K3.push_back(gov->K3);
+  p_K4.push_back(gov->K4);
+  p_K5.push_back(gov->K5);
+  p_K6.push_back(gov->K6);
+  p_K7.push_back(gov->K7);
+  p_K8.push_back(gov->K8);
+  p_Pref.push_back(gov->Pref);
+
+  p_x1LL.push_back(gov->x1LL);
+  p_x2GovOut.push_back(gov->x2GovOut);
+  p_x3Turb1.push_back(gov->x3Turb1);
+  p_x4Turb2.push_back(gov->x4Turb2);
+  p_x5Turb3.push_back(gov->x5Turb3);
+  p_x6Turb4.push_back(gov->x6Turb4);
+  p_x1LL_1.push_back(gov->x1LL_1);
+  p_x2GovOut_1.push_back(gov->x2GovOut_1);
+  p_x3Turb1_1.push_back(gov->x3Turb1_1);
+  p_x4Turb2_1.push_back(gov->x4Turb2_1);
+  p_x5Turb3_1.push_back(gov->x5Turb3_1);
+  p_x6Turb4_1.push_back(gov->x6Turb4_1);
+  p_dx1LL.push_back(gov->dx1LL);
+  p_dx2GovOut.push_back(gov->dx2GovOut);
+  p_dx3Turb1.push_back(gov->dx3Turb1);
+  p_dx4Turb2.push_back(gov->dx4Turb2);
+  p_dx5Turb3.push_back(gov->dx5Turb3);
+  p_dx6Turb4.push_back(gov->dx6Turb4);
+  p_dx1LL_1.push_back(gov->dx1LL_1);
+  p_dx2GovOut_1.push_back(gov->dx2GovOut_1);
+  p_dx3Turb1_1.push_back(gov->dx3Turb1_1);
+  p_dx4Turb2_1.push_back(gov->dx4Turb2_1);
+  p_dx5Turb3_1.push_back(gov->dx5Turb3_1);
+  p_dx6Turb4_1.push_back(gov->dx6Turb4_1);
+  p_Pmech1.push_back(gov->Pmech1);
+  p_Pmech2.push_back(gov->Pmech2);
+  p_w.push_back(gov->w);
+
+  p_size++;
+  return p_size-1;
+}
+
+/**
+ * Copy state back into governors and remove all governors from batch
+ */
+void gridpack::dynamic_simulation::Wsieg1Batch::clear()
+{
+  int i;
+  for (i = 0; i < p_size; i++) {
+    syncGovernor(i);
+  }
+  p_size = 0;
+  p_governors.clear();
+
+  p_K.clear();
+  p_T1.clear();
+  p_T2.clear();
+  p_T3.clear();
+  p_Uo.clear();
+  p_Uc.clear();
+  p_Pmax.clear();
+  p_Pmin.clear();
+  p_T4.clear();
+  p_T5.clear();
+  p_T6.clear();
+  p_T7.clear();
+  p_K1.clear();
+  p_K2.clear();
+  p_K3.clear();
+  p_K4.clear();
+  p_K5.clear();
+  p_K6.clear();
+  p_K7.clear();
+  p_K8.clear();
+  p_Pref.clear();
+
+  p_x1LL.clear();
+  p_x2GovOut.clear();
+  p_x3Turb1.clear();
+  p_x4Turb2.clear();
+  p_x5Turb3.clear();
+  p_x6Turb4.clear();
+  p_x1LL_1.clear();
+  p_x2GovOut_1.clear();
+  p_x3Turb1_1.clear();
+  p_x4Turb2_1.clear();
+  p_x5Turb3_1.clear();
+  p_x6Turb4_1.clear();
+  p_dx1LL.clear();
+  p_dx2GovOut.clear();
+  p_dx3Turb1.clear();
+  p_dx4Turb2.clear();
+  p_dx5Turb3.clear();
+  p_dx6Turb4.clear();
+  p_dx1LL_1.clear();
+  p_dx2GovOut_1.clear();
+  p_dx3Turb1_1.clear();
+  p_dx4Turb2_1.clear();
+  p_dx5Turb3_1.clear();
+  p_dx6Turb4_1.clear();
+  p_Pmech1.clear();
+  p_Pmech2.clear();
+  p_w.clear();
+}
+
+/**
+ * Number of governors in batch
+ * @return number of governors
+ */
+int gridpack::dynamic_simulation::Wsieg1Batch::size()
+{
+  return p_size;
+}
+
+/**
+ * Set the rotor speed deviation of a governor for the next stage
+ * @param idx index of governor in batch
+ * @param delta_o value of the rotor speed deviation
+ */
+void gridpack::dynamic_simulation::Wsieg1Batch::setRotorSpeedDeviation(
+    int idx, double delta_o)
+{
+  p_w[idx] = delta_o;
+}
+
+/**
+ * Get the value of the mechanical power of a governor
+ * @param idx index of governor in batch
+ * @return value of mechanical power
+ */
+double gridpack::dynamic_simulation::Wsieg1Batch::getMechanicalPower(
+    int idx)
+{
+  return p_Pmech1[idx];
+}
+
+/**
+ * Predict new state variables for time step for all governors
+ * @param t_inc time step increment
+ * @param flag initial step if true
+ */
+void gridpack::dynamic_simulation::Wsieg1Batch::predictor(
+    double t_inc, bool flag)
+{
+  if (p_size == 0) return;
+  if (!flag) {
+    p_x1LL = p_x1LL_1;
+    p_x2GovOut = p_x2GovOut_1;
+    p_x3Turb1 = p_x3Turb1_1;
+    p_x4Turb2 = p_x4Turb2_1;
+    p_x5Turb3 = p_x5Turb3_1;
+    p_x6Turb4 = p_x6Turb4_1;
+  }
+  int i;
+  for (i = 0; i < p_size; i++) {
+    double T1 = p_T1[i];
+    double T2 = p_T2[i];
+    // State 1
+    double TempIn1 = p_K[i] * p_w[i];
+    double TempOut;
+    if (T1 > 4 * t_inc) {
+      p_dx1LL[i] = (TempIn1 * ( 1 - T2 / T1) - p_x1LL[i]) / T1;
+      TempOut = TempIn1 * (T2 / T1) + p_x1LL[i];
+    } else {
+      TempOut = TempIn1;
+    }
+    // State 2
+    // enforce non-windup limits
+    double TempIn2;
+    if (p_x2GovOut[i] > p_Pmax[i]) p_x2GovOut[i] = p_Pmax[i];
+    else if (p_x2GovOut[i] < p_Pmin[i]) p_x2GovOut[i] = p_Pmin[i];
+    double GV = p_governors[i]->BackLash.Output(p_x2GovOut[i]);
+    if (p_T3[i] < 4 * t_inc) TempIn2 = (+ p_Pref[i] - TempOut - GV)
+      / (4 * t_inc);
+    else TempIn2 = (+ p_Pref[i] - TempOut - GV) / p_T3[i];
+    if (TempIn2 > p_Uo[i]) TempIn2 = p_Uo[i];
+    else if (TempIn2 < p_Uc[i]) TempIn2 = p_Uc[i];
+    p_dx2GovOut[i] = TempIn2;
+    // enforce non-windup limits
+    if (p_dx2GovOut[i] > 0 && p_x2GovOut[i] >= p_Pmax[i])
+      p_dx2GovOut[i] = 0;
+    else if (p_dx2GovOut[i] < 0 && p_x2GovOut[i] <= p_Pmin[i])
+      p_dx2GovOut[i] = 0;
+    // State 3
+    double PGV = p_governors[i]->GainBlock.XtoY(GV);
+    if (p_T4[i] < 4 * t_inc) {
+      p_x3Turb1[i] = PGV;
+      p_dx3Turb1[i] = 0;
+    } else {
+      p_dx3Turb1[i] = (PGV - p_x3Turb1[i]) / p_T4[i];
+    }
+    // State 4
+    if (p_T5[i] < 4 * t_inc) {
+      p_x4Turb2[i] = p_x3Turb1[i];
+      p_dx4Turb2[i] = 0;
+    } else {
+      p_dx4Turb2[i] = (p_x3Turb1[i] - p_x4Turb2[i]) / p_T5[i];
+    }
+    // State 5
+    if (p_T6[i] < 4 * t_inc) {
+      p_x5Turb3[i] = p_x4Turb2[i];
+      p_dx5Turb3[i] = 0;
+    } else {
+      p_dx5Turb3[i] = (p_x4Turb2[i] - p_x5Turb3[i]) / p_T6[i];
+    }
+    // State 6
+    if (p_T7[i] < 4 * t_inc) {
+      p_x6Turb4[i] = p_x5Turb3[i];
+      p_dx6Turb4[i] = 0;
+    } else {
+      p_dx6Turb4[i] = (p_x5Turb3[i] - p_x6Turb4[i]) / p_T7[i];
+    }
+
+    p_x1LL_1[i] = p_x1LL[i] + p_dx1LL[i] * t_inc;
+    p_x2GovOut_1[i] = p_x2GovOut[i] + p_dx2GovOut[i] * t_inc;
+    p_x3Turb1_1[i] = p_x3Turb1[i] + p_dx3Turb1[i] * t_inc;
+    p_x4Turb2_1[i] = p_x4Turb2[i] + p_dx4Turb2[i] * t_inc;
+    p_x5Turb3_1[i] = p_x5Turb3[i] + p_dx5Turb3[i] * t_inc;
+    p_x6Turb4_1[i] = p_x6Turb4[i] + p_dx6Turb4[i] * t_inc;
+
+    p_Pmech1[i] = p_x3Turb1_1[i] * p_K1[i] + p_x4Turb2_1[i] * p_K3[i]
+                + p_x5Turb3_1[i] * p_K5[i] + p_x6Turb4_1[i] * p_K7[i];
+    p_Pmech2[i] = p_x3Turb1_1[i] * p_K2[i] + p_x4Turb2_1[i] * p_K4[i]
+                + p_x5Turb3_1[i] * p_K6[i] + p_x6Turb4_1[i] * p_K8[i];
+  }
+}
+
+/**
+ * Correct state variables for time step for all governors
+ * @param t_inc time step increment
+ * @param flag initial step if true
+ */
+void gridpack::dynamic_simulation::Wsieg1Batch::corrector(
+    double t_inc, bool flag)
+{
+  int i;
+  for (i = 0; i < p_size; i++) {
+    double T1 = p_T1[i];
+    double T2 = p_T2[i];
+    // State 1
+    double TempIn1 = p_K[i] * p_w[i];
+    double TempOut;
+    if (T1 > 4 * t_inc) {
+      p_dx1LL_1[i] = (TempIn1 * ( 1 - T2 / T1) - p_x1LL_1[i]) / T1;
+      TempOut = TempIn1 * (T2 / T1) + p_x1LL_1[i];
+    } else {
+      TempOut = TempIn1;
+    }
+    // State 2
+    // enforce non-windup limits
+    double TempIn2;
+    if (p_x2GovOut_1[i] > p_Pmax[i]) p_x2GovOut_1[i] = p_Pmax[i];
+    else if (p_x2GovOut_1[i] < p_Pmin[i]) p_x2GovOut_1[i] = p_Pmin[i];
+    double GV = p_governors[i]->BackLash.Output(p_x2GovOut_1[i]);
+    if (p_T3[i] < 4 * t_inc) TempIn2 = (+ p_Pref[i] - TempOut - GV)
+      / (4 * t_inc);
+    else TempIn2 = (+ p_Pref[i] - TempOut - GV) / p_T3[i];
+    if (TempIn2 > p_Uo[i]) TempIn2 = p_Uo[i];
+    else if (TempIn2 < p_Uc[i]) TempIn2 = p_Uc[i];
+    p_dx2GovOut_1[i] = TempIn2;
+    // enforce non-windup limits
+    if (p_dx2GovOut_1[i] > 0 && p_x2GovOut_1[i] >= p_Pmax[i])
+      p_dx2GovOut_1[i] = 0;
+    else if (p_dx2GovOut_1[i] < 0 && p_x2GovOut_1[i] <= p_Pmin[i])
+      p_dx2GovOut_1[i] = 0;
+    // State 3
+    double PGV = p_governors[i]->GainBlock.XtoY(GV);
+    if (p_T4[i] < 4 * t_inc) {
+      p_x3Turb1_1[i] = PGV;
+      p_dx3Turb1_1[i] = 0;
+    } else {
+      p_dx3Turb1_1[i] = (PGV - p_x3Turb1_1[i]) / p_T4[i];
+    }
+    // State 4
+    if (p_T5[i] < 4 * t_inc) {
+      p_x4Turb2_1[i] = p_x3Turb1_1[i];
+      p_dx4Turb2_1[i] = 0;
+    } else {
+      p_dx4Turb2_1[i] = (p_x3Turb1_1[i] - p_x4Turb2_1[i]) / p_T5[i];
+    }
+    // State 5
+    if (p_T6[i] < 4 * t_inc) {
+      p_x5Turb3_1[i] = p_x4Turb2_1[i];
+      p_dx5Turb3_1[i] = 0;
+    } else {
+      p_dx5Turb3_1[i] = (p_x4Turb2_1[i] - p_x5Turb3_1[i]) / p_T6[i];
+    }
+    // State 6
+    if (p_T7[i] < 4 * t_inc) {
+      p_x6Turb4_1[i] = p_x5Turb3_1[i];
+      p_dx6Turb4_1[i] = 0;
+    } else {
+      p_dx6Turb4_1[i] = (p_x5Turb3_1[i] - p_x6Turb4_1[i]) / p_T7[i];
+    }
+
+    p_x1LL_1[i] = p_x1LL[i] + (p_dx1LL[i] + p_dx1LL_1[i]) / 2.0 * t_inc;
+    p_x2GovOut_1[i] = p_x2GovOut[i]
+                    + (p_dx2GovOut[i] + p_dx2GovOut_1[i]) / 2.0 * t_inc;
+    p_x3Turb1_1[i] = p_x3Turb1[i]
+                   + (p_dx3Turb1[i] + p_dx3Turb1_1[i]) / 2.0 * t_inc;
+    p_x4Turb2_1[i] = p_x4Turb2[i]
+                   + (p_dx4Turb2[i] + p_dx4Turb2_1[i]) / 2.0 * t_inc;
+    p_x5Turb3_1[i] = p_x5Turb3[i]
+                   + (p_dx5Turb3[i] + p_dx5Turb3_1[i]) / 2.0 * t_inc;
+    p_x6Turb4_1[i] = p_x6Turb4[i]
+                   + (p_dx6Turb4[i] + p_dx6Turb4_1[i]) / 2.0 * t_inc;
+
+    p_Pmech1[i] = p_x3Turb1_1[i] * p_K1[i] + p_x4Turb2_1[i] * p_K3[i]
+                + p_x5Turb3_1[i] * p_K5[i] + p_x6Turb4_1[i] * p_K7[i];
+    p_Pmech2[i] = p_x3Turb1_1[i] * p_K2[i] + p_x4Turb2_1[i] * p_K4[i]
+                + p_x5Turb3_1[i] * p_K6[i] + p_x6Turb4_1[i] * p_K8[i];
+  }
+}
+
+/**
+ * Copy state of a governor from the batch back into the governor
+ * object
+ * @param idx index of governor in batch
+ */
+void gridpack::dynamic_simulation::Wsieg1Batch::syncGovernor(int idx)
+{
+  Wsieg1Model *gov = p_governors[idx];
+  gov->x1LL = p_x1LL[idx];
+  gov->x2GovOut = p_x2GovOut[idx];
+  gov->x3Turb1 = p_x3Turb1[idx];
+  gov->x4Turb2 = p_x4Turb2[idx];
+  gov->x5Turb3 = p_x5Turb3[idx];
+  gov->x6Turb4 = p_x6Turb4[idx];
+  gov->x1LL_1 = p_x1LL_1[idx];
+  gov->x2GovOut_1 = p_x2GovOut_1[idx];
+  gov->x3Turb1_1 = p_x3Turb1_1[idx];
+  gov->x4Turb2_1 = p_x4Turb2_1[idx];
+  gov->x5Turb3_1 = p_x5Turb3_1[idx];
+  gov->x6Turb4_1 = p_x6Turb4_1[idx];
+  gov->dx1LL = p_dx1LL[idx];
+  gov->dx2GovOut = p_dx2GovOut[idx];
+  gov->dx3Turb1 = p_dx3Turb1[idx];
+  gov->dx4Turb2 = p_dx4Turb2[idx];
+  gov->dx5Turb3 = p_dx5Turb3[idx];
+  gov->dx6Turb4 = p_dx6Turb4[idx];
+  gov->dx1LL_1 = p_dx1LL_1[idx];
+  gov->dx2GovOut_1 = p_dx2GovOut_1[idx];
+  gov->dx3Turb1_1 = p_dx3Turb1_1[idx];
+  gov->dx4Turb2_1 = p_dx4Turb2_1[idx];
+  gov->dx5Turb3_1 = p_dx5Turb3_1[idx];
+  gov->dx6Turb4_1 = p_dx6Turb4_1[idx];
+  gov->Pmech1 = p_Pmech1[idx];
+  gov->Pmech2 = p_Pmech2[idx];
+  gov->w = p_w[idx];
+}
@@ -0,0 +1,120 @@
+/*
+ *     Copyright (c) 2013 Battelle Memorial Institute
+ *     Licensed under modified BSD License. A copy of this license can be found
+ *     in the LICENSE file in the top level directory of this distribution.
+ */
+// -------------------------------------------------------------
+/**
+ * @file   wsieg1_batch.hpp
+ *
+ * @brief  Batched integration of WSIEG1 governors attached to batched
+ * generators. Parameters and state variables of the governors are held
+ * in separate arrays and each stage is evaluated in a single loop over
+ * the arrays. The backlash and gain blocks of each governor are still
+ * evaluated through the governor's own objects.
+ *
+ */
+
+#ifndef _wsieg1_batch_h_
+#define _wsieg1_batch_h_
+
+#include <vector>
+#include "base_governor_model.hpp"
+#include "wsieg1.hpp"
+
+namespace gridpack {
+namespace dynamic_simulation {
+class Wsieg1Batch
+{
+  public:
+    /**
+     * Basic constructor
+     */
+    Wsieg1Batch();
+
+    /**
+     * Basic destructor
+     */
+    ~Wsieg1Batch();
+
+    /**
+     * Add an initialized governor to the batch. Parameters and state of
+     * the governor are copied into the batch
+     * @param governor governor model
+     * @return index of governor in batch or -1 if governor is not a WSIEG1
+     * model
+     */
+    int addGovernor(BaseGovernorModel *governor);
+
+    /**
+     * Copy state back into governors and remove all governors from batch
+     */
+    void clear();
+
+    /**
+     * Number of governors in batch
+     * @return number of governors
+     */
+    int size();
+
+    /**
+     * Set the rotor speed deviation of a governor for the next stage
+     * @param idx index of governor in batch
+     * @param delta_o value of the rotor speed deviation
+     */
+    void setRotorSpeedDeviation(int idx, double delta_o);
+
+    /**
+     * Get the value of the mechanical power of a governor
+     * @param idx index of governor in batch
+     * @return value of mechanical power
+     */
+    double getMechanicalPower(int idx);
+
+    /**
+     * Predict new state variables for time step for all governors
+     * @param t_inc time step increment
+     * @param flag initial step if true
+     */
+    void predictor(double t_inc, bool flag);
+
+    /**
+     * Correct state variables for time step for all governors
+     * @param t_inc time step increment
+     * @param flag initial step if true
+     */
+    void corrector(double t_inc, bool flag);
+
+    /**
+     * Copy state of a governor from the batch back into the governor
+     * object
+     * @param idx index of governor in batch
+     */
+    void syncGovernor(int idx);
+
+  private:
+
+    int p_size;
+
+    std::vector<Wsieg1Model*> p_governors;
+
+    // Parameters
+    std::vector<double> p_K, p_T1, p_T2, p_T3, p_Uo, p_Uc, p_Pmax, p_Pmin;
+    std::vector<double> p_T4, p_T5, p_T6, p_T7;
+    std::vector<double> p_K1, p_K2, p_K3, p_K4, p_K5, p_K6, p_K7, p_K8;
+    std::vector<double> p_Pref;
+
+    // State
+    std::vector<double> p_x1LL, p_x2GovOut, p_x3Turb1, p_x4Turb2,
+      p_x5Turb3, p_x6Turb4;
+    std::vector<double> p_x1LL_1, p_x2GovOut_1, p_x3Turb1_1, p_x4Turb2_1,
+      p_x5Turb3_1, p_x6Turb4_1;
+    std::vector<double> p_dx1LL, p_dx2GovOut, p_dx3Turb1, p_dx4Turb2,
+      p_dx5Turb3, p_dx6Turb4;
+    std::vector<double> p_dx1LL_1, p_dx2GovOut_1, p_dx3Turb1_1,
+      p_dx4Turb2_1, p_dx5Turb3_1, p_dx6Turb4_1;
+    std::vector<double> p_Pmech1, p_Pmech2, p_w;
+};
+}  // dynamic_simulation
+}  // gridpack
+#endif
@@ -0,0 +1,202 @@
+// -------------------------------------------------------------
+/*
+ *     Copyright (c) 2013 Battelle Memorial Institute
+ *     Licensed under modified BSD License. A copy of this license can be found
+ *     in the LICENSE file in the top level directory of this distribution.
+ */
+// -------------------------------------------------------------
+// -------------------------------------------------------------
+/**
+ * @file   generator_batch_test.cpp
+ *
+ * @brief  Check that GENROU generators with EXDC1 exciters and WSIEG1
+ * governors integrated in batches follow the same trajectory as the
+ * same models integrated one instance at a time
+ *
+ *
+ */
+// -------------------------------------------------------------
+
+#include <iostream>
+#include <cstring>
+#include <cmath>
+
+#include "boost/smart_ptr/shared_ptr.hpp"
+#include "gridpack/component/data_collection.hpp"
+#include "gridpack/parser/dictionary.hpp"
+#include "genrou.hpp"
+#include "genrou_batch.hpp"
+#include "exdc1.hpp"
+#include "wsieg1.hpp"
+
+#define BOOST_TEST_NO_MAIN
+#define BOOST_TEST_ALTERNATIVE_INIT_API
+#include <boost/test/included/unit_test.hpp>
+
+using namespace gridpack::dynamic_simulation;
+
+static const double delta(1.0e-8);
+static const int ngen(5);
+static const int nsteps(20);
+static const double tstep(0.005);
+
+// Terminal voltage of generator k at step s. The voltage drifts so that
+// the exciters and governors respond
+static gridpack::ComplexType
+terminalVoltage(int k, int s)
+{
+  return std::polar(1.0+0.01*k-0.002*s, 0.1*k);
+}
+
+// Create and initialize a GENROU generator with an EXDC1 exciter and a
+// WSIEG1 governor. Parameters depend on k so that generators differ
+static boost::shared_ptr<BaseGeneratorModel>
+createGenerator(int k)
+{
+  boost::shared_ptr<gridpack::component::DataCollection>
+    data(new gridpack::component::DataCollection);
+  data->addValue(BUS_NUMBER, k+1);
+  data->addValue(GENERATOR_ID, "1", 0);
+  data->addValue(GENERATOR_PG, 0.5+0.1*k, 0);
+  data->addValue(GENERATOR_QG, 0.1, 0);
+  data->addValue(GENERATOR_STAT, 1, 0);
+  data->addValue(GENERATOR_MBASE, 100.0+10.0*k, 0);
+  data->addValue(GENERATOR_INERTIA_CONSTANT_H, 3.0+k, 0);
+  data->addValue(GENERATOR_DAMPING_COEFFICIENT_0, 0.1, 0);
+  data->addValue(GENERATOR_RESISTANCE, 0.003, 0);
+  data->addValue(GENERATOR_XD, 1.8, 0);
+  data->addValue(GENERATOR_XQ, 1.7, 0);
+  data->addValue(GENERATOR_XDP, 0.3, 0);
+  data->addValue(GENERATOR_XDPP, 0.25, 0);
+  data->addValue(GENERATOR_XL, 0.15, 0);
+  data->addValue(GENERATOR_XQP, 0.55, 0);
+  data->addValue(GENERATOR_TDOP, 6.0, 0);
+  data->addValue(GENERATOR_TDOPP, 0.05, 0);
+  data->addValue(GENERATOR_TQOPP, 0.09, 0);
+
+  data->addValue(EXCITER_TR, 0.02, 0);
+  data->addValue(EXCITER_KA, 50.0+10.0*k, 0);
+  data->addValue(EXCITER_TA, 0.06, 0);
+  data->addValue(EXCITER_TB, 0.1*k, 0);
+  data->addValue(EXCITER_TC, 0.05*k, 0);
+  data->addValue(EXCITER_VRMAX, 5.0, 0);
+  data->addValue(EXCITER_VRMIN, -5.0, 0);
+  data->addValue(EXCITER_KE, 1.0, 0);
+  data->addValue(EXCITER_TE, 0.5, 0);
+  data->addValue(EXCITER_KF, 0.05, 0);
+  data->addValue(EXCITER_TF1, 0.5, 0);
+  data->addValue(EXCITER_E1, 2.8, 0);
+  data->addValue(EXCITER_SE1, 0.04, 0);
+  data->addValue(EXCITER_E2, 3.73, 0);
+  data->addValue(EXCITER_SE2, 0.33, 0);
+
+  data->addValue(GOVERNOR_K, 20.0, 0);
+  data->addValue(GOVERNOR_T1, 0.1, 0);
+  data->addValue(GOVERNOR_T2, 0.02*k, 0);
+  data->addValue(GOVERNOR_T3, 0.1, 0);
+  data->addValue(GOVERNOR_UO, 0.5, 0);
+  data->addValue(GOVERNOR_UC, -0.5, 0);
+  data->addValue(GOVERNOR_PMAX, 2.0, 0);
+  data->addValue(GOVERNOR_PMIN, 0.0, 0);
+  data->addValue(GOVERNOR_T4, 0.3, 0);
+  data->addValue(GOVERNOR_K1, 0.3, 0);
+  data->addValue(GOVERNOR_T5, 7.0, 0);
+  data->addValue(GOVERNOR_K3, 0.3, 0);
+  data->addValue(GOVERNOR_T6, 0.5, 0);
+  data->addValue(GOVERNOR_K5, 0.4, 0);
+
+  boost::shared_ptr<BaseGeneratorModel> generator(new GenrouGenerator);
+  boost::shared_ptr<BaseExciterModel> exciter(new Exdc1Model);
+  boost::shared_ptr<BaseGovernorModel> governor(new Wsieg1Model);
+  generator->load(data, 0);
+  exciter->load(data, 0);
+  governor->load(data, 0);
+  generator->setExciter(exciter);
+  generator->setGovernor(governor);
+  gridpack::ComplexType v = terminalVoltage(k, 0);
+  generator->init(abs(v), arg(v), tstep);
+  return generator;
+}
+
+BOOST_AUTO_TEST_SUITE(GeneratorBatch)
+
+BOOST_AUTO_TEST_CASE(GenrouBatchMatchesInstances)
+{
+  std::vector<boost::shared_ptr<BaseGeneratorModel> > single, batched;
+  GenrouBatch batch;
+  int k, s;
+  for (k = 0; k < ngen; k++) {
+    single.push_back(createGenerator(k));
+    batched.push_back(createGenerator(k));
+    BOOST_REQUIRE(batch.addGenerator(batched[k]));
+    BOOST_CHECK(batched[k]->getBatched());
+  }
+  BOOST_CHECK_EQUAL(batch.size(), ngen);
+
+  for (s = 0; s < nsteps; s++) {
+    bool flag = (s == 0);
+    for (k = 0; k < ngen; k++) {
+      gridpack::ComplexType v = terminalVoltage(k, s);
+      single[k]->setVoltage(v);
+      batched[k]->setVoltage(v);
+    }
+
+    for (k = 0; k < ngen; k++) single[k]->predictor_currentInjection(flag);
+    batch.predictor_currentInjection(flag);
+    for (k = 0; k < ngen; k++) {
+      gridpack::ComplexType a = single[k]->INorton();
+      gridpack::ComplexType b = batched[k]->INorton();
+      BOOST_CHECK_CLOSE(real(a), real(b), delta);
+      BOOST_CHECK_CLOSE(imag(a), imag(b), delta);
+    }
+    for (k = 0; k < ngen; k++) single[k]->predictor(tstep, flag);
+    batch.predictor(tstep, flag);
+
+    for (k = 0; k < ngen; k++) single[k]->corrector_currentInjection(flag);
+    batch.corrector_currentInjection(flag);
+    for (k = 0; k < ngen; k++) {
+      gridpack::ComplexType a = single[k]->INorton();
+      gridpack::ComplexType b = batched[k]->INorton();
+      BOOST_CHECK_CLOSE(real(a), real(b), delta);
+      BOOST_CHECK_CLOSE(imag(a), imag(b), delta);
+    }
+    for (k = 0; k < ngen; k++) single[k]->corrector(tstep, flag);
+    batch.corrector(tstep, flag);
+  }
+
+  // Copy state back into the models and compare them
+  batch.clear();
+  for (k = 0; k < ngen; k++) {
+    BOOST_CHECK(!batched[k]->getBatched());
+    BOOST_CHECK_CLOSE(single[k]->getFieldVoltage(),
+        batched[k]->getFieldVoltage(), delta);
+    BOOST_CHECK_CLOSE(single[k]->getExciter()->getFieldVoltage(),
+        batched[k]->getExciter()->getFieldVoltage(), delta);
+    BOOST_CHECK_CLOSE(single[k]->getGovernor()->getMechanicalPower(),
+        batched[k]->getGovernor()->getMechanicalPower(), delta);
+    char sbuf[256], bbuf[256];
+    single[k]->write("standard", sbuf);
+    batched[k]->write("standard", bbuf);
+    BOOST_CHECK(strcmp(sbuf, bbuf) == 0);
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+// -------------------------------------------------------------
+// init_function
+// -------------------------------------------------------------
+bool init_function()
+{
+  return true;
+}
+
+// -------------------------------------------------------------
+//  Main Program
+// -------------------------------------------------------------
+int
+main(int argc, char **argv)
+{
+  int result = ::boost::unit_test::unit_test_main( &init_function, argc, argv );
+  return result;
+}
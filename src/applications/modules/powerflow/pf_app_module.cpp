@@ -27,11 +27,60 @@
 
 #define USE_REAL_VALUES
 
+/**
+ * Mappers, Jacobian, vectors and linear solver that are kept between calls
+ * to solve in contingency mode, along with the layout used to create them
+ */
+struct gridpack::powerflow::PFAppModule::SolverState {
+  std::vector<int> layout;
+  boost::shared_ptr<gridpack::mapper::BusVectorMap<PFNetwork> > vMap;
+  boost::shared_ptr<gridpack::mapper::FullMatrixMap<PFNetwork> > jMap;
+#ifdef USE_REAL_VALUES
+  boost::shared_ptr<gridpack::math::RealVector> PQ;
+  boost::shared_ptr<gridpack::math::RealVector> X;
+  boost::shared_ptr<gridpack::math::RealMatrix> J;
+  boost::shared_ptr<gridpack::math::RealLinearSolver> solver;
+#else
+  boost::shared_ptr<gridpack::math::Vector> PQ;
+  boost::shared_ptr<gridpack::math::Vector> X;
+  boost::shared_ptr<gridpack::math::Matrix> J;
+  boost::shared_ptr<gridpack::math::LinearSolver> solver;
+#endif
+};
+
+/**
+ * B matrix, mappers and linear solver for DC power flow along with base
+ * case data for all line elements on active local branches. Line elements
+ * on a branch are stored contiguously starting at offset[branch index]
+ */
+struct gridpack::powerflow::PFAppModule::DCState {
+  boost::shared_ptr<gridpack::mapper::BusVectorMap<PFNetwork> > vMap;
+  boost::shared_ptr<gridpack::mapper::FullMatrixMap<PFNetwork> > bMap;
+  boost::shared_ptr<gridpack::math::RealVector> inj;
+  boost::shared_ptr<gridpack::math::RealVector> theta;
+  boost::shared_ptr<gridpack::math::RealMatrix> B;
+  boost::shared_ptr<gridpack::math::RealLinearSolver> solver;
+  std::vector<int> offset;
+  std::vector<int> branch;
+  std::vector<std::string> tag;
+  std::vector<double> b;
+  std::vector<double> p;
+  std::vector<double> q;
+  std::vector<double> rate;
+  std::vector<bool> ignore;
+  std::vector<double> flow;
+};
+
 /**
  * Basic constructor
  */
 gridpack::powerflow::PFAppModule::PFAppModule(void)
 {
+  p_contingencyMode = false;
+  p_iterations = 0;
+  p_layoutChanged = true;
+  p_loneBuses = false;
+  p_qlimSwitched = false;
 }
 
 /**
@@ -183,6 +232,9 @@ void gridpack::powerflow::PFAppModule::reload()
   timer->start(t_load);
   p_factory->load();
   timer->stop(t_load);
+  // All admittances need to be recomputed after reloading
+  p_state.reset();
+  p_dc.reset();
 }
 
 /**
@@ -198,93 +250,150 @@ bool gridpack::powerflow::PFAppModule::solve()
   int t_total = timer->createCategory("Powerflow: Total Application");
   timer->start(t_total);
 
+  // In contingency mode, the objects from the previous call can be reused if
+  // the structure of the Jacobian is unchanged on all processors. Only
+  // the admittance contributions of components touched by the contingency
+  // need to be recomputed in that case. The layout is only compared
+  // across processors after an event that can change it
+  bool reuse = false;
+  std::vector<int> layout;
+  if (p_contingencyMode) {
+    if (p_state && !p_layoutChanged) {
+      reuse = true;
+    } else {
+      getLayout(layout);
+      int changed = 0;
+      if (!p_state || p_state->layout != layout) changed = 1;
+      p_comm.sum(&changed,1);
+      reuse = (changed == 0);
+    }
+    p_layoutChanged = false;
+  }
+
   // set YBus components so that you can create Y matrix
   int t_fact = timer->createCategory("Powerflow: Factory Operations");
   timer->start(t_fact);
-  p_factory->setYBus();
+  if (reuse) {
+    p_factory->setYBus(p_dirtyBranches, p_dirtyBuses);
+  } else {
+    p_factory->setYBus();
+  }
+  p_dirtyBranches.clear();
+  p_dirtyBuses.clear();
   timer->stop(t_fact);
 
   int t_cmap = timer->createCategory("Powerflow: Create Mappers");
-  timer->start(t_cmap);
-  p_factory->setMode(YBus); 
-#if 0
-  gridpack::mapper::FullMatrixMap<PFNetwork> mMap(p_network);
-#endif
-  timer->stop(t_cmap);
   int t_mmap = timer->createCategory("Powerflow: Map to Matrix");
-  timer->start(t_mmap);
-#if 0
-  gridpack::mapper::FullMatrixMap<PFNetwork> mMap(p_network);
-  boost::shared_ptr<gridpack::math::Matrix> Y = mMap.mapToMatrix();
-  p_busIO->header("\nY-matrix values\n");
-//  Y->print();
-  Y->save("Ybus.m");
-#endif
-  timer->stop(t_mmap);
-
-  timer->start(t_fact);
-  p_factory->setMode(S_Cal);
-  timer->stop(t_fact);
-  timer->start(t_cmap);
-  gridpack::mapper::BusVectorMap<PFNetwork> vvMap(p_network);
-  timer->stop(t_cmap);
   int t_vmap = timer->createCategory("Powerflow: Map to Vector");
+  int t_csolv = timer->createCategory("Powerflow: Create Linear Solver");
+
+  boost::shared_ptr<gridpack::mapper::BusVectorMap<PFNetwork> > vMap;
+  boost::shared_ptr<gridpack::mapper::FullMatrixMap<PFNetwork> > jMap;
+#ifdef USE_REAL_VALUES
+  boost::shared_ptr<gridpack::math::RealVector> PQ;
+  boost::shared_ptr<gridpack::math::RealVector> X;
+  boost::shared_ptr<gridpack::math::RealMatrix> J;
+  boost::shared_ptr<gridpack::math::RealLinearSolver> solver;
+#else
+  boost::shared_ptr<gridpack::math::Vector> PQ;
+  boost::shared_ptr<gridpack::math::Vector> X;
+  boost::shared_ptr<gridpack::math::Matrix> J;
+  boost::shared_ptr<gridpack::math::LinearSolver> solver;
+#endif
 
   // make Sbus components to create S vector
   timer->start(t_fact);
+  p_factory->setMode(S_Cal);
   p_factory->setSBus();
   timer->stop(t_fact);
-//  p_busIO->header("\nIteration 0\n");
-
-  // Set PQ
-  timer->start(t_cmap);
-  p_factory->setMode(RHS); 
-  gridpack::mapper::BusVectorMap<PFNetwork> vMap(p_network);
-  timer->stop(t_cmap);
-  timer->start(t_vmap);
+
+  if (reuse) {
+    vMap = p_state->vMap;
+    jMap = p_state->jMap;
+    PQ = p_state->PQ;
+    X = p_state->X;
+    J = p_state->J;
+    solver = p_state->solver;
+
+    // Refill existing PQ vector and Jacobian
+    timer->start(t_vmap);
+    p_factory->setMode(RHS);
 #ifdef USE_REAL_VALUES
-  boost::shared_ptr<gridpack::math::RealVector> PQ = vMap.mapToRealVector();
+    vMap->mapToRealVector(PQ);
 #else
-  boost::shared_ptr<gridpack::math::Vector> PQ = vMap.mapToVector();
+    vMap->mapToVector(PQ);
 #endif
-  timer->stop(t_vmap);
-//  PQ->print();
-  timer->start(t_cmap);
-  p_factory->setMode(Jacobian);
-  gridpack::mapper::FullMatrixMap<PFNetwork> jMap(p_network);
-  timer->stop(t_cmap);
-  timer->start(t_mmap);
+    timer->stop(t_vmap);
+    timer->start(t_mmap);
+    p_factory->setMode(Jacobian);
 #ifdef USE_REAL_VALUES
-  boost::shared_ptr<gridpack::math::RealMatrix> J = jMap.mapToRealMatrix();
+    jMap->mapToRealMatrix(J);
 #else
-  boost::shared_ptr<gridpack::math::Matrix> J = jMap.mapToMatrix();
+    jMap->mapToMatrix(J);
 #endif
-  timer->stop(t_mmap);
-//  p_busIO->header("\nJacobian values\n");
-//  J->print();
-
-  // Create X vector by cloning PQ
+    timer->stop(t_mmap);
+  } else {
+    // Set PQ
+    timer->start(t_cmap);
+    p_factory->setMode(RHS); 
+    vMap.reset(new gridpack::mapper::BusVectorMap<PFNetwork>(p_network));
+    timer->stop(t_cmap);
+    timer->start(t_vmap);
+#ifdef USE_REAL_VALUES
+    PQ = vMap->mapToRealVector();
+#else
+    PQ = vMap->mapToVector();
+#endif
+    timer->stop(t_vmap);
+//    PQ->print();
+    timer->start(t_cmap);
+    p_factory->setMode(Jacobian);
+    jMap.reset(new gridpack::mapper::FullMatrixMap<PFNetwork>(p_network));
+    timer->stop(t_cmap);
+    timer->start(t_mmap);
 #ifdef USE_REAL_VALUES
-  boost::shared_ptr<gridpack::math::RealVector> X(PQ->clone());
+    J = jMap->mapToRealMatrix();
 #else
-  boost::shared_ptr<gridpack::math::Vector> X(PQ->clone());
+    J = jMap->mapToMatrix();
 #endif
+    timer->stop(t_mmap);
+//    p_busIO->header("\nJacobian values\n");
+//    J->print();
 
-  gridpack::utility::Configuration::CursorPtr cursor;
-  cursor = p_config->getCursor("Configuration.Powerflow");
-  // Create linear solver
-  int t_csolv = timer->createCategory("Powerflow: Create Linear Solver");
-  timer->start(t_csolv);
+    // Create X vector by cloning PQ
+    X.reset(PQ->clone());
+
+    gridpack::utility::Configuration::CursorPtr cursor;
+    cursor = p_config->getCursor("Configuration.Powerflow");
+    // Create linear solver
+    timer->start(t_csolv);
 #ifdef USE_REAL_VALUES
-  gridpack::math::RealLinearSolver solver(*J);
+    solver.reset(new gridpack::math::RealLinearSolver(*J));
 #else
-  gridpack::math::LinearSolver solver(*J);
+    solver.reset(new gridpack::math::LinearSolver(*J));
 #endif
-  solver.configure(cursor);
-  timer->stop(t_csolv);
+    solver->configure(cursor);
+    // Jacobian is remapped in place, so only its values change
+    solver->constantPattern(true);
+    timer->stop(t_csolv);
+
+    if (p_contingencyMode) {
+      p_state.reset(new SolverState);
+      p_state->layout = layout;
+      p_state->vMap = vMap;
+      p_state->jMap = jMap;
+      p_state->PQ = PQ;
+      p_state->X = X;
+      p_state->J = J;
+      p_state->solver = solver;
+    } else {
+      p_state.reset();
+    }
+  }
 
   gridpack::ComplexType tol = 2.0*p_tolerance;
   int iter = 0;
+  p_iterations = 0;
 
   // First iteration
   X->zero(); //might not need to do this
@@ -297,7 +406,7 @@ bool gridpack::powerflow::PFAppModule::solve()
 //    sprintf(dbgfile,"pq0.bin");
 //    PQ->saveBinary(dbgfile);
   try {
-    solver.solve(*PQ, *X);
+    solver->solve(*PQ, *X);
   } catch (const gridpack::Exception e) {
     std::string w(e.what());
     printf("p[%d] hit exception: %s\n",
@@ -322,7 +431,7 @@ bool gridpack::powerflow::PFAppModule::solve()
     // work
     timer->start(t_bmap);
     p_factory->setMode(RHS);
-    vMap.mapToBus(X);
+    vMap->mapToBus(X);
     timer->stop(t_bmap);
 
     // Exchange data between ghost buses (I don't think we need to exchange data
@@ -334,9 +443,9 @@ bool gridpack::powerflow::PFAppModule::solve()
     // Create new versions of Jacobian and PQ vector
     timer->start(t_vmap);
 #ifdef USE_REAL_VALUES
-    vMap.mapToRealVector(PQ);
+    vMap->mapToRealVector(PQ);
 #else
-    vMap.mapToVector(PQ);
+    vMap->mapToVector(PQ);
 #endif
 //    p_busIO->header("\nnew PQ vector\n");
 //    PQ->print();
@@ -344,9 +453,9 @@ bool gridpack::powerflow::PFAppModule::solve()
     timer->start(t_mmap);
     p_factory->setMode(Jacobian);
 #ifdef USE_REAL_VALUES
-    jMap.mapToRealMatrix(J);
+    jMap->mapToRealMatrix(J);
 #else
-    jMap.mapToMatrix(J);
+    jMap->mapToMatrix(J);
 #endif
     timer->stop(t_mmap);
 
@@ -358,7 +467,7 @@ bool gridpack::powerflow::PFAppModule::solve()
 //    sprintf(dbgfile,"pq%d.bin",iter+1);
 //    PQ->saveBinary(dbgfile);
     try {
-      solver.solve(*PQ, *X);
+      solver->solve(*PQ, *X);
     } catch (const gridpack::Exception e) {
       std::string w(e.what());
       printf("p[%d] hit exception: %s\n",
@@ -377,12 +486,13 @@ bool gridpack::powerflow::PFAppModule::solve()
     iter++;
   }
 
+  p_iterations = iter;
   if (iter >= p_max_iteration) ret = false;
 
   // Push final result back onto buses
   timer->start(t_bmap);
   p_factory->setMode(RHS);
-  vMap.mapToBus(X);
+  vMap->mapToBus(X);
   timer->stop(t_bmap);
 
   // Make sure that ghost buses have up-to-date values before printing out
@@ -393,6 +503,15 @@ bool gridpack::powerflow::PFAppModule::solve()
   timer->stop(t_total);
   return ret;
 }
+/**
+ * Return the number of Newton iterations taken by the last call to solve
+ * @return number of iterations
+ */
+int gridpack::powerflow::PFAppModule::getIterations()
+{
+  return p_iterations;
+}
+
 /**
  * Execute the iterative solve portion of the application using a library
  * non-linear solver
@@ -575,19 +694,26 @@ void gridpack::powerflow::PFAppModule::writeHeader(const char *msg)
 }
 
 /**
- * Redirect output from standard out
+ * Redirect output from standard out. If asyncOutput is set in the
+ * Powerflow block of the input deck, file writes are done by a
+ * background thread
  * @param filename name of file to write results to
  */
 void gridpack::powerflow::PFAppModule::open(const char *filename)
 {
-  p_busIO->open(filename);
+  gridpack::utility::Configuration::CursorPtr cursor;
+  cursor = p_config->getCursor("Configuration.Powerflow");
+  bool async = cursor->get("asyncOutput",false);
+  p_busIO->open(filename,false,async);
   p_branchIO->setStream(p_busIO->getStream());
+  p_branchIO->setAsyncWriter(p_busIO->getAsyncWriter());
 }
 
 void gridpack::powerflow::PFAppModule::close()
 {
   p_busIO->close();
   p_branchIO->setStream(p_busIO->getStream());
+  p_branchIO->setAsyncWriter(p_busIO->getAsyncWriter());
 }
 
 /**
@@ -652,12 +778,16 @@ bool gridpack::powerflow::PFAppModule::setContingency(
             p_network->getBranch(jdx).get());
         event.p_saveLineStatus[i] = branch->getBranchStatus(tag);
         branch->setBranchStatus(tag, false);
+        markDirtyBranch(jdx);
       }
     }
   } else {
     ret = false;
   }
-  p_factory->checkLoneBus();
+  // checkLoneBus is false on all processors if a bus anywhere in the
+  // network has been isolated, which changes the Jacobian layout
+  p_loneBuses = !p_factory->checkLoneBus();
+  if (p_loneBuses) p_layoutChanged = true;
   return ret;
 }
 
@@ -670,6 +800,8 @@ bool gridpack::powerflow::PFAppModule::unSetContingency(
     gridpack::powerflow::Contingency &event)
 {
   p_factory->clearLoneBus();
+  if (p_loneBuses) p_layoutChanged = true;
+  p_loneBuses = false;
   bool ret = true;
   if (event.p_type == Generator) {
     int ngen = event.p_busid.size();
@@ -703,6 +835,7 @@ bool gridpack::powerflow::PFAppModule::unSetContingency(
         branch = dynamic_cast<gridpack::powerflow::PFBranch*>(
             p_network->getBranch(jdx).get());
         branch->setBranchStatus(tag,event.p_saveLineStatus[i]);
+        markDirtyBranch(jdx);
       }
     }
   } else {
@@ -778,11 +911,22 @@ bool gridpack::powerflow::PFAppModule::checkLineOverloadViolations(int area)
  */
 bool gridpack::powerflow::PFAppModule::checkQlimViolations()
 {
-  return p_factory->checkQlimViolations();
+  // A violation switches PV buses to PQ on some processor
+  bool ok = p_factory->checkQlimViolations();
+  if (!ok) {
+    p_qlimSwitched = true;
+    p_layoutChanged = true;
+  }
+  return ok;
 }
 bool gridpack::powerflow::PFAppModule::checkQlimViolations(int area)
 {
-  return p_factory->checkQlimViolations(area);
+  bool ok = p_factory->checkQlimViolations(area);
+  if (!ok) {
+    p_qlimSwitched = true;
+    p_layoutChanged = true;
+  }
+  return ok;
 }
 
 /**
@@ -792,6 +936,8 @@ bool gridpack::powerflow::PFAppModule::checkQlimViolations(int area)
 void gridpack::powerflow::PFAppModule::clearQlimViolations()
 {
   p_factory->clearQlimViolations();
+  if (p_qlimSwitched) p_layoutChanged = true;
+  p_qlimSwitched = false;
 }
 
 /**
@@ -801,3 +947,350 @@ void gridpack::powerflow::PFAppModule::resetVoltages()
 {
   p_factory->resetVoltages();
 }
+
+/**
+ * Store current voltages so that they can be used as the starting point
+ * of subsequent calculations. This is normally called after the base
+ * case has converged
+ */
+void gridpack::powerflow::PFAppModule::saveVoltages()
+{
+  p_factory->saveVoltages();
+}
+
+/**
+ * Reset voltages to values stored by saveVoltages
+ */
+void gridpack::powerflow::PFAppModule::restoreVoltages()
+{
+  p_factory->restoreVoltages();
+}
+
+/**
+ * Keep mappers, Jacobian and linear solver alive between calls to solve.
+ * Subsequent calls only recompute admittance contributions for
+ * components modified by setContingency and unSetContingency and reuse
+ * the existing objects, as long as the structure of the Jacobian has
+ * not changed
+ * @param flag true if solver state should be kept between calls
+ */
+void gridpack::powerflow::PFAppModule::setContingencyMode(bool flag)
+{
+  p_contingencyMode = flag;
+  if (!flag) p_state.reset();
+  p_layoutChanged = true;
+  p_dirtyBranches.clear();
+  p_dirtyBuses.clear();
+}
+
+/**
+ * Record that the type or isolation status of buses may have changed
+ * outside of setContingency, unSetContingency and the Q limit checks, so
+ * the next solve in contingency mode compares the Jacobian layout on all
+ * processors before reusing its objects. Must be called on all processors
+ */
+void gridpack::powerflow::PFAppModule::layoutChanged()
+{
+  p_layoutChanged = true;
+}
+
+/**
+ * Record that the admittance contributions of a branch and its
+ * end buses must be recomputed on the next call to solve
+ * @param idx local index of branch
+ */
+void gridpack::powerflow::PFAppModule::markDirtyBranch(int idx)
+{
+  int bus1, bus2;
+  p_network->getBranchEndpoints(idx,&bus1,&bus2);
+  p_dirtyBranches.push_back(idx);
+  p_dirtyBuses.push_back(bus1);
+  p_dirtyBuses.push_back(bus2);
+}
+
+/**
+ * Evaluate block sizes that determine the structure of the Jacobian
+ * and PQ vector on this process
+ * @param layout block sizes for all buses
+ */
+void gridpack::powerflow::PFAppModule::getLayout(std::vector<int> &layout)
+{
+  int numBus = p_network->numBuses();
+  int i, isize, jsize;
+  layout.resize(2*numBus);
+  p_factory->setMode(Jacobian);
+  for (i=0; i<numBus; i++) {
+    if (p_network->getBus(i)->matrixDiagSize(&isize,&jsize)) {
+      layout[2*i] = isize;
+    } else {
+      layout[2*i] = 0;
+    }
+  }
+  p_factory->setMode(RHS);
+  for (i=0; i<numBus; i++) {
+    if (p_network->getBus(i)->vectorSize(&isize)) {
+      layout[2*i+1] = isize;
+    } else {
+      layout[2*i+1] = 0;
+    }
+  }
+}
+
+/**
+ * Build B matrix and linear solver for DC power flow and record base case
+ * flows on all local line elements
+ */
+void gridpack::powerflow::PFAppModule::setupScreening()
+{
+  p_dc.reset(new DCState);
+  p_factory->clearDCInjections();
+  p_factory->setMode(DCFlow);
+  p_dc->vMap.reset(new gridpack::mapper::BusVectorMap<PFNetwork>(p_network));
+  p_dc->bMap.reset(new gridpack::mapper::FullMatrixMap<PFNetwork>(p_network));
+  p_dc->inj = p_dc->vMap->mapToRealVector();
+  p_dc->theta.reset(p_dc->inj->clone());
+  p_dc->B = p_dc->bMap->mapToRealMatrix();
+  gridpack::utility::Configuration::CursorPtr cursor;
+  cursor = p_config->getCursor("Configuration.Powerflow");
+  p_dc->solver.reset(new gridpack::math::RealLinearSolver(*(p_dc->B)));
+  p_dc->solver->configure(cursor);
+
+  // Record base case flows
+  int numBranch = p_network->numBranches();
+  int i, k;
+  p_dc->offset.resize(numBranch);
+  for (i=0; i<numBranch; i++) {
+    p_dc->offset[i] = p_dc->branch.size();
+    if (!p_network->getActiveBranch(i)) continue;
+    gridpack::powerflow::PFBranch *branch =
+      dynamic_cast<gridpack::powerflow::PFBranch*>
+      (p_network->getBranch(i).get());
+    std::vector<std::string> tags = branch->getLineTags();
+    for (k=0; k<tags.size(); k++) {
+      gridpack::ComplexType s = branch->getComplexPower(tags[k]);
+      p_dc->branch.push_back(i);
+      p_dc->tag.push_back(tags[k]);
+      p_dc->b.push_back(branch->getDCSusceptance(tags[k]));
+      p_dc->p.push_back(real(s));
+      p_dc->q.push_back(imag(s));
+      p_dc->rate.push_back(branch->getBranchRatingA(tags[k]));
+      p_dc->ignore.push_back(branch->getIgnore(tags[k]));
+    }
+  }
+}
+
+/**
+ * Solve DC power flow equations for the current bus injections and
+ * update DC phase angles on all buses, including ghost buses
+ */
+void gridpack::powerflow::PFAppModule::solveDC()
+{
+  p_factory->setMode(DCFlow);
+  p_dc->vMap->mapToRealVector(p_dc->inj);
+  p_dc->theta->zero();
+  p_dc->solver->solve(*(p_dc->inj), *(p_dc->theta));
+  p_dc->vMap->mapToBus(p_dc->theta);
+  p_network->updateBuses();
+}
+
+/**
+ * Estimate line loadings after a contingency using DC sensitivity
+ * factors (PTDF/LODF) evaluated around the current solution. The B
+ * matrix is built and factored on the first call, so this should be
+ * called after the base case has been solved and before any
+ * contingency has been applied to the network
+ * @param event data describing location and type of contingency
+ * @param threshold fraction of line rating at which a line is
+ * considered to be potentially overloaded
+ * @param maxLoading largest estimated ratio of line flow to rating
+ * @param nOverload number of lines with estimated loading above
+ * threshold
+ * @return false if the contingency could not be evaluated using DC
+ * sensitivities (e.g. it separates the network into islands)
+ */
+bool gridpack::powerflow::PFAppModule::screenContingency(
+    gridpack::powerflow::Contingency &event, double threshold,
+    double *maxLoading, int *nOverload)
+{
+  gridpack::utility::CoarseTimer *timer =
+    gridpack::utility::CoarseTimer::instance();
+  int t_scrn = timer->createCategory("Powerflow: Contingency Screening");
+  timer->start(t_scrn);
+  if (!p_dc) setupScreening();
+  int nelem = p_dc->branch.size();
+  std::vector<double> delta(nelem,0.0);
+  std::vector<bool> outaged(nelem,false);
+  int i, j, k, e;
+  int ok = 1;
+  if (event.p_type == Branch) {
+    // Flow on line element e from a unit transfer across outaged element j
+    // is phi[j][e]. Outaged elements interact through the matrix
+    // M = I - phi(outaged,outaged) and the change in flow on the remaining
+    // elements is phi*M^-1*f, where f are the base case flows on the outaged
+    // elements. For a single outage this reduces to the usual LODF
+    int nline = event.p_to.size();
+    std::vector<std::vector<double> > phi(nline);
+    std::vector<double> M(nline*nline,0.0);
+    std::vector<double> f(nline,0.0);
+    for (j=0; j<nline; j++) {
+      p_factory->clearDCInjections();
+      std::vector<int> lids
+        = p_network->getLocalBranchIndices(event.p_from[j],event.p_to[j]);
+      for (k=0; k<lids.size(); k++) {
+        gridpack::powerflow::PFBranch *branch =
+          dynamic_cast<gridpack::powerflow::PFBranch*>
+          (p_network->getBranch(lids[k]).get());
+        dynamic_cast<gridpack::powerflow::PFBus*>
+          (branch->getBus1().get())->setDCInjection(1.0);
+        dynamic_cast<gridpack::powerflow::PFBus*>
+          (branch->getBus2().get())->setDCInjection(-1.0);
+      }
+      solveDC();
+      phi[j].resize(nelem);
+      for (e=0; e<nelem; e++) {
+        gridpack::powerflow::PFBranch *branch =
+          dynamic_cast<gridpack::powerflow::PFBranch*>
+          (p_network->getBranch(p_dc->branch[e]).get());
+        double a1 = dynamic_cast<gridpack::powerflow::PFBus*>
+          (branch->getBus1().get())->getDCAngle();
+        double a2 = dynamic_cast<gridpack::powerflow::PFBus*>
+          (branch->getBus2().get())->getDCAngle();
+        phi[j][e] = p_dc->b[e]*(a1-a2);
+      }
+      // Evaluate interaction with outaged elements on the processor that
+      // owns them
+      for (i=0; i<nline; i++) {
+        lids = p_network->getLocalBranchIndices(event.p_from[i],event.p_to[i]);
+        for (k=0; k<lids.size(); k++) {
+          if (!p_network->getActiveBranch(lids[k])) continue;
+          for (e=p_dc->offset[lids[k]]; e<nelem && p_dc->branch[e] == lids[k];
+              e++) {
+            if (p_dc->tag[e] == event.p_ckt[i]) {
+              M[i*nline+j] -= phi[j][e];
+              if (j == 0) {
+                f[i] += p_dc->p[e];
+                outaged[e] = true;
+              }
+            }
+          }
+        }
+      }
+    }
+    p_comm.sum(&M[0],nline*nline);
+    p_comm.sum(&f[0],nline);
+    for (i=0; i<nline; i++) M[i*nline+i] += 1.0;
+    // Solve M*z = f using Gaussian elimination with partial pivoting.
+    // A singular M means that the outage separates the network
+    for (k=0; k<nline && ok; k++) {
+      int piv = k;
+      for (i=k+1; i<nline; i++) {
+        if (fabs(M[i*nline+k]) > fabs(M[piv*nline+k])) piv = i;
+      }
+      if (fabs(M[piv*nline+k]) < 1.0e-6) {
+        ok = 0;
+        break;
+      }
+      if (piv != k) {
+        for (j=0; j<nline; j++) std::swap(M[k*nline+j],M[piv*nline+j]);
+        std::swap(f[k],f[piv]);
+      }
+      for (i=k+1; i<nline; i++) {
+        double r = M[i*nline+k]/M[k*nline+k];
+        for (j=k; j<nline; j++) M[i*nline+j] -= r*M[k*nline+j];
+        f[i] -= r*f[k];
+      }
+    }
+    if (ok) {
+      for (k=nline-1; k>=0; k--) {
+        for (j=k+1; j<nline; j++) f[k] -= M[k*nline+j]*f[j];
+        f[k] /= M[k*nline+k];
+      }
+      for (j=0; j<nline; j++) {
+        for (e=0; e<nelem; e++) delta[e] += phi[j][e]*f[j];
+      }
+    }
+  } else if (event.p_type == Generator) {
+    // Lost generation is picked up by the reference bus
+    p_factory->clearDCInjections();
+    int ngen = event.p_busid.size();
+    for (i=0; i<ngen; i++) {
+      std::vector<int> lids = p_network->getLocalBusIndices(event.p_busid[i]);
+      for (k=0; k<lids.size(); k++) {
+        dynamic_cast<gridpack::powerflow::PFBus*>
+          (p_network->getBus(lids[k]).get())->addDCGenInjection(
+              event.p_genid[i],-1.0);
+      }
+    }
+    solveDC();
+    for (e=0; e<nelem; e++) {
+      gridpack::powerflow::PFBranch *branch =
+        dynamic_cast<gridpack::powerflow::PFBranch*>
+        (p_network->getBranch(p_dc->branch[e]).get());
+      double a1 = dynamic_cast<gridpack::powerflow::PFBus*>
+        (branch->getBus1().get())->getDCAngle();
+      double a2 = dynamic_cast<gridpack::powerflow::PFBus*>
+        (branch->getBus2().get())->getDCAngle();
+      delta[e] = p_dc->b[e]*(a1-a2);
+    }
+  } else {
+    ok = 0;
+  }
+  p_factory->clearDCInjections();
+
+  // Estimate post-contingency loadings, keeping the base case reactive flow
+  double lmax = 0.0;
+  int nover = 0;
+  p_dc->flow = p_dc->p;
+  if (ok) {
+    for (e=0; e<nelem; e++) {
+      if (outaged[e]) {
+        p_dc->flow[e] = 0.0;
+        continue;
+      }
+      p_dc->flow[e] += delta[e];
+      if (p_dc->ignore[e] || p_dc->rate[e] <= 0.0) continue;
+      double p = p_dc->flow[e];
+      double q = p_dc->q[e];
+      double loading = sqrt(p*p+q*q)/p_dc->rate[e];
+      if (loading > lmax) lmax = loading;
+      if (loading > threshold) nover++;
+    }
+  }
+  p_comm.max(&lmax,1);
+  p_comm.sum(&nover,1);
+  *maxLoading = lmax;
+  *nOverload = nover;
+  timer->stop(t_scrn);
+  return (ok != 0);
+}
+
+/**
+ * Return the real power flows on local line elements estimated by the
+ * last call to screenContingency. Outaged elements have zero flow. If the
+ * contingency could not be evaluated, base case flows are returned
+ * @param from original index of from bus of each line element
+ * @param to original index of to bus of each line element
+ * @param tags circuit identifier of each line element
+ * @param flow estimated real power flow on each line element
+ */
+void gridpack::powerflow::PFAppModule::getScreeningFlows(
+    std::vector<int> &from, std::vector<int> &to,
+    std::vector<std::string> &tags, std::vector<double> &flow)
+{
+  from.clear();
+  to.clear();
+  tags.clear();
+  flow.clear();
+  if (!p_dc) return;
+  int nelem = p_dc->flow.size();
+  int e;
+  for (e=0; e<nelem; e++) {
+    gridpack::powerflow::PFBranch *branch =
+      dynamic_cast<gridpack::powerflow::PFBranch*>
+      (p_network->getBranch(p_dc->branch[e]).get());
+    from.push_back(branch->getBus1OriginalIndex());
+    to.push_back(branch->getBus2OriginalIndex());
+    tags.push_back(p_dc->tag[e]);
+    flow.push_back(p_dc->flow[e]);
+  }
+}
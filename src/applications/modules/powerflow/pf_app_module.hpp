@@ -113,6 +113,12 @@ class PFAppModule
      */
     bool solve();
 
+    /**
+     * Return the number of Newton iterations taken by the last call to solve
+     * @return number of iterations
+     */
+    int getIterations();
+
     /**
      * Execute the iterative solve portion of the application using a library
      * non-linear solver
@@ -231,8 +237,123 @@ class PFAppModule
      * Reset voltages to values in network configuration file
      */
     void resetVoltages();
+
+    /**
+     * Store current voltages so that they can be used as the starting point
+     * of subsequent calculations. This is normally called after the base
+     * case has converged
+     */
+    void saveVoltages();
+
+    /**
+     * Reset voltages to values stored by saveVoltages
+     */
+    void restoreVoltages();
+
+    /**
+     * Keep mappers, Jacobian and linear solver alive between calls to solve.
+     * Subsequent calls only recompute admittance contributions for
+     * components modified by setContingency and unSetContingency and reuse
+     * the existing objects, as long as the structure of the Jacobian has
+     * not changed
+     * @param flag true if solver state should be kept between calls
+     */
+    void setContingencyMode(bool flag);
+
+    /**
+     * Record that the type or isolation status of buses may have changed
+     * outside of setContingency, unSetContingency and the Q limit checks,
+     * so the next solve in contingency mode compares the Jacobian layout
+     * on all processors before reusing its objects. Must be called on all
+     * processors
+     */
+    void layoutChanged();
+
+    /**
+     * Estimate line loadings after a contingency using DC sensitivity
+     * factors (PTDF/LODF) evaluated around the current solution. The B
+     * matrix is built and factored on the first call, so this should be
+     * called after the base case has been solved and before any
+     * contingency has been applied to the network
+     * @param event data describing location and type of contingency
+     * @param threshold fraction of line rating at which a line is
+     * considered to be potentially overloaded
+     * @param maxLoading largest estimated ratio of line flow to rating
+     * @param nOverload number of lines with estimated loading above
+     * threshold
+     * @return false if the contingency could not be evaluated using DC
+     * sensitivities (e.g. it separates the network into islands)
+     */
+    bool screenContingency(Contingency &event, double threshold,
+        double *maxLoading, int *nOverload);
+
+    /**
+     * Return the real power flows on local line elements estimated by the
+     * last call to screenContingency. Outaged elements have zero flow
+     * @param from original index of from bus of each line element
+     * @param to original index of to bus of each line element
+     * @param tags circuit identifier of each line element
+     * @param flow estimated real power flow on each line element
+     */
+    void getScreeningFlows(std::vector<int> &from, std::vector<int> &to,
+        std::vector<std::string> &tags, std::vector<double> &flow);
   private:
 
+    // DC power flow objects used for contingency screening
+    struct DCState;
+
+    /**
+     * Build B matrix and linear solver for DC power flow and record base case
+     * flows on all local line elements
+     */
+    void setupScreening();
+
+    /**
+     * Solve DC power flow equations for the current bus injections and
+     * update DC phase angles on all buses, including ghost buses
+     */
+    void solveDC();
+
+    // DC power flow objects
+    boost::shared_ptr<DCState> p_dc;
+
+    // persistent solver objects used in contingency mode
+    struct SolverState;
+
+    /**
+     * Evaluate block sizes that determine the structure of the Jacobian
+     * and PQ vector on this process
+     * @param layout block sizes for all buses
+     */
+    void getLayout(std::vector<int> &layout);
+
+    /**
+     * Record that the admittance contributions of a branch and its
+     * end buses must be recomputed on the next call to solve
+     * @param idx local index of branch
+     */
+    void markDirtyBranch(int idx);
+
+    // solver objects kept between calls to solve
+    boost::shared_ptr<SolverState> p_state;
+
+    // keep solver state between calls to solve
+    bool p_contingencyMode;
+
+    // the Jacobian layout may have changed since the last solve. This has
+    // the same value on all processors
+    bool p_layoutChanged;
+
+    // the last contingency isolated buses
+    bool p_loneBuses;
+
+    // the last Q limit check switched PV buses to PQ
+    bool p_qlimSwitched;
+
+    // local indices of branches and buses modified since last solve
+    std::vector<int> p_dirtyBranches;
+    std::vector<int> p_dirtyBuses;
+
     // pointer to network
     boost::shared_ptr<PFNetwork> p_network;
 
@@ -245,6 +366,9 @@ class PFAppModule
     // maximum number of iterations
     int p_max_iteration;
 
+    // number of iterations taken by the last call to solve
+    int p_iterations;
+
     // convergence tolerance
     double p_tolerance;
 
@@ -64,6 +64,25 @@ void gridpack::powerflow::PFFactoryModule::setYBus(void)
 
 }
 
+/**
+ * Recompute admittance contributions for a subset of the network. The
+ * branches are evaluated before the buses so that bus contributions pick
+ * up the updated branch values
+ * @param branchIds local indices of branches that have changed
+ * @param busIds local indices of buses attached to changed branches
+ */
+void gridpack::powerflow::PFFactoryModule::setYBus(
+    const std::vector<int> &branchIds, const std::vector<int> &busIds)
+{
+  int i;
+  for (i=0; i<branchIds.size(); i++) {
+    dynamic_cast<PFBranch*>(p_network->getBranch(branchIds[i]).get())->setYBus();
+  }
+  for (i=0; i<busIds.size(); i++) {
+    dynamic_cast<PFBus*>(p_network->getBus(busIds[i]).get())->setYBus();
+  }
+}
+
 /**
   * Make SBus vector 
   */
@@ -177,7 +196,7 @@ bool gridpack::powerflow::PFFactoryModule::checkLoneBus(std::ofstream *stream)
     if (!ok) bus_ok = false;
   }
   // Check whether bus_ok is true on all processors
-  return checkTrue(!bus_ok);
+  return checkTrue(bus_ok);
 }
 
 /**
@@ -570,5 +589,52 @@ void gridpack::powerflow::PFFactoryModule::resetVoltages()
   }
 }
 
+/**
+ * Store current voltages so that they can be used as the starting
+ * point for subsequent calculations
+ */
+void gridpack::powerflow::PFFactoryModule::saveVoltages()
+{
+  int numBus = p_network->numBuses();
+  int i;
+  for (i=0; i<numBus; i++) {
+    gridpack::powerflow::PFBus *bus =
+      dynamic_cast<gridpack::powerflow::PFBus*>
+      (p_network->getBus(i).get());
+    bus->saveVoltage();
+  }
+}
+
+/**
+ * Reset voltages to values stored by saveVoltages
+ */
+void gridpack::powerflow::PFFactoryModule::restoreVoltages()
+{
+  int numBus = p_network->numBuses();
+  int i;
+  for (i=0; i<numBus; i++) {
+    gridpack::powerflow::PFBus *bus =
+      dynamic_cast<gridpack::powerflow::PFBus*>
+      (p_network->getBus(i).get());
+    bus->restoreVoltage();
+  }
+}
+
+/**
+ * Set real power injections used in DC power flow calculations to zero
+ * on all buses
+ */
+void gridpack::powerflow::PFFactoryModule::clearDCInjections()
+{
+  int numBus = p_network->numBuses();
+  int i;
+  for (i=0; i<numBus; i++) {
+    gridpack::powerflow::PFBus *bus =
+      dynamic_cast<gridpack::powerflow::PFBus*>
+      (p_network->getBus(i).get());
+    bus->setDCInjection(0.0);
+  }
+}
+
 } // namespace powerflow
 } // namespace gridpack
@@ -48,6 +48,16 @@ class PFFactoryModule
      */
     void setYBus(void);
 
+    /**
+     * Recompute admittance contributions for a subset of the network. The
+     * branches are evaluated before the buses so that bus contributions pick
+     * up the updated branch values
+     * @param branchIds local indices of branches that have changed
+     * @param busIds local indices of buses attached to changed branches
+     */
+    void setYBus(const std::vector<int> &branchIds,
+        const std::vector<int> &busIds);
+
     /**
      * Make SBus vector 
      */
@@ -149,6 +159,23 @@ class PFFactoryModule
      * Reinitialize voltages
      */
     void resetVoltages();
+
+    /**
+     * Store current voltages so that they can be used as the starting
+     * point for subsequent calculations
+     */
+    void saveVoltages();
+
+    /**
+     * Reset voltages to values stored by saveVoltages
+     */
+    void restoreVoltages();
+
+    /**
+     * Set real power injections used in DC power flow calculations to zero
+     * on all buses
+     */
+    void clearDCInjections();
   private:
 
     NetworkPtr p_network;
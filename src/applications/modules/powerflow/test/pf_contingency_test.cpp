@@ -0,0 +1,170 @@
+/*
+ *     Copyright (c) 2013 Battelle Memorial Institute
+ *     Licensed under modified BSD License. A copy of this license can be found
+ *     in the LICENSE file in the top level directory of this distribution.
+ */
+// -------------------------------------------------------------
+/**
+ * @file   pf_contingency_test.cpp
+ *
+ * @brief  Check that contingency solves in contingency mode (reused
+ *         solver objects, started from the base case solution) give the
+ *         same voltages as contingency solves started from scratch and
+ *         take no more iterations
+ */
+// -------------------------------------------------------------
+
+#include "mpi.h"
+#include <ga.h>
+#include <macdecls.h>
+#include <cmath>
+#include "gridpack/include/gridpack.hpp"
+#include "pf_app_module.hpp"
+
+#define NCONT 5
+
+// Line outages in the IEEE 14 bus system. Removing line 7-8 isolates
+// bus 8, which changes the layout of the Jacobian
+static int contFrom[NCONT] = {2, 4, 6, 9, 7};
+static int contTo[NCONT] = {3, 5, 13, 14, 8};
+
+// Set up a line outage
+void setLineOutage(gridpack::powerflow::Contingency &event, int from, int to)
+{
+  char buf[64];
+  sprintf(buf,"Line %d-%d",from,to);
+  event.p_name = buf;
+  event.p_type = gridpack::powerflow::Branch;
+  event.p_from.assign(1,from);
+  event.p_to.assign(1,to);
+  event.p_ckt.assign(1,"BL");
+  event.p_saveLineStatus.assign(1,true);
+}
+
+// Get voltage magnitudes and angles on all local buses
+void getVoltages(boost::shared_ptr<gridpack::powerflow::PFNetwork> network,
+    std::vector<double> &vmag, std::vector<double> &vang)
+{
+  int i;
+  int nbus = network->numBuses();
+  vmag.resize(nbus);
+  vang.resize(nbus);
+  for (i=0; i<nbus; i++) {
+    gridpack::powerflow::PFBus *bus =
+      dynamic_cast<gridpack::powerflow::PFBus*>(network->getBus(i).get());
+    vmag[i] = bus->getVoltage();
+    vang[i] = bus->getPhase();
+  }
+}
+
+// -------------------------------------------------------------
+//  Main Program
+// -------------------------------------------------------------
+int
+main(int argc, char **argv)
+{
+  gridpack::parallel::Environment env(argc,argv);
+  gridpack::math::Initialize(&argc,&argv);
+  int ok = 1;
+
+  if (1) {
+    gridpack::parallel::Communicator world;
+    int me = world.rank();
+
+    // read configuration file
+    gridpack::utility::Configuration *config =
+      gridpack::utility::Configuration::configuration();
+    if (argc >= 2 && argv[1] != NULL) {
+      char inputfile[256];
+      sprintf(inputfile,"%s",argv[1]);
+      config->open(inputfile,world);
+    } else {
+      config->open("input_14.xml",world);
+    }
+
+    boost::shared_ptr<gridpack::powerflow::PFNetwork>
+      pf_network(new gridpack::powerflow::PFNetwork(world));
+    gridpack::powerflow::PFAppModule pf_app;
+    pf_app.readNetwork(pf_network,config);
+    pf_app.initialize();
+
+    std::vector<std::vector<double> > cold_mag(NCONT), cold_ang(NCONT);
+    std::vector<int> cold_iter(NCONT);
+    int i, j;
+
+    // Solve each contingency from scratch: new solver objects on every call
+    // and voltages reset to the values in the network configuration file
+    pf_app.setContingencyMode(false);
+    for (i=0; i<NCONT; i++) {
+      gridpack::powerflow::Contingency event;
+      setLineOutage(event,contFrom[i],contTo[i]);
+      pf_app.resetVoltages();
+      pf_app.setContingency(event);
+      if (!pf_app.solve()) {
+        if (me == 0) printf("Cold start solve failed for %s\n",
+            event.p_name.c_str());
+        ok = 0;
+      }
+      cold_iter[i] = pf_app.getIterations();
+      getVoltages(pf_network,cold_mag[i],cold_ang[i]);
+      pf_app.unSetContingency(event);
+    }
+
+    // Solve the base case in contingency mode and use its solution as the
+    // starting point for each contingency
+    pf_app.setContingencyMode(true);
+    pf_app.resetVoltages();
+    pf_app.solve();
+    pf_app.saveVoltages();
+    for (i=0; i<NCONT; i++) {
+      gridpack::powerflow::Contingency event;
+      setLineOutage(event,contFrom[i],contTo[i]);
+      pf_app.restoreVoltages();
+      pf_app.setContingency(event);
+      if (!pf_app.solve()) {
+        if (me == 0) printf("Warm start solve failed for %s\n",
+            event.p_name.c_str());
+        ok = 0;
+      }
+      int warm_iter = pf_app.getIterations();
+      std::vector<double> vmag, vang;
+      getVoltages(pf_network,vmag,vang);
+      pf_app.unSetContingency(event);
+
+      double diff = 0.0;
+      for (j=0; j<vmag.size(); j++) {
+        if (!pf_network->getActiveBus(j)) continue;
+        diff = std::max(diff,fabs(vmag[j]-cold_mag[i][j]));
+        diff = std::max(diff,fabs(vang[j]-cold_ang[i][j]));
+      }
+      world.max(&diff,1);
+      if (me == 0) {
+        printf("%s: cold start %d iterations, warm start %d iterations,"
+            " largest voltage difference %e\n",event.p_name.c_str(),
+            cold_iter[i],warm_iter,diff);
+      }
+      if (diff > 1.0e-4) {
+        if (me == 0) printf("Error: voltages for %s do not agree\n",
+            event.p_name.c_str());
+        ok = 0;
+      }
+      if (warm_iter > cold_iter[i]) {
+        if (me == 0) printf("Error: warm start for %s took more"
+            " iterations than cold start\n",event.p_name.c_str());
+        ok = 0;
+      }
+    }
+    world.min(&ok,1);
+    if (me == 0) {
+      if (ok) {
+        printf("\nWarm started contingencies OK\n");
+      } else {
+        printf("\nError found in warm started contingencies\n");
+      }
+    }
+  }
+
+  // Terminate Math libraries
+  gridpack::math::Finalize();
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,239 @@
+/*
+ *     Copyright (c) 2013 Battelle Memorial Institute
+ *     Licensed under modified BSD License. A copy of this license can be found
+ *     in the LICENSE file in the top level directory of this distribution.
+ */
+// -------------------------------------------------------------
+/**
+ * @file   pf_screening_test.cpp
+ *
+ * @brief  Check post-outage line flows estimated by DC contingency
+ *         screening against full DC power flow solutions with the outaged
+ *         line removed from the network
+ */
+// -------------------------------------------------------------
+
+#include "mpi.h"
+#include <ga.h>
+#include <macdecls.h>
+#include <cmath>
+#include "gridpack/include/gridpack.hpp"
+#include "pf_app_module.hpp"
+
+#define NCONT 5
+#define NINJ 11
+
+// Line outages in the IEEE 14 bus system. None of them isolate a bus
+static int contFrom[NCONT] = {2, 2, 4, 6, 9};
+static int contTo[NCONT] = {3, 5, 5, 13, 14};
+
+// Net real power injections (generation minus load) in per unit used for
+// the full DC power flow. Bus 1 is the reference bus and picks up the
+// balance
+static int injBus[NINJ] = {2, 3, 4, 5, 6, 9, 10, 11, 12, 13, 14};
+static double injVal[NINJ] = {0.183, -0.942, -0.478, -0.076, -0.112,
+  -0.295, -0.090, -0.035, -0.061, -0.135, -0.149};
+
+// Set up a line outage
+void setLineOutage(gridpack::powerflow::Contingency &event, int from, int to)
+{
+  char buf[64];
+  sprintf(buf,"Line %d-%d",from,to);
+  event.p_name = buf;
+  event.p_type = gridpack::powerflow::Branch;
+  event.p_from.assign(1,from);
+  event.p_to.assign(1,to);
+  event.p_ckt.assign(1,"BL");
+  event.p_saveLineStatus.assign(1,true);
+}
+
+// Solve the DC power flow equations for the injections above with the
+// current line status and return the real power flow on each local line
+// element, in the same order as PFAppModule::getScreeningFlows
+void dcFlows(boost::shared_ptr<gridpack::powerflow::PFNetwork> network,
+    gridpack::utility::Configuration::CursorPtr cursor,
+    std::vector<double> &flow)
+{
+  int i, k;
+  gridpack::powerflow::PFFactoryModule factory(network);
+  factory.clearDCInjections();
+  for (i=0; i<NINJ; i++) {
+    std::vector<int> lids = network->getLocalBusIndices(injBus[i]);
+    for (k=0; k<lids.size(); k++) {
+      dynamic_cast<gridpack::powerflow::PFBus*>
+        (network->getBus(lids[k]).get())->setDCInjection(injVal[i]);
+    }
+  }
+  factory.setMode(gridpack::powerflow::DCFlow);
+  gridpack::mapper::BusVectorMap<gridpack::powerflow::PFNetwork>
+    vMap(network);
+  gridpack::mapper::FullMatrixMap<gridpack::powerflow::PFNetwork>
+    bMap(network);
+  boost::shared_ptr<gridpack::math::RealVector> inj
+    = vMap.mapToRealVector();
+  boost::shared_ptr<gridpack::math::RealVector> theta(inj->clone());
+  boost::shared_ptr<gridpack::math::RealMatrix> B = bMap.mapToRealMatrix();
+  gridpack::math::RealLinearSolver solver(*B);
+  solver.configure(cursor);
+  theta->zero();
+  solver.solve(*inj, *theta);
+  vMap.mapToBus(theta);
+  network->updateBuses();
+  factory.clearDCInjections();
+
+  flow.clear();
+  int nbranch = network->numBranches();
+  for (i=0; i<nbranch; i++) {
+    if (!network->getActiveBranch(i)) continue;
+    gridpack::powerflow::PFBranch *branch =
+      dynamic_cast<gridpack::powerflow::PFBranch*>
+      (network->getBranch(i).get());
+    double a1 = dynamic_cast<gridpack::powerflow::PFBus*>
+      (branch->getBus1().get())->getDCAngle();
+    double a2 = dynamic_cast<gridpack::powerflow::PFBus*>
+      (branch->getBus2().get())->getDCAngle();
+    std::vector<std::string> tags = branch->getLineTags();
+    for (k=0; k<tags.size(); k++) {
+      flow.push_back(branch->getDCSusceptance(tags[k])*(a1-a2));
+    }
+  }
+}
+
+// -------------------------------------------------------------
+//  Main Program
+// -------------------------------------------------------------
+int
+main(int argc, char **argv)
+{
+  gridpack::parallel::Environment env(argc,argv);
+  gridpack::math::Initialize(&argc,&argv);
+  int ok = 1;
+
+  if (1) {
+    gridpack::parallel::Communicator world;
+    int me = world.rank();
+
+    // read configuration file
+    gridpack::utility::Configuration *config =
+      gridpack::utility::Configuration::configuration();
+    if (argc >= 2 && argv[1] != NULL) {
+      char inputfile[256];
+      sprintf(inputfile,"%s",argv[1]);
+      config->open(inputfile,world);
+    } else {
+      config->open("input_14.xml",world);
+    }
+    gridpack::utility::Configuration::CursorPtr cursor;
+    cursor = config->getCursor("Configuration.Powerflow");
+
+    boost::shared_ptr<gridpack::powerflow::PFNetwork>
+      pf_network(new gridpack::powerflow::PFNetwork(world));
+    gridpack::powerflow::PFAppModule pf_app;
+    pf_app.readNetwork(pf_network,config);
+    pf_app.initialize();
+    if (!pf_app.solve()) {
+      if (me == 0) printf("Base case did not converge\n");
+      ok = 0;
+    }
+
+    // Base case flows used by the screening
+    int i, e;
+    std::vector<double> pac;
+    int nbranch = pf_network->numBranches();
+    for (i=0; i<nbranch; i++) {
+      if (!pf_network->getActiveBranch(i)) continue;
+      gridpack::powerflow::PFBranch *branch =
+        dynamic_cast<gridpack::powerflow::PFBranch*>
+        (pf_network->getBranch(i).get());
+      std::vector<std::string> tags = branch->getLineTags();
+      for (int k=0; k<tags.size(); k++) {
+        pac.push_back(real(branch->getComplexPower(tags[k])));
+      }
+    }
+
+    for (i=0; i<NCONT; i++) {
+      gridpack::powerflow::Contingency event;
+      setLineOutage(event,contFrom[i],contTo[i]);
+      double lmax;
+      int nover;
+      if (!pf_app.screenContingency(event,1.0,&lmax,&nover)) {
+        if (me == 0) printf("Screening failed for %s\n",
+            event.p_name.c_str());
+        ok = 0;
+        continue;
+      }
+      std::vector<int> from, to;
+      std::vector<std::string> tags;
+      std::vector<double> est;
+      pf_app.getScreeningFlows(from,to,tags,est);
+
+      std::vector<double> pre, post;
+      dcFlows(pf_network,cursor,pre);
+      pf_app.setContingency(event);
+      dcFlows(pf_network,cursor,post);
+      pf_app.unSetContingency(event);
+      int nelem = pac.size();
+      if (est.size() != nelem || pre.size() != nelem || post.size() != nelem) {
+        printf("p[%d] Error: %d screened line elements, expected %d\n",
+            me,static_cast<int>(est.size()),nelem);
+        ok = 0;
+        nelem = 0;
+      }
+
+      // The screening applies outage distribution factors to the base case
+      // flow on the outaged line, so the change in DC flow is scaled by
+      // the ratio of base case to DC flow on that line. The expected flow
+      // on the outaged line itself is then zero
+      double fac = 0.0;
+      double fdc = 0.0;
+      for (e=0; e<nelem; e++) {
+        if (tags[e] == event.p_ckt[0] &&
+            ((from[e] == contFrom[i] && to[e] == contTo[i]) ||
+             (from[e] == contTo[i] && to[e] == contFrom[i]))) {
+          double sign = (from[e] == contFrom[i]) ? 1.0 : -1.0;
+          fac += sign*pac[e];
+          fdc += sign*pre[e];
+        }
+      }
+      world.sum(&fac,1);
+      world.sum(&fdc,1);
+      if (fabs(fdc) < 1.0e-8) {
+        if (me == 0) printf("Error: no DC flow on %s\n",
+            event.p_name.c_str());
+        ok = 0;
+        continue;
+      }
+
+      double diff = 0.0;
+      double scale = 1.0;
+      for (e=0; e<nelem; e++) {
+        double expected = pac[e]+(post[e]-pre[e])*fac/fdc;
+        diff = std::max(diff,fabs(est[e]-expected));
+        scale = std::max(scale,fabs(expected));
+      }
+      world.max(&diff,1);
+      world.max(&scale,1);
+      if (me == 0) {
+        printf("%s: largest difference from DC solution %e\n",
+            event.p_name.c_str(),diff);
+      }
+      if (diff > 1.0e-6*scale) {
+        if (me == 0) printf("Error: screened flows for %s do not agree"
+            " with DC solution\n",event.p_name.c_str());
+        ok = 0;
+      }
+    }
+    world.min(&ok,1);
+    if (me == 0) {
+      if (ok) {
+        printf("\nContingency screening OK\n");
+      } else {
+        printf("\nError found in contingency screening\n");
+      }
+    }
+  }
+
+  // Terminate Math libraries
+  gridpack::math::Finalize();
+  return ok ? 0 : 1;
+}
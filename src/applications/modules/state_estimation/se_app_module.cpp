@@ -33,6 +33,7 @@
  * Basic constructor
  */
 gridpack::state_estimation::SEAppModule::SEAppModule(void)
+  : p_leastSquares(false)
 {
 }
 
@@ -142,6 +143,9 @@ void gridpack::state_estimation::SEAppModule::readNetwork(
   // Convergence and iteration parameters
   p_tolerance = secursor->get("tolerance",1.0e-3);
   p_max_iteration = secursor->get("maxIteration",20);
+  std::string solverMode = secursor->get("solverMode",
+      std::string("NormalEquations"));
+  p_leastSquares = (solverMode == "LeastSquares");
 
   // load input file
   //gridpack::parser::PTI23_parser<SENetwork> parser(p_network);
@@ -192,6 +196,9 @@ void gridpack::state_estimation::SEAppModule::setNetwork(
   // Convergence and iteration parameters
   p_tolerance = secursor->get("tolerance",1.0e-3);
   p_max_iteration = secursor->get("maxIteration",20);
+  std::string solverMode = secursor->get("solverMode",
+      std::string("NormalEquations"));
+  p_leastSquares = (solverMode == "LeastSquares");
   char buf[128];
   sprintf(buf,"Tolerance: %12.4e\n",p_tolerance);
   p_busIO->header(buf);
@@ -313,6 +320,34 @@ void gridpack::state_estimation::SEAppModule::solve(void)
   boost::shared_ptr<gridpack::math::Matrix> Rinv = RinvMap.mapToMatrix();
 //  Rinv->print();
 
+  // The linear solver and the matrices and vectors used to build the
+  // linear system are created on the first iteration and reused on
+  // subsequent iterations
+  boost::shared_ptr<gridpack::math::LinearSolver> solver;
+  boost::shared_ptr<gridpack::math::Matrix> trans_HJac;
+  boost::shared_ptr<gridpack::math::Matrix> HTR;
+  boost::shared_ptr<gridpack::math::Matrix> Gain;
+  boost::shared_ptr<gridpack::math::Vector> W;
+  boost::shared_ptr<gridpack::math::Vector> RHS;
+  boost::shared_ptr<gridpack::math::Vector> X;
+
+  if (p_leastSquares) {
+    // Weight each measurement equation by the square root of its
+    // inverse variance, so that the weighted least squares problem
+    // can be solved directly without forming H'*Rinv*H
+    W.reset(Ez->clone());
+    gridpack::math::diagonal(*Rinv, *W);
+    int lo, hi;
+    W->localIndexRange(lo, hi);
+    if (hi > lo) {
+      std::vector<ComplexType> w(hi-lo);
+      W->getElementRange(lo, hi, &w[0]);
+      for (int i = 0; i < hi-lo; ++i) w[i] = sqrt(w[i]);
+      W->setElementRange(lo, hi, &w[0]);
+    }
+    W->ready();
+  }
+
   // Start N-R loop
   while (real(tol) > p_tolerance && iter < p_max_iteration) {
 
@@ -322,56 +357,55 @@ void gridpack::state_estimation::SEAppModule::solve(void)
 //    printf("Got to HJac\n");
     HJacMap.mapToMatrix(HJac);
 //    HJac->print();
-//  printf("Got to H'\n");
-
-    // Form H'
-    boost::shared_ptr<gridpack::math::Matrix> trans_HJac(transpose(*HJac));
-//  trans_HJac->print();
-//  printf("Got to Ez\n");
 
     // Build measurement equation
     EzMap.mapToVector(Ez);
 //  Ez->print();
-//  printf("Got to Gain\n");
 
-    // Form Gain matrix
-    boost::shared_ptr<gridpack::math::Matrix> Gain1(multiply(*trans_HJac, *Rinv));
-    boost::shared_ptr<gridpack::math::Matrix> Gain(multiply(*Gain1, *HJac));
-//    Gain->print();
-//  printf("Got to H'*Rinv\n");
-
-    // Form right hand side vector
-    boost::shared_ptr<gridpack::math::Matrix> HTR(multiply(*trans_HJac, *Rinv));
-//  HTR->print();
-//  printf("Got to RHS\n");
-
-//  printf("HTR iDim: %d jDim: %d Ez len: %d\n",HTR->rows(),HTR->cols(),Ez->size());
-    boost::shared_ptr<gridpack::math::Vector> RHS(multiply(*HTR, *Ez));
-//  printf("Create Solver\n");
-//  RHS->print();
-//  printf("Got to Solver\n");
-
-// create a linear solver
-    gridpack::utility::Configuration::CursorPtr cursor;
-    cursor = p_config->getCursor("Configuration.State_estimation");
-    gridpack::math::LinearSolver solver(*Gain);
-    solver.configure(cursor);
-    
-    p_busIO->header("\n Print Gain matrix\n");
+    if (p_leastSquares) {
+      // Form weighted system W*H*dx = W*Ez. The Jacobian is remapped
+      // in place so its nonzero pattern does not change
+      HJac->scaleRows(*W);
+      if (!solver) {
+        RHS.reset(Ez->clone());
+        X.reset(new gridpack::math::Vector(p_network->communicator(),
+              HJac->localCols()));
+        solver.reset(new gridpack::math::LinearSolver(*HJac));
+        solver->configure(
+            p_config->getCursor("Configuration.State_estimation.LeastSquares"));
+        solver->constantPattern(true);
+      }
+      RHS->equate(*Ez);
+      RHS->elementMultiply(*W);
+    } else if (!solver) {
+      // Form H', Gain matrix and right hand side vector
+      trans_HJac.reset(transpose(*HJac));
+      HTR.reset(multiply(*trans_HJac, *Rinv));
+      Gain.reset(multiply(*HTR, *HJac));
+      RHS.reset(multiply(*HTR, *Ez));
+      X.reset(RHS->clone());
+
+      // create a linear solver
+      gridpack::utility::Configuration::CursorPtr cursor;
+      cursor = p_config->getCursor("Configuration.State_estimation");
+      solver.reset(new gridpack::math::LinearSolver(*Gain));
+      solver->configure(cursor);
+    } else {
+      // Update H' in place, reusing its nonzero pattern, then update
+      // Gain matrix and right hand side vector
+      transpose(*HJac, *trans_HJac);
+      multiply(*trans_HJac, *Rinv, *HTR);
+      multiply(*HTR, *HJac, *Gain);
+      multiply(*HTR, *Ez, *RHS);
+    }
 //    Gain->print();
 //    Gain->save("gain.txt");
-//  printf("Got to DeltaX\n");
 
     // Solve linear equation
-    boost::shared_ptr<gridpack::math::Vector> X(RHS->clone()); 
-//    printf("Got to Solve\n");
-    p_busIO->header("\n Print RHS vector\n");
 //    RHS->print();
     X->zero(); //might not need to do this
-    solver.solve(*RHS, *X);
+    solver->solve(*RHS, *X);
 //    X->print();
-//  printf("Got to updateBus\n");
-//    boost::shared_ptr<gridpack::math::Vector> X(solver.solve(*RHS)); 
     tol = X->normInfinity();
     char ioBuf[128];
     sprintf(ioBuf,"\nIteration %d Tol: %12.6e\n",iter+1,real(tol));
@@ -384,7 +418,6 @@ void gridpack::state_estimation::SEAppModule::solve(void)
   
     // update values
     p_network->updateBuses();
-//  printf("Last sentence\n");
 
     iter++;
 
@@ -83,7 +83,15 @@ class SEAppModule
     void initialize();
 
     /**
-     * Solve the state estimation problem
+     * Solve the state estimation problem. By default, each Gauss-Newton
+     * iteration forms and solves the normal equations
+     * H'*Rinv*H*dx = H'*Rinv*Ez using the solver in the
+     * State_estimation.LinearSolver block. If solverMode is set to
+     * LeastSquares, the weighted system Rinv^(1/2)*H*dx = Rinv^(1/2)*Ez
+     * is solved directly without forming the gain matrix, using the
+     * solver in the State_estimation.LeastSquares.LinearSolver block
+     * (this should be a least squares Krylov method such as LSQR).
+     * In both cases the linear solver is kept for all iterations.
      */
     void solve();
 
@@ -124,6 +132,10 @@ class SEAppModule
 
     // convergence tolerance
     double p_tolerance;
+
+    // solve the weighted least squares problem directly instead of
+    // forming the gain matrix
+    bool p_leastSquares;
 };
 
 } // state estimation
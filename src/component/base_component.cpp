@@ -534,6 +534,28 @@ bool BaseComponent::getDataItem(void *data, const char *signal)
   return false;
 }
 
+/**
+ * Estimate the relative cost of computations on this component
+ * @param data data collection associated with component
+ * @return estimated workload
+ */
+int BaseComponent::getWorkload(
+    const boost::shared_ptr<gridpack::component::DataCollection> &data) const
+{
+  return 1;
+}
+
+/**
+ * Estimate the number of matrix rows contributed by this component
+ * @param data data collection associated with component
+ * @return estimated number of matrix rows
+ */
+int BaseComponent::getMatrixWorkload(
+    const boost::shared_ptr<gridpack::component::DataCollection> &data) const
+{
+  return 1;
+}
+
 /**
  * Save state variables inside the component to a DataCollection object.
  * This can be used as a way of moving data in a way that is useful for
@@ -644,12 +666,45 @@ void BaseBusComponent::getNeighborBuses(
   }
 }
 
+/**
+ * Get branches that are connected to bus without copying the list
+ * @return list of pointers to neighboring branches
+ */
+ComponentSpan<BaseComponent> BaseBusComponent::getBranchSpan(void) const
+{
+  return p_branchSpan;
+}
+
+/**
+ * Get buses that are connected to calling bus via a branch without
+ * copying the list
+ * @return list of pointers to neighboring buses
+ */
+ComponentSpan<BaseComponent> BaseBusComponent::getBusSpan(void) const
+{
+  return p_busSpan;
+}
+
+/**
+ * Set lists of neighboring branches and buses
+ * @param branches list of pointers to neighboring branches
+ * @param buses list of pointers to neighboring buses
+ */
+void BaseBusComponent::setNeighborSpans(
+    const ComponentSpan<BaseComponent> &branches,
+    const ComponentSpan<BaseComponent> &buses)
+{
+  p_branchSpan = branches;
+  p_busSpan = buses;
+}
+
 /**
  * Clear all pointers to neighboring branches
  */
 void BaseBusComponent::clearBranches(void)
 {
   p_branches.clear();
+  p_branchSpan = ComponentSpan<BaseComponent>();
 }
 
 /**
@@ -658,6 +713,7 @@ void BaseBusComponent::clearBranches(void)
 void BaseBusComponent::clearBuses(void)
 {
   p_buses.clear();
+  p_busSpan = ComponentSpan<BaseComponent>();
 }
 
 /**
@@ -773,6 +829,25 @@ boost::shared_ptr<BaseComponent>
   return ret;
 }
 
+/**
+ * Get buses at either end of branch without copying or locking pointers
+ * @return list of pointers to buses at either end of branch
+ */
+ComponentSpan<BaseComponent> BaseBranchComponent::getBusSpan(void) const
+{
+  return p_busSpan;
+}
+
+/**
+ * Set list of buses at either end of branch
+ * @param buses list of pointers to bus 1 and bus 2
+ */
+void BaseBranchComponent::setBusSpan(
+    const ComponentSpan<BaseComponent> &buses)
+{
+  p_busSpan = buses;
+}
+
 /**
  * Clear bus pointers
  */
@@ -780,6 +855,7 @@ void BaseBranchComponent::clearBuses(void)
 {
   p_bus1.reset();
   p_bus2.reset();
+  p_busSpan = ComponentSpan<BaseComponent>();
 }
 
 
@@ -438,6 +438,29 @@ class BaseComponent
      */
     virtual bool getDataItem(void *data, const char *signal = NULL);
 
+    /**
+     * Estimate the relative cost of computations on this component. The
+     * network uses this estimate as a weight when it is partitioned, so that
+     * expensive components (e.g. buses with several dynamic models) are
+     * spread evenly over processors. Components have not been loaded when
+     * the network is partitioned, so the estimate must be based on the data
+     * collection. The default is 1
+     * @param data data collection associated with component
+     * @return estimated workload
+     */
+    virtual int getWorkload(
+        const boost::shared_ptr<gridpack::component::DataCollection> &data) const;
+
+    /**
+     * Estimate the number of matrix rows contributed by this component. This
+     * is used as a second weight if the network is partitioned with multiple
+     * constraints. The default is 1
+     * @param data data collection associated with component
+     * @return estimated number of matrix rows
+     */
+    virtual int getMatrixWorkload(
+        const boost::shared_ptr<gridpack::component::DataCollection> &data) const;
+
     /**
      * Set rank holding the component
      * @param rank processor rank holding the component
@@ -502,6 +525,95 @@ class BaseComponent
 
 };
 
+// -------------------------------------------------------------
+//  class ComponentSpan:
+//  A read-only view of a contiguous list of component pointers.
+//  The list itself is owned by the network, so copying a span does not
+//  copy the list or touch reference counts. A span is valid until the
+//  network relinks its components (e.g. after partitioning or cleaning)
+// -------------------------------------------------------------
+template <class _component>
+class ComponentSpan {
+  public:
+    typedef _component* const* iterator;
+
+    /**
+     * Simple constructor. Creates an empty span
+     */
+    ComponentSpan(void)
+      : p_data(NULL), p_size(0)
+    {
+    }
+
+    /**
+     * Create span from a list of pointers
+     * @param data pointer to first element of list
+     * @param size number of elements in list
+     */
+    ComponentSpan(_component* const *data, int size)
+      : p_data(data), p_size(size)
+    {
+    }
+
+    /**
+     * Number of components in span
+     * @return number of components
+     */
+    int size(void) const
+    {
+      return p_size;
+    }
+
+    /**
+     * Is the span empty?
+     * @return true if span has no components
+     */
+    bool empty(void) const
+    {
+      return p_size == 0;
+    }
+
+    /**
+     * Get pointer to component
+     * @param i position in span
+     * @return pointer to component
+     */
+    _component* operator[](int i) const
+    {
+      return p_data[i];
+    }
+
+    /**
+     * Get pointer to component, converted to a derived component type.
+     * This is a static conversion, so the type must be the type of the
+     * components that were created by the network (e.g. the branch class of
+     * the network for a span of branches)
+     * @param i position in span
+     * @return pointer to component
+     */
+    template <class _derived>
+    _derived* get(int i) const
+    {
+      return static_cast<_derived*>(p_data[i]);
+    }
+
+    /**
+     * Iterators over the span
+     */
+    iterator begin(void) const
+    {
+      return p_data;
+    }
+    iterator end(void) const
+    {
+      return p_data + p_size;
+    }
+
+  private:
+    _component* const *p_data;
+    int p_size;
+};
+
 class BaseBusComponent
   : public BaseComponent {
   public:
@@ -540,6 +652,31 @@ class BaseBusComponent
      */
     void getNeighborBuses(std::vector<boost::shared_ptr<BaseComponent> > &nghbrs) const;
 
+    /**
+     * Get branches that are connected to bus without copying the list. The
+     * span points into the network's adjacency lists and is set when the
+     * network links its components
+     * @return list of pointers to neighboring branches
+     */
+    ComponentSpan<BaseComponent> getBranchSpan(void) const;
+
+    /**
+     * Get buses that are connected to calling bus via a branch without
+     * copying the list. Entry i is the bus at the other end of entry i of
+     * getBranchSpan
+     * @return list of pointers to neighboring buses
+     */
+    ComponentSpan<BaseComponent> getBusSpan(void) const;
+
+    /**
+     * Set lists of neighboring branches and buses. This is called by the
+     * network
+     * @param branches list of pointers to neighboring branches
+     * @param buses list of pointers to neighboring buses
+     */
+    void setNeighborSpans(const ComponentSpan<BaseComponent> &branches,
+        const ComponentSpan<BaseComponent> &buses);
+
     /**
      * Clear all pointers to neighboring branches
      */
@@ -596,6 +733,12 @@ class BaseBusComponent
      */
     std::vector<boost::weak_ptr<BaseComponent> > p_buses;
 
+    /**
+     * Neighboring branches and buses in the network's adjacency lists
+     */
+    ComponentSpan<BaseComponent> p_branchSpan;
+    ComponentSpan<BaseComponent> p_busSpan;
+
     /**
      * Is this a reference bus?
      */
@@ -658,6 +801,22 @@ class BaseBranchComponent
      */
     boost::shared_ptr<BaseComponent> getBus2(void) const;
 
+    /**
+     * Get buses at either end of branch without copying or locking
+     * pointers. Entry 0 is bus 1 and entry 1 is bus 2. The span points into
+     * the network's adjacency lists and is set when the network links its
+     * components
+     * @return list of pointers to buses at either end of branch
+     */
+    ComponentSpan<BaseComponent> getBusSpan(void) const;
+
+    /**
+     * Set list of buses at either end of branch. This is called by the
+     * network
+     * @param buses list of pointers to bus 1 and bus 2
+     */
+    void setBusSpan(const ComponentSpan<BaseComponent> &buses);
+
     /**
      * Clear bus pointers
      */
@@ -729,6 +888,11 @@ class BaseBranchComponent
     boost::weak_ptr<BaseComponent> p_bus1;
     boost::weak_ptr<BaseComponent> p_bus2;
 
+    /**
+     *  Buses at either end of branch in the network's adjacency lists
+     */
+    ComponentSpan<BaseComponent> p_busSpan;
+
     /**
      *  Original indices for bus 1 and bus 2 (assigned from input file)
      */
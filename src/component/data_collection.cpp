@@ -4,8 +4,264 @@
  *     in the LICENSE file in the top level directory of this distribution.
  */
 #include "gridpack/component/data_collection.hpp"
+#include "gridpack/utilities/exception.hpp"
 #include <iostream>
 #include <cstdio>
+#include <cstring>
+#include <boost/unordered_map.hpp>
+
+namespace {
+
+/**
+ * Process-wide table of data element names. Each distinct name is
+ * stored once and is identified everywhere else by its integer key.
+ * Indexed names ("name:idx") are also cached by (key, idx) pair so that
+ * the string does not need to be built on every lookup.
+ */
+class KeyRegistry {
+public:
+
+  /**
+   * Get key for name
+   * @param name name of data element
+   * @param create assign a new key if name has not been seen before
+   * @return key for name or -1 if name is new and create is false
+   */
+  int find(const char *name, bool create)
+  {
+    std::string str = name;
+    boost::unordered_map<std::string, int>::iterator it = p_keys.find(str);
+    if (it != p_keys.end()) return it->second;
+    if (!create) return -1;
+    int key = static_cast<int>(p_names.size());
+    p_keys.insert(std::pair<std::string, int>(str, key));
+    p_names.push_back(str);
+    return key;
+  }
+
+  /**
+   * Get key for indexed name "name:idx"
+   * @param name name of data element
+   * @param idx index of data element
+   * @param create assign a new key if name has not been seen before
+   * @return key for name or -1 if name is new and create is false
+   */
+  int find(const char *name, const int idx, bool create)
+  {
+    int base = find(name, create);
+    std::pair<int, int> pr(base, idx);
+    if (base >= 0) {
+      boost::unordered_map<std::pair<int, int>, int>::iterator it
+        = p_indexed.find(pr);
+      if (it != p_indexed.end()) return it->second;
+    }
+    std::string str = name;
+    str.append(":");
+    char buf[32];
+    sprintf(buf,"%d",idx);
+    str.append(buf);
+    int key = find(str.c_str(), create);
+    if (base >= 0 && key >= 0) {
+      p_indexed.insert(std::pair<std::pair<int, int>, int>(pr, key));
+    }
+    return key;
+  }
+
+  /**
+   * Get name for key
+   * @param key key of data element
+   * @return name of data element
+   */
+  const std::string& name(const int key) const
+  {
+    return p_names[key];
+  }
+
+  /**
+   * Number of keys that have been assigned
+   */
+  int size(void) const
+  {
+    return static_cast<int>(p_names.size());
+  }
+
+private:
+  boost::unordered_map<std::string, int> p_keys;
+  boost::unordered_map<std::pair<int, int>, int> p_indexed;
+  std::vector<std::string> p_names;
+};
+
+KeyRegistry& registry(void)
+{
+  static KeyRegistry reg;
+  return reg;
+}
+
+template <typename T> bool
+keyLessThan(const std::pair<int, T> &a, const int key)
+{
+  return a.first < key;
+}
+
+/**
+ * Find the value stored with a key
+ * @param values vector of values sorted by key
+ * @param key key of data element
+ * @return pointer to value or NULL if key is not found
+ */
+template <typename T> T*
+findValue(std::vector<std::pair<int, T> > &values, const int key)
+{
+  if (key < 0) return NULL;
+  typename std::vector<std::pair<int, T> >::iterator it =
+    std::lower_bound(values.begin(), values.end(), key, keyLessThan<T>);
+  if (it != values.end() && it->first == key) return &(it->second);
+  return NULL;
+}
+
+/**
+ * Insert a value, keeping the vector sorted by key. As with the
+ * std::map that was used previously, an existing value is not replaced
+ * @param values vector of values sorted by key
+ * @param key key of data element
+ * @param value value of data element
+ */
+template <typename T> void
+insertValue(std::vector<std::pair<int, T> > &values, const int key,
+    const T &value)
+{
+  // Data elements are usually added in the same order for every
+  // object, so most keys go on the end
+  if (values.empty() || values.back().first < key) {
+    values.push_back(std::pair<int, T>(key, value));
+    return;
+  }
+  typename std::vector<std::pair<int, T> >::iterator it =
+    std::lower_bound(values.begin(), values.end(), key, keyLessThan<T>);
+  if (it != values.end() && it->first == key) return;
+  values.insert(it, std::pair<int, T>(key, value));
+}
+
+/**
+ * Append a fixed size value to a binary buffer
+ */
+template <typename T> void
+packItem(std::vector<char> &buf, const T &value)
+{
+  const char *ptr = reinterpret_cast<const char*>(&value);
+  buf.insert(buf.end(), ptr, ptr+sizeof(T));
+}
+
+/**
+ * Throw an exception if fewer than len bytes remain in a binary buffer
+ */
+void
+checkRemaining(const char *buf, const char *end, long len)
+{
+  if (len < 0 || end - buf < len) {
+    throw gridpack::Exception(
+        "DataCollection::unpack: buffer ends before packed collection");
+  }
+}
+
+/**
+ * Read a fixed size value from a binary buffer. The buffer does not need
+ * to be aligned
+ */
+template <typename T> const char*
+unpackItem(const char *buf, const char *end, T &value)
+{
+  checkRemaining(buf, end, sizeof(T));
+  memcpy(&value, buf, sizeof(T));
+  return buf+sizeof(T);
+}
+
+/**
+ * Translate a key read from a binary buffer to a key on this process
+ */
+int
+unpackKey(const std::vector<int> &keys, int key)
+{
+  if (key < 0 || key >= static_cast<int>(keys.size())) {
+    throw gridpack::Exception(
+        "DataCollection::unpack: key in buffer is out of range");
+  }
+  return keys[key];
+}
+
+/**
+ * Append a vector of values to a binary buffer as a count followed by
+ * (key, value) pairs
+ */
+template <typename T> void
+packValues(std::vector<char> &buf, const std::vector<std::pair<int, T> > &values)
+{
+  int n = values.size();
+  packItem(buf, n);
+  typename std::vector<std::pair<int, T> >::const_iterator it;
+  for (it = values.begin(); it != values.end(); it++) {
+    packItem(buf, it->first);
+    packItem(buf, it->second);
+  }
+}
+
+void
+packValues(std::vector<char> &buf,
+    const std::vector<std::pair<int, std::string> > &values)
+{
+  int n = values.size();
+  packItem(buf, n);
+  std::vector<std::pair<int, std::string> >::const_iterator it;
+  for (it = values.begin(); it != values.end(); it++) {
+    int len = it->second.length();
+    packItem(buf, it->first);
+    packItem(buf, len);
+    buf.insert(buf.end(), it->second.begin(), it->second.end());
+  }
+}
+
+/**
+ * Read values written by packValues, translating keys with a table
+ */
+template <typename T> const char*
+unpackValues(const char *buf, const char *end, const std::vector<int> &keys,
+    std::vector<std::pair<int, T> > &values)
+{
+  int i, n, key;
+  T value;
+  buf = unpackItem(buf, end, n);
+  checkRemaining(buf, end, static_cast<long>(n)*(sizeof(int)+sizeof(T)));
+  values.clear();
+  values.reserve(n);
+  for (i=0; i<n; i++) {
+    buf = unpackItem(buf, end, key);
+    buf = unpackItem(buf, end, value);
+    values.push_back(std::pair<int, T>(unpackKey(keys, key), value));
+  }
+  return buf;
+}
+
+const char*
+unpackValues(const char *buf, const char *end, const std::vector<int> &keys,
+    std::vector<std::pair<int, std::string> > &values)
+{
+  int i, n, key, len;
+  buf = unpackItem(buf, end, n);
+  checkRemaining(buf, end, static_cast<long>(n)*2*sizeof(int));
+  values.clear();
+  values.reserve(n);
+  for (i=0; i<n; i++) {
+    buf = unpackItem(buf, end, key);
+    buf = unpackItem(buf, end, len);
+    checkRemaining(buf, end, len);
+    values.push_back(std::pair<int, std::string>(unpackKey(keys, key),
+          std::string(buf, len)));
+    buf += len;
+  }
+  return buf;
+}
+
+}
 
 /**
  * Simple constructor
@@ -38,6 +294,149 @@ gridpack::component::DataCollection & gridpack::component::DataCollection::opera
   return *this;
 }
 
+/**
+ * Get the integer key used to store a data element
+ * @param name name of data element
+ * @return key for name
+ */
+int gridpack::component::DataCollection::key(const char *name)
+{
+  return registry().find(name, true);
+}
+
+/**
+ * Get the integer key used to store a data element with an index
+ * @param name name of data element
+ * @param idx index of data element
+ * @return key for name and index
+ */
+int gridpack::component::DataCollection::key(const char *name, const int idx)
+{
+  return registry().find(name, idx, true);
+}
+
+/**
+ * Get the name of a data element from its key
+ * @param key key returned by key()
+ * @return name of data element
+ */
+std::string gridpack::component::DataCollection::keyName(const int key)
+{
+  return registry().name(key);
+}
+
+/**
+ * Get the number of keys that have been assigned on this process
+ * @return number of keys
+ */
+int gridpack::component::DataCollection::numKeys(void)
+{
+  return registry().size();
+}
+
+/**
+ * Append the contents of the collection to a binary buffer
+ * @param buf buffer that contents are appended to
+ */
+void gridpack::component::DataCollection::pack(std::vector<char> &buf) const
+{
+  packValues(buf, p_ints);
+  packValues(buf, p_longs);
+  packValues(buf, p_bools);
+  packValues(buf, p_strings);
+  packValues(buf, p_floats);
+  packValues(buf, p_doubles);
+  packValues(buf, p_complexType);
+}
+
+/**
+ * Replace the contents of the collection with values from a buffer
+ * written by pack. Throws an exception if the buffer ends before the
+ * packed collection or contains an unknown key
+ * @param buf start of packed collection
+ * @param end end of buffer
+ * @param keys keys on this process indexed by the key used when the
+ * buffer was written
+ * @return pointer to the first byte after the packed collection
+ */
+const char* gridpack::component::DataCollection::unpack(const char *buf,
+    const char *end, const std::vector<int> &keys)
+{
+  buf = unpackValues(buf, end, keys, p_ints);
+  buf = unpackValues(buf, end, keys, p_longs);
+  buf = unpackValues(buf, end, keys, p_bools);
+  buf = unpackValues(buf, end, keys, p_strings);
+  buf = unpackValues(buf, end, keys, p_floats);
+  buf = unpackValues(buf, end, keys, p_doubles);
+  buf = unpackValues(buf, end, keys, p_complexType);
+  // Keys on this process may be in a different order than the keys that
+  // were used to write the buffer
+  p_sort(p_ints);
+  p_sort(p_longs);
+  p_sort(p_bools);
+  p_sort(p_strings);
+  p_sort(p_floats);
+  p_sort(p_doubles);
+  p_sort(p_complexType);
+  return buf;
+}
+
+/**
+ * Find the key for a name without creating a new one
+ * @param name name of data element
+ * @return key for name or -1 if name has never been used
+ */
+int gridpack::component::DataCollection::p_findKey(const char *name)
+{
+  return registry().find(name, false);
+}
+
+int gridpack::component::DataCollection::p_findKey(const char *name, const int idx)
+{
+  return registry().find(name, idx, false);
+}
+
+
+/**
+ *  Add variables to DataCollection object using a key from key()
+ *  @param key key of data element
+ *  @param value value of data element
+ */
+void gridpack::component::DataCollection::addValue(const int key, const int value)
+{
+  insertValue(p_ints, key, value);
+}
+
+void gridpack::component::DataCollection::addValue(const int key, const long value)
+{
+  insertValue(p_longs, key, value);
+}
+
+void gridpack::component::DataCollection::addValue(const int key, const bool value)
+{
+  insertValue(p_bools, key, value);
+}
+
+void gridpack::component::DataCollection::addValue(const int key, const char *value)
+{
+  insertValue(p_strings, key, std::string(value));
+}
+
+void gridpack::component::DataCollection::addValue(const int key, const float value)
+{
+  insertValue(p_floats, key, value);
+}
+
+void gridpack::component::DataCollection::addValue(const int key, const double value)
+{
+  insertValue(p_doubles, key, value);
+}
+
+void gridpack::component::DataCollection::addValue(const int key, const gridpack::ComplexType value)
+{
+  insertValue(p_complexType, key, value);
+}
+
 /**
  *  Add variables to DataCollection object
  *  @param name name given to data element
@@ -45,45 +444,37 @@ gridpack::component::DataCollection & gridpack::component::DataCollection::opera
  */
 void gridpack::component::DataCollection::addValue(const char *name, const int value)
 {
-  std::string str = name;
-  p_ints.insert(std::pair<std::string, int>(str,value));
+  addValue(key(name), value);
 }
 
 void gridpack::component::DataCollection::addValue(const char *name, const long value)
 {
-  std::string str = name;
-  p_longs.insert(std::pair<std::string, long>(str,value));
+  addValue(key(name), value);
 }
 
 void gridpack::component::DataCollection::addValue(const char *name, const bool value)
 {
-  std::string str = name;
-  p_bools.insert(std::pair<std::string, bool>(str,value));
+  addValue(key(name), value);
 }
 
 void gridpack::component::DataCollection::addValue(const char *name, const char *value)
 {
-  std::string str = name;
-  std::string val = value;
-  p_strings.insert(std::pair<std::string, std::string>(str,val));
+  addValue(key(name), value);
 }
 
 void gridpack::component::DataCollection::addValue(const char *name, const float value)
 {
-  std::string str = name;
-  p_floats.insert(std::pair<std::string, float>(str,value));
+  addValue(key(name), value);
 }
 
 void gridpack::component::DataCollection::addValue(const char *name, const double value)
 {
-  std::string str = name;
-  p_doubles.insert(std::pair<std::string, double>(str,value));
+  addValue(key(name), value);
 }
 
 void gridpack::component::DataCollection::addValue(const char *name, const gridpack::ComplexType value)
 {
-  std::string str = name;
-  p_complexType.insert(std::pair<std::string, gridpack::ComplexType>(str,value));
+  addValue(key(name), value);
 }
 
 /**
@@ -97,209 +488,172 @@ void gridpack::component::DataCollection::addValue(const char *name, const gridp
 void gridpack::component::DataCollection::addValue(const char *name, const int value,
     const int idx)
 {
-  std::string str = name;
-  str.append(":");
-  char buf[8];
-  sprintf(buf,"%d",idx);
-  str.append(buf);
-  p_ints.insert(std::pair<std::string, int>(str,value));
+  addValue(key(name,idx), value);
 }
 
 void gridpack::component::DataCollection::addValue(const char *name, const long value,
     const int idx)
 {
-  std::string str = name;
-  str.append(":");
-  char buf[8];
-  sprintf(buf,"%d",idx);
-  str.append(buf);
-  p_longs.insert(std::pair<std::string, long>(str,value));
+  addValue(key(name,idx), value);
 }
 
 void gridpack::component::DataCollection::addValue(const char *name, const bool value,
     const int idx)
 {
-  std::string str = name;
-  str.append(":");
-  char buf[8];
-  sprintf(buf,"%d",idx);
-  str.append(buf);
-  p_bools.insert(std::pair<std::string, bool>(str,value));
+  addValue(key(name,idx), value);
 }
 
 void gridpack::component::DataCollection::addValue(const char *name, const char *value,
     const int idx)
 {
-  std::string str = name;
-  str.append(":");
-  char buf[8];
-  sprintf(buf,"%d",idx);
-  str.append(buf);
-  std::string val = value;
-  p_strings.insert(std::pair<std::string, std::string>(str,val));
+  addValue(key(name,idx), value);
 }
 
 void gridpack::component::DataCollection::addValue(const char *name, const float value,
     const int idx)
 {
-  std::string str = name;
-  str.append(":");
-  char buf[8];
-  sprintf(buf,"%d",idx);
-  str.append(buf);
-  p_floats.insert(std::pair<std::string, float>(str,value));
+  addValue(key(name,idx), value);
 }
 
 void gridpack::component::DataCollection::addValue(const char *name, const double value,
     const int idx)
 {
-  std::string str = name;
-  str.append(":");
-  char buf[8];
-  sprintf(buf,"%d",idx);
-  str.append(buf);
-  p_doubles.insert(std::pair<std::string, double>(str,value));
+  addValue(key(name,idx), value);
 }
 
-void gridpack::component::DataCollection::addValue(const char *name,
-    const gridpack::ComplexType value, const int idx)
+void gridpack::component::DataCollection::addValue(const char *name, const gridpack::ComplexType value,
+    const int idx)
 {
-  std::string str = name;
-  str.append(":");
-  char buf[8];
-  sprintf(buf,"%d",idx);
-  str.append(buf);
-  p_complexType.insert(std::pair<std::string, gridpack::ComplexType>(str,value));
+  addValue(key(name,idx), value);
 }
 
 /**
- *  Modify current value of existing data element in
- *  DataCollection object
- *  @param name name of data element
+ *  Modify current value of existing data element using a key from key()
+ *  @param key key of data element
  *  @param value new value of data element
- *  @return false if no element of the correct name and type exists in
+ *  @return false if no element of the correct key and type exists in
  *  DataCollection object
  */
-bool gridpack::component::DataCollection::setValue(const char *name, const int value)
+bool gridpack::component::DataCollection::setValue(const int key, const int value)
 {
-  std::string str = name;
-#ifdef OLD_MAP
-  std::map<std::string, int>::iterator it;
-#else
-  boost::unordered_map<std::string, int>::iterator it;
-#endif
-  it = p_ints.find(str);
-  if (it != p_ints.end()) {
-    it->second = value;
+  int *ptr = findValue(p_ints, key);
+  if (ptr) {
+    *ptr = value;
     return true;
   } else {
     return false;
   }
 }
 
-bool gridpack::component::DataCollection::setValue(const char *name, const long value)
+bool gridpack::component::DataCollection::setValue(const int key, const long value)
 {
-  std::string str = name;
-#ifdef OLD_MAP
-  std::map<std::string, long>::iterator it;
-#else
-  boost::unordered_map<std::string, long>::iterator it;
-#endif
-  it = p_longs.find(str);
-  if (it != p_longs.end()) {
-    it->second = value;
+  long *ptr = findValue(p_longs, key);
+  if (ptr) {
+    *ptr = value;
     return true;
   } else {
     return false;
   }
 }
 
-bool gridpack::component::DataCollection::setValue(const char *name, const bool value)
+bool gridpack::component::DataCollection::setValue(const int key, const bool value)
 {
-  std::string str = name;
-#ifdef OLD_MAP
-  std::map<std::string, bool>::iterator it;
-#else
-  boost::unordered_map<std::string, bool>::iterator it;
-#endif
-  it = p_bools.find(str);
-  if (it != p_bools.end()) {
-    it->second = value;
+  bool *ptr = findValue(p_bools, key);
+  if (ptr) {
+    *ptr = value;
     return true;
   } else {
     return false;
   }
 }
 
-bool gridpack::component::DataCollection::setValue(const char *name, const char *value)
+bool gridpack::component::DataCollection::setValue(const int key, const char *value)
 {
-  std::string str = name;
-  std::string val = value;
-#ifdef OLD_MAP
-  std::map<std::string, std::string>::iterator it;
-#else
-  boost::unordered_map<std::string, std::string>::iterator it;
-#endif
-  it = p_strings.find(str);
-  if (it != p_strings.end()) {
-    it->second = val;
+  std::string *ptr = findValue(p_strings, key);
+  if (ptr) {
+    *ptr = value;
     return true;
   } else {
     return false;
   }
 }
 
-bool gridpack::component::DataCollection::setValue(const char *name, const float value)
+bool gridpack::component::DataCollection::setValue(const int key, const float value)
 {
-  std::string str = name;
-#ifdef OLD_MAP
-  std::map<std::string, float>::iterator it;
-#else
-  boost::unordered_map<std::string, float>::iterator it;
-#endif
-  it = p_floats.find(str);
-  if (it != p_floats.end()) {
-    it->second = value;
+  float *ptr = findValue(p_floats, key);
+  if (ptr) {
+    *ptr = value;
     return true;
   } else {
     return false;
   }
 }
 
-bool gridpack::component::DataCollection::setValue(const char *name, const double value)
+bool gridpack::component::DataCollection::setValue(const int key, const double value)
 {
-  std::string str = name;
-#ifdef OLD_MAP
-  std::map<std::string, double>::iterator it;
-#else
-  boost::unordered_map<std::string, double>::iterator it;
-#endif
-  it = p_doubles.find(str);
-  if (it != p_doubles.end()) {
-    it->second = value;
+  double *ptr = findValue(p_doubles, key);
+  if (ptr) {
+    *ptr = value;
     return true;
   } else {
     return false;
   }
 }
 
-bool gridpack::component::DataCollection::setValue(const char *name, const gridpack::ComplexType value)
+bool gridpack::component::DataCollection::setValue(const int key, const gridpack::ComplexType value)
 {
-  std::string str = name;
-#ifdef OLD_MAP
-  std::map<std::string, gridpack::ComplexType>::iterator it;
-#else
-  boost::unordered_map<std::string, gridpack::ComplexType>::iterator it;
-#endif
-  it = p_complexType.find(str);
-  if (it != p_complexType.end()) {
-    it->second = value;
+  gridpack::ComplexType *ptr = findValue(p_complexType, key);
+  if (ptr) {
+    *ptr = value;
     return true;
   } else {
     return false;
   }
 }
 
+/**
+ *  Modify current value of existing data element in
+ *  DataCollection object
+ *  @param name name of data element
+ *  @param value new value of data element
+ *  @return false if no element of the correct name and type exists in
+ *  DataCollection object
+ */
+bool gridpack::component::DataCollection::setValue(const char *name, const int value)
+{
+  return setValue(p_findKey(name), value);
+}
+
+bool gridpack::component::DataCollection::setValue(const char *name, const long value)
+{
+  return setValue(p_findKey(name), value);
+}
+
+bool gridpack::component::DataCollection::setValue(const char *name, const bool value)
+{
+  return setValue(p_findKey(name), value);
+}
+
+bool gridpack::component::DataCollection::setValue(const char *name, const char *value)
+{
+  return setValue(p_findKey(name), value);
+}
+
+bool gridpack::component::DataCollection::setValue(const char *name, const float value)
+{
+  return setValue(p_findKey(name), value);
+}
+
+bool gridpack::component::DataCollection::setValue(const char *name, const double value)
+{
+  return setValue(p_findKey(name), value);
+}
+
+bool gridpack::component::DataCollection::setValue(const char *name, const gridpack::ComplexType value)
+{
+  return setValue(p_findKey(name), value);
+}
+
 /**
  *  Modify current value of existing data element in
  *  DataCollection object. Assume that name appears in DataCollection with an
@@ -313,152 +667,123 @@ bool gridpack::component::DataCollection::setValue(const char *name, const gridp
 bool gridpack::component::DataCollection::setValue(const char *name, const int value,
     const int idx)
 {
-  std::string str = name;
-  str.append(":");
-  char buf[8];
-  sprintf(buf,"%d",idx);
-  str.append(buf);
-#ifdef OLD_MAP
-  std::map<std::string, int>::iterator it;
-#else
-  boost::unordered_map<std::string, int>::iterator it;
-#endif
-  it = p_ints.find(str);
-  if (it != p_ints.end()) {
-    it->second = value;
+  return setValue(p_findKey(name,idx), value);
+}
+
+bool gridpack::component::DataCollection::setValue(const char *name, const long value,
+    const int idx)
+{
+  return setValue(p_findKey(name,idx), value);
+}
+
+bool gridpack::component::DataCollection::setValue(const char *name, const bool value,
+    const int idx)
+{
+  return setValue(p_findKey(name,idx), value);
+}
+
+bool gridpack::component::DataCollection::setValue(const char *name, const char *value,
+    const int idx)
+{
+  return setValue(p_findKey(name,idx), value);
+}
+
+bool gridpack::component::DataCollection::setValue(const char *name, const float value,
+    const int idx)
+{
+  return setValue(p_findKey(name,idx), value);
+}
+
+bool gridpack::component::DataCollection::setValue(const char *name, const double value,
+    const int idx)
+{
+  return setValue(p_findKey(name,idx), value);
+}
+
+bool gridpack::component::DataCollection::setValue(const char *name, const gridpack::ComplexType value,
+    const int idx)
+{
+  return setValue(p_findKey(name,idx), value);
+}
+
+/**
+ *  Retrieve current value of existing data element using a key from key()
+ *  @param key key of data element
+ *  @param value current value of data element
+ *  @return false if no element of the correct key and type exists in
+ *  DataCollection object
+ */
+bool gridpack::component::DataCollection::getValue(const int key, int *value)
+{
+  int *ptr = findValue(p_ints, key);
+  if (ptr) {
+    *value = *ptr;
     return true;
   } else {
     return false;
   }
 }
 
-bool gridpack::component::DataCollection::setValue(const char *name, const long value,
-    const int idx)
+bool gridpack::component::DataCollection::getValue(const int key, long *value)
 {
-  std::string str = name;
-  str.append(":");
-  char buf[8];
-  sprintf(buf,"%d",idx);
-  str.append(buf);
-#ifdef OLD_MAP
-  std::map<std::string, long>::iterator it;
-#else
-  boost::unordered_map<std::string, long>::iterator it;
-#endif
-  it = p_longs.find(str);
-  if (it != p_longs.end()) {
-    it->second = value;
+  long *ptr = findValue(p_longs, key);
+  if (ptr) {
+    *value = *ptr;
     return true;
   } else {
     return false;
   }
 }
 
-bool gridpack::component::DataCollection::setValue(const char *name, const bool value,
-    const int idx)
+bool gridpack::component::DataCollection::getValue(const int key, bool *value)
 {
-  std::string str = name;
-  str.append(":");
-  char buf[8];
-  sprintf(buf,"%d",idx);
-  str.append(buf);
-#ifdef OLD_MAP
-  std::map<std::string, bool>::iterator it;
-#else
-  boost::unordered_map<std::string, bool>::iterator it;
-#endif
-  it = p_bools.find(str);
-  if (it != p_bools.end()) {
-    it->second = value;
+  bool *ptr = findValue(p_bools, key);
+  if (ptr) {
+    *value = *ptr;
     return true;
   } else {
     return false;
   }
 }
 
-bool gridpack::component::DataCollection::setValue(const char *name, const char *value,
-    const int idx)
+bool gridpack::component::DataCollection::getValue(const int key, std::string *value)
 {
-  std::string str = name;
-  str.append(":");
-  char buf[8];
-  sprintf(buf,"%d",idx);
-  str.append(buf);
-  std::string val = value;
-#ifdef OLD_MAP
-  std::map<std::string, std::string>::iterator it;
-#else
-  boost::unordered_map<std::string, std::string>::iterator it;
-#endif
-  it = p_strings.find(str);
-  if (it != p_strings.end()) {
-    it->second = val;
+  std::string *ptr = findValue(p_strings, key);
+  if (ptr) {
+    *value = *ptr;
     return true;
   } else {
     return false;
   }
 }
 
-bool gridpack::component::DataCollection::setValue(const char *name, const float value,
-    const int idx)
+bool gridpack::component::DataCollection::getValue(const int key, float *value)
 {
-  std::string str = name;
-  str.append(":");
-  char buf[8];
-  sprintf(buf,"%d",idx);
-  str.append(buf);
-#ifdef OLD_MAP
-  std::map<std::string, float>::iterator it;
-#else
-  boost::unordered_map<std::string, float>::iterator it;
-#endif
-  it = p_floats.find(str);
-  if (it != p_floats.end()) {
-    it->second = value;
+  float *ptr = findValue(p_floats, key);
+  if (ptr) {
+    *value = *ptr;
     return true;
   } else {
     return false;
   }
 }
 
-bool gridpack::component::DataCollection::setValue(const char *name, const double value,
-    const int idx)
+bool gridpack::component::DataCollection::getValue(const int key, double *value)
 {
-  std::string str = name;
-  str.append(":");
-  char buf[8];
-  sprintf(buf,"%d",idx);
-  str.append(buf);
-#ifdef OLD_MAP
-  std::map<std::string, double>::iterator it;
-#else
-  boost::unordered_map<std::string, double>::iterator it;
-#endif
-  it = p_doubles.find(str);
-  if (it != p_doubles.end()) {
-    it->second = value;
+  double *ptr = findValue(p_doubles, key);
+  if (ptr) {
+    *value = *ptr;
     return true;
   } else {
     return false;
   }
 }
 
-bool gridpack::component::DataCollection::setValue(const char *name,
-    const gridpack::ComplexType value, const int idx)
+bool gridpack::component::DataCollection::getValue(const int key, gridpack::ComplexType *value)
 {
-  std::string str = name;
-  str.append(":");
-  char buf[8];
-  sprintf(buf,"%d",idx);
-  str.append(buf);
-#ifdef OLD_MAP
-  std::map<std::string, gridpack::ComplexType>::iterator it;
-#else
-  boost::unordered_map<std::string, gridpack::ComplexType>::iterator it;
-#endif
-  it = p_complexType.find(str);
-  if (it != p_complexType.end()) {
-    it->second = value;
+  gridpack::ComplexType *ptr = findValue(p_complexType, key);
+  if (ptr) {
+    *value = *ptr;
     return true;
   } else {
     return false;
@@ -475,121 +800,37 @@ bool gridpack::component::DataCollection::setValue(const char *name,
  */
 bool gridpack::component::DataCollection::getValue(const char *name, int *value)
 {
-  std::string str = name;
-#ifdef OLD_MAP
-  std::map<std::string, int>::iterator it;
-#else
-  boost::unordered_map<std::string, int>::iterator it;
-#endif
-  it = p_ints.find(str);
-  if (it != p_ints.end()) {
-    *value = it->second;
-    return true;
-  } else {
-    return false;
-  }
+  return getValue(p_findKey(name), value);
 }
 
 bool gridpack::component::DataCollection::getValue(const char *name, long *value)
 {
-  std::string str = name;
-#ifdef OLD_MAP
-  std::map<std::string, long>::iterator it;
-#else
-  boost::unordered_map<std::string, long>::iterator it;
-#endif
-  it = p_longs.find(str);
-  if (it != p_longs.end()) {
-    *value = it->second;
-    return true;
-  } else {
-    return false;
-  }
+  return getValue(p_findKey(name), value);
 }
 
 bool gridpack::component::DataCollection::getValue(const char *name, bool *value)
 {
-  std::string str = name;
-#ifdef OLD_MAP
-  std::map<std::string, bool>::iterator it;
-#else
-  boost::unordered_map<std::string, bool>::iterator it;
-#endif
-  it = p_bools.find(str);
-  if (it != p_bools.end()) {
-    *value = it->second;
-    return true;
-  } else {
-    return false;
-  }
+  return getValue(p_findKey(name), value);
 }
 
 bool gridpack::component::DataCollection::getValue(const char *name, std::string *value)
 {
-  std::string str = name;
-#ifdef OLD_MAP
-  std::map<std::string, std::string>::iterator it;
-#else
-  boost::unordered_map<std::string, std::string>::iterator it;
-#endif
-  it = p_strings.find(str);
-  if (it != p_strings.end()) {
-    *value = it->second;
-    return true;
-  } else {
-    return false;
-  }
+  return getValue(p_findKey(name), value);
 }
 
 bool gridpack::component::DataCollection::getValue(const char *name, float *value)
 {
-  std::string str = name;
-#ifdef OLD_MAP
-  std::map<std::string, float>::iterator it;
-#else
-  boost::unordered_map<std::string, float>::iterator it;
-#endif
-  it = p_floats.find(str);
-  if (it != p_floats.end()) {
-    *value = it->second;
-    return true;
-  } else {
-    return false;
-  }
+  return getValue(p_findKey(name), value);
 }
 
 bool gridpack::component::DataCollection::getValue(const char *name, double *value)
 {
-  std::string str = name;
-#ifdef OLD_MAP
-  std::map<std::string, double>::iterator it;
-#else
-  boost::unordered_map<std::string, double>::iterator it;
-#endif
-  it = p_doubles.find(str);
-  if (it != p_doubles.end()) {
-    *value = it->second;
-    return true;
-  } else {
-    return false;
-  }
+  return getValue(p_findKey(name), value);
 }
 
 bool gridpack::component::DataCollection::getValue(const char *name, gridpack::ComplexType *value)
 {
-  std::string str = name;
-#ifdef OLD_MAP
-  std::map<std::string, gridpack::ComplexType>::iterator it;
-#else
-  boost::unordered_map<std::string, gridpack::ComplexType>::iterator it;
-#endif
-  it = p_complexType.find(str);
-  if (it != p_complexType.end()) {
-    *value = it->second;
-    return true;
-  } else {
-    return false;
-  }
+  return getValue(p_findKey(name), value);
 }
 
 /**
@@ -605,155 +846,43 @@ bool gridpack::component::DataCollection::getValue(const char *name, gridpack::C
 bool gridpack::component::DataCollection::getValue(const char *name, int *value,
     const int idx)
 {
-  std::string str = name;
-  str.append(":");
-  char buf[8];
-  sprintf(buf,"%d",idx);
-  str.append(buf);
-#ifdef OLD_MAP
-  std::map<std::string, int>::iterator it;
-#else
-  boost::unordered_map<std::string, int>::iterator it;
-#endif
-  it = p_ints.find(str);
-  if (it != p_ints.end()) {
-    *value = it->second;
-    return true;
-  } else {
-    return false;
-  }
+  return getValue(p_findKey(name,idx), value);
 }
 
 bool gridpack::component::DataCollection::getValue(const char *name, long *value,
     const int idx)
 {
-  std::string str = name;
-  str.append(":");
-  char buf[8];
-  sprintf(buf,"%d",idx);
-  str.append(buf);
-#ifdef OLD_MAP
-  std::map<std::string, long>::iterator it;
-#else
-  boost::unordered_map<std::string, long>::iterator it;
-#endif
-  it = p_longs.find(str);
-  if (it != p_longs.end()) {
-    *value = it->second;
-    return true;
-  } else {
-    return false;
-  }
+  return getValue(p_findKey(name,idx), value);
 }
 
 bool gridpack::component::DataCollection::getValue(const char *name, bool *value,
     const int idx)
 {
-  std::string str = name;
-  str.append(":");
-  char buf[8];
-  sprintf(buf,"%d",idx);
-  str.append(buf);
-#ifdef OLD_MAP
-  std::map<std::string, bool>::iterator it;
-  it = p_bools.find(str);
-#else
-  boost::unordered_map<std::string, bool>::iterator it;
-#endif
-  if (it != p_bools.end()) {
-    *value = it->second;
-    return true;
-  } else {
-    return false;
-  }
+  return getValue(p_findKey(name,idx), value);
 }
 
 bool gridpack::component::DataCollection::getValue(const char *name, std::string *value,
     const int idx)
 {
-  std::string str = name;
-  str.append(":");
-  char buf[8];
-  sprintf(buf,"%d",idx);
-  str.append(buf);
-#ifdef OLD_MAP
-  std::map<std::string, std::string>::iterator it;
-#else
-  boost::unordered_map<std::string, std::string>::iterator it;
-#endif
-  it = p_strings.find(str);
-  if (it != p_strings.end()) {
-    *value = it->second;
-    return true;
-  } else {
-    return false;
-  }
+  return getValue(p_findKey(name,idx), value);
 }
 
 bool gridpack::component::DataCollection::getValue(const char *name, float *value,
     const int idx)
 {
-  std::string str = name;
-  str.append(":");
-  char buf[8];
-  sprintf(buf,"%d",idx);
-  str.append(buf);
-#ifdef OLD_MAP
-  std::map<std::string, float>::iterator it;
-#else
-  boost::unordered_map<std::string, float>::iterator it;
-#endif
-  it = p_floats.find(str);
-  if (it != p_floats.end()) {
-    *value = it->second;
-    return true;
-  } else {
-    return false;
-  }
+  return getValue(p_findKey(name,idx), value);
 }
 
 bool gridpack::component::DataCollection::getValue(const char *name, double *value,
     const int idx)
 {
-  std::string str = name;
-  str.append(":");
-  char buf[8];
-  sprintf(buf,"%d",idx);
-  str.append(buf);
-#ifdef OLD_MAP
-  std::map<std::string, double>::iterator it;
-#else
-  boost::unordered_map<std::string, double>::iterator it;
-#endif
-  it = p_doubles.find(str);
-  if (it != p_doubles.end()) {
-    *value = it->second;
-    return true;
-  } else {
-    return false;
-  }
+  return getValue(p_findKey(name,idx), value);
 }
 
-bool gridpack::component::DataCollection::getValue(const char *name,
-    gridpack::ComplexType *value, const int idx)
+bool gridpack::component::DataCollection::getValue(const char *name, gridpack::ComplexType *value,
+    const int idx)
 {
-  std::string str = name;
-  str.append(":");
-  char buf[8];
-  sprintf(buf,"%d",idx);
-  str.append(buf);
-#ifdef OLD_MAP
-  std::map<std::string, gridpack::ComplexType>::iterator it;
-#else
-  boost::unordered_map<std::string, gridpack::ComplexType>::iterator it;
-#endif
-  it = p_complexType.find(str);
-  if (it != p_complexType.end()) {
-    *value = it->second;
-    return true;
-  } else {
-    return false;
-  }
+  return getValue(p_findKey(name,idx), value);
 }
 
 /**
@@ -762,95 +891,38 @@ bool gridpack::component::DataCollection::getValue(const char *name,
 void gridpack::component::DataCollection::dump(void)
 {
   // print out integers
-#ifdef OLD_MAP
-  std::map<std::string, int>::iterator int_it;
-#else
-  boost::unordered_map<std::string, int>::iterator int_it;
-#endif
-  int_it = p_ints.begin();
-  int i = 0;
-  while (int_it != p_ints.end()) {
-    std::string key = int_it->first;
-    int ival = int_it->second;
-    std::cout << "  (INTEGER) key: "<<key<<" value: "<<ival<<std::endl;
-    int_it++;
+  std::vector<std::pair<int, int> >::iterator int_it;
+  for (int_it = p_ints.begin(); int_it != p_ints.end(); int_it++) {
+    std::cout << "  (INTEGER) key: "<<keyName(int_it->first)<<" value: "<<int_it->second<<std::endl;
   }
   // print out longs
-#ifdef OLD_MAP
-  std::map<std::string, long>::iterator long_it;
-#else
-  boost::unordered_map<std::string, long>::iterator long_it;
-#endif
-  long_it = p_longs.begin();
-  while (long_it != p_longs.end()) {
-    std::string key = long_it->first;
-    long lval = long_it->second;
-    std::cout << "  (LONG) key: "<<key<<" value: "<<lval<<std::endl;
-    long_it++;
+  std::vector<std::pair<int, long> >::iterator long_it;
+  for (long_it = p_longs.begin(); long_it != p_longs.end(); long_it++) {
+    std::cout << "  (LONG) key: "<<keyName(long_it->first)<<" value: "<<long_it->second<<std::endl;
   }
   // print out bools
-#ifdef OLD_MAP
-  std::map<std::string, bool>::iterator bool_it;
-#else
-  boost::unordered_map<std::string, bool>::iterator bool_it;
-#endif
-  bool_it = p_bools.begin();
-  while (bool_it != p_bools.end()) {
-    std::string key = bool_it->first;
-    bool bval = bool_it->second;
-    std::cout << "  (BOOL) key: "<<key<<" value: "<<bval<<std::endl;
-    bool_it++;
+  std::vector<std::pair<int, bool> >::iterator bool_it;
+  for (bool_it = p_bools.begin(); bool_it != p_bools.end(); bool_it++) {
+    std::cout << "  (BOOL) key: "<<keyName(bool_it->first)<<" value: "<<bool_it->second<<std::endl;
   }
   // print out strings
-#ifdef OLD_MAP
-  std::map<std::string, std::string>::iterator str_it;
-#else
-  boost::unordered_map<std::string, std::string>::iterator str_it;
-#endif
-  str_it = p_strings.begin();
-  while (str_it != p_strings.end()) {
-    std::string key = str_it->first;
-    std::string sval = str_it->second;
-    std::cout << "  (STRING) key: "<<key<<" value: "<<sval<<std::endl;
-    str_it++;
+  std::vector<std::pair<int, std::string> >::iterator str_it;
+  for (str_it = p_strings.begin(); str_it != p_strings.end(); str_it++) {
+    std::cout << "  (STRING) key: "<<keyName(str_it->first)<<" value: "<<str_it->second<<std::endl;
   }
   // print out floats
-#ifdef OLD_MAP
-  std::map<std::string, float>::iterator flt_it;
-#else
-  boost::unordered_map<std::string, float>::iterator flt_it;
-#endif
-  flt_it = p_floats.begin();
-  while (flt_it != p_floats.end()) {
-    std::string key = flt_it->first;
-    float fval = flt_it->second;
-    std::cout << "  (FLOAT) key: "<<key<<" value: "<<fval<<std::endl;
-    flt_it++;
+  std::vector<std::pair<int, float> >::iterator flt_it;
+  for (flt_it = p_floats.begin(); flt_it != p_floats.end(); flt_it++) {
+    std::cout << "  (FLOAT) key: "<<keyName(flt_it->first)<<" value: "<<flt_it->second<<std::endl;
   }
   // print out doubles
-#ifdef OLD_MAP
-  std::map<std::string, double>::iterator dbl_it;
-#else
-  boost::unordered_map<std::string, double>::iterator dbl_it;
-#endif
-  dbl_it = p_doubles.begin();
-  while (dbl_it != p_doubles.end()) {
-    std::string key = dbl_it->first;
-    double dval = dbl_it->second;
-    std::cout << "  (DOUBLE) key: "<<key<<" value: "<<dval<<std::endl;
-    dbl_it++;
+  std::vector<std::pair<int, double> >::iterator dbl_it;
+  for (dbl_it = p_doubles.begin(); dbl_it != p_doubles.end(); dbl_it++) {
+    std::cout << "  (DOUBLE) key: "<<keyName(dbl_it->first)<<" value: "<<dbl_it->second<<std::endl;
   }
   // print out complex
-#ifdef OLD_MAP
-  std::map<std::string, gridpack::ComplexType>::iterator cmplx_it;
-#else
-  boost::unordered_map<std::string, gridpack::ComplexType>::iterator cmplx_it;
-#endif
-  cmplx_it = p_complexType.begin();
-  while (cmplx_it != p_complexType.end()) {
-    std::string key = cmplx_it->first;
-    ComplexType cval = cmplx_it->second;
-    std::cout << "  (COMPLEX) key: "<<key<<" value: "<<cval<<std::endl;
-    cmplx_it++;
+  std::vector<std::pair<int, gridpack::ComplexType> >::iterator cmplx_it;
+  for (cmplx_it = p_complexType.begin(); cmplx_it != p_complexType.end(); cmplx_it++) {
+    std::cout << "  (COMPLEX) key: "<<keyName(cmplx_it->first)<<" value: "<<cmplx_it->second<<std::endl;
   }
 }
@@ -6,15 +6,14 @@
 #ifndef _data_collection_h
 #define _data_collection_h
 
-#define OLD_MAP
-
-#ifndef OLD_MAP
-#include <boost/unordered_map.hpp>
-#endif
+#include <algorithm>
 #include <map>
 #include <string>
+#include <vector>
+#include <utility>
 #include <boost/serialization/map.hpp>
 #include <boost/serialization/string.hpp>
+#include <boost/serialization/split_member.hpp>
 
 #include "gridpack/utilities/complex.hpp"
 
@@ -139,44 +138,223 @@ public:
   bool getValue(const char *name, double *value, const int idx);
   bool getValue(const char *name, gridpack::ComplexType *value, const int idx);
 
+  /**
+   * Get the integer key used to store a data element. Keys are
+   * assigned the first time a name is seen and are shared by all
+   * DataCollection objects on this process, so they can be looked up
+   * once (e.g. in a static variable) and reused. Keys are not the same
+   * on different processes.
+   * @param name name of data element
+   * @return key for name
+   */
+  static int key(const char *name);
+
+  /**
+   * Get the integer key used to store a data element with an index.
+   * This is the same key as the name "name:idx"
+   * @param name name of data element
+   * @param idx index of data element
+   * @return key for name and index
+   */
+  static int key(const char *name, const int idx);
+
+  /**
+   * Get the name of a data element from its key
+   * @param key key returned by key()
+   * @return name of data element
+   */
+  static std::string keyName(const int key);
+
+  /**
+   * Get the number of keys that have been assigned on this process. Keys
+   * run from 0 to numKeys()-1
+   * @return number of keys
+   */
+  static int numKeys(void);
+
+  /**
+   * Append the contents of the collection to a binary buffer. Values are
+   * written with the keys used on this process, so the buffer must be
+   * read with a table that maps these keys to keys on the reading process
+   * @param buf buffer that contents are appended to
+   */
+  void pack(std::vector<char> &buf) const;
+
+  /**
+   * Replace the contents of the collection with values from a buffer
+   * written by pack. Throws an exception if the buffer ends before the
+   * packed collection or contains an unknown key
+   * @param buf start of packed collection
+   * @param end end of buffer
+   * @param keys keys on this process indexed by the key used when the
+   * buffer was written
+   * @return pointer to the first byte after the packed collection
+   */
+  const char* unpack(const char *buf, const char *end,
+      const std::vector<int> &keys);
+
+  /**
+   *  Add variables to DataCollection object using a key from key()
+   *  @param key key of data element
+   *  @param value value of data element
+   */
+  void addValue(const int key, const int value);
+  void addValue(const int key, const long value);
+  void addValue(const int key, const bool value);
+  void addValue(const int key, const char *value);
+  void addValue(const int key, const float value);
+  void addValue(const int key, const double value);
+  void addValue(const int key, const gridpack::ComplexType value);
+
+  /**
+   *  Modify current value of existing data element using a key from key()
+   *  @param key key of data element
+   *  @param value new value of data element
+   *  @return false if no element of the correct key and type exists in
+   *  DataCollection object
+   */
+  bool setValue(const int key, const int value);
+  bool setValue(const int key, const long value);
+  bool setValue(const int key, const bool value);
+  bool setValue(const int key, const char *value);
+  bool setValue(const int key, const float value);
+  bool setValue(const int key, const double value);
+  bool setValue(const int key, const gridpack::ComplexType value);
+
+  /**
+   *  Retrieve current value of existing data element using a key from key()
+   *  @param key key of data element
+   *  @param value current value of data element
+   *  @return false if no element of the correct key and type exists in
+   *  DataCollection object
+   */
+  bool getValue(const int key, int *value);
+  bool getValue(const int key, long *value);
+  bool getValue(const int key, bool *value);
+  bool getValue(const int key, std::string *value);
+  bool getValue(const int key, float *value);
+  bool getValue(const int key, double *value);
+  bool getValue(const int key, gridpack::ComplexType *value);
+
   /**
    * Dump contents of data collection to standard out
    */
   void dump(void);
 private:
-#ifdef OLD_MAP
-  std::map<std::string, int> p_ints; 
-  std::map<std::string, long> p_longs; 
-  std::map<std::string, bool> p_bools; 
-  std::map<std::string, std::string> p_strings; 
-  std::map<std::string, float> p_floats; 
-  std::map<std::string, double> p_doubles; 
-  std::map<std::string, gridpack::ComplexType> p_complexType; 
-#else
-  boost::unordered_map<std::string, int> p_ints; 
-  boost::unordered_map<std::string, long> p_longs; 
-  boost::unordered_map<std::string, bool> p_bools; 
-  boost::unordered_map<std::string, std::string> p_strings; 
-  boost::unordered_map<std::string, float> p_floats; 
-  boost::unordered_map<std::string, double> p_doubles; 
-  boost::unordered_map<std::string, gridpack::ComplexType> p_complexType; 
-#endif
+  /**
+   * Find the key for a name without creating a new one
+   * @param name name of data element
+   * @return key for name or -1 if name has never been used
+   */
+  static int p_findKey(const char *name);
+  static int p_findKey(const char *name, const int idx);
+
+  // Values are stored in vectors sorted by key
+  std::vector<std::pair<int, int> > p_ints; 
+  std::vector<std::pair<int, long> > p_longs; 
+  std::vector<std::pair<int, bool> > p_bools; 
+  std::vector<std::pair<int, std::string> > p_strings; 
+  std::vector<std::pair<int, float> > p_floats; 
+  std::vector<std::pair<int, double> > p_doubles; 
+  std::vector<std::pair<int, gridpack::ComplexType> > p_complexType; 
 
 private:
   friend class boost::serialization::access;
 
-  /// Serialization method
-  template<class Archive> void serialize(Archive &ar, const unsigned int)
+  /**
+   * Keys are only valid on the process that created them, so values are
+   * serialized using their names
+   */
+  template <typename T> static void
+  p_toNames(const std::vector<std::pair<int, T> > &values,
+            std::map<std::string, T> &named)
+  {
+    typename std::vector<std::pair<int, T> >::const_iterator it;
+    for (it = values.begin(); it != values.end(); it++) {
+      named.insert(std::pair<std::string, T>(keyName(it->first), it->second));
+    }
+  }
+
+  template <typename T> static void
+  p_fromNames(const std::map<std::string, T> &named,
+              std::vector<std::pair<int, T> > &values)
   {
-    ar & p_ints
-      & p_longs
-      & p_bools
-      & p_strings
-      & p_floats
-      & p_doubles
-      & p_complexType;
+    typename std::map<std::string, T>::const_iterator it;
+    values.clear();
+    values.reserve(named.size());
+    for (it = named.begin(); it != named.end(); it++) {
+      values.push_back(std::pair<int, T>(key(it->first.c_str()), it->second));
+    }
+    p_sort(values);
   }
 
+  /// Compare keys of two values
+  template <typename T> static bool
+  p_keyLess(const std::pair<int, T> &a, const std::pair<int, T> &b)
+  {
+    return a.first < b.first;
+  }
+
+  /// Sort values by key
+  template <typename T> static void
+  p_sort(std::vector<std::pair<int, T> > &values)
+  {
+    std::sort(values.begin(), values.end(), p_keyLess<T>);
+  }
+
+  /// Serialization methods
+  template<class Archive> void save(Archive &ar, const unsigned int) const
+  {
+    std::map<std::string, int> ints; 
+    std::map<std::string, long> longs; 
+    std::map<std::string, bool> bools; 
+    std::map<std::string, std::string> strings; 
+    std::map<std::string, float> floats; 
+    std::map<std::string, double> doubles; 
+    std::map<std::string, gridpack::ComplexType> complexType; 
+    p_toNames(p_ints, ints);
+    p_toNames(p_longs, longs);
+    p_toNames(p_bools, bools);
+    p_toNames(p_strings, strings);
+    p_toNames(p_floats, floats);
+    p_toNames(p_doubles, doubles);
+    p_toNames(p_complexType, complexType);
+    ar & ints
+      & longs
+      & bools
+      & strings
+      & floats
+      & doubles
+      & complexType;
+  }
+
+  template<class Archive> void load(Archive &ar, const unsigned int)
+  {
+    std::map<std::string, int> ints; 
+    std::map<std::string, long> longs; 
+    std::map<std::string, bool> bools; 
+    std::map<std::string, std::string> strings; 
+    std::map<std::string, float> floats; 
+    std::map<std::string, double> doubles; 
+    std::map<std::string, gridpack::ComplexType> complexType; 
+    ar & ints
+      & longs
+      & bools
+      & strings
+      & floats
+      & doubles
+      & complexType;
+    p_fromNames(ints, p_ints);
+    p_fromNames(longs, p_longs);
+    p_fromNames(bools, p_bools);
+    p_fromNames(strings, p_strings);
+    p_fromNames(floats, p_floats);
+    p_fromNames(doubles, p_doubles);
+    p_fromNames(complexType, p_complexType);
+  }
+
+  BOOST_SERIALIZATION_SPLIT_MEMBER()
+
 };
 
 
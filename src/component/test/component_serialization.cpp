@@ -275,6 +275,39 @@ BOOST_AUTO_TEST_CASE( DataCollection_bin )
   check_data_collection(key, *dcin, *dcout);
 }
 
+BOOST_AUTO_TEST_CASE( DataCollection_keys )
+{
+  gridpack::component::DataCollection dc;
+  int key(gridpack::component::DataCollection::key("key name"));
+  int ikey(gridpack::component::DataCollection::key("key name", 2));
+
+  // indexed names are the same as "name:idx"
+  BOOST_CHECK_EQUAL(ikey, gridpack::component::DataCollection::key("key name:2"));
+  BOOST_CHECK_EQUAL(gridpack::component::DataCollection::keyName(ikey),
+                    std::string("key name:2"));
+
+  double dval;
+  int ival;
+  dc.addValue(key, 1.5);
+  dc.addValue("key name", 4, 2);
+  BOOST_CHECK(dc.getValue("key name", &dval));
+  BOOST_CHECK_CLOSE(dval, 1.5, delta);
+  BOOST_CHECK(dc.getValue(ikey, &ival));
+  BOOST_CHECK_EQUAL(ival, 4);
+  BOOST_CHECK(dc.getValue("key name:2", &ival));
+  BOOST_CHECK_EQUAL(ival, 4);
+  BOOST_CHECK(!dc.getValue(key, &ival));
+  BOOST_CHECK(!dc.getValue("not a key name", &dval));
+
+  // adding an existing element does not change it
+  dc.addValue(key, 2.5);
+  dc.getValue(key, &dval);
+  BOOST_CHECK_CLOSE(dval, 1.5, delta);
+  BOOST_CHECK(dc.setValue(key, 2.5));
+  dc.getValue("key name", &dval);
+  BOOST_CHECK_CLOSE(dval, 2.5, delta);
+}
+
 BOOST_AUTO_TEST_CASE( DataCollection_mpi )
 {
   gridpack::parallel::Communicator comm;
@@ -0,0 +1,300 @@
+// -------------------------------------------------------------
+/*
+ *     Copyright (c) 2013 Battelle Memorial Institute
+ *     Licensed under modified BSD License. A copy of this license can be found
+ *     in the LICENSE file in the top level directory of this distribution.
+ */
+// -------------------------------------------------------------
+// -------------------------------------------------------------
+/**
+ * @file   compiled_expression.cpp
+ *
+ * @brief  Compile Expression trees into canonical sparse form
+ */
+// -------------------------------------------------------------
+
+#include <cmath>
+#include <boost/foreach.hpp>
+#include <boost/format.hpp>
+
+#include "gridpack/utilities/exception.hpp"
+#include "functions.hpp"
+#include "compiled_expression.hpp"
+
+namespace gridpack {
+namespace optimization {
+
+// -------------------------------------------------------------
+//  class ExpressionCompiler
+// -------------------------------------------------------------
+/// Accumulate the terms of an expression tree
+class ExpressionCompiler
+  : public ExpressionVisitor,
+    public CompiledExpressionBuilder
+{
+public:
+
+  /// Default constructor.
+  ExpressionCompiler(void)
+    : ExpressionVisitor(), CompiledExpressionBuilder(), p_scale(1.0)
+  {}
+
+  /// Destructor
+  ~ExpressionCompiler(void)
+  {}
+
+  void visit(IntegerConstant& e)
+  {
+    p_constant += p_scale*e.value();
+  }
+
+  void visit(RealConstant& e)
+  {
+    p_constant += p_scale*e.value();
+  }
+
+  void visit(VariableExpression& e)
+  {
+    p_linear[e.var()] += p_scale;
+  }
+
+  void visit(UnaryMinus& e)
+  {
+    p_scale = -p_scale;
+    e.rhs()->accept(*this);
+    p_scale = -p_scale;
+  }
+
+  void visit(UnaryPlus& e)
+  {
+    e.rhs()->accept(*this);
+  }
+
+  void visit(Addition& e)
+  {
+    e.lhs()->accept(*this);
+    e.rhs()->accept(*this);
+  }
+
+  void visit(Subtraction& e)
+  {
+    e.lhs()->accept(*this);
+    p_scale = -p_scale;
+    e.rhs()->accept(*this);
+    p_scale = -p_scale;
+  }
+
+  void visit(Multiplication& e)
+  {
+    ExpressionCompiler l, r;
+    e.lhs()->accept(l);
+    e.rhs()->accept(r);
+    p_multiply(e, l, r);
+  }
+
+  void visit(Division& e)
+  {
+    ExpressionCompiler l, r;
+    e.lhs()->accept(l);
+    e.rhs()->accept(r);
+    if (!r.constant() || r.p_constant == 0.0) {
+      p_unsupported(e);
+    }
+    this->add(l, p_scale/r.p_constant);
+  }
+
+  void visit(Exponentiation& e)
+  {
+    ExpressionCompiler l, r;
+    e.lhs()->accept(l);
+    e.rhs()->accept(r);
+    if (!r.constant()) {
+      p_unsupported(e);
+    }
+    double x(r.p_constant);
+    if (l.constant()) {
+      p_constant += p_scale*pow(l.p_constant, x);
+    } else if (x == 0.0) {
+      p_constant += p_scale;
+    } else if (x == 1.0) {
+      this->add(l, p_scale);
+    } else if (x == 2.0) {
+      p_multiply(e, l, l);
+    } else {
+      p_unsupported(e);
+    }
+  }
+
+  void visit(Constraint& e)
+  {
+    if (!p_op.empty()) {
+      p_unsupported(e);
+    }
+    this->constraint(e.op(), e.name());
+    e.lhs()->accept(*this);
+    p_scale = -p_scale;
+    e.rhs()->accept(*this);
+    p_scale = -p_scale;
+  }
+
+  void visit(Function& e)
+  {
+    p_unsupported(e);
+  }
+
+protected:
+
+  /// Factor applied to everything currently being visited
+  double p_scale;
+
+  /// Add the product of two compiled expressions
+  void p_multiply(Expression& e,
+                  const ExpressionCompiler& l, const ExpressionCompiler& r)
+  {
+    if (l.constant()) {
+      this->add(r, p_scale*l.p_constant);
+      return;
+    }
+    if (r.constant()) {
+      this->add(l, p_scale*r.p_constant);
+      return;
+    }
+    if (!l.p_quadratic.empty() || !r.p_quadratic.empty()) {
+      p_unsupported(e);
+    }
+    p_constant += p_scale*l.p_constant*r.p_constant;
+    BOOST_FOREACH(const LinearMap::value_type& i, l.p_linear) {
+      p_linear[i.first] += p_scale*i.second*r.p_constant;
+    }
+    BOOST_FOREACH(const LinearMap::value_type& j, r.p_linear) {
+      p_linear[j.first] += p_scale*l.p_constant*j.second;
+    }
+    BOOST_FOREACH(const LinearMap::value_type& i, l.p_linear) {
+      BOOST_FOREACH(const LinearMap::value_type& j, r.p_linear) {
+        this->addQuadratic(i.first, j.first, p_scale*i.second*j.second);
+      }
+    }
+  }
+
+  /// Report a term that cannot be compiled
+  void p_unsupported(Expression& e)
+  {
+    std::string msg =
+      boost::str(boost::format("compile: cannot compile expression term: %s") %
+                 e.render());
+    throw gridpack::Exception(msg);
+  }
+};
+
+// -------------------------------------------------------------
+//  class CompiledExpression
+// -------------------------------------------------------------
+
+// -------------------------------------------------------------
+// CompiledExpression:: constructors / destructor
+// -------------------------------------------------------------
+CompiledExpression::CompiledExpression(void)
+  : utility::Uncopyable(), p_constant(0.0)
+{}
+
+CompiledExpression::~CompiledExpression(void)
+{}
+
+// -------------------------------------------------------------
+//  class CompiledExpressionBuilder
+// -------------------------------------------------------------
+
+// -------------------------------------------------------------
+// CompiledExpressionBuilder:: constructors / destructor
+// -------------------------------------------------------------
+CompiledExpressionBuilder::CompiledExpressionBuilder(void)
+  : p_constant(0.0), p_linear(), p_quadratic(), p_op(), p_name()
+{}
+
+CompiledExpressionBuilder::~CompiledExpressionBuilder(void)
+{}
+
+// -------------------------------------------------------------
+// CompiledExpressionBuilder::addQuadratic
+// -------------------------------------------------------------
+void
+CompiledExpressionBuilder::addQuadratic(const VariablePtr& v1,
+                                        const VariablePtr& v2,
+                                        const double& coef)
+{
+  VariableOrder less;
+  if (less(v2, v1)) {
+    p_quadratic[VariablePair(v2, v1)] += coef;
+  } else {
+    p_quadratic[VariablePair(v1, v2)] += coef;
+  }
+}
+
+// -------------------------------------------------------------
+// CompiledExpressionBuilder::add
+// -------------------------------------------------------------
+void
+CompiledExpressionBuilder::add(const CompiledExpression& c,
+                               const double& factor)
+{
+  p_constant += factor*c.p_constant;
+  for (size_t i = 0; i < c.p_vars.size(); ++i) {
+    p_linear[c.p_vars[i]] += factor*c.p_coefs[i];
+  }
+  for (size_t i = 0; i < c.p_qvars1.size(); ++i) {
+    this->addQuadratic(c.p_qvars1[i], c.p_qvars2[i], factor*c.p_qcoefs[i]);
+  }
+}
+
+void
+CompiledExpressionBuilder::add(const CompiledExpressionBuilder& b,
+                               const double& factor)
+{
+  p_constant += factor*b.p_constant;
+  BOOST_FOREACH(const LinearMap::value_type& i, b.p_linear) {
+    p_linear[i.first] += factor*i.second;
+  }
+  BOOST_FOREACH(const QuadraticMap::value_type& i, b.p_quadratic) {
+    p_quadratic[i.first] += factor*i.second;
+  }
+}
+
+// -------------------------------------------------------------
+// CompiledExpressionBuilder::result
+// -------------------------------------------------------------
+CompiledExpressionPtr
+CompiledExpressionBuilder::result(void) const
+{
+  CompiledExpressionPtr c(new CompiledExpression());
+  c->p_constant = p_constant;
+  c->p_vars.reserve(p_linear.size());
+  c->p_coefs.reserve(p_linear.size());
+  BOOST_FOREACH(const LinearMap::value_type& i, p_linear) {
+    if (i.second == 0.0) continue;
+    c->p_vars.push_back(i.first);
+    c->p_coefs.push_back(i.second);
+  }
+  BOOST_FOREACH(const QuadraticMap::value_type& i, p_quadratic) {
+    if (i.second == 0.0) continue;
+    c->p_qvars1.push_back(i.first.first);
+    c->p_qvars2.push_back(i.first.second);
+    c->p_qcoefs.push_back(i.second);
+  }
+  c->p_op = p_op;
+  c->p_name = p_name;
+  return c;
+}
+
+// -------------------------------------------------------------
+// compile
+// -------------------------------------------------------------
+CompiledExpressionPtr
+compile(ExpressionPtr e)
+{
+  ExpressionCompiler c;
+  if (e) e->accept(c);
+  return c.result();
+}
+
+} // namespace optimization
+} // namespace gridpack
@@ -0,0 +1,276 @@
+// Emacs Mode Line: -*- Mode:c++;-*-
+// -------------------------------------------------------------
+/*
+ *     Copyright (c) 2013 Battelle Memorial Institute
+ *     Licensed under modified BSD License. A copy of this license can be found
+ *     in the LICENSE file in the top level directory of this distribution.
+ */
+// -------------------------------------------------------------
+// -------------------------------------------------------------
+/**
+ * @file   compiled_expression.hpp
+ *
+ * @brief  Flat (sparse coefficient) form of linear and quadratic
+ * expressions
+ *
+ * An Expression tree can be compiled into a constant, a list of
+ * linear terms, and a list of quadratic terms. Repeated references to
+ * the same variable (or pair of variables) are merged into a single
+ * term, and terms are ordered by variable id, so the result is the
+ * same no matter how the expression was written. Solver backends can
+ * load the resulting arrays directly instead of walking the tree.
+ */
+// -------------------------------------------------------------
+
+#ifndef _compiled_expression_hpp_
+#define _compiled_expression_hpp_
+
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+#include <boost/shared_ptr.hpp>
+
+#include <gridpack/expression/expression.hpp>
+
+namespace gridpack {
+namespace optimization {
+
+class CompiledExpressionBuilder;
+
+// -------------------------------------------------------------
+//  class CompiledExpression
+// -------------------------------------------------------------
+/// A linear or quadratic expression in canonical sparse form
+/**
+ * The expression represented is
+ *
+ *   constant() + sum_i coefficients()[i]*variables()[i]
+ *     + sum_k quadraticCoefficients()[k]*
+ *         quadraticVariables1()[k]*quadraticVariables2()[k]
+ *
+ * If compiled from a Constraint, the constraint is stored as
+ * (lhs - rhs) op 0, where op is the constraint's relational operator.
+ */
+class CompiledExpression
+  : private utility::Uncopyable
+{
+public:
+
+  /// Default constructor.
+  CompiledExpression(void);
+
+  /// Destructor
+  ~CompiledExpression(void);
+
+  /// Get the constant part
+  double constant(void) const
+  {
+    return p_constant;
+  }
+
+  /// Get the variables of the linear terms
+  const std::vector<VariablePtr>& variables(void) const
+  {
+    return p_vars;
+  }
+
+  /// Get the coefficients of the linear terms
+  const std::vector<double>& coefficients(void) const
+  {
+    return p_coefs;
+  }
+
+  /// Get the first variable of each quadratic term
+  const std::vector<VariablePtr>& quadraticVariables1(void) const
+  {
+    return p_qvars1;
+  }
+
+  /// Get the second variable of each quadratic term
+  const std::vector<VariablePtr>& quadraticVariables2(void) const
+  {
+    return p_qvars2;
+  }
+
+  /// Get the coefficients of the quadratic terms
+  const std::vector<double>& quadraticCoefficients(void) const
+  {
+    return p_qcoefs;
+  }
+
+  /// Is the expression linear (no quadratic terms)?
+  bool linear(void) const
+  {
+    return p_qcoefs.empty();
+  }
+
+  /// Is this a compiled constraint?
+  bool constraint(void) const
+  {
+    return !p_op.empty();
+  }
+
+  /// Get the relational operator (empty if not a constraint)
+  const std::string& op(void) const
+  {
+    return p_op;
+  }
+
+  /// Get the constraint name (empty if not a constraint)
+  const std::string& name(void) const
+  {
+    return p_name;
+  }
+
+protected:
+
+  /// The constant part
+  double p_constant;
+
+  /// Linear term variables, ordered by id
+  std::vector<VariablePtr> p_vars;
+
+  /// Linear term coefficients
+  std::vector<double> p_coefs;
+
+  /// Quadratic term first variables
+  std::vector<VariablePtr> p_qvars1;
+
+  /// Quadratic term second variables (never ordered before the first)
+  std::vector<VariablePtr> p_qvars2;
+
+  /// Quadratic term coefficients
+  std::vector<double> p_qcoefs;
+
+  /// Constraint relational operator
+  std::string p_op;
+
+  /// Constraint name
+  std::string p_name;
+
+  friend class CompiledExpressionBuilder;
+};
+
+typedef boost::shared_ptr<CompiledExpression> CompiledExpressionPtr;
+
+// -------------------------------------------------------------
+//  struct VariableOrder
+// -------------------------------------------------------------
+/// Order variables by id (then name, in case ids from different
+/// processors are the same)
+struct VariableOrder
+{
+  bool operator()(const VariablePtr& a, const VariablePtr& b) const
+  {
+    if (a->id() != b->id()) return a->id() < b->id();
+    if (a->name() != b->name()) return a->name() < b->name();
+    return a.get() < b.get();
+  }
+};
+
+// -------------------------------------------------------------
+//  class CompiledExpressionBuilder
+// -------------------------------------------------------------
+/// Accumulate terms into a CompiledExpression
+/**
+ * Terms may be added in any order and may be repeated; they are merged
+ * and ordered when the result is made.
+ */
+class CompiledExpressionBuilder
+{
+public:
+
+  /// Default constructor.
+  CompiledExpressionBuilder(void);
+
+  /// Destructor
+  virtual ~CompiledExpressionBuilder(void);
+
+  /// Add to the constant part
+  void addConstant(const double& c)
+  {
+    p_constant += c;
+  }
+
+  /// Add the linear term coef*v
+  void addLinear(const VariablePtr& v, const double& coef)
+  {
+    p_linear[v] += coef;
+  }
+
+  /// Add the quadratic term coef*v1*v2
+  void addQuadratic(const VariablePtr& v1, const VariablePtr& v2,
+                    const double& coef);
+
+  /// Add a compiled expression, multiplied by a factor
+  void add(const CompiledExpression& c, const double& factor);
+
+  /// Add the terms of another builder, multiplied by a factor
+  void add(const CompiledExpressionBuilder& b, const double& factor);
+
+  /// Make the result a constraint: (accumulated terms) op 0
+  void constraint(const std::string& op, const std::string& name)
+  {
+    p_op = op;
+    p_name = name;
+  }
+
+  /// Are there only constant terms so far?
+  bool constant(void) const
+  {
+    return p_linear.empty() && p_quadratic.empty();
+  }
+
+  /// Make a CompiledExpression from the accumulated terms
+  CompiledExpressionPtr result(void) const;
+
+protected:
+
+  typedef std::map<VariablePtr, double, VariableOrder> LinearMap;
+  typedef std::pair<VariablePtr, VariablePtr> VariablePair;
+
+  /// Order variable pairs by the first, then second, variable
+  struct PairOrder
+  {
+    bool operator()(const VariablePair& a, const VariablePair& b) const
+    {
+      VariableOrder less;
+      if (less(a.first, b.first)) return true;
+      if (less(b.first, a.first)) return false;
+      return less(a.second, b.second);
+    }
+  };
+
+  typedef std::map<VariablePair, double, PairOrder> QuadraticMap;
+
+  /// The constant part
+  double p_constant;
+
+  /// Linear terms
+  LinearMap p_linear;
+
+  /// Quadratic terms, with the lower ordered variable first
+  QuadraticMap p_quadratic;
+
+  /// Constraint operator, if any
+  std::string p_op;
+
+  /// Constraint name, if any
+  std::string p_name;
+};
+
+/// Compile an expression (or constraint) into canonical sparse form
+/**
+ * Throws a gridpack::Exception if the expression contains terms of
+ * higher than second order or functions.
+ *
+ * @param e expression or constraint to compile
+ * @return compiled expression
+ */
+CompiledExpressionPtr compile(ExpressionPtr e);
+
+} // namespace optimization
+} // namespace gridpack
+
+#endif
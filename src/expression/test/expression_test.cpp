@@ -40,6 +40,7 @@
 
 #include "gridpack/expression/variable.hpp"
 #include "gridpack/expression/functions.hpp"
+#include "gridpack/expression/compiled_expression.hpp"
 
 #define BOOST_TEST_NO_MAIN
 #define BOOST_TEST_ALTERNATIVE_INIT_API
@@ -215,6 +216,46 @@ BOOST_AUTO_TEST_CASE(function_test)
   f->evaluate();
 }
 
+BOOST_AUTO_TEST_CASE(compile_test)
+{
+  go::VariablePtr A(new go::RealVariable(13.0));
+  go::VariablePtr B(new go::RealVariable(0.0, -1.0, 1.0));
+  go::VariablePtr C(new go::IntegerVariable(0, -1, 1));
+
+  // duplicate terms are merged and terms are ordered by variable id
+  go::ExpressionPtr e(2.0*C + 3*(A - B/2.0) - (-B) + 4 - 1.5*(A*2.0) + C);
+  go::CompiledExpressionPtr c(go::compile(e));
+  BOOST_CHECK(c->linear());
+  BOOST_CHECK(!c->constraint());
+  BOOST_CHECK_CLOSE(c->constant(), 4.0, 1.0e-10);
+  BOOST_REQUIRE_EQUAL(c->variables().size(), 2);
+  BOOST_CHECK_EQUAL(c->variables()[0].get(), B.get());
+  BOOST_CHECK_CLOSE(c->coefficients()[0], -0.5, 1.0e-10);
+  BOOST_CHECK_EQUAL(c->variables()[1].get(), C.get());
+  BOOST_CHECK_CLOSE(c->coefficients()[1], 3.0, 1.0e-10);
+
+  // constraints are stored as (lhs - rhs) op 0
+  go::ConstraintPtr con(2*A + (B^2) - 3*(B*A) + 4*(B*B) >= 6);
+  c = go::compile(con);
+  BOOST_CHECK(c->constraint());
+  BOOST_CHECK_EQUAL(c->op(), ">=");
+  BOOST_CHECK_EQUAL(c->name(), con->name());
+  BOOST_CHECK_CLOSE(c->constant(), -6.0, 1.0e-10);
+  BOOST_REQUIRE_EQUAL(c->variables().size(), 1);
+  BOOST_CHECK_EQUAL(c->variables()[0].get(), A.get());
+  BOOST_REQUIRE_EQUAL(c->quadraticCoefficients().size(), 2);
+  BOOST_CHECK_EQUAL(c->quadraticVariables1()[0].get(), A.get());
+  BOOST_CHECK_EQUAL(c->quadraticVariables2()[0].get(), B.get());
+  BOOST_CHECK_CLOSE(c->quadraticCoefficients()[0], -3.0, 1.0e-10);
+  BOOST_CHECK_EQUAL(c->quadraticVariables1()[1].get(), B.get());
+  BOOST_CHECK_EQUAL(c->quadraticVariables2()[1].get(), B.get());
+  BOOST_CHECK_CLOSE(c->quadraticCoefficients()[1], 5.0, 1.0e-10);
+
+  // third order terms and functions cannot be compiled
+  BOOST_CHECK_THROW(go::compile(A*(B^2)), gridpack::Exception);
+  BOOST_CHECK_THROW(go::compile(go::sin(A)), gridpack::Exception);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 // -------------------------------------------------------------
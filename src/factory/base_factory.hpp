@@ -114,7 +114,10 @@ class BaseFactory {
         p_network->getBus(i)->setMatVecIndex(bus_idx);
         if (p_network->getActiveBus(i)) numActiveBus++;
       }
-      
+
+      // Point components at the network's adjacency lists
+      p_network->setTopology();
+
       // Set reference bus
       int idx = p_network->getReferenceBus();
       if (idx != -1) {
@@ -361,6 +364,43 @@ class BaseFactory {
       timer->configTimer(true);
     }
 
+    /**
+     * Repartition the network using the costs measured on each bus (see
+     * BaseNetwork::repartition) and set up the factory and the components
+     * again for the new distribution. Mappers and anything else built
+     * from the old distribution need to be recreated by the caller.
+     * No application calls this yet. The dynamic simulation components
+     * do not serialize their integration state, so the dynamic
+     * simulation application does not rebalance during a run
+     * @param itr ratio of communication to redistribution cost passed to
+     *            BaseNetwork::repartition
+     * @param exchange if true, set up exchange buffers and bus and branch
+     *            updates again
+     */
+    virtual void repartition(double itr = 1000.0, bool exchange = true)
+    {
+      p_network->repartition(itr);
+      delete [] p_buses;
+      delete [] p_branches;
+      p_numBuses = p_network->numBuses();
+      p_numBranches = p_network->numBranches();
+      p_buses = new gridpack::component::BaseBusComponent*[p_numBuses];
+      p_branches = new gridpack::component::BaseBranchComponent*[p_numBranches];
+      int i;
+      for (i=0; i<p_numBuses; i++) {
+        p_buses[i] = p_network->getBus(i).get();
+      }
+      for (i=0; i<p_numBranches; i++) {
+        p_branches[i] = p_network->getBranch(i).get();
+      }
+      setComponents();
+      if (exchange) {
+        setExchange();
+        p_network->initBusUpdate();
+        p_network->initBranchUpdate();
+      }
+    }
+
     /**
      * Set the mode for all BaseComponent objects in the network.
      * @param mode integer representing desired mode
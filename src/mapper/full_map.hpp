@@ -19,6 +19,7 @@
 
 //#define NZ_PER_ROW
 
+#include <vector>
 #include <boost/smart_ptr/shared_ptr.hpp>
 #include <ga.h>
 #include "gridpack/parallel/parallel.hpp"
@@ -58,6 +59,11 @@ FullMatrixMap(boost::shared_ptr<_network> network)
   p_timer = NULL;
   //p_timer = gridpack::utility::CoarseTimer::instance();
 
+  p_planMatrix = -1;
+  p_planState = -1;
+  p_planValid = false;
+  p_planSlotSize = 0;
+
   p_GAgrp = network->communicator().getGroup();
   p_me = GA_Pgroup_nodeid(p_GAgrp);
   p_nNodes = GA_Pgroup_nnodes(p_GAgrp);
@@ -227,54 +233,98 @@ gridpack::math::Matrix* intMapToMatrix(bool isDense = false)
 
 
 /**
- * Reset existing matrix from current component state on network
+ * Reset existing matrix from current component state on network. The
+ * first call for a given matrix records where each block of values is
+ * stored. Later calls write the blocks directly to those locations, as
+ * long as the nonzero structure of the matrix and the block sizes
+ * returned by the network components have not changed.
  * @param matrix existing matrix (should be generated from same mapper)
  */
 void mapToMatrix(gridpack::math::Matrix &matrix)
 {
-  int t_set, t_bus, t_branch;
+  int t_set, t_load;
   GA_Pgroup_sync(p_GAgrp);
   if (p_timer) t_set = p_timer->createCategory("Mapper: Set Matrix");
   if (p_timer) p_timer->start(t_set);
   matrix.zero();
   if (p_timer) p_timer->stop(t_set);
-  if (p_timer) t_bus = p_timer->createCategory("Mapper: Load Bus Data");
-  if (p_timer) p_timer->start(t_bus);
-  loadBusData(matrix,false);
-  if (p_timer) p_timer->stop(t_bus);
-  if (p_timer) t_branch = p_timer->createCategory("Mapper: Load Branch Data");
-  if (p_timer) p_timer->start(t_branch);
-  loadBranchData(matrix,false);
-  if (p_timer) p_timer->stop(t_branch);
+  if (p_timer) t_load = p_timer->createCategory("Mapper: Load Data");
+  if (p_timer) p_timer->start(t_load);
+  bool record = false;
+  int path = planPath(matrix);
+  if (path == 2) {
+    matrix.beginValueSlots();
+    bool ok = loadDataBySlot<gridpack::math::Matrix, ComplexType>(matrix, false);
+    matrix.endValueSlots();
+    if (!allNodes(ok)) {
+      // Component blocks have changed somewhere, start over
+      matrix.zero();
+      record = true;
+    }
+  } else if (path == 1) {
+    record = true;
+  } else {
+    // Storage locations are not available for this matrix, or could
+    // not be found before, so set the values directly
+    loadBusData(matrix,false);
+    loadBranchData(matrix,false);
+  }
+  if (record) {
+    loadDataBySlot<gridpack::math::Matrix, ComplexType>(matrix, true);
+  }
+  if (p_timer) p_timer->stop(t_load);
   if (p_timer) p_timer->start(t_set);
   GA_Pgroup_sync(p_GAgrp);
   matrix.ready();
+  if (record) finishPlan(matrix);
   if (p_timer) p_timer->stop(t_set);
 }
 
 /**
- * Reset existing matrix from current component state on network
+ * Reset existing matrix from current component state on network. The
+ * first call for a given matrix records where each block of values is
+ * stored. Later calls write the blocks directly to those locations, as
+ * long as the nonzero structure of the matrix and the block sizes
+ * returned by the network components have not changed.
  * @param matrix existing matrix (should be generated from same mapper)
  */
 void mapToRealMatrix(gridpack::math::RealMatrix &matrix)
 {
-  int t_set, t_bus, t_branch;
+  int t_set, t_load;
   GA_Pgroup_sync(p_GAgrp);
   if (p_timer) t_set = p_timer->createCategory("Mapper: Set Matrix");
   if (p_timer) p_timer->start(t_set);
   matrix.zero();
   if (p_timer) p_timer->stop(t_set);
-  if (p_timer) t_bus = p_timer->createCategory("Mapper: Load Bus Data");
-  if (p_timer) p_timer->start(t_bus);
-  loadRealBusData(matrix,false);
-  if (p_timer) p_timer->stop(t_bus);
-  if (p_timer) t_branch = p_timer->createCategory("Mapper: Load Branch Data");
-  if (p_timer) p_timer->start(t_branch);
-  loadRealBranchData(matrix,false);
-  if (p_timer) p_timer->stop(t_branch);
+  if (p_timer) t_load = p_timer->createCategory("Mapper: Load Data");
+  if (p_timer) p_timer->start(t_load);
+  bool record = false;
+  int path = planPath(matrix);
+  if (path == 2) {
+    matrix.beginValueSlots();
+    bool ok = loadDataBySlot<gridpack::math::RealMatrix, RealType>(matrix, false);
+    matrix.endValueSlots();
+    if (!allNodes(ok)) {
+      // Component blocks have changed somewhere, start over
+      matrix.zero();
+      record = true;
+    }
+  } else if (path == 1) {
+    record = true;
+  } else {
+    // Storage locations are not available for this matrix, or could
+    // not be found before, so set the values directly
+    loadRealBusData(matrix,false);
+    loadRealBranchData(matrix,false);
+  }
+  if (record) {
+    loadDataBySlot<gridpack::math::RealMatrix, RealType>(matrix, true);
+  }
+  if (p_timer) p_timer->stop(t_load);
   if (p_timer) p_timer->start(t_set);
   GA_Pgroup_sync(p_GAgrp);
   matrix.ready();
+  if (record) finishPlan(matrix);
   if (p_timer) p_timer->stop(t_set);
 }
 
@@ -923,6 +973,41 @@ void setBusOffsets(void)
   }
 }
 
+/**
+ * Load a single block returned by a network component into the matrix.
+ * Components return blocks in column-major order, so the values are
+ * copied to a row-major buffer and passed to the matrix in one call
+ * @param matrix matrix to which block is added
+ * @param ioff row offset of block
+ * @param joff column offset of block
+ * @param isize number of rows in block
+ * @param jsize number of columns in block
+ * @param values block values in column-major order
+ * @param block buffer of at least isize*jsize values
+ * @param flag add values to matrix (true) or overwrite existing values (false)
+ */
+template <class _matrix, typename _type>
+void loadBlock(_matrix &matrix, int ioff, int joff, int isize, int jsize,
+    const _type *values, _type *block, bool flag)
+{
+  int j,k;
+  if (static_cast<int>(p_blockRows.size()) < isize) p_blockRows.resize(isize);
+  if (static_cast<int>(p_blockCols.size()) < jsize) p_blockCols.resize(jsize);
+  for (j=0; j<isize; j++) p_blockRows[j] = ioff + j;
+  for (k=0; k<jsize; k++) p_blockCols[k] = joff + k;
+  for (k=0; k<jsize; k++) {
+    for (j=0; j<isize; j++) {
+      block[j*jsize+k] = values[k*isize+j];
+    }
+  }
+  if (isize <= 0 || jsize <= 0) return;
+  if (flag) {
+    matrix.addBlock(isize, &p_blockRows[0], jsize, &p_blockCols[0], block);
+  } else {
+    matrix.setBlock(isize, &p_blockRows[0], jsize, &p_blockCols[0], block);
+  }
+}
+
 /**
  * Add diagonal block contributions from buses to matrix
  * @param matrix matrix to which contributions are added
@@ -930,11 +1015,12 @@ void setBusOffsets(void)
  */
 void loadBusData(gridpack::math::Matrix &matrix, bool flag)
 {
-  int i,idx,jdx,isize,jsize,icnt;
+  int i,isize,jsize;
   boost::shared_ptr<gridpack::component::BaseBusComponent> bus;
   // Add matrix elements
   ComplexType *values = new ComplexType[p_maxIBlock*p_maxJBlock];
-  int j,k;
+  ComplexType *block = new ComplexType[p_maxIBlock*p_maxJBlock];
+  int k;
   int jcnt = 0;
   for (i=0; i<p_nBuses; i++) {
     if (p_network->getActiveBus(i)) {
@@ -945,19 +1031,8 @@ void loadBusData(gridpack::math::Matrix &matrix, bool flag)
         for (k=0; k<ijsize; k++) values[k] = 0.0;
 #endif
         if (bus->matrixDiagValues(values)) {
-          icnt = 0;
-          for (k=0; k<jsize; k++) {
-            jdx = p_j_busOffsets[jcnt] + k;
-            for (j=0; j<isize; j++) {
-              idx = p_i_busOffsets[jcnt] + j;
-              if (flag) {
-                matrix.addElement(idx, jdx, values[icnt]);
-              } else {
-                matrix.setElement(idx, jdx, values[icnt]);
-              }
-              icnt++;
-            }
-          }
+          loadBlock(matrix, p_i_busOffsets[jcnt], p_j_busOffsets[jcnt],
+              isize, jsize, values, block, flag);
         }
         jcnt++;
       }
@@ -966,6 +1041,7 @@ void loadBusData(gridpack::math::Matrix &matrix, bool flag)
 
   // Clean up arrays
   delete [] values;
+  delete [] block;
 }
 
 /**
@@ -975,11 +1051,12 @@ void loadBusData(gridpack::math::Matrix &matrix, bool flag)
  */
 void loadRealBusData(gridpack::math::RealMatrix &matrix, bool flag)
 {
-  int i,idx,jdx,isize,jsize,icnt;
+  int i,isize,jsize;
   boost::shared_ptr<gridpack::component::BaseBusComponent> bus;
   // Add matrix elements
   RealType *values = new RealType[p_maxIBlock*p_maxJBlock];
-  int j,k;
+  RealType *block = new RealType[p_maxIBlock*p_maxJBlock];
+  int k;
   int jcnt = 0;
   for (i=0; i<p_nBuses; i++) {
     if (p_network->getActiveBus(i)) {
@@ -990,19 +1067,8 @@ void loadRealBusData(gridpack::math::RealMatrix &matrix, bool flag)
         for (k=0; k<ijsize; k++) values[k] = 0.0;
 #endif
         if (bus->matrixDiagValues(values)) {
-          icnt = 0;
-          for (k=0; k<jsize; k++) {
-            jdx = p_j_busOffsets[jcnt] + k;
-            for (j=0; j<isize; j++) {
-              idx = p_i_busOffsets[jcnt] + j;
-              if (flag) {
-                matrix.addElement(idx, jdx, values[icnt]);
-              } else {
-                matrix.setElement(idx, jdx, values[icnt]);
-              }
-              icnt++;
-            }
-          }
+          loadBlock(matrix, p_i_busOffsets[jcnt], p_j_busOffsets[jcnt],
+              isize, jsize, values, block, flag);
         }
         jcnt++;
       }
@@ -1011,6 +1077,7 @@ void loadRealBusData(gridpack::math::RealMatrix &matrix, bool flag)
 
   // Clean up arrays
   delete [] values;
+  delete [] block;
 }
 
 /**
@@ -1113,14 +1180,15 @@ void setBranchOffsets(void)
  */
 void loadBranchData(gridpack::math::Matrix &matrix, bool flag)
 {
-  int i,idx,jdx,isize,jsize,icnt;
+  int i,idx,jdx,isize,jsize;
   // Add matrix elements
   int t_add(0);
   if (p_timer) t_add = p_timer->createCategory("loadBranchData: Add Matrix Elements");
   if (p_timer) p_timer->start(t_add);
   boost::shared_ptr<gridpack::component::BaseBranchComponent> branch;
   ComplexType *values = new ComplexType[p_maxIBlock*p_maxJBlock];
-  int j,k;
+  ComplexType *block = new ComplexType[p_maxIBlock*p_maxJBlock];
+  int k;
   int jcnt = 0;
   for (i=0; i<p_nBranches; i++) {
     branch = p_network->getBranch(i);
@@ -1132,19 +1200,8 @@ void loadBranchData(gridpack::math::Matrix &matrix, bool flag)
         for (k=0; k<ijsize; k++) values[k] = 0.0;
 #endif
         if (branch->matrixForwardValues(values)) {
-          icnt = 0;
-          for (k=0; k<jsize; k++) {
-            jdx = p_j_branchOffsets[jcnt] + k;
-            for (j=0; j<isize; j++) {
-              idx = p_i_branchOffsets[jcnt] + j;
-              if (flag) {
-                matrix.addElement(idx, jdx, values[icnt]);
-              } else {
-                matrix.setElement(idx, jdx, values[icnt]);
-              }
-              icnt++;
-            }
-          }
+          loadBlock(matrix, p_i_branchOffsets[jcnt], p_j_branchOffsets[jcnt],
+              isize, jsize, values, block, flag);
         }
         jcnt++;
       }
@@ -1157,21 +1214,10 @@ void loadBranchData(gridpack::math::Matrix &matrix, bool flag)
         for (k=0; k<ijsize; k++) values[k] = 0.0;
 #endif
         if (branch->matrixReverseValues(values)) {
-          icnt = 0;
-          // Note that because the indices have been reversed, we need to switch
-          // the ordering of the offsets as well
-          for (k=0; k<jsize; k++) {
-            idx = p_j_branchOffsets[jcnt] + k;
-            for (j=0; j<isize; j++) {
-              jdx = p_i_branchOffsets[jcnt] + j;
-              if (flag) {
-                matrix.addElement(jdx, idx, values[icnt]);
-              } else {
-                matrix.setElement(jdx, idx, values[icnt]);
-              }
-              icnt++;
-            }
-          }
+          // Reversed blocks use the same offsets as forward blocks, with
+          // the row and column indices of the branch switched
+          loadBlock(matrix, p_i_branchOffsets[jcnt], p_j_branchOffsets[jcnt],
+              isize, jsize, values, block, flag);
         }
         jcnt++;
       }
@@ -1181,6 +1227,7 @@ void loadBranchData(gridpack::math::Matrix &matrix, bool flag)
 
   // Clean up array
   delete [] values;
+  delete [] block;
 }
 
 /**
@@ -1190,14 +1237,15 @@ void loadBranchData(gridpack::math::Matrix &matrix, bool flag)
  */
 void loadRealBranchData(gridpack::math::RealMatrix &matrix, bool flag)
 {
-  int i,idx,jdx,isize,jsize,icnt;
+  int i,idx,jdx,isize,jsize;
   // Add matrix elements
   int t_add(0);
   if (p_timer) t_add = p_timer->createCategory("loadBranchData: Add Matrix Elements");
   if (p_timer) p_timer->start(t_add);
   boost::shared_ptr<gridpack::component::BaseBranchComponent> branch;
   RealType *values = new RealType[p_maxIBlock*p_maxJBlock];
-  int j,k;
+  RealType *block = new RealType[p_maxIBlock*p_maxJBlock];
+  int k;
   int jcnt = 0;
   for (i=0; i<p_nBranches; i++) {
     branch = p_network->getBranch(i);
@@ -1209,19 +1257,8 @@ void loadRealBranchData(gridpack::math::RealMatrix &matrix, bool flag)
         for (k=0; k<ijsize; k++) values[k] = 0.0;
 #endif
         if (branch->matrixForwardValues(values)) {
-          icnt = 0;
-          for (k=0; k<jsize; k++) {
-            jdx = p_j_branchOffsets[jcnt] + k;
-            for (j=0; j<isize; j++) {
-              idx = p_i_branchOffsets[jcnt] + j;
-              if (flag) {
-                matrix.addElement(idx, jdx, values[icnt]);
-              } else {
-                matrix.setElement(idx, jdx, values[icnt]);
-              }
-              icnt++;
-            }
-          }
+          loadBlock(matrix, p_i_branchOffsets[jcnt], p_j_branchOffsets[jcnt],
+              isize, jsize, values, block, flag);
         }
         jcnt++;
       }
@@ -1234,21 +1271,10 @@ void loadRealBranchData(gridpack::math::RealMatrix &matrix, bool flag)
         for (k=0; k<ijsize; k++) values[k] = 0.0;
 #endif
         if (branch->matrixReverseValues(values)) {
-          icnt = 0;
-          // Note that because the indices have been reversed, we need to switch
-          // the ordering of the offsets as well
-          for (k=0; k<jsize; k++) {
-            idx = p_j_branchOffsets[jcnt] + k;
-            for (j=0; j<isize; j++) {
-              jdx = p_i_branchOffsets[jcnt] + j;
-              if (flag) {
-                matrix.addElement(jdx, idx, values[icnt]);
-              } else {
-                matrix.setElement(jdx, idx, values[icnt]);
-              }
-              icnt++;
-            }
-          }
+          // Reversed blocks use the same offsets as forward blocks, with
+          // the row and column indices of the branch switched
+          loadBlock(matrix, p_i_branchOffsets[jcnt], p_j_branchOffsets[jcnt],
+              isize, jsize, values, block, flag);
         }
         jcnt++;
       }
@@ -1258,6 +1284,7 @@ void loadRealBranchData(gridpack::math::RealMatrix &matrix, bool flag)
 
   // Clean up array
   delete [] values;
+  delete [] block;
 }
 
 /**
@@ -1280,6 +1307,282 @@ void loadRealBranchData(boost::shared_ptr<gridpack::math::Matrix> &matrix, bool
   loadRealBranchData(*matrix, flag);
 }
 
+/**
+ * Check if storage locations can be recorded for a matrix. This
+ * requires the matrix to report both its storage identifier and its
+ * nonzero structure
+ * @param matrix existing matrix
+ * @return true if an assembly plan can be used for the matrix
+ */
+template <class _matrix>
+bool planSupported(const _matrix &matrix)
+{
+  return (matrix.storageId() >= 0 && matrix.nonzeroState() >= 0
+      && matrix.valueSlotSize() > 0);
+}
+
+/**
+ * Check if the assembly plan was recorded for this matrix and if the
+ * nonzero structure of the matrix is unchanged since then. The matrix
+ * is identified by its storage, not its address, so a plan is never
+ * applied to a different matrix that reuses the same memory
+ * @param matrix existing matrix
+ * @return true if the plan belongs to the current matrix structure
+ */
+template <class _matrix>
+bool planMatches(const _matrix &matrix)
+{
+  long id = matrix.storageId();
+  if (id < 0 || id != p_planMatrix) return false;
+  long state = matrix.nonzeroState();
+  return (state >= 0 && state == p_planState);
+}
+
+/**
+ * Decide, on all processors together, how an existing matrix is
+ * reloaded, so that all processors take the same path
+ * @param matrix existing matrix
+ * @return 2 if the assembly plan can be used, 1 if a plan should be
+ * recorded, 0 if values should be set directly
+ */
+template <class _matrix>
+int planPath(const _matrix &matrix)
+{
+  bool planned = planMatches(matrix);
+  int flags[3];
+  flags[0] = static_cast<int>(planSupported(matrix));
+  flags[1] = static_cast<int>(planned && p_planValid);
+  flags[2] = static_cast<int>(!planned || p_planValid);
+  int three = 3;
+  char cmin[4];
+  strcpy(cmin,"min");
+  GA_Pgroup_igop(p_GAgrp,flags,three,cmin);
+  if (!flags[0]) return 0;
+  if (flags[1]) return 2;
+  if (flags[2]) return 1;
+  return 0;
+}
+
+/**
+ * Check if a condition holds on all processors
+ * @param flag condition on this processor
+ * @return true if flag is true on all processors
+ */
+bool allNodes(bool flag)
+{
+  int ival = static_cast<int>(flag);
+  int one = 1;
+  char cmin[4];
+  strcpy(cmin,"min");
+  GA_Pgroup_igop(p_GAgrp,&ival,one,cmin);
+  return (ival != 0);
+}
+
+/**
+ * Discard the assembly plan. The next call to mapToMatrix() or
+ * mapToRealMatrix() records a new plan
+ */
+void invalidatePlan(void)
+{
+  p_planMatrix = -1;
+  p_planState = -1;
+  p_planValid = false;
+  p_planBlocks.clear();
+  p_planSlots.clear();
+  p_planRows.clear();
+  p_planCols.clear();
+}
+
+/**
+ * Compare the size of a block to the assembly plan or add the block to
+ * the plan
+ * @param kind type of block: bus (0), forward branch (1) or reverse
+ * branch (2)
+ * @param isize number of rows in block
+ * @param jsize number of columns in block
+ * @param set true if the component returned values for the block
+ * @param record true if the block is being added to the plan
+ * @param nblk current block number, incremented on return
+ * @return false if the block does not match the plan
+ */
+bool planBlock(int kind, int isize, int jsize, bool set, bool record,
+               int &nblk)
+{
+  int off = 4*nblk;
+  nblk++;
+  if (record) {
+    p_planBlocks.push_back(kind);
+    p_planBlocks.push_back(isize);
+    p_planBlocks.push_back(jsize);
+    p_planBlocks.push_back(static_cast<int>(set));
+    return true;
+  }
+  if (off+4 > static_cast<int>(p_planBlocks.size())) return false;
+  return (p_planBlocks[off] == kind && p_planBlocks[off+1] == isize
+      && p_planBlocks[off+2] == jsize
+      && p_planBlocks[off+3] == static_cast<int>(set));
+}
+
+/**
+ * Load bus and branch blocks into matrix. If record is true, the
+ * elements are set one at a time and their indices are saved so that
+ * storage locations can be found by finishPlan() after the matrix is
+ * assembled. Otherwise, blocks are written to the storage locations
+ * in the assembly plan.
+ * @param matrix matrix to which contributions are added
+ * @param record true if the assembly plan is being recorded
+ * @return false if component blocks do not match assembly plan. Some
+ * blocks may already have been written to the matrix
+ */
+template <class _matrix, typename _type>
+bool loadDataBySlot(_matrix &matrix, bool record)
+{
+  int i,k,idx,jdx,isize,jsize;
+  int nblk = 0;
+  int nslot = 0;
+  bool ok = true;
+  bool set;
+  if (record) invalidatePlan();
+  _type *values = new _type[p_maxIBlock*p_maxJBlock];
+  _type *block = new _type[p_maxIBlock*p_maxJBlock];
+  boost::shared_ptr<gridpack::component::BaseBusComponent> bus;
+  int jcnt = 0;
+  for (i=0; ok && i<p_nBuses; i++) {
+    if (p_network->getActiveBus(i)) {
+      bus = p_network->getBus(i);
+      if (bus->matrixDiagSize(&isize,&jsize)) {
+#ifdef DBG_CHECK
+        int ijsize = isize*jsize;
+        for (k=0; k<ijsize; k++) values[k] = 0.0;
+#endif
+        set = bus->matrixDiagValues(values);
+        ok = planBlock(0,isize,jsize,set,record,nblk);
+        if (ok && set) {
+          if (record) {
+            loadBlock(matrix, p_i_busOffsets[jcnt], p_j_busOffsets[jcnt],
+                isize, jsize, values, block, false);
+            recordBlock(p_i_busOffsets[jcnt], p_j_busOffsets[jcnt],
+                isize, jsize);
+          } else {
+            matrix.setValuesBySlot(isize*jsize, &p_planSlots[nslot], values);
+            nslot += isize*jsize*p_planSlotSize;
+          }
+        }
+        jcnt++;
+      }
+    }
+  }
+  boost::shared_ptr<gridpack::component::BaseBranchComponent> branch;
+  jcnt = 0;
+  for (i=0; ok && i<p_nBranches; i++) {
+    branch = p_network->getBranch(i);
+    if (branch->matrixForwardSize(&isize,&jsize)) {
+      branch->getMatVecIndices(&idx, &jdx);
+      if (idx >= p_minRowIndex && idx <= p_maxRowIndex) {
+#ifdef DBG_CHECK
+        int ijsize = isize*jsize;
+        for (k=0; k<ijsize; k++) values[k] = 0.0;
+#endif
+        set = branch->matrixForwardValues(values);
+        ok = planBlock(1,isize,jsize,set,record,nblk);
+        if (ok && set) {
+          if (record) {
+            loadBlock(matrix, p_i_branchOffsets[jcnt], p_j_branchOffsets[jcnt],
+                isize, jsize, values, block, false);
+            recordBlock(p_i_branchOffsets[jcnt], p_j_branchOffsets[jcnt],
+                isize, jsize);
+          } else {
+            matrix.setValuesBySlot(isize*jsize, &p_planSlots[nslot], values);
+            nslot += isize*jsize*p_planSlotSize;
+          }
+        }
+        jcnt++;
+      }
+    }
+    if (!ok) break;
+    if (branch->matrixReverseSize(&isize,&jsize)) {
+      branch->getMatVecIndices(&idx, &jdx);
+      if (jdx >= p_minRowIndex && jdx <= p_maxRowIndex) {
+#ifdef DBG_CHECK
+        int ijsize = isize*jsize;
+        for (k=0; k<ijsize; k++) values[k] = 0.0;
+#endif
+        set = branch->matrixReverseValues(values);
+        ok = planBlock(2,isize,jsize,set,record,nblk);
+        if (ok && set) {
+          if (record) {
+            loadBlock(matrix, p_i_branchOffsets[jcnt], p_j_branchOffsets[jcnt],
+                isize, jsize, values, block, false);
+            recordBlock(p_i_branchOffsets[jcnt], p_j_branchOffsets[jcnt],
+                isize, jsize);
+          } else {
+            matrix.setValuesBySlot(isize*jsize, &p_planSlots[nslot], values);
+            nslot += isize*jsize*p_planSlotSize;
+          }
+        }
+        jcnt++;
+      }
+    }
+  }
+  // Make sure no blocks have disappeared since the plan was recorded
+  if (ok && !record && 4*nblk != static_cast<int>(p_planBlocks.size())) {
+    ok = false;
+  }
+  delete [] values;
+  delete [] block;
+  return ok;
+}
+
+/**
+ * Save the indices of a block in the order its values are returned by
+ * the network component (column-major)
+ * @param ioff row offset of block
+ * @param joff column offset of block
+ * @param isize number of rows in block
+ * @param jsize number of columns in block
+ */
+void recordBlock(int ioff, int joff, int isize, int jsize)
+{
+  int j,k;
+  for (k=0; k<jsize; k++) {
+    for (j=0; j<isize; j++) {
+      p_planRows.push_back(ioff+j);
+      p_planCols.push_back(joff+k);
+    }
+  }
+}
+
+/**
+ * Find storage locations for the elements recorded by
+ * loadDataBySlot(). Must be called after the matrix is assembled.
+ * @param matrix matrix that was loaded
+ */
+template <class _matrix>
+void finishPlan(_matrix &matrix)
+{
+  p_planMatrix = matrix.storageId();
+  p_planState = matrix.nonzeroState();
+  p_planSlotSize = matrix.valueSlotSize();
+  p_planValid = false;
+  int nelem = p_planRows.size();
+  if (p_planMatrix >= 0 && p_planState >= 0 && p_planSlotSize > 0) {
+    p_planSlots.resize(nelem*p_planSlotSize);
+    if (nelem == 0 || matrix.valueSlots(nelem, &p_planRows[0],
+          &p_planCols[0], &p_planSlots[0])) {
+      p_planValid = true;
+    }
+  }
+  // Only use the plan if it could be found everywhere
+  p_planValid = allNodes(p_planValid);
+  if (!p_planValid) {
+    p_planSlots.clear();
+    p_planBlocks.clear();
+  }
+  // Indices are not needed once slots have been found
+  std::vector<int>().swap(p_planRows);
+  std::vector<int>().swap(p_planCols);
+}
+
 /**
  * Calculate how many buses and branches contribute to matrix
  */
@@ -1354,6 +1657,20 @@ int                         p_GAgrp;
     // pointer to timer
 gridpack::utility::CoarseTimer *p_timer;
 
+    // index buffers used to load component blocks
+std::vector<int>            p_blockRows;
+std::vector<int>            p_blockCols;
+
+    // cached assembly plan used to reload an existing matrix
+long                        p_planMatrix;
+long                        p_planState;
+bool                        p_planValid;
+int                         p_planSlotSize;
+std::vector<int>            p_planBlocks;
+std::vector<int>            p_planSlots;
+std::vector<int>            p_planRows;
+std::vector<int>            p_planCols;
+
 };
 
 } /* namespace mapper */
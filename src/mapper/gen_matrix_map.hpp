@@ -649,11 +649,11 @@ void loadBusData(gridpack::math::Matrix &matrix, bool flag)
     if (p_network->getActiveBus(i)) {
       nvals = p_network->getBus(i)->matrixNumValues();
       p_network->getBus(i)->matrixGetValues(values,rows,cols);
-      for (j=0; j<nvals; j++) {
+      if (nvals > 0) {
         if (flag) {
-          matrix.addElement(rows[j],cols[j],values[j]);
+          matrix.addElements(nvals,rows,cols,values);
         } else {
-          matrix.setElement(rows[j],cols[j],values[j]);
+          matrix.setElements(nvals,rows,cols,values);
         }
       }
     }
@@ -686,6 +686,9 @@ void loadBranchData(gridpack::math::Matrix &matrix, bool flag)
       }
       p_network->getBranch(i)->matrixGetValues(values,rows,cols);
       bool addElem;
+      // Compress the elements that belong in the matrix to the front of
+      // the arrays so they can be loaded with a single call
+      int nadd = 0;
       for (j=0; j<nvals; j++) {
         if (rows[j] >= p_minRowIndex && rows[j] <= p_maxRowIndex) {
           addElem = false;
@@ -699,14 +702,20 @@ void loadBranchData(gridpack::math::Matrix &matrix, bool flag)
             addElem = true;
           }
           if (addElem) {
-            if (flag) {
-              matrix.addElement(rows[j],cols[j],values[j]);
-            } else {
-              matrix.setElement(rows[j],cols[j],values[j]);
-            }
+            rows[nadd] = rows[j];
+            cols[nadd] = cols[j];
+            values[nadd] = values[j];
+            nadd++;
           }
         }
       }
+      if (nadd > 0) {
+        if (flag) {
+          matrix.addElements(nadd,rows,cols,values);
+        } else {
+          matrix.setElements(nadd,rows,cols,values);
+        }
+      }
     }
   }
   delete [] values;
@@ -591,19 +591,23 @@ void loadBusData(gridpack::math::Matrix &matrix, bool flag)
     values.push_back(new ComplexType[p_nColumns]);
   }
   int *idx = new int[p_maxValues];
+  std::vector<int> cols(p_nColumns);
+  for (k=0; k<p_nColumns; k++) cols[k] = k;
+  std::vector<ComplexType> block(p_maxValues*p_nColumns);
   for (i=0; i<p_nBuses; i++) {
     if (p_network->getActiveBus(i)) {
       p_network->getBus(i)->slabSize(&ivals,&jvals);
       p_network->getBus(i)->slabGetValues(values, idx);
       for (j=0; j<ivals; j++) {
+        for (k=0; k<p_nColumns; k++) {
+          block[j*p_nColumns+k] = (values[j])[k];
+        }
+      }
+      if (ivals > 0 && p_nColumns > 0) {
         if (flag) {
-          for (k=0; k<p_nColumns; k++) {
-            matrix.addElement(idx[j],k,(values[j])[k]);
-          }
+          matrix.addBlock(ivals,idx,p_nColumns,&cols[0],&block[0]);
         } else {
-          for (k=0; k<p_nColumns; k++) {
-            matrix.setElement(idx[j],k,(values[j])[k]);
-          }
+          matrix.setBlock(ivals,idx,p_nColumns,&cols[0],&block[0]);
         }
       }
     }
@@ -627,21 +631,29 @@ void loadBranchData(gridpack::math::Matrix &matrix, bool flag)
     values.push_back(new ComplexType[p_nColumns]);
   }
   int *idx = new int[p_maxValues];
+  std::vector<int> cols(p_nColumns);
+  for (k=0; k<p_nColumns; k++) cols[k] = k;
+  std::vector<ComplexType> block(p_maxValues*p_nColumns);
   for (i=0; i<p_nBranches; i++) {
     if (p_network->getActiveBranch(i)) {
       p_network->getBranch(i)->slabSize(&ivals,&jvals);
       p_network->getBranch(i)->slabGetValues(values,idx);
+      // Only load rows that are owned by this processor
+      int nrows = 0;
       for (j=0; j<ivals; j++) {
         if (idx[j] >= p_minIndex && idx[j] <= p_maxIndex) {
-          if (flag) {
-            for (k=0; k<p_nColumns; k++) {
-              matrix.addElement(idx[j],k,(values[j])[k]);
-            }
-          } else {
-            for (k=0; k<p_nColumns; k++) {
-              matrix.setElement(idx[j],k,(values[j])[k]);
-            }
+          idx[nrows] = idx[j];
+          for (k=0; k<p_nColumns; k++) {
+            block[nrows*p_nColumns+k] = (values[j])[k];
           }
+          nrows++;
+        }
+      }
+      if (nrows > 0 && p_nColumns > 0) {
+        if (flag) {
+          matrix.addBlock(nrows,idx,p_nColumns,&cols[0],&block[0]);
+        } else {
+          matrix.setBlock(nrows,idx,p_nColumns,&cols[0],&block[0]);
         }
       }
     }
@@ -26,6 +26,7 @@ class TestBus
   public: 
 
   TestBus(void) {
+    p_factor = 1.0;
     p_vals = new double*[2];
     p_vals[0] = new double[NSLAB];
     p_vals[1] = new double[NSLAB];
@@ -51,7 +52,7 @@ class TestBus
 
   bool matrixDiagValues(gridpack::ComplexType *values) {
     if (!getReferenceBus()) {
-      *values = -4.0;
+      *values = -4.0*p_factor;
       return true;
     } else {
       return false;
@@ -94,6 +95,10 @@ class TestBus
     p_val = *values;
   }
 
+  void setFactor(double factor) {
+    p_factor = factor;
+  }
+
   void setValues(gridpack::RealType *values) {
     p_rval = *values;
   }
@@ -262,6 +267,7 @@ class TestBus
   int p_slab_idx1;
   int p_slab_idx2;
   gridpack::ComplexType p_vec1, p_vec2;
+  double p_factor;
   double **p_vals;
 };
 
@@ -270,6 +276,7 @@ class TestBranch
   public: 
 
   TestBranch(void) {
+    p_factor = 1.0;
     p_vals = new double*[1];
     p_vals[0] = new double[NSLAB];
   }
@@ -279,6 +286,10 @@ class TestBranch
     delete [] p_vals;
   }
 
+  void setFactor(double factor) {
+    p_factor = factor;
+  }
+
   bool matrixForwardSize(int *isize, int *jsize) const {
     if (checkReferenceBus()) {
       *isize = 1;
@@ -305,7 +316,7 @@ class TestBranch
 
   bool matrixForwardValues(gridpack::ComplexType *values) {
     if (checkReferenceBus()) {
-      *values = 1.0;
+      *values = p_factor;
       return true;
     } else {
       return false;
@@ -314,7 +325,7 @@ class TestBranch
 
   bool matrixReverseValues(gridpack::ComplexType *values) {
     if (checkReferenceBus()) {
-      *values = 1.0;
+      *values = p_factor;
       return true;
     } else {
       return false;
@@ -455,6 +466,7 @@ class TestBranch
   int p_vec_idx;
   int p_slab_idx;
   gridpack::ComplexType p_vec_val;
+  double p_factor;
   double **p_vals;
 };
 
@@ -515,7 +527,7 @@ void factor_grid(int nproc, int xsize, int ysize, int *pdx, int *pdy)
 
 typedef gridpack::network::BaseNetwork<TestBus, TestBranch> TestNetwork;
 
-void run (const int &me, const int &nprocs)
+int run (const int &me, const int &nprocs)
 {
   // Create network
   gridpack::parallel::Communicator world;
@@ -699,6 +711,8 @@ void run (const int &me, const int &nprocs)
   gridpack::mapper::FullMatrixMap<TestNetwork> mMap(network); 
   boost::shared_ptr<gridpack::math::Matrix> M = mMap.mapToMatrix();
   mMap.mapToMatrix(M);
+  // Map again to reuse the cached assembly plan
+  mMap.mapToMatrix(M);
   // Check to see if matrix has correct values
   int one = 1;
   int chk = 0;
@@ -766,6 +780,77 @@ void run (const int &me, const int &nprocs)
     }
   }
 
+  // Change the component values, map them into the existing matrix
+  // using the cached assembly plan and compare with a matrix mapped
+  // from scratch
+  for (i=0; i<nbus; i++) {
+    network->getBus(i)->setFactor(2.5);
+  }
+  for (i=0; i<nbranch; i++) {
+    network->getBranch(i)->setFactor(-0.5);
+  }
+  mMap.mapToMatrix(M);
+  boost::shared_ptr<gridpack::math::Matrix> F = mMap.mapToMatrix();
+  gridpack::ComplexType fv;
+  chk = 0;
+  for (i=0; i<nbus; i++) {
+    if (network->getActiveBus(i)) {
+      if (network->getBus(i)->matrixDiagSize(&isize,&jsize)
+          && isize > 0 && jsize > 0) {
+        network->getBus(i)->getMatVecIndex(&idx);
+        idx--;
+        M->getElement(idx,idx,v);
+        F->getElement(idx,idx,fv);
+        if (v != fv || real(v) != -10.0) {
+          printf("p[%d] Re-mapped diagonal matrix error i: %d j:%d v: %f"
+              " expected: %f\n",me,idx,idx,real(v),real(fv));
+          chk = 1;
+        }
+      }
+    }
+  }
+  for (i=0; i<nbranch; i++) {
+    if (network->getBranch(i)->matrixForwardSize(&isize,&jsize)
+        && isize > 0 && jsize > 0) {
+      network->getBranch(i)->getMatVecIndices(&idx,&jdx);
+      idx--;
+      jdx--;
+      if (idx >= rlo-1 && idx <= rhi-1) {
+        M->getElement(idx,jdx,v);
+        F->getElement(idx,jdx,fv);
+        if (v != fv || real(v) != -0.5) {
+          printf("p[%d] Re-mapped forward matrix error i: %d j:%d v: %f"
+              " expected: %f\n",me,idx,jdx,real(v),real(fv));
+          chk = 1;
+        }
+      }
+      if (jdx >= rlo-1 && jdx <= rhi-1) {
+        M->getElement(jdx,idx,v);
+        F->getElement(jdx,idx,fv);
+        if (v != fv || real(v) != -0.5) {
+          printf("p[%d] Re-mapped reverse matrix error i: %d j:%d v: %f"
+              " expected: %f\n",me,jdx,idx,real(v),real(fv));
+          chk = 1;
+        }
+      }
+    }
+  }
+  GA_Igop(&chk,one,"+");
+  if (me == 0) {
+    if (chk == 0) {
+      printf("\nRe-mapped matrix elements are ok\n");
+    } else {
+      printf("\nError found in re-mapped matrix elements\n");
+    }
+  }
+  int remap_chk = chk;
+  for (i=0; i<nbus; i++) {
+    network->getBus(i)->setFactor(1.0);
+  }
+  for (i=0; i<nbranch; i++) {
+    network->getBranch(i)->setFactor(1.0);
+  }
+
   if (me == 0) {
     printf("\nTesting BusVectorMap\n");
   }
@@ -1111,7 +1196,7 @@ void run (const int &me, const int &nprocs)
       printf("\nError found in array from matrixToNetwork\n");
     }
   }
-
+  return remap_chk;
 }
 
 int
@@ -1139,7 +1224,7 @@ main (int argc, char **argv) {
     printf("\nTest Network is %d X %d\n",XDIM,YDIM);
   }
 
-  run(me, nprocs);
+  int nerr = run(me, nprocs);
 
   GA_Terminate();
 
@@ -1147,5 +1232,6 @@ main (int argc, char **argv) {
   gridpack::math::Finalize();
   // Clean up MPI libraries
   ierr = MPI_Finalize();
+  if (nerr != 0) return 1;
   return ierr;
 }
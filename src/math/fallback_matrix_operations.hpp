@@ -137,6 +137,40 @@ multiplyDiagonal(MatrixT<T, I>& A, const VectorT<T, I>& x)
 
 
 
+/// Multiply each row of this matrix by the corresponding vector element (fallback)
+/** 
+ * @e Collective.
+ *
+ * @param x row scale factors
+ */
+template <typename T, typename I>
+void 
+scaleRows(MatrixT<T, I>& A, const VectorT<T, I>& x)
+{
+  I ncols(A.cols());
+  std::vector<T> row(ncols);
+  std::vector<I> rows, cols;
+  std::vector<T> vals;
+  I lo, hi;
+  A.localRowRange(lo, hi);
+  for (I i = lo; i < hi; ++i) {
+    T v;
+    x.getElement(i, v);
+    A.getRow(i, &row[0]);
+    for (I j = 0; j < ncols; ++j) {
+      if (row[j] != static_cast<T>(0.0)) {
+        rows.push_back(i);
+        cols.push_back(j);
+        vals.push_back(v*row[j]);
+      }
+    }
+  }
+  if (!vals.empty()) {
+    A.setElements(vals.size(), &rows[0], &cols[0], &vals[0]);
+  }
+  A.ready();
+}
+
 /// Add the specified vector to the diagonal of this matrix (fallback)
 /** 
  * @c Collective.
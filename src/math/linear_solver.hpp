@@ -160,6 +160,42 @@ protected:
     p_solver->maximumIterations(n);
   }
 
+  /// Is the nonzero pattern assumed constant (specialized)
+  bool p_constantPattern(void) const
+  {
+    return p_solver->constantPattern();
+  }
+
+  /// Assume the nonzero pattern does not change (specialized)
+  void p_constantPattern(const bool& flag)
+  {
+    p_solver->constantPattern(flag);
+  }
+
+  /// Get the number of solves that reuse a preconditioner (specialized)
+  int p_preconditionerReuse(void) const
+  {
+    return p_solver->preconditionerReuse();
+  }
+
+  /// Set the number of solves that reuse a preconditioner (specialized)
+  void p_preconditionerReuse(const int& n)
+  {
+    p_solver->preconditionerReuse(n);
+  }
+
+  /// Get the number of symbolic factorizations (specialized)
+  int p_symbolicFactorizations(void) const
+  {
+    return p_solver->symbolicFactorizations();
+  }
+
+  /// Get the number of numeric factorizations (specialized)
+  int p_numericFactorizations(void) const
+  {
+    return p_solver->numericFactorizations();
+  }
+
   /// Solve w/ the specified RHS, put result in specified vector
   /** 
    * @e Collective.
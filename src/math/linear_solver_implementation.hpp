@@ -63,7 +63,11 @@ public:
       p_doSerial(false),
       p_constSerialMatrix(),
       p_guessZero(false),
-      p_serialSolution()
+      p_serialSolution(),
+      p_samePattern(false),
+      p_pcReuse(0),
+      p_nSymbolic(0),
+      p_nNumeric(0)
   {
   }
 
@@ -137,6 +141,25 @@ protected:
   /// A buffer to use for value transfer
   mutable std::vector<TheType> p_valueBuffer;
 
+  /// Assume the coefficient matrix nonzero pattern is constant
+  /**
+   * If true, only the values of the coefficient matrix change between
+   * solves. The symbolic factorization is kept and, if a serial
+   * solver is used in a parallel environment, the collected serial
+   * matrix is updated in place rather than replaced.
+   * 
+   */
+  bool p_samePattern;
+
+  /// Number of solves that use the same preconditioner
+  int p_pcReuse;
+
+  /// Number of symbolic factorizations performed
+  mutable int p_nSymbolic;
+
+  /// Number of numeric factorizations performed
+  mutable int p_nNumeric;
+
   /// Specialized way to configure from property tree
   void p_configure(utility::Configuration::CursorPtr props)
   {
@@ -152,6 +175,9 @@ protected:
       p_doSerial = (p_doSerial && (this->processor_size() > 1));
 
       p_guessZero = props->get("InitialGuessZero", p_guessZero);
+
+      p_samePattern = props->get("MatrixPatternConstant", p_samePattern);
+      p_pcReuse = props->get("PreconditionerReuse", p_pcReuse);
     }
   }
 
@@ -179,6 +205,42 @@ protected:
     p_maxIterations = n;
   }
 
+  /// Is the nonzero pattern assumed constant (specialized)
+  bool p_constantPattern(void) const
+  {
+    return p_samePattern;
+  }
+
+  /// Assume the nonzero pattern does not change (specialized)
+  void p_constantPattern(const bool& flag)
+  {
+    p_samePattern = flag;
+  }
+
+  /// Get the number of solves that reuse a preconditioner (specialized)
+  int p_preconditionerReuse(void) const
+  {
+    return p_pcReuse;
+  }
+
+  /// Set the number of solves that reuse a preconditioner (specialized)
+  void p_preconditionerReuse(const int& n)
+  {
+    p_pcReuse = n;
+  }
+
+  /// Get the number of symbolic factorizations (specialized)
+  int p_symbolicFactorizations(void) const
+  {
+    return p_nSymbolic;
+  }
+
+  /// Get the number of numeric factorizations (specialized)
+  int p_numericFactorizations(void) const
+  {
+    return p_nNumeric;
+  }
+
   /// Solve the specified system w/ RHS and estimate (implementation)  
   virtual void p_solveImpl(MatrixType& A, const VectorType& b, VectorType& x) const = 0;
 
@@ -238,7 +300,14 @@ protected:
       if (!p_serialMatrix ) {
           p_serialMatrix.reset(p_matrix.localClone());
       } else if (!p_constSerialMatrix) {
+        if (p_samePattern) {
+          // keep the same serial matrix instance so that its symbolic
+          // factorization can be reused
+          boost::scoped_ptr<MatrixType> tmp(p_matrix.localClone());
+          p_serialMatrix->equate(*tmp);
+        } else {
           p_serialMatrix.reset(p_matrix.localClone());
+        }
       }
       
       this->p_serialSolvePrep(b, x);
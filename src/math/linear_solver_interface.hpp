@@ -95,6 +95,84 @@ public:
     this->p_maximumIterations(n);
   }
 
+  /// Is the coefficient matrix nonzero pattern assumed constant?
+  /** 
+   * 
+   * 
+   * 
+   * @return true if the nonzero pattern is assumed constant
+   */
+  bool constantPattern(void) const
+  {
+    return this->p_constantPattern();
+  }
+
+  /// Assume the coefficient matrix nonzero pattern does not change
+  /** 
+   * If true, the coefficient matrix is assumed to keep the same
+   * nonzero pattern between solves, with only the values changing.
+   * The ordering and fill pattern (symbolic factorization) of direct
+   * solvers and factored preconditioners are kept and only numeric
+   * refactorization is done.
+   * 
+   * @param flag true if the nonzero pattern does not change
+   */
+  void constantPattern(const bool& flag)
+  {
+    this->p_constantPattern(flag);
+  }
+
+  /// Get the number of solves for which a preconditioner is reused
+  /** 
+   * 
+   * 
+   * 
+   * @return number of solves
+   */
+  int preconditionerReuse(void) const
+  {
+    return this->p_preconditionerReuse();
+  }
+
+  /// Reuse the preconditioner (or factorization) for a number of solves
+  /** 
+   * The preconditioner is rebuilt from the current coefficient matrix
+   * every @c n solves, or whenever the nonzero pattern
+   * changes. Values of 0 or 1 rebuild the preconditioner for every
+   * solve.
+   * 
+   * @param n number of solves that use the same preconditioner
+   */
+  void preconditionerReuse(const int& n)
+  {
+    this->p_preconditionerReuse(n);
+  }
+
+  /// Get the number of symbolic factorizations performed
+  /** 
+   * A symbolic factorization (ordering and fill pattern) is needed the
+   * first time the preconditioner is built and whenever the nonzero
+   * pattern of the coefficient matrix changes.
+   * 
+   * @return number of symbolic factorizations
+   */
+  int symbolicFactorizations(void) const
+  {
+    return this->p_symbolicFactorizations();
+  }
+
+  /// Get the number of numeric factorizations performed
+  /** 
+   * A numeric factorization is done each time the preconditioner is
+   * rebuilt from the values of the coefficient matrix.
+   * 
+   * @return number of numeric factorizations
+   */
+  int numericFactorizations(void) const
+  {
+    return this->p_numericFactorizations();
+  }
+
   /// Solve w/ the specified RHS, put result in specified vector
   /** 
    * @e Collective.
@@ -171,6 +249,24 @@ protected:
   /// Set the maximum solution iterations
   virtual void p_maximumIterations(const int& n) = 0;
 
+  /// Is the nonzero pattern assumed constant (specialized)
+  virtual bool p_constantPattern(void) const = 0;
+
+  /// Assume the nonzero pattern does not change (specialized)
+  virtual void p_constantPattern(const bool& flag) = 0;
+
+  /// Get the number of solves that reuse a preconditioner (specialized)
+  virtual int p_preconditionerReuse(void) const = 0;
+
+  /// Set the number of solves that reuse a preconditioner (specialized)
+  virtual void p_preconditionerReuse(const int& n) = 0;
+
+  /// Get the number of symbolic factorizations (specialized)
+  virtual int p_symbolicFactorizations(void) const = 0;
+
+  /// Get the number of numeric factorizations (specialized)
+  virtual int p_numericFactorizations(void) const = 0;
+
   /// Solve w/ the specified RHS, put result in specified vector
   /** 
    * Can be called repeatedly with different @c b and @c x vectors
@@ -230,6 +230,19 @@ public:
    */
   void multiplyDiagonal(const VectorT<T, I>& x);
 
+  /// Multiply each row of this matrix by the corresponding vector element
+  /** 
+   * @e Collective.
+   *
+   * Row @c i of the matrix is multiplied by element @c i of @c x,
+   * i.e., this matrix is replaced by diag(x)*A. The nonzero pattern
+   * is not changed. @c x must have the same length and parallel
+   * distribution as the matrix rows.
+   * 
+   * @param x row scale factors
+   */
+  void scaleRows(const VectorT<T, I>& x);
+
   /// Add the specified vector to the diagonal of this matrix
   /** 
    * @c Collective.
@@ -328,6 +341,22 @@ protected:
     p_matrix_impl->addElements(n, i, j, x); 
   }
 
+  /// Set a dense block of elements
+  void p_setBlock(const IdxType& ni, const IdxType *i,
+                  const IdxType& nj, const IdxType *j, 
+                  const TheType *x)
+  { 
+    p_matrix_impl->setBlock(ni, i, nj, j, x); 
+  }
+
+  /// Add to a dense block of elements
+  void p_addBlock(const IdxType& ni, const IdxType *i,
+                  const IdxType& nj, const IdxType *j, 
+                  const TheType *x)
+  { 
+    p_matrix_impl->addBlock(ni, i, nj, j, x); 
+  }
+
   /// Get an individual element
   void p_getElement(const IdxType& i, const IdxType& j, TheType& x) const
   { 
@@ -408,6 +437,58 @@ protected:
     p_matrix_impl->ready(); 
   }
 
+  /// Get the number of storage locations used for each matrix element
+  IdxType p_valueSlotSize(void) const
+  {
+    return p_matrix_impl->valueSlotSize();
+  }
+
+  /// Find the storage locations of several locally owned elements
+  bool p_valueSlots(const IdxType& n, 
+                    const IdxType *i, const IdxType *j,
+                    IdxType *slots) const
+  {
+    return p_matrix_impl->valueSlots(n, i, j, slots);
+  }
+
+  /// Overwrite several elements using storage locations from valueSlots()
+  void p_setValuesBySlot(const IdxType& n, const IdxType *slots,
+                         const TheType *x)
+  {
+    p_matrix_impl->setValuesBySlot(n, slots, x);
+  }
+
+  /// Add to several elements using storage locations from valueSlots()
+  void p_addValuesBySlot(const IdxType& n, const IdxType *slots,
+                         const TheType *x)
+  {
+    p_matrix_impl->addValuesBySlot(n, slots, x);
+  }
+
+  /// Prepare for a series of setValuesBySlot() or addValuesBySlot() calls
+  void p_beginValueSlots(void)
+  {
+    p_matrix_impl->beginValueSlots();
+  }
+
+  /// Finish a series of setValuesBySlot() or addValuesBySlot() calls
+  void p_endValueSlots(void)
+  {
+    p_matrix_impl->endValueSlots();
+  }
+
+  /// Get an identifier for the current nonzero structure of the matrix
+  long p_nonzeroState(void) const
+  {
+    return p_matrix_impl->nonzeroState();
+  }
+
+  /// Get an identifier for the storage underlying this matrix
+  long p_storageId(void) const
+  {
+    return p_matrix_impl->storageId();
+  }
+
   /// Print to named file or standard output
   void p_print(const char* filename = NULL) const
   {
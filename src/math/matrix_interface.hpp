@@ -171,6 +171,47 @@ public:
     this->p_addElements(n, i, j, x);
   }
 
+  /// Set a dense block of elements
+  /** 
+   * @e Local.
+   *
+   * This overwrites the values of all elements at the intersections
+   * of the specified rows and columns. ready() must be called after
+   * all setBlock() calls and before using the matrix.
+   * 
+   * @param ni number of rows in block
+   * @param i array of @c ni global, 0-based row indexes
+   * @param nj number of columns in block
+   * @param j array of @c nj global, 0-based column indexes
+   * @param x array of @c ni*nj values, row-major (@c x[a*nj+b] goes
+   * to row @c i[a], column @c j[b])
+   */
+  void setBlock(const IdxType& ni, const IdxType *i,
+                const IdxType& nj, const IdxType *j, const TheType *x)
+  {
+    this->p_setBlock(ni, i, nj, j, x);
+  }
+
+  /// Add to a dense block of elements
+  /** 
+   * @e Local.
+   *
+   * ready() must be called after all addBlock() calls and before
+   * using the matrix.
+   * 
+   * @param ni number of rows in block
+   * @param i array of @c ni global, 0-based row indexes
+   * @param nj number of columns in block
+   * @param j array of @c nj global, 0-based column indexes
+   * @param x array of @c ni*nj values, row-major (@c x[a*nj+b] goes
+   * to row @c i[a], column @c j[b])
+   */
+  void addBlock(const IdxType& ni, const IdxType *i,
+                const IdxType& nj, const IdxType *j, const TheType *x)
+  {
+    this->p_addBlock(ni, i, nj, j, x);
+  }
+
   /// Get an individual element
   /** 
    * @c Local.
@@ -378,6 +419,133 @@ public:
     this->p_saveBinary(filename);
   }
 
+  /// Get the number of storage locations used for each matrix element
+  /** 
+   * @e Local.
+   *
+   * Some math libraries store a single matrix element in more than
+   * one location (complex values stored as 2x2 real blocks, for
+   * example). This is the number of storage locations, or slots,
+   * that valueSlots() produces for each element. If zero, direct
+   * access to matrix storage is not supported.
+   * 
+   * @return number of storage slots per matrix element
+   */
+  IdxType valueSlotSize(void) const
+  {
+    return this->p_valueSlotSize();
+  }
+
+  /// Find the storage locations of several locally owned elements
+  /** 
+   * @e Local.
+   *
+   * The matrix must be ready() and all requested elements must be
+   * part of its nonzero structure. The slots returned can be passed
+   * to setValuesBySlot() or addValuesBySlot() to modify the values
+   * without searching for their location again. Slots remain valid
+   * as long as nonzeroState() does not change.
+   * 
+   * @param n number of elements
+   * @param i array of @c n global, 0-based row indexes
+   * @param j array of @c n global, 0-based column indexes
+   * @param slots array of @c n*valueSlotSize() storage locations
+   * 
+   * @return false if storage locations could not be found for all
+   * elements
+   */
+  bool valueSlots(const IdxType& n, const IdxType *i, const IdxType *j,
+                  IdxType *slots) const
+  {
+    return this->p_valueSlots(n, i, j, slots);
+  }
+
+  /// Overwrite several elements using storage locations from valueSlots()
+  /** 
+   * @e Local.
+   *
+   * ready() must be called after all setValuesBySlot() calls and
+   * before using the matrix.
+   * 
+   * @param n number of elements
+   * @param slots array of @c n*valueSlotSize() storage locations
+   * @param x array of @c n values
+   */
+  void setValuesBySlot(const IdxType& n, const IdxType *slots, const TheType *x)
+  {
+    this->p_setValuesBySlot(n, slots, x);
+  }
+
+  /// Add to several elements using storage locations from valueSlots()
+  /** 
+   * @e Local.
+   *
+   * ready() must be called after all addValuesBySlot() calls and
+   * before using the matrix.
+   * 
+   * @param n number of elements
+   * @param slots array of @c n*valueSlotSize() storage locations
+   * @param x array of @c n values
+   */
+  void addValuesBySlot(const IdxType& n, const IdxType *slots, const TheType *x)
+  {
+    this->p_addValuesBySlot(n, slots, x);
+  }
+
+  /// Prepare for a series of setValuesBySlot() or addValuesBySlot() calls
+  /** 
+   * @e Local.
+   *
+   * Gives access to the matrix storage until endValueSlots() is
+   * called, so it is not looked up again for every call. Calls to
+   * setValuesBySlot() or addValuesBySlot() outside of
+   * beginValueSlots() and endValueSlots() are still allowed, but
+   * each one looks up the storage. endValueSlots() must be called
+   * before ready().
+   */
+  void beginValueSlots(void)
+  {
+    this->p_beginValueSlots();
+  }
+
+  /// Finish a series of setValuesBySlot() or addValuesBySlot() calls
+  /** 
+   * @e Local.
+   */
+  void endValueSlots(void)
+  {
+    this->p_endValueSlots();
+  }
+
+  /// Get an identifier for the current nonzero structure of the matrix
+  /** 
+   * @e Local.
+   *
+   * The value changes whenever the nonzero structure of the matrix
+   * changes. 
+   * 
+   * @return nonzero structure identifier, or -1 if not available
+   */
+  long nonzeroState(void) const
+  {
+    return this->p_nonzeroState();
+  }
+
+  /// Get an identifier for the storage underlying this matrix
+  /** 
+   * @e Local.
+   *
+   * The value is unique among the matrices on this process, so it
+   * can be combined with nonzeroState() to decide whether storage
+   * locations found with valueSlots() still belong to this matrix.
+   * 
+   * @return storage identifier, or -1 if not available
+   */
+  long storageId(void) const
+  {
+    return this->p_storageId();
+  }
+
 protected:
 
   /// Get the global index range of the locally owned rows (specialized)
@@ -409,6 +577,30 @@ protected:
   virtual void p_addElements(const IdxType& n, const IdxType *i, const IdxType *j, 
                              const TheType *x) = 0;
 
+  /// Set a dense block of elements
+  virtual void p_setBlock(const IdxType& ni, const IdxType *i,
+                          const IdxType& nj, const IdxType *j, 
+                          const TheType *x)
+  {
+    for (IdxType a = 0; a < ni; ++a) {
+      for (IdxType b = 0; b < nj; ++b) {
+        this->p_setElement(i[a], j[b], x[a*nj + b]);
+      }
+    }
+  }
+
+  /// Add to a dense block of elements
+  virtual void p_addBlock(const IdxType& ni, const IdxType *i,
+                          const IdxType& nj, const IdxType *j, 
+                          const TheType *x)
+  {
+    for (IdxType a = 0; a < ni; ++a) {
+      for (IdxType b = 0; b < nj; ++b) {
+        this->p_addElement(i[a], j[b], x[a*nj + b]);
+      }
+    }
+  }
+
   /// Get an individual element (specialized)
   virtual void p_getElement(const IdxType& i, const IdxType& j, TheType& x) const = 0;
 
@@ -464,6 +656,53 @@ protected:
 
   /// Save to named file in whatever binary format the math library uses
   virtual void p_saveBinary(const char *filename) const = 0;
+
+  /// Get the number of storage locations used for each matrix element
+  virtual IdxType p_valueSlotSize(void) const
+  {
+    return 0;
+  }
+
+  /// Find the storage locations of several locally owned elements
+  virtual bool p_valueSlots(const IdxType& n, const IdxType *i, const IdxType *j,
+                            IdxType *slots) const
+  {
+    return false;
+  }
+
+  /// Overwrite several elements using storage locations from valueSlots()
+  virtual void p_setValuesBySlot(const IdxType& n, const IdxType *slots,
+                                 const TheType *x)
+  {
+  }
+
+  /// Add to several elements using storage locations from valueSlots()
+  virtual void p_addValuesBySlot(const IdxType& n, const IdxType *slots,
+                                 const TheType *x)
+  {
+  }
+
+  /// Prepare for a series of setValuesBySlot() or addValuesBySlot() calls
+  virtual void p_beginValueSlots(void)
+  {
+  }
+
+  /// Finish a series of setValuesBySlot() or addValuesBySlot() calls
+  virtual void p_endValueSlots(void)
+  {
+  }
+
+  /// Get an identifier for the current nonzero structure of the matrix
+  virtual long p_nonzeroState(void) const
+  {
+    return -1;
+  }
+
+  /// Get an identifier for the storage underlying this matrix
+  virtual long p_storageId(void) const
+  {
+    return -1;
+  }
 };
 
 
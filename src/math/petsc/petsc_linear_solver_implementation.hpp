@@ -50,7 +50,11 @@ public:
   PETScLinearSolverImplementation(MatrixType& A)
     : LinearSolverImplementation<T, I>(A),
       PETScConfigurable(this->communicator()),
-      p_matrixSet(false)
+      p_matrixSet(false),
+      p_lastMatrix(NULL),
+      p_lastNonzeroState(0),
+      p_pcAge(0),
+      p_factorReuseSet(false)
   {
   }
 
@@ -78,6 +82,18 @@ protected:
   /// For constant matrices, has the coefficient matrix been set
   mutable bool p_matrixSet;
 
+  /// The coefficient matrix used to build the current preconditioner
+  mutable Mat p_lastMatrix;
+
+  /// Nonzero state of the coefficient matrix used to build the current preconditioner
+  mutable PetscObjectState p_lastNonzeroState;
+
+  /// Number of solves that have used the current preconditioner
+  mutable int p_pcAge;
+
+  /// Have the factor reuse options been handed to the preconditioner
+  mutable bool p_factorReuseSet;
+
   /// Do what is necessary to build this instance
   void p_build(const std::string& option_prefix)
   {
@@ -95,6 +111,16 @@ protected:
       }
       ierr = KSPSetOptionsPrefix(p_KSP, option_prefix.c_str()); CHKERRXX(ierr);
 
+      // A rectangular coefficient matrix can only be handled as a least
+      // squares problem, so make LSQR without a preconditioner the
+      // default. Options from the configuration still take precedence
+      if (this->p_matrix.rows() != this->p_matrix.cols()) {
+        PC pc;
+        ierr = KSPSetType(p_KSP, KSPLSQR); CHKERRXX(ierr);
+        ierr = KSPGetPC(p_KSP, &pc); CHKERRXX(ierr);
+        ierr = PCSetType(pc, PCNONE); CHKERRXX(ierr);
+      }
+
       ierr = KSPSetTolerances(p_KSP, 
                               LinearSolverImplementation<T, I>::p_relativeTolerance, 
                               LinearSolverImplementation<T, I>::p_solutionTolerance, 
@@ -114,14 +140,54 @@ protected:
     try {
       Mat *Amat(PETScMatrix(A));
 
+      if (this->p_samePattern && !p_factorReuseSet) {
+        // keep ordering and fill of factored preconditioners (no
+        // effect for other preconditioner types)
+        PC pc;
+        ierr = KSPGetPC(p_KSP, &pc); CHKERRXX(ierr);
+        ierr = PCFactorSetReuseOrdering(pc, PETSC_TRUE); CHKERRXX(ierr);
+        ierr = PCFactorSetReuseFill(pc, PETSC_TRUE); CHKERRXX(ierr);
+        p_factorReuseSet = true;
+      }
+
       if (p_matrixSet && this->p_constSerialMatrix) {
         // KSPSetOperators can be skipped
       } else {
+
+        // A new symbolic factorization is needed if the matrix
+        // instance or its nonzero pattern changed
+        bool newPattern(!p_matrixSet || *Amat != p_lastMatrix);
+#if PETSC_VERSION_LT(3,5,0)
+        newPattern = newPattern || !this->p_samePattern;
+#else
+        PetscObjectState nzstate;
+        ierr = MatGetNonzeroState(*Amat, &nzstate); CHKERRXX(ierr);
+        newPattern = newPattern || (nzstate != p_lastNonzeroState);
+        p_lastNonzeroState = nzstate;
+#endif
+        bool reuse(!newPattern && p_pcAge < this->p_pcReuse);
+
 #if PETSC_VERSION_LT(3,5,0)
-        ierr = KSPSetOperators(p_KSP, *Amat, *Amat, SAME_NONZERO_PATTERN); CHKERRXX(ierr);
+        MatStructure flag(SAME_NONZERO_PATTERN);
+        if (reuse) {
+          flag = SAME_PRECONDITIONER;
+        } else if (newPattern) {
+          flag = DIFFERENT_NONZERO_PATTERN;
+        }
+        ierr = KSPSetOperators(p_KSP, *Amat, *Amat, flag); CHKERRXX(ierr);
 #else
+        ierr = KSPSetReusePreconditioner(p_KSP,
+                                         (reuse ? PETSC_TRUE : PETSC_FALSE)); CHKERRXX(ierr);
         ierr = KSPSetOperators(p_KSP, *Amat, *Amat); CHKERRXX(ierr);
 #endif
+        if (reuse) {
+          p_pcAge++;
+        } else {
+          if (newPattern) this->p_nSymbolic++;
+          this->p_nNumeric++;
+          p_pcAge = 1;
+        }
+        p_lastMatrix = *Amat;
         p_matrixSet = true;
       }
 
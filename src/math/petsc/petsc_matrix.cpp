@@ -284,6 +284,41 @@ template
 void
 MatrixT<RealType>::multiplyDiagonal(const VectorT<RealType>& x);
 
+// -------------------------------------------------------------
+// Matrix::scaleRows
+// -------------------------------------------------------------
+template <typename T, typename I>
+void
+MatrixT<T, I>::scaleRows(const VectorT<T, I>& x)
+{
+  if (x.size() != this->rows()) {
+    std::string msg = 
+      boost::str(boost::format("Matrix::scaleRows: size mismatch: Matrix rows: %d, Vector length: %d") %
+                 this->rows() % x.size());
+    throw Exception(msg);
+  }
+  if (PETScMatrixImplementation<T, I>::useLibrary) {
+    const Vec *pscale(PETScVector(x));
+    Mat *pA(PETScMatrix(*this));
+    PetscErrorCode ierr(0);
+    try {
+      ierr = MatDiagonalScale(*pA, *pscale, NULL); CHKERRXX(ierr);
+    } catch (const PETSC_EXCEPTION_TYPE& e) {
+      throw PETScException(ierr, e);
+    }
+  } else {
+    fallback::scaleRows<T, I>(*this, x);
+  }
+}
+
+template 
+void
+MatrixT<ComplexType>::scaleRows(const VectorT<ComplexType>& x);
+
+template 
+void
+MatrixT<RealType>::scaleRows(const VectorT<RealType>& x);
+
 // -------------------------------------------------------------
 // Matrix::storageType
 // -------------------------------------------------------------
@@ -20,6 +20,8 @@
 #ifndef _petsc_matrix_implementation_h_
 #define _petsc_matrix_implementation_h_
 
+#include <algorithm>
+#include <vector>
 #include <petscmat.h>
 #include <boost/scoped_ptr.hpp>
 #include <boost/format.hpp>
@@ -371,6 +373,74 @@ protected:
     }
   }
 
+  /// Set or add to a dense block of elements with a single MatSetValues() call
+  void p_setBlock(const IdxType& ni, const IdxType *i,
+                  const IdxType& nj, const IdxType *j, 
+                  const TheType *x, InsertMode mode)
+  {
+    PetscErrorCode ierr(0);
+    try {
+      Mat *mat = p_mwrap->getMatrix();
+      const int nrow(ni*elementSize), ncol(nj*elementSize);
+      std::vector<PetscInt> iidx(nrow), jidx(ncol);
+      for (IdxType a = 0; a < ni; ++a) {
+        for (unsigned int ii = 0; ii < elementSize; ++ii) {
+          iidx[a*elementSize + ii] = i[a]*elementSize + ii;
+        }
+      }
+      for (IdxType b = 0; b < nj; ++b) {
+        for (unsigned int jj = 0; jj < elementSize; ++jj) {
+          jidx[b*elementSize + jj] = j[b]*elementSize + jj;
+        }
+      }
+      std::vector<PetscScalar> px(nrow*ncol);
+      if (elementSize == 1) {
+        std::vector<TheType> tmp(x, x + ni*nj);
+        MatrixValueTransferToLibrary<TheType, PetscScalar> trans(ni*nj, &tmp[0], &px[0]);
+        trans.go();
+      } else {
+        // Each element becomes an elementSize x elementSize block, so
+        // spread the blocks out into the row-major array PETSc expects
+        PetscScalar pe[elementSize*elementSize];
+        for (IdxType a = 0; a < ni; ++a) {
+          for (IdxType b = 0; b < nj; ++b) {
+            TheType tmp(x[a*nj + b]);
+            MatrixValueTransferToLibrary<TheType, PetscScalar> trans(1, &tmp, &pe[0]);
+            trans.go();
+            for (unsigned int ii = 0; ii < elementSize; ++ii) {
+              for (unsigned int jj = 0; jj < elementSize; ++jj) {
+                px[(a*elementSize + ii)*ncol + b*elementSize + jj] =
+                  pe[ii*elementSize + jj];
+              }
+            }
+          }
+        }
+      }
+      if (nrow > 0 && ncol > 0) {
+        ierr = MatSetValues(*mat, nrow, &iidx[0], ncol, &jidx[0], &px[0], mode); 
+        CHKERRXX(ierr);
+      }
+    } catch (const PETSC_EXCEPTION_TYPE& e) {
+      throw PETScException(ierr, e);
+    }
+  }
+
+  /// Set a dense block of elements (specialized)
+  void p_setBlock(const IdxType& ni, const IdxType *i,
+                  const IdxType& nj, const IdxType *j, 
+                  const TheType *x)
+  {
+    p_setBlock(ni, i, nj, j, x, INSERT_VALUES);
+  }
+
+  /// Add to a dense block of elements (specialized)
+  void p_addBlock(const IdxType& ni, const IdxType *i,
+                  const IdxType& nj, const IdxType *j, 
+                  const TheType *x)
+  {
+    p_setBlock(ni, i, nj, j, x, ADD_VALUES);
+  }
+
   /// Add to  an individual element
   void p_addElement(const IdxType& i, const IdxType& j, const TheType& x)
   {
@@ -418,6 +488,274 @@ protected:
     }
   }
 
+  /// Get the sequential AIJ parts of the PETSc matrix, if that's what it is
+  /** 
+   * For a sequential AIJ matrix, @c Ad is the matrix itself and @c
+   * Ao is NULL. For a parallel AIJ matrix, @c Ad and @c Ao are the
+   * diagonal and off-diagonal blocks, and @c colmap maps @c Ao's
+   * local column indexes to global column indexes.
+   * 
+   * @return false if the matrix is not an assembled AIJ matrix
+   */
+  bool p_aijParts(Mat& Ad, Mat& Ao, const PetscInt*& colmap) const
+  {
+    PetscErrorCode ierr(0);
+    try {
+      Mat mat(*(const_cast<Mat*>(p_mwrap->getMatrix())));
+      PetscBool isseq, ismpi, assembled;
+      ierr = PetscObjectTypeCompare((PetscObject)mat, MATSEQAIJ, &isseq); CHKERRXX(ierr);
+      ierr = PetscObjectTypeCompare((PetscObject)mat, MATMPIAIJ, &ismpi); CHKERRXX(ierr);
+      if (!isseq && !ismpi) return false;
+      ierr = MatAssembled(mat, &assembled); CHKERRXX(ierr);
+      if (!assembled) return false;
+      if (ismpi) {
+        ierr = MatMPIAIJGetSeqAIJ(mat, &Ad, &Ao, &colmap); CHKERRXX(ierr);
+      } else {
+        Ad = mat;
+        Ao = NULL;
+        colmap = NULL;
+      }
+    } catch (const PETSC_EXCEPTION_TYPE& e) {
+      throw PETScException(ierr, e);
+    }
+    return true;
+  }
+
+  /// Get the number of storage locations used for each matrix element (specialized)
+  IdxType p_valueSlotSize(void) const
+  {
+    return elementSize*elementSize;
+  }
+
+  /// Find the storage locations of several locally owned elements (specialized)
+  /** 
+   * Slots index the value array of the diagonal block, followed by
+   * the value array of the off-diagonal block (if any).
+   */
+  bool p_valueSlots(const IdxType& n, const IdxType *i, const IdxType *j,
+                    IdxType *slots) const
+  {
+    Mat Ad, Ao;
+    const PetscInt *colmap;
+    if (!p_aijParts(Ad, Ao, colmap)) return false;
+
+    PetscErrorCode ierr(0);
+    bool ok(true);
+    try {
+      const Mat *mat = p_mwrap->getMatrix();
+      PetscInt rlo, rhi, clo, chi;
+      ierr = MatGetOwnershipRange(*mat, &rlo, &rhi); CHKERRXX(ierr);
+      ierr = MatGetOwnershipRangeColumn(*mat, &clo, &chi); CHKERRXX(ierr);
+
+      PetscInt dn, on(0);
+      const PetscInt *dia, *dja, *oia(NULL), *oja(NULL);
+      PetscBool ddone, odone(PETSC_TRUE);
+      ierr = MatGetRowIJ(Ad, 0, PETSC_FALSE, PETSC_FALSE, 
+                         &dn, &dia, &dja, &ddone); CHKERRXX(ierr);
+      if (Ao != NULL) {
+        ierr = MatGetRowIJ(Ao, 0, PETSC_FALSE, PETSC_FALSE, 
+                           &on, &oia, &oja, &odone); CHKERRXX(ierr);
+      }
+      ok = (ddone && odone);
+      PetscInt dnnz(ok ? dia[dn] : 0);
+
+      for (IdxType k = 0; ok && k < n; ++k) {
+        for (unsigned int ii = 0; ok && ii < elementSize; ++ii) {
+          PetscInt row(i[k]*elementSize + ii);
+          if (row < rlo || row >= rhi) {
+            ok = false;
+            break;
+          }
+          PetscInt lrow(row - rlo);
+          for (unsigned int jj = 0; jj < elementSize; ++jj) {
+            PetscInt col(j[k]*elementSize + jj);
+            PetscInt slot(-1);
+            if (col >= clo && col < chi) {
+              const PetscInt *b(dja + dia[lrow]), *e(dja + dia[lrow+1]);
+              const PetscInt *p(std::lower_bound(b, e, col - clo));
+              if (p != e && *p == col - clo) slot = p - dja;
+            } else if (Ao != NULL) {
+              // colmap is sorted, so off-diagonal columns are too
+              PetscInt lo(oia[lrow]), hi(oia[lrow+1]);
+              while (lo < hi) {
+                PetscInt mid((lo + hi)/2);
+                if (colmap[oja[mid]] < col) {
+                  lo = mid + 1;
+                } else {
+                  hi = mid;
+                }
+              }
+              if (lo < oia[lrow+1] && colmap[oja[lo]] == col) slot = dnnz + lo;
+            }
+            if (slot < 0) {
+              ok = false;
+              break;
+            }
+            slots[k*elementSize*elementSize + ii*elementSize + jj] = slot;
+          }
+        }
+      }
+
+      ierr = MatRestoreRowIJ(Ad, 0, PETSC_FALSE, PETSC_FALSE, 
+                             &dn, &dia, &dja, &ddone); CHKERRXX(ierr);
+      if (Ao != NULL) {
+        ierr = MatRestoreRowIJ(Ao, 0, PETSC_FALSE, PETSC_FALSE, 
+                               &on, &oia, &oja, &odone); CHKERRXX(ierr);
+      }
+    } catch (const PETSC_EXCEPTION_TYPE& e) {
+      throw PETScException(ierr, e);
+    }
+    return ok;
+  }
+
+  /// Value arrays of the AIJ parts, while slots are in use
+  struct SlotAccess {
+    bool open;
+    Mat Ad, Ao;
+    PetscInt dnnz;
+    PetscScalar *da, *oa;
+    SlotAccess(void)
+      : open(false), Ad(NULL), Ao(NULL), dnnz(0), da(NULL), oa(NULL)
+    {}
+  };
+
+  /// The current slot access, if any
+  SlotAccess p_slots;
+
+  /// Prepare for a series of setValuesBySlot() or addValuesBySlot() calls (specialized)
+  /** 
+   * The value arrays of the AIJ parts are fetched here once and kept
+   * until p_endValueSlots().
+   */
+  void p_beginValueSlots(void)
+  {
+    if (p_slots.open) return;
+    const PetscInt *colmap;
+    if (!p_aijParts(p_slots.Ad, p_slots.Ao, colmap)) {
+      throw gridpack::Exception("PETScMatrixImplementation: "
+                                "matrix does not support storage slots");
+    }
+    PetscErrorCode ierr(0);
+    try {
+      PetscInt dn;
+      const PetscInt *dia, *dja;
+      PetscBool done;
+      ierr = MatGetRowIJ(p_slots.Ad, 0, PETSC_FALSE, PETSC_FALSE, 
+                         &dn, &dia, &dja, &done); CHKERRXX(ierr);
+      p_slots.dnnz = dia[dn];
+      ierr = MatRestoreRowIJ(p_slots.Ad, 0, PETSC_FALSE, PETSC_FALSE, 
+                             &dn, &dia, &dja, &done); CHKERRXX(ierr);
+
+      ierr = MatSeqAIJGetArray(p_slots.Ad, &p_slots.da); CHKERRXX(ierr);
+      p_slots.oa = NULL;
+      if (p_slots.Ao != NULL) {
+        ierr = MatSeqAIJGetArray(p_slots.Ao, &p_slots.oa); CHKERRXX(ierr);
+      }
+    } catch (const PETSC_EXCEPTION_TYPE& e) {
+      throw PETScException(ierr, e);
+    }
+    p_slots.open = true;
+  }
+
+  /// Finish a series of setValuesBySlot() or addValuesBySlot() calls (specialized)
+  /** 
+   * The value arrays are returned and the matrix is marked as
+   * changed, once for the whole series.
+   */
+  void p_endValueSlots(void)
+  {
+    if (!p_slots.open) return;
+    PetscErrorCode ierr(0);
+    try {
+      ierr = MatSeqAIJRestoreArray(p_slots.Ad, &p_slots.da); CHKERRXX(ierr);
+      if (p_slots.Ao != NULL) {
+        ierr = MatSeqAIJRestoreArray(p_slots.Ao, &p_slots.oa); CHKERRXX(ierr);
+      }
+      Mat *mat = p_mwrap->getMatrix();
+      ierr = PetscObjectStateIncrease((PetscObject)(*mat)); CHKERRXX(ierr);
+    } catch (const PETSC_EXCEPTION_TYPE& e) {
+      throw PETScException(ierr, e);
+    }
+    p_slots = SlotAccess();
+  }
+
+  /// Overwrite or add to several elements using storage locations from valueSlots()
+  void p_setValuesBySlot(const IdxType& n, const IdxType *slots, const TheType *x,
+                         InsertMode mode)
+  {
+    bool single(!p_slots.open);
+    if (single) p_beginValueSlots();
+
+    const unsigned int bsize(elementSize*elementSize);
+    const PetscInt dnnz(p_slots.dnnz);
+    PetscScalar *da(p_slots.da), *oa(p_slots.oa);
+    PetscScalar px[elementSize*elementSize];
+    for (IdxType k = 0; k < n; ++k) {
+      TheType tmp(x[k]);
+      MatrixValueTransferToLibrary<TheType, PetscScalar> trans(1, &tmp, &px[0]);
+      trans.go();
+      for (unsigned int b = 0; b < bsize; ++b) {
+        IdxType slot(slots[k*bsize + b]);
+        PetscScalar *v(slot < dnnz ? &da[slot] : &oa[slot - dnnz]);
+        if (mode == ADD_VALUES) {
+          *v += px[b];
+        } else {
+          *v = px[b];
+        }
+      }
+    }
+
+    if (single) p_endValueSlots();
+  }
+
+  /// Overwrite several elements using storage locations from valueSlots() (specialized)
+  void p_setValuesBySlot(const IdxType& n, const IdxType *slots, const TheType *x)
+  {
+    p_setValuesBySlot(n, slots, x, INSERT_VALUES);
+  }
+
+  /// Add to several elements using storage locations from valueSlots() (specialized)
+  void p_addValuesBySlot(const IdxType& n, const IdxType *slots, const TheType *x)
+  {
+    p_setValuesBySlot(n, slots, x, ADD_VALUES);
+  }
+
+  /// Get an identifier for the current nonzero structure of the matrix (specialized)
+  long p_nonzeroState(void) const
+  {
+    long result(-1);
+#if PETSC_VERSION_GE(3,7,0)
+    PetscErrorCode ierr(0);
+    try {
+      const Mat *mat = p_mwrap->getMatrix();
+      PetscObjectState state;
+      ierr = MatGetNonzeroState(*mat, &state); CHKERRXX(ierr);
+      result = static_cast<long>(state);
+    } catch (const PETSC_EXCEPTION_TYPE& e) {
+      throw PETScException(ierr, e);
+    }
+#endif
+    return result;
+  }
+
+  /// Get an identifier for the storage underlying this matrix (specialized)
+  long p_storageId(void) const
+  {
+    long result(-1);
+#if PETSC_VERSION_GE(3,7,0)
+    PetscErrorCode ierr(0);
+    try {
+      const Mat *mat = p_mwrap->getMatrix();
+      PetscObjectId id;
+      ierr = PetscObjectGetId((PetscObject)(*mat), &id); CHKERRXX(ierr);
+      result = static_cast<long>(id);
+    } catch (const PETSC_EXCEPTION_TYPE& e) {
+      throw PETScException(ierr, e);
+    }
+#endif
+    return result;
+  }
+
           
 
   /// Scale this entire MatrixT by the given value (specialized)
@@ -635,6 +973,7 @@ protected:
   /// Make this instance ready to use
   void p_ready(void)
   {
+    p_endValueSlots();
     p_mwrap->ready();
   }
 
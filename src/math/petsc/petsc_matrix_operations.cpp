@@ -378,6 +378,80 @@ multiply_dense(const Mat& A, const Mat& B, Mat& C)
   return ierr;
 }
 
+#if PETSC_VERSION_GE(3,7,0)
+// -------------------------------------------------------------
+// Matrix product records
+//
+// A matrix made by MatMatMult carries a record of the operands it
+// was made from. MatMatMult can reuse the matrix (MAT_REUSE_MATRIX)
+// only if it is called again with the same operands and none of the
+// three matrices has changed its nonzero structure. Objects are
+// identified by their PETSc id, which is never reused.
+// -------------------------------------------------------------
+struct MatProductRecord {
+  PetscObjectId A, B, C;
+  PetscObjectState Astate, Bstate, Cstate;
+};
+
+static const char *productRecordName = "GridPACK_MatProductRecord";
+
+static
+PetscErrorCode
+makeProductRecord(const Mat& A, const Mat& B, const Mat& C,
+                  MatProductRecord *rec)
+{
+  PetscErrorCode ierr(0);
+  ierr = PetscObjectGetId((PetscObject)A, &rec->A); CHKERRQ(ierr);
+  ierr = PetscObjectGetId((PetscObject)B, &rec->B); CHKERRQ(ierr);
+  ierr = PetscObjectGetId((PetscObject)C, &rec->C); CHKERRQ(ierr);
+  ierr = MatGetNonzeroState(A, &rec->Astate); CHKERRQ(ierr);
+  ierr = MatGetNonzeroState(B, &rec->Bstate); CHKERRQ(ierr);
+  ierr = MatGetNonzeroState(C, &rec->Cstate); CHKERRQ(ierr);
+  return ierr;
+}
+
+static
+PetscErrorCode
+productReusable(const Mat& A, const Mat& B, const Mat& C, bool *reuse)
+{
+  PetscErrorCode ierr(0);
+  PetscContainer container(NULL);
+  MatProductRecord current, *saved;
+  *reuse = false;
+  ierr = PetscObjectQuery((PetscObject)C, productRecordName,
+                          (PetscObject*)&container); CHKERRQ(ierr);
+  if (container == NULL) return ierr;
+  ierr = PetscContainerGetPointer(container, (void**)&saved); CHKERRQ(ierr);
+  ierr = makeProductRecord(A, B, C, &current); CHKERRQ(ierr);
+  *reuse = (current.A == saved->A && current.B == saved->B &&
+            current.C == saved->C &&
+            current.Astate == saved->Astate &&
+            current.Bstate == saved->Bstate &&
+            current.Cstate == saved->Cstate);
+  return ierr;
+}
+
+static
+PetscErrorCode
+saveProductRecord(const Mat& A, const Mat& B, const Mat& C)
+{
+  PetscErrorCode ierr(0);
+  PetscContainer container;
+  MatProductRecord *rec;
+  ierr = PetscMalloc(sizeof(MatProductRecord), &rec); CHKERRQ(ierr);
+  ierr = makeProductRecord(A, B, C, rec); CHKERRQ(ierr);
+  ierr = PetscContainerCreate(PetscObjectComm((PetscObject)C),
+                              &container); CHKERRQ(ierr);
+  ierr = PetscContainerSetPointer(container, rec); CHKERRQ(ierr);
+  ierr = PetscContainerSetUserDestroy(container,
+                                      PetscContainerUserDestroyDefault); CHKERRQ(ierr);
+  ierr = PetscObjectCompose((PetscObject)C, productRecordName,
+                            (PetscObject)container); CHKERRQ(ierr);
+  ierr = PetscContainerDestroy(&container); CHKERRQ(ierr);
+  return ierr;
+}
+#endif
+
 // -------------------------------------------------------------
 // (Matrix) multiply
 // -------------------------------------------------------------
@@ -402,8 +476,21 @@ multiply(const MatrixT<T, I>& A, const MatrixT<T, I>& B, MatrixT<T, I>& result)
     Mat *Cmat(PETScMatrix(result));
     
     try {
-      ierr = MatDestroy(Cmat); CHKERRXX(ierr);
-      ierr = MatMatMult(*Amat, *Bmat, MAT_INITIAL_MATRIX, PETSC_DEFAULT, Cmat); CHKERRXX(ierr);
+      // If result was made by an earlier call with the same operands and
+      // nonzero structure, only the numeric part of the product is needed
+      bool reuse(false);
+#if PETSC_VERSION_GE(3,7,0)
+      ierr = productReusable(*Amat, *Bmat, *Cmat, &reuse); CHKERRXX(ierr);
+#endif
+      if (reuse) {
+        ierr = MatMatMult(*Amat, *Bmat, MAT_REUSE_MATRIX, PETSC_DEFAULT, Cmat); CHKERRXX(ierr);
+      } else {
+        ierr = MatDestroy(Cmat); CHKERRXX(ierr);
+        ierr = MatMatMult(*Amat, *Bmat, MAT_INITIAL_MATRIX, PETSC_DEFAULT, Cmat); CHKERRXX(ierr);
+      }
+#if PETSC_VERSION_GE(3,7,0)
+      ierr = saveProductRecord(*Amat, *Bmat, *Cmat); CHKERRXX(ierr);
+#endif
     } catch (const PETSC_EXCEPTION_TYPE& e) {
       throw PETScException(ierr, e);
     }
@@ -447,6 +534,9 @@ multiply(const MatrixT<T, I>& A, const MatrixT<T, I>& B)
 
     try {
       ierr = MatMatMult(*Amat, *Bmat, MAT_INITIAL_MATRIX, PETSC_DEFAULT, &Cmat); CHKERRXX(ierr);
+#if PETSC_VERSION_GE(3,7,0)
+      ierr = saveProductRecord(*Amat, *Bmat, Cmat); CHKERRXX(ierr);
+#endif
     } catch (const PETSC_EXCEPTION_TYPE& e) {
       throw PETScException(ierr, e);
     }
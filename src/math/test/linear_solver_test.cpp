@@ -218,6 +218,61 @@ BOOST_AUTO_TEST_CASE( Versteeg )
   }
 }
 
+// -------------------------------------------------------------
+// Solve the Versteeg problem several times, changing only the
+// coefficient matrix values, and make sure the symbolic
+// factorization is only done once
+// -------------------------------------------------------------
+BOOST_AUTO_TEST_CASE( VersteegConstantPattern )
+{
+  gridpack::parallel::Communicator world;
+
+  static const int imax = 3*world.size();
+  static const int jmax = 4*world.size();
+  static const int global_size = imax*jmax;
+  int local_size(global_size/world.size());
+
+  std::auto_ptr<gridpack::math::RealMatrix> 
+    A(new gridpack::math::RealMatrix(world, local_size, local_size, 
+                                 gridpack::math::Sparse));
+  std::auto_ptr<gridpack::math::RealVector>
+    b(new gridpack::math::RealVector(world, local_size)),
+    x(new gridpack::math::RealVector(world, local_size));
+
+  assemble(imax, jmax, *A, *b);
+  A->ready();
+  b->ready();
+
+  std::auto_ptr<gridpack::math::RealLinearSolver> 
+    solver(new gridpack::math::RealLinearSolver(*A));
+
+  BOOST_REQUIRE(test_config);
+  solver->configure(test_config);
+  solver->constantPattern(true);
+  BOOST_CHECK(solver->constantPattern());
+
+  static const int nsolve(3);
+  for (int n = 0; n < nsolve; ++n) {
+    if (n > 0) A->scale(2.0);
+    x->fill(0.0);
+    x->ready();
+    solver->solve(*b, *x);
+
+    std::auto_ptr<gridpack::math::RealVector>
+      res(multiply(*A, *x));
+    res->add(*b, -1.0);
+    double l2norm(res->norm2());
+    if (world.rank() == 0) {
+      std::cout << "Solve " << n << ": Residual L2 Norm = " 
+                << l2norm << std::endl;
+    }
+    BOOST_CHECK(l2norm < 1.0e-05);
+  }
+
+  BOOST_CHECK_EQUAL(solver->symbolicFactorizations(), 1);
+  BOOST_CHECK_EQUAL(solver->numericFactorizations(), nsolve);
+}
+
 // FIXME
 BOOST_AUTO_TEST_CASE ( VersteegInverse )
 {
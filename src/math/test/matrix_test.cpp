@@ -356,6 +356,45 @@ BOOST_AUTO_TEST_CASE( accumulate )
   }
 }
 
+BOOST_AUTO_TEST_CASE( block_set_and_add )
+{
+  gridpack::parallel::Communicator world;
+  int global_size;
+  boost::mpi::all_reduce(world, local_size, global_size, std::plus<int>());
+
+  TestMatrixType 
+    A(world, local_size, global_size, the_storage_type);
+
+  int lo, hi;
+  A.localRowRange(lo, hi);
+
+  // a dense block covering the local rows and the same columns, with
+  // distinct row and column contributions to check the ordering
+
+  int n(hi - lo);
+  std::vector<int> idx(n);
+  std::vector<TestType> x(n*n);
+  for (int a = 0; a < n; ++a) {
+    idx[a] = lo + a;
+    for (int b = 0; b < n; ++b) {
+      x[a*n + b] = TestType(static_cast<double>((lo + a)*global_size + lo + b));
+    }
+  }
+  A.setBlock(n, &idx[0], n, &idx[0], &x[0]);
+  A.ready();
+  A.addBlock(n, &idx[0], n, &idx[0], &x[0]);
+  A.ready();
+
+  for (int i = lo; i < hi; ++i) {
+    for (int j = lo; j < hi; ++j) {
+      TestType expected(static_cast<double>(2*(i*global_size + j)));
+      TestType y;
+      A.getElement(i, j, y);
+      TEST_VALUE_CLOSE(expected, y, delta);
+    }
+  }
+}
+
 BOOST_AUTO_TEST_CASE( local_clone )
 {
   gridpack::parallel::Communicator world;
@@ -847,6 +886,34 @@ BOOST_AUTO_TEST_CASE( MultiplyDiagonalTest )
   }
 }
 
+BOOST_AUTO_TEST_CASE( ScaleRowsTest )
+{
+  int global_size;
+  gridpack::parallel::Communicator world;
+  boost::scoped_ptr<TestMatrixType> 
+    A(make_and_fill_test_matrix(world, 3, global_size));
+  boost::scoped_ptr<TestVectorType>
+    rscale(new TestVectorType(A->communicator(), A->localRows()));
+
+  int lo, hi;
+  A->localRowRange(lo, hi);
+  for (int i = lo; i < hi; ++i) {
+    rscale->setElement(i, static_cast<TestType>(i+1));
+  }
+  rscale->ready();
+
+  A->scaleRows(*rscale);
+
+  for (int i = lo; i < hi; ++i) {
+    TestType x(static_cast<TestType>(i)*static_cast<TestType>(i+1)), y;
+    int jmin(std::max(i-1, 0)), jmax(std::min(i+1,global_size-1));
+    for (int j = jmin; j <= jmax; ++j) {
+      A->getElement(i, j, y);
+      TEST_VALUE_CLOSE(x, y, delta);
+    }
+  }
+}
+
 BOOST_AUTO_TEST_CASE( MultiplyIdentity )
 {
   static const int bandwidth(3);
@@ -874,6 +941,42 @@ BOOST_AUTO_TEST_CASE( MultiplyIdentity )
   }
 }
 
+BOOST_AUTO_TEST_CASE( MultiplyInPlace )
+{
+  static const int bandwidth(3);
+  int global_size;
+  gridpack::parallel::Communicator world;
+  boost::scoped_ptr<TestMatrixType> 
+    A(make_and_fill_test_matrix(world, bandwidth, global_size)),
+    B(new TestMatrixType(A->communicator(), A->localRows(), A->localCols(), 
+                                 gridpack::math::Sparse));
+  B->identity();
+  boost::scoped_ptr<TestMatrixType> 
+    C(gridpack::math::multiply(*A, *B));
+
+  // The operands keep their nonzero structure, so the product should be
+  // updated in place
+  long id(C->storageId());
+  int lo, hi;
+  A->localRowRange(lo, hi);
+  for (int pass = 0; pass < 2; ++pass) {
+    A->scale(2.0);
+    gridpack::math::multiply(*A, *B, *C);
+    if (id >= 0) {
+      BOOST_CHECK_EQUAL(C->storageId(), id);
+    }
+    for (int i = lo; i < hi; ++i) {
+      int jmin(std::max(i-1, 0)), jmax(std::min(i+1,global_size-1));
+      for (int j = jmin; j <= jmax; ++j) {
+        TestType x, y;
+        A->getElement(i, j, x);
+        C->getElement(i, j, y);
+        TEST_VALUE_CLOSE(x, y, delta);
+      }
+    }
+  }
+}
+
 static void
 testMatrixMultiply(TestMatrixType *A,
                    TestMatrixType *B)
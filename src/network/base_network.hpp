@@ -19,19 +19,31 @@
 #define _base_network_h_
 
 #include <fstream>
+#include <sstream>
 #include <iomanip>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 #include <vector>
 #include <map>
+#include <algorithm>
 #include <boost/smart_ptr/shared_ptr.hpp>
+#include <boost/mpi/collectives.hpp>
 #include <boost/serialization/singleton.hpp>
 #include <boost/serialization/extended_type_info.hpp>
 #include <boost/serialization/shared_ptr.hpp>
 #include <boost/type_traits.hpp>
+#include <boost/archive/binary_oarchive.hpp>
+#include <boost/archive/binary_iarchive.hpp>
 #include <ga.h>
 #include "gridpack/parallel/distributed.hpp"
 #include "gridpack/parallel/index_hash.hpp"
 #include "gridpack/component/base_component.hpp"
 #include "gridpack/component/data_collection.hpp"
+#include "gridpack/network/component_arena.hpp"
 #include "gridpack/partition/graph_partitioner.hpp"
 #include "gridpack/parallel/shuffler.hpp"
 #include "gridpack/parallel/ga_shuffler.hpp"
@@ -59,7 +71,8 @@ BusData(void)
     p_branchNeighbors(),
     p_bus(new _bus),
     p_data(new gridpack::component::DataCollection),
-    p_refFlag(false)
+    p_refFlag(false),
+    p_cost(0.0)
 {
 }
 
@@ -71,7 +84,8 @@ BusData(const BusData& old)
     p_branchNeighbors(old.p_branchNeighbors),
     p_bus(old.p_bus),
     p_data(old.p_data),
-    p_refFlag(old.p_refFlag)
+    p_refFlag(old.p_refFlag),
+    p_cost(old.p_cost)
 {}
 
 /**
@@ -94,6 +108,7 @@ BusData<_bus> & operator=(const BusData<_bus> & rhs)
   p_bus = rhs.p_bus;
   p_data = rhs.p_data;
   p_refFlag = rhs.p_refFlag;
+  p_cost = rhs.p_cost;
   return *this;
 }
 
@@ -106,6 +121,7 @@ BusData<_bus> & operator=(const BusData<_bus> & rhs)
  * p_bus: pointer to bus object
  * p_data: pointer to data collection object
  * p_refFlag: true if this bus is the reference bus
+ * p_cost: measured cost of computations on this bus (used by repartition)
  */
   bool                                                   p_activeBus;
   int                                                    p_originalBusIndex;
@@ -114,6 +130,7 @@ BusData<_bus> & operator=(const BusData<_bus> & rhs)
   boost::shared_ptr<_bus>                                p_bus;
   boost::shared_ptr<component::DataCollection>           p_data;
   bool                                                   p_refFlag;
+  double                                                 p_cost;
 
 private: 
 
@@ -128,7 +145,8 @@ private:
       & p_branchNeighbors
       & *p_bus
       & *p_data
-      & p_refFlag;
+      & p_refFlag
+      & p_cost;
   }
 
 };
@@ -244,6 +262,69 @@ private:
   }
 
 };
+
+// -------------------------------------------------------------
+// A simple data class that holds the communication pattern used
+// to exchange ghost data directly between the process that owns a
+// bus or branch and the processes that hold ghost copies of it
+// -------------------------------------------------------------
+class GhostExchangePlan {
+public:
+
+/**
+ *  Default constructor
+ */
+GhostExchangePlan(void)
+{
+}
+
+/**
+ *  Default destructor
+ */
+~GhostExchangePlan(void)
+{
+}
+
+/**
+ *  Remove all send and receive lists from plan
+ */
+void clear(void)
+{
+  p_sendProcs.clear();
+  p_sendOffsets.clear();
+  p_sendIndices.clear();
+  p_recvProcs.clear();
+  p_recvOffsets.clear();
+  p_recvIndices.clear();
+  p_sendBuf.clear();
+  p_recvBuf.clear();
+  p_requests.clear();
+}
+
+/**
+ * Data elements in plan
+ * p_sendProcs: processes that hold ghost copies of local active elements
+ * p_sendOffsets: offsets into p_sendIndices for each process in p_sendProcs
+ * p_sendIndices: local indices of active elements that are sent to each
+ *      process in p_sendProcs
+ * p_recvProcs: processes that own the active copy of local ghost elements
+ * p_recvOffsets: offsets into p_recvIndices for each process in p_recvProcs
+ * p_recvIndices: local indices of ghost elements that are received from each
+ *      process in p_recvProcs
+ * p_sendBuf: buffer for packing outgoing data
+ * p_recvBuf: buffer for receiving incoming data
+ * p_requests: MPI requests for outstanding messages
+ */
+  std::vector<int>                                       p_sendProcs;
+  std::vector<int>                                       p_sendOffsets;
+  std::vector<int>                                       p_sendIndices;
+  std::vector<int>                                       p_recvProcs;
+  std::vector<int>                                       p_recvOffsets;
+  std::vector<int>                                       p_recvIndices;
+  std::vector<char>                                      p_sendBuf;
+  std::vector<char>                                      p_recvBuf;
+  std::vector<MPI_Request>                               p_requests;
+};
 /** @endcond */
 
 /**
@@ -307,6 +388,15 @@ explicit BaseNetwork(const parallel::Communicator& comm)
   p_external_branch = false;
   p_allocatedBus = false;
   p_allocatedBranch = false;
+  p_neighborXC = false;
+  p_busNeighborXC = false;
+  p_branchNeighborXC = false;
+  p_busUpdatePending = false;
+  p_branchUpdatePending = false;
+  p_matrixPartitionWeights = false;
+  p_timedBus = -1;
+  p_busTimerStart = 0.0;
+  p_arenaStorage = false;
 }
 
 /**
@@ -985,206 +1075,483 @@ void assemble(void)
 }
 
 /**
- * Partition the network over the available processes
+ * Select the weights used to balance the partition. Buses are always
+ * weighted by the workload estimate returned by getWorkload. If flag is
+ * true, the estimate of matrix rows returned by getMatrixWorkload is used
+ * as a second weight and the partitioner tries to balance both. This
+ * function must be called before partition to have any effect.
+ * @param flag true if matrix rows should also be balanced
+ */
+void setMatrixPartitionWeights(bool flag)
+{
+  p_matrixPartitionWeights = flag;
+}
+
+/**
+ * Return the load imbalance achieved by the last call to partition. There is
+ * one value for each partitioning weight (workload, then matrix rows if
+ * setMatrixPartitionWeights was called). Each value is the largest total
+ * weight on any process divided by the average, so 1.0 is perfect balance
+ * @param imbalance imbalance for each weight
+ */
+void getPartitionImbalance(std::vector<double> &imbalance) const
+{
+  imbalance = p_partitionImbalance;
+}
+
+/**
+ * Partition the network over the available processes. Buses are weighted
+ * by the workload estimates of their components (see
+ * setMatrixPartitionWeights)
  */
 void partition(void)
 {
-  gridpack::utility::CoarseTimer *timer;
-  timer = NULL;
-//  timer = gridpack::utility::CoarseTimer::instance();
+  partitionNetwork(false, 0.0, NULL);
+}
 
-  int t_total(0), t_part(0), t_bus_dist(0), t_branch_dist(0);
+/**
+ * Accumulate measured computation time on a bus. These times are used as
+ * partitioning weights by repartition
+ * @param idx local index of bus
+ * @param cost time (or other measure of cost) to add
+ */
+void addBusCost(int idx, double cost)
+{
+  if (idx<0 || idx >= p_buses.size()) {
+    char buf[256];
+    sprintf(buf,"BaseNetwork::addBusCost: illegal index: %d size: %d\n",
+        idx, static_cast<int>(p_buses.size()));
+    printf("%s",buf);
+    throw gridpack::Exception(buf);
+  }
+  p_buses[idx].p_cost += cost;
+}
 
-  if (timer != NULL) {
-    t_total = timer->createCategory("BaseNetwork<>::partition(): Total");
-    t_part = timer->createCategory("BaseNetwork<>::partition(): Partitioner");
-    t_bus_dist = timer->createCategory("BaseNetwork<>::partition(): Bus Distribution");
-    t_branch_dist = timer->createCategory("BaseNetwork<>::partition(): Branch Distribution");
+/**
+ * Return the cost accumulated on a bus since the last call to
+ * resetBusCosts or repartition
+ * @param idx local index of bus
+ * @return accumulated cost
+ */
+double getBusCost(int idx) const
+{
+  if (idx<0 || idx >= p_buses.size()) {
+    char buf[256];
+    sprintf(buf,"BaseNetwork::getBusCost: illegal index: %d size: %d\n",
+        idx, static_cast<int>(p_buses.size()));
+    printf("%s",buf);
+    throw gridpack::Exception(buf);
   }
+  return p_buses[idx].p_cost;
+}
 
-  if (timer != NULL) timer->start(t_total);
+/**
+ * Set the accumulated cost of all buses to zero
+ */
+void resetBusCosts(void)
+{
+  for (BusIterator bus = p_buses.begin(); bus != p_buses.end(); ++bus) {
+    bus->p_cost = 0.0;
+  }
+}
 
-  if (timer != NULL) timer->start(t_part);
+/**
+ * Start timing work on a bus. Only one bus can be timed at a time; the
+ * elapsed time is added to the cost of the bus by stopBusTimer
+ * @param idx local index of bus
+ */
+void startBusTimer(int idx)
+{
+  p_timedBus = idx;
+  p_busTimerStart = MPI_Wtime();
+}
 
-  // if (this->processor_size() <= 1) return;
-  GraphPartitioner partitioner(this->communicator(),
-      p_buses.size(), p_branches.size());
+/**
+ * Stop timing work on the bus passed to startBusTimer and add the elapsed
+ * time to its cost
+ */
+void stopBusTimer(void)
+{
+  if (p_timedBus >= 0) {
+    addBusCost(p_timedBus, MPI_Wtime()-p_busTimerStart);
+    p_timedBus = -1;
+  }
+}
 
-  for (BusIterator bus = p_buses.begin(); 
-      bus != p_buses.end(); ++bus) {
-    partitioner.add_node(bus->p_globalBusIndex,bus->p_originalBusIndex);
+/**
+ * Repartition a network that has already been partitioned, using the cost
+ * measured on each active bus (see addBusCost and startBusTimer) as its
+ * weight. If no cost has been measured anywhere, the workload estimates of
+ * the components are used instead. ParMETIS adaptive repartitioning is
+ * used, so buses only move if the improvement in balance is worth the cost
+ * of moving them. Buses and branches are moved along with their components
+ * and data collections, so component state that must survive
+ * repartitioning needs to be included in the serialize method of the
+ * component (or saved to the data collection). Ghost buses and branches
+ * are rebuilt, but exchange buffers are removed and anything built from
+ * the old distribution (exchange buffers, bus and branch updates,
+ * factories, mappers) needs to be set up again. Accumulated bus costs are
+ * set to zero.
+ * @param itr ratio of the cost of communication during computation to the
+ *            cost of moving a bus. Larger values favor balance over keeping
+ *            buses in place
+ */
+void repartition(double itr = 1000.0)
+{
+  // remove ghosts, so that only active buses and branches remain
+  clean();
+
+  // scale measured costs to integer weights, so that the average bus has
+  // a weight of 100
+  double cost(0.0), total(0.0);
+  int nbus(0), totalbus(0);
+  for (BusIterator bus = p_buses.begin(); bus != p_buses.end(); ++bus) {
+    cost += bus->p_cost;
+    nbus++;
   }
-  for (BranchIterator branch = p_branches.begin(); 
-      branch != p_branches.end(); ++branch) {
-    partitioner.add_edge(branch->p_globalBranchIndex, 
-        branch->p_originalBusIndex1,
-        branch->p_originalBusIndex2);
+  boost::mpi::all_reduce(this->communicator(), cost, total,
+      std::plus<double>());
+  boost::mpi::all_reduce(this->communicator(), nbus, totalbus,
+      std::plus<int>());
+  if (total > 0.0 && totalbus > 0) {
+    double scale = 100.0*static_cast<double>(totalbus)/total;
+    std::vector<int> weights;
+    weights.reserve(p_buses.size());
+    for (BusIterator bus = p_buses.begin(); bus != p_buses.end(); ++bus) {
+      weights.push_back(std::max(1,
+            static_cast<int>(scale*bus->p_cost + 0.5)));
+    }
+    partitionNetwork(true, itr, &weights);
+  } else {
+    partitionNetwork(true, itr, NULL);
   }
-  partitioner.partition();
-  // Recover global indices for branch ends from partitioner
+  resetBusCosts();
+  if (!p_busMap.empty() || !p_branchMap.empty()) setMap();
+}
+/**
+ * Sort local active buses and branches into interior and boundary lists.
+ * A boundary bus is an active bus that is connected by a branch to a ghost
+ * bus and a boundary branch is an active branch with a ghost bus at one
+ * end. Interior buses and branches only depend on data that is stored
+ * locally, so they can be processed while a ghost update is in progress.
+ * This function is called by partition and clean. It should be called
+ * again if the network topology is modified by other means.
+ */
+void setBoundaryLists(void)
+{
+  int i;
+  int nbus = p_buses.size();
   int nbranch = p_branches.size();
-  int idx;
-  unsigned int index1, index2;
-  for (idx=0; idx<nbranch; idx++) {
-    partitioner.get_global_edge_ids(idx, &index1, &index2);
-    p_branches[idx].p_globalBusIndex1 = static_cast<int>(index1);
-    p_branches[idx].p_globalBusIndex2 = static_cast<int>(index2);
+  std::vector<bool> boundary(nbus,false);
+  p_interiorBranches.clear();
+  p_boundaryBranches.clear();
+  for (i=0; i<nbranch; i++) {
+    int idx1 = p_branches[i].p_localBusIndex1;
+    int idx2 = p_branches[i].p_localBusIndex2;
+    if (idx1 < 0 || idx1 >= nbus || idx2 < 0 || idx2 >= nbus) continue;
+    bool active1 = p_buses[idx1].p_activeBus;
+    bool active2 = p_buses[idx2].p_activeBus;
+    if (!active1) boundary[idx2] = true;
+    if (!active2) boundary[idx1] = true;
+    if (p_branches[i].p_activeBranch) {
+      if (active1 && active2) {
+        p_interiorBranches.push_back(i);
+      } else {
+        p_boundaryBranches.push_back(i);
+      }
+    }
+  }
+  p_interiorBuses.clear();
+  p_boundaryBuses.clear();
+  for (i=0; i<nbus; i++) {
+    if (p_buses[i].p_activeBus) {
+      if (boundary[i]) {
+        p_boundaryBuses.push_back(i);
+      } else {
+        p_interiorBuses.push_back(i);
+      }
+    }
   }
+}
 
-  if (timer != NULL) timer->stop(t_part);
+/**
+ * Return local indices of active buses that are not connected to any
+ * ghost bus
+ * @return vector of local bus indices
+ */
+const std::vector<int>& getInteriorBuses(void) const
+{
+  return p_interiorBuses;
+}
 
-  int me(this->processor_rank());
-  GraphPartitioner::IndexVector dest, gdest;
+/**
+ * Return local indices of active buses that are connected to at least one
+ * ghost bus
+ * @return vector of local bus indices
+ */
+const std::vector<int>& getBoundaryBuses(void) const
+{
+  return p_boundaryBuses;
+}
 
-#if 1
-  typedef parallel::Shuffler<BusData<BusType>, GraphPartitioner::Index> BusShufflerType;
-  typedef parallel::Shuffler<BranchData<BranchType>, GraphPartitioner::Index> BranchShufflerType;
-#else 
-  typedef parallel::gaShuffler<BusData<BusType>, GraphPartitioner::Index> BusShufflerType;
-  typedef parallel::gaShuffler<BranchData<BranchType>, GraphPartitioner::Index> BranchShufflerType;
-#endif
+/**
+ * Return local indices of active branches that have active buses at both
+ * ends
+ * @return vector of local branch indices
+ */
+const std::vector<int>& getInteriorBranches(void) const
+{
+  return p_interiorBranches;
+}
 
-  BusShufflerType bus_shuffler(this->communicator());
-  BranchShufflerType branch_shuffler(this->communicator());
+/**
+ * Return local indices of active branches that have a ghost bus at one
+ * end
+ * @return vector of local branch indices
+ */
+const std::vector<int>& getBoundaryBranches(void) const
+{
+  return p_boundaryBranches;
+}
 
-  // Need to make copies of buses and branches that will be ghosted.
-  // After active bus/branch distribution, they may not be on this
-  // processor.
+/**
+ * Build compressed (CSR) adjacency lists for the local network and point
+ * the bus and branch components at them. The lists for bus i are stored in
+ * positions getBusBranchOffsets()[i] to getBusBranchOffsets()[i+1]-1 of the
+ * branch and bus lists, and the two buses of branch j are stored in
+ * positions 2*j and 2*j+1. Components can then traverse their neighbors
+ * through getBranchSpan and getBusSpan without copying lists or locking
+ * shared pointers. This function is called by partition and clean and by
+ * the factory when it sets up the components. It should be called again if
+ * the network topology is modified by other means.
+ */
+void setTopology(void)
+{
+  int i, j, nsize;
+  int nbus = p_buses.size();
+  int nbranch = p_branches.size();
+  p_busBranchOffsets.assign(nbus+1,0);
+  for (i=0; i<nbus; i++) {
+    p_busBranchOffsets[i+1] = p_busBranchOffsets[i]
+      + p_buses[i].p_branchNeighbors.size();
+  }
+  nsize = p_busBranchOffsets[nbus];
+  p_busBranchIndices.resize(nsize);
+  p_busBusIndices.resize(nsize);
+  p_busBranchPtrs.resize(nsize);
+  p_busBusPtrs.resize(nsize);
+  p_busBranchComponents.resize(nsize);
+  p_busBusComponents.resize(nsize);
+  for (i=0; i<nbus; i++) {
+    const std::vector<int> &nghbrs = p_buses[i].p_branchNeighbors;
+    int offset = p_busBranchOffsets[i];
+    for (j=0; j<static_cast<int>(nghbrs.size()); j++) {
+      int br = nghbrs[j];
+      int idx1 = p_branches[br].p_localBusIndex1;
+      int idx2 = p_branches[br].p_localBusIndex2;
+      int other = (idx1 != i) ? idx1 : idx2;
+      p_busBranchIndices[offset+j] = br;
+      p_busBusIndices[offset+j] = other;
+      p_busBranchPtrs[offset+j] = p_branches[br].p_branch.get();
+      p_busBusPtrs[offset+j] =
+        (other >= 0 && other < nbus) ? p_buses[other].p_bus.get() : NULL;
+      p_busBranchComponents[offset+j] = p_busBranchPtrs[offset+j];
+      p_busBusComponents[offset+j] = p_busBusPtrs[offset+j];
+    }
+  }
+  p_branchBusIndices.resize(2*nbranch);
+  p_branchBusPtrs.resize(2*nbranch);
+  p_branchBusComponents.resize(2*nbranch);
+  for (i=0; i<nbranch; i++) {
+    int idx1 = p_branches[i].p_localBusIndex1;
+    int idx2 = p_branches[i].p_localBusIndex2;
+    p_branchBusIndices[2*i] = idx1;
+    p_branchBusIndices[2*i+1] = idx2;
+    p_branchBusPtrs[2*i] =
+      (idx1 >= 0 && idx1 < nbus) ? p_buses[idx1].p_bus.get() : NULL;
+    p_branchBusPtrs[2*i+1] =
+      (idx2 >= 0 && idx2 < nbus) ? p_buses[idx2].p_bus.get() : NULL;
+    p_branchBusComponents[2*i] = p_branchBusPtrs[2*i];
+    p_branchBusComponents[2*i+1] = p_branchBusPtrs[2*i+1];
+  }
+
+  // point components at their part of the lists
+  for (i=0; i<nbus; i++) {
+    int offset = p_busBranchOffsets[i];
+    int nghbrs = p_busBranchOffsets[i+1]-offset;
+    component::BaseComponent* const *branches =
+      nghbrs > 0 ? &p_busBranchComponents[offset] : NULL;
+    component::BaseComponent* const *buses =
+      nghbrs > 0 ? &p_busBusComponents[offset] : NULL;
+    p_buses[i].p_bus->setNeighborSpans(
+        component::ComponentSpan<component::BaseComponent>(branches,nghbrs),
+        component::ComponentSpan<component::BaseComponent>(buses,nghbrs));
+  }
+  for (i=0; i<nbranch; i++) {
+    p_branches[i].p_branch->setBusSpan(
+        component::ComponentSpan<component::BaseComponent>(
+          &p_branchBusComponents[2*i],2));
+  }
+}
 
-  BusDataVector ghostbuses;
-  GraphPartitioner::MultiIndexVector gnodedest;
-  GraphPartitioner::IndexVector ghostbusdest;
-  BusIterator bus(p_buses.begin());
-  partitioner.ghost_node_destinations(gnodedest);
+/**
+ * Return offsets of the adjacency lists of each bus
+ * @return vector of numBuses()+1 offsets
+ */
+const std::vector<int>& getBusBranchOffsets(void) const
+{
+  return p_busBranchOffsets;
+}
 
-  for (size_t i = 0; i < gnodedest.size(); ++i, ++bus) {
-    for (GraphPartitioner::IndexVector::iterator d = gnodedest[i].begin();
-        d != gnodedest[i].end(); ++d) {
-      ghostbuses.push_back(*bus);
-      ghostbusdest.push_back(*d);
-    }
+/**
+ * Return local indices of the branches connected to each bus, stored by
+ * bus
+ * @return vector of local branch indices
+ */
+const std::vector<int>& getBusBranchIndices(void) const
+{
+  return p_busBranchIndices;
+}
+
+/**
+ * Return local indices of the buses connected to each bus via a branch,
+ * stored by bus in the same order as getBusBranchIndices
+ * @return vector of local bus indices
+ */
+const std::vector<int>& getBusBusIndices(void) const
+{
+  return p_busBusIndices;
+}
+
+/**
+ * Return local indices of the buses at either end of each branch, stored
+ * in pairs
+ * @return vector of local bus indices
+ */
+const std::vector<int>& getBranchBusIndices(void) const
+{
+  return p_branchBusIndices;
+}
+
+/**
+ * Return branches connected to bus without copying
+ * @param idx local bus index
+ * @return list of pointers to branches
+ */
+component::ComponentSpan<_branch> getBranchSpan(int idx) const
+{
+  if (idx<0 || idx+1 >= static_cast<int>(p_busBranchOffsets.size())) {
+    char buf[256];
+    sprintf(buf,"BaseNetwork::getBranchSpan: illegal index: %d size: %d\n",
+           idx, static_cast<int>(p_busBranchOffsets.size())-1);
+    printf("%s",buf);
+    throw gridpack::Exception(buf);
   }
+  int offset = p_busBranchOffsets[idx];
+  int nghbrs = p_busBranchOffsets[idx+1]-offset;
+  return component::ComponentSpan<_branch>(
+      nghbrs > 0 ? &p_busBranchPtrs[offset] : NULL, nghbrs);
+}
 
-  // Branches can only be ghosted on one other process, so they're
-  // easy.
+/**
+ * Return buses connected to bus via a branch without copying. Entry i is
+ * the bus at the other end of entry i of getBranchSpan
+ * @param idx local bus index
+ * @return list of pointers to buses
+ */
+component::ComponentSpan<_bus> getBusSpan(int idx) const
+{
+  if (idx<0 || idx+1 >= static_cast<int>(p_busBranchOffsets.size())) {
+    char buf[256];
+    sprintf(buf,"BaseNetwork::getBusSpan: illegal index: %d size: %d\n",
+           idx, static_cast<int>(p_busBranchOffsets.size())-1);
+    printf("%s",buf);
+    throw gridpack::Exception(buf);
+  }
+  int offset = p_busBranchOffsets[idx];
+  int nghbrs = p_busBranchOffsets[idx+1]-offset;
+  return component::ComponentSpan<_bus>(
+      nghbrs > 0 ? &p_busBusPtrs[offset] : NULL, nghbrs);
+}
 
-  partitioner.edge_destinations(dest);
-  partitioner.ghost_edge_destinations(gdest);
+/**
+ * Return buses at either end of branch without copying
+ * @param idx local branch index
+ * @return list of pointers to bus 1 and bus 2
+ */
+component::ComponentSpan<_bus> getBranchBusSpan(int idx) const
+{
+  if (idx<0 || 2*idx >= static_cast<int>(p_branchBusPtrs.size())) {
+    char buf[256];
+    sprintf(buf,"BaseNetwork::getBranchBusSpan: illegal index: %d size: %d\n",
+           idx, static_cast<int>(p_branchBusPtrs.size())/2);
+    printf("%s",buf);
+    throw gridpack::Exception(buf);
+  }
+  return component::ComponentSpan<_bus>(&p_branchBusPtrs[2*idx], 2);
+}
 
-  BranchDataVector ghostbranches;
-  BranchIterator branch(p_branches.begin());
-  GraphPartitioner::IndexVector ghostbranchdest;
+/**
+ * Store components in arenas when the network is partitioned. After the
+ * ghost buses and branches have been added, all bus components and all
+ * branch components on a process are moved into contiguous blocks of
+ * memory in local index order, so that loops over the network (e.g. in the
+ * mappers) walk through memory instead of visiting individually allocated
+ * components. getBus and getBranch still return shared pointers.
+ * @param flag if true, use arena storage
+ */
+void setArenaStorage(bool flag)
+{
+  p_arenaStorage = flag;
+}
 
-  for (size_t i = 0; i < dest.size(); ++i, ++branch) {
-    if (dest[i] != gdest[i]) {
-      ghostbranches.push_back(*branch);
-      ghostbranches.back().p_activeBranch = false;
-      ghostbranchdest.push_back(gdest[i]);
-    }
+/**
+ * Move all components into arenas in local index order and reset the
+ * component pointers and adjacency lists. This is done by partition if
+ * setArenaStorage(true) has been called, but it can also be called
+ * afterwards, e.g. after clean. Components are moved by serialization, as
+ * they are when the network is partitioned, so this should be called
+ * before the components are loaded and before exchange buffers are
+ * allocated. An arena is released when the last component in it is
+ * released, so components removed from the network (e.g. by clean) keep
+ * their memory until the network is compacted again.
+ */
+void compactComponents(void)
+{
+  if (p_busXCBufSize != 0 || p_branchXCBufSize != 0) {
+    char buf[256];
+    sprintf(buf,"BaseNetwork::compactComponents: exchange buffers"
+        " must be freed before compacting components\n");
+    printf("%s",buf);
+    throw gridpack::Exception(buf);
   }
+  moveComponentsToArenas();
 
-
-  // distribute active nodes
-
-  // std::cout << me << ": distributing " << p_buses.size() << " active buses" << std::endl;
-
-  if (timer != NULL) timer->start(t_bus_dist);
-  partitioner.node_destinations(dest);
-  bus_shuffler(p_buses, dest);
-  if (timer != NULL) timer->stop(t_bus_dist);
-
-  // distribute active edges
-
-  if (timer != NULL) timer->start(t_branch_dist);
-  partitioner.edge_destinations(dest);
-  branch_shuffler(p_branches, dest);
-  if (timer != NULL) timer->stop(t_branch_dist);
-
-  // At this point, active buses and branches are on the proper
-  // process.  Now, we need to distribute and nodes and edges that
-  // are ghosted.  
-
-  // std::cout << me << ": distributing " << ghostbuses.size() << " ghost buses" << std::endl;
-
-  if (timer != NULL) timer->start(t_bus_dist);
-  bus_shuffler(ghostbuses, ghostbusdest);
-  for (bus = ghostbuses.begin(); bus != ghostbuses.end(); ++bus) {
-    bus->p_activeBus = false;
-    p_buses.push_back(*bus);
-  }
-  ghostbuses.clear();
-  if (timer != NULL) timer->stop(t_bus_dist);
-
-  if (timer != NULL) timer->start(t_branch_dist);
-  branch_shuffler(ghostbranches, ghostbranchdest);
-  std::copy(ghostbranches.begin(), ghostbranches.end(),
-      std::back_inserter(p_branches));
-  ghostbranches.clear();
-  if (timer != NULL) timer->stop(t_branch_dist);
-
-  // At this point, each process should have a self-contained
-  // network, update local and global indexes, etc.
-
-  // make an index of global bus index to local index and update
-  // the branch local bus indexes
-  int active_buses(0), active_branches(0);
-  {
-    std::map<int, int> busindexes;
-    int lidx(0);
-    for (BusIterator b = p_buses.begin(); b != p_buses.end(); ++b, ++lidx) {
-      clearBranchNeighbors(lidx);
-      busindexes[b->p_globalBusIndex] = lidx;
-      if (b->p_activeBus) active_buses += 1;
-    }
-
-    // go through the branches and set the local bus indexes and pointers
-    lidx = 0;
-    for (BranchIterator b = p_branches.begin(); b != p_branches.end(); ++b, ++lidx) {
-      int gbus, lbus1, lbus2;
-      BusPtr bus1, bus2;
-
-      // set local indexes
-
-      gbus = b->p_globalBusIndex1;
-      lbus1 = busindexes[gbus];
-      bus1 = p_buses[lbus1].p_bus;
-
-      gbus = b->p_globalBusIndex2;
-      lbus2 = busindexes[gbus];
-      bus2 = p_buses[lbus2].p_bus;
-
-      b->p_localBusIndex1 = lbus1;
-      addBranchNeighbor(lbus1, lidx);
-
-      b->p_localBusIndex2 = lbus2;
-      addBranchNeighbor(lbus2, lidx);
-
-      // set component pointers
-
-      b->p_branch->setBus1(bus1);
-      b->p_branch->setBus2(bus2);
-
-      gbus = b->p_globalBusIndex1;
-      bus1->addBranch(b->p_branch);
-      bus1->addBus(bus2);
-      setGlobalBusIndex1(lidx,gbus); 
-      gbus = b->p_globalBusIndex2;
-      bus2->addBranch(b->p_branch);
-      bus2->addBus(bus1);
-      setGlobalBusIndex2(lidx,gbus); 
-
-      if (b->p_activeBranch) active_branches += 1;
-    }
-  }
-
-  std::cout << me << ": "
-    << "I have " 
-    << p_buses.size() << " buses and "
-    << p_branches.size() << " branches"
-    << std::endl;
-
-  if (timer != NULL) timer->stop(t_total);
-}
+  // set component pointers, as is done at the end of partition
+  int i;
+  int nbus = p_buses.size();
+  int nbranch = p_branches.size();
+  for (i=0; i<nbus; i++) {
+    p_buses[i].p_bus->clearBranches();
+    p_buses[i].p_bus->clearBuses();
+  }
+  for (i=0; i<nbranch; i++) {
+    BranchData<_branch> &branch = p_branches[i];
+    int idx1 = branch.p_localBusIndex1;
+    int idx2 = branch.p_localBusIndex2;
+    branch.p_branch->clearBuses();
+    if (idx1 < 0 || idx1 >= nbus || idx2 < 0 || idx2 >= nbus) continue;
+    BusPtr bus1 = p_buses[idx1].p_bus;
+    BusPtr bus2 = p_buses[idx2].p_bus;
+    branch.p_branch->setBus1(bus1);
+    branch.p_branch->setBus2(bus2);
+    bus1->addBranch(branch.p_branch);
+    bus1->addBus(bus2);
+    bus2->addBranch(branch.p_branch);
+    bus2->addBus(bus1);
+  }
+  setTopology();
+}
 
 
 
@@ -1246,6 +1613,12 @@ void clean(void)
     delete [] ((char*)p_branchRcvBuf);
     p_branchRcvBuf = NULL;
   }
+  p_busPlan.clear();
+  p_branchPlan.clear();
+  p_busNeighborXC = false;
+  p_branchNeighborXC = false;
+  p_busUpdatePending = false;
+  p_branchUpdatePending = false;
 
   // remove inactive branches
   int size = p_branches.size();
@@ -1312,6 +1685,8 @@ void clean(void)
   if (p_refBus != -1) {
     p_refBus = buses[p_refBus];
   }
+  setBoundaryLists();
+  setTopology();
 }
 
 /**
@@ -1367,6 +1742,8 @@ template <class _new_bus, class _new_branch> void clone(
     j = getGlobalBusIndex(jdx);
     new_network->setGlobalBusIndex2(i,j);
   }
+  new_network->setBoundaryLists();
+  new_network->setTopology();
 }
 
 /**
@@ -1630,6 +2007,26 @@ void clear(void)
   p_external_branch = false;
   p_allocatedBus = false;
   p_allocatedBranch = false;
+  p_busNeighborXC = false;
+  p_branchNeighborXC = false;
+  p_busUpdatePending = false;
+  p_branchUpdatePending = false;
+  p_busPlan.clear();
+  p_branchPlan.clear();
+  p_interiorBuses.clear();
+  p_boundaryBuses.clear();
+  p_interiorBranches.clear();
+  p_boundaryBranches.clear();
+  p_busBranchOffsets.clear();
+  p_busBranchIndices.clear();
+  p_busBusIndices.clear();
+  p_branchBusIndices.clear();
+  p_busBranchPtrs.clear();
+  p_busBusPtrs.clear();
+  p_branchBusPtrs.clear();
+  p_busBranchComponents.clear();
+  p_busBusComponents.clear();
+  p_branchBusComponents.clear();
 }
 
 /**
@@ -1898,6 +2295,30 @@ void setXCBranchBuffer(int idx, void* ptr)
   }
 }
 
+/**
+ * Select the algorithm used to update ghost buses and branches. If flag is
+ * true, initBusUpdate and initBranchUpdate construct lists of buses and
+ * branches that are exchanged with each neighboring process and the update
+ * routines send data directly between owning and ghosting processes. If flag
+ * is false (the default), ghost data is exchanged through a global array.
+ * This function must be called before initBusUpdate and initBranchUpdate to
+ * have any effect.
+ * @param flag true if ghosts should be exchanged directly between neighbors
+ */
+void setNeighborExchange(bool flag)
+{
+  p_neighborXC = flag;
+}
+
+/**
+ * Return algorithm used to update ghost buses and branches
+ * @return true if ghosts are exchanged directly between neighbors
+ */
+bool getNeighborExchange(void) const
+{
+  return p_neighborXC;
+}
+
 /**
  * This function must be called before calling the update bus routine.
  * It initializes data structures for the bus update
@@ -1913,6 +2334,7 @@ void initBusUpdate(void)
     if (p_busGASet) {
       GA_Destroy(p_busGA);
       NGA_Deregister_type(p_busXCBufType);
+      p_busGASet = false;
     }
     if (p_activeBusIndices) {
       for (i=0; i<p_numActiveBuses; ++i) {
@@ -1936,6 +2358,29 @@ void initBusUpdate(void)
       delete [] ((char*)p_busRcvBuf);
       p_busRcvBuf = NULL;
     }
+    p_numActiveBuses = 0;
+    p_numInactiveBuses = 0;
+    p_busPlan.clear();
+    p_busNeighborXC = p_neighborXC;
+    if (p_busNeighborXC) {
+      // Build lists of buses that are exchanged directly with neighboring
+      // processes. No global array is needed for this mode
+      std::vector<int> activeGlobal, activeLocal, ghostGlobal, ghostLocal;
+      size = p_buses.size();
+      for (i=0; i<size; i++) {
+        if (getActiveBus(i)) {
+          activeGlobal.push_back(getGlobalBusIndex(i));
+          activeLocal.push_back(i);
+        } else {
+          ghostGlobal.push_back(getGlobalBusIndex(i));
+          ghostLocal.push_back(i);
+        }
+      }
+      setupExchangePlan(p_busPlan, activeGlobal, activeLocal,
+          ghostGlobal, ghostLocal, p_busXCBufSize);
+      GA_Pgroup_sync(grp);
+      return;
+    }
     // Find out how many active buses exist
     size = p_buses.size();
     numBuses = 0;
@@ -2038,6 +2483,37 @@ void initBusUpdate(void)
  */
 void updateBuses(void)
 {
+  beginBusUpdate();
+  endBusUpdate();
+}
+
+/**
+ * Start the update of bus ghost values. Data in the exchange buffers of
+ * active buses is sent to processes holding ghost copies, but ghost
+ * buffers are not guaranteed to hold new values until endBusUpdate is
+ * called. The exchange buffers of active buses must not be modified
+ * until endBusUpdate returns. This is a collective operation across all
+ * processors.
+ * Communication only overlaps with work done between beginBusUpdate and
+ * endBusUpdate if neighbor exchanges are enabled with setNeighborExchange.
+ * The default Global Arrays exchange scatters the data with a blocking
+ * NGA_Scatter in this call, because GA has no non-blocking scatter.
+ */
+void beginBusUpdate(void)
+{
+  if (p_busUpdatePending) {
+    char buf[256];
+    sprintf(buf,"BaseNetwork::beginBusUpdate: previous update not"
+        " completed\n");
+    printf("%s",buf);
+    throw gridpack::Exception(buf);
+  }
+  p_busUpdatePending = true;
+  if (p_busNeighborXC) {
+    startExchange(p_busPlan, p_busXCBuffers, p_busXCBufSize,
+        p_busXCTag);
+    return;
+  }
   int grp = this->communicator().getGroup();
   // Copy data from XC buffer to send buffer
   GA_Pgroup_sync(grp);
@@ -2059,10 +2535,36 @@ void updateBuses(void)
     }
   }
 
-  // Scatter data to exchange GA and then gather it back to local buffers
+  // Scatter data to exchange GA. It is gathered back to local buffers in
+  // endBusUpdate
   if (p_numActiveBuses > 0) {
     NGA_Scatter(p_busGA,p_busSndBuf,p_activeBusIndices,p_numActiveBuses);
   }
+}
+
+/**
+ * Complete the update of bus ghost values started by beginBusUpdate.
+ * On return, the exchange buffers of ghost buses hold the values from
+ * the corresponding active buses. This is a collective operation across
+ * all processors.
+ */
+void endBusUpdate(void)
+{
+  if (!p_busUpdatePending) {
+    char buf[256];
+    sprintf(buf,"BaseNetwork::endBusUpdate: no update in progress\n");
+    printf("%s",buf);
+    throw gridpack::Exception(buf);
+  }
+  p_busUpdatePending = false;
+  if (p_busNeighborXC) {
+    finishExchange(p_busPlan, p_busXCBuffers, p_busXCBufSize);
+    return;
+  }
+  int grp = this->communicator().getGroup();
+  int i, xc_off, rs_off, icnt, nbus;
+  char *rs_ptr, *xc_ptr;
+  nbus = numBuses();
   GA_Pgroup_sync(grp);
   if (p_numInactiveBuses > 0) {
     NGA_Gather(p_busGA,p_busRcvBuf,p_inactiveBusIndices,p_numInactiveBuses);
@@ -2102,6 +2604,7 @@ void initBranchUpdate(void)
     if (p_branchGASet) {
       GA_Destroy(p_branchGA);
       NGA_Deregister_type(p_branchXCBufType);
+      p_branchGASet = false;
     }
     if (p_activeBranchIndices) {
       for (i=0; i<p_numActiveBranches; ++i) {
@@ -2125,6 +2628,29 @@ void initBranchUpdate(void)
         p_branchRcvBuf = NULL;
       }
     }
+    p_numActiveBranches = 0;
+    p_numInactiveBranches = 0;
+    p_branchPlan.clear();
+    p_branchNeighborXC = p_neighborXC;
+    if (p_branchNeighborXC) {
+      // Build lists of branches that are exchanged directly with neighboring
+      // processes. No global array is needed for this mode
+      std::vector<int> activeGlobal, activeLocal, ghostGlobal, ghostLocal;
+      size = p_branches.size();
+      for (i=0; i<size; i++) {
+        if (getActiveBranch(i)) {
+          activeGlobal.push_back(getGlobalBranchIndex(i));
+          activeLocal.push_back(i);
+        } else {
+          ghostGlobal.push_back(getGlobalBranchIndex(i));
+          ghostLocal.push_back(i);
+        }
+      }
+      setupExchangePlan(p_branchPlan, activeGlobal, activeLocal,
+          ghostGlobal, ghostLocal, p_branchXCBufSize);
+      GA_Pgroup_sync(grp);
+      return;
+    }
     // Find out how many active branches exist
     size = p_branches.size();
     numBranches = 0;
@@ -2216,6 +2742,37 @@ void initBranchUpdate(void)
  */
 void updateBranches(void)
 {
+  beginBranchUpdate();
+  endBranchUpdate();
+}
+
+/**
+ * Start the update of branch ghost values. Data in the exchange buffers of
+ * active branches is sent to processes holding ghost copies, but ghost
+ * buffers are not guaranteed to hold new values until endBranchUpdate is
+ * called. The exchange buffers of active branches must not be modified
+ * until endBranchUpdate returns. This is a collective operation across all
+ * processors.
+ * Communication only overlaps with work done between beginBranchUpdate and
+ * endBranchUpdate if neighbor exchanges are enabled with setNeighborExchange.
+ * The default Global Arrays exchange scatters the data with a blocking
+ * NGA_Scatter in this call, because GA has no non-blocking scatter.
+ */
+void beginBranchUpdate(void)
+{
+  if (p_branchUpdatePending) {
+    char buf[256];
+    sprintf(buf,"BaseNetwork::beginBranchUpdate: previous update not"
+        " completed\n");
+    printf("%s",buf);
+    throw gridpack::Exception(buf);
+  }
+  p_branchUpdatePending = true;
+  if (p_branchNeighborXC) {
+    startExchange(p_branchPlan, p_branchXCBuffers, p_branchXCBufSize,
+        p_branchXCTag);
+    return;
+  }
   // Copy data from XC buffer to send buffer
   int grp = this->communicator().getGroup();
   GA_Pgroup_sync(grp);
@@ -2237,10 +2794,36 @@ void updateBranches(void)
     }
   }
 
-  // Scatter data to exchange GA and then gather it back to local buffers
+  // Scatter data to exchange GA. It is gathered back to local buffers in
+  // endBranchUpdate
   if (p_numActiveBranches > 0) {
     NGA_Scatter(p_branchGA,p_branchSndBuf,p_activeBranchIndices,p_numActiveBranches);
   }
+}
+
+/**
+ * Complete the update of branch ghost values started by beginBranchUpdate.
+ * On return, the exchange buffers of ghost branches hold the values from
+ * the corresponding active branches. This is a collective operation across
+ * all processors.
+ */
+void endBranchUpdate(void)
+{
+  if (!p_branchUpdatePending) {
+    char buf[256];
+    sprintf(buf,"BaseNetwork::endBranchUpdate: no update in progress\n");
+    printf("%s",buf);
+    throw gridpack::Exception(buf);
+  }
+  p_branchUpdatePending = false;
+  if (p_branchNeighborXC) {
+    finishExchange(p_branchPlan, p_branchXCBuffers, p_branchXCBufSize);
+    return;
+  }
+  int grp = this->communicator().getGroup();
+  int i, xc_off, rs_off, icnt, nbranch;
+  char *rs_ptr, *xc_ptr;
+  nbranch = numBranches();
   GA_Pgroup_sync(grp);
   if (p_numInactiveBranches > 0) {
     NGA_Gather(p_branchGA,p_branchRcvBuf,p_inactiveBranchIndices,p_numInactiveBranches);
@@ -2373,6 +2956,265 @@ void writeGraph(const std::string& outname)
   }
 }
 
+/**
+ * Write the partitioned network to a binary snapshot so that it can be
+ * restored with readSnapshot without parsing and partitioning the network
+ * again. Each processor writes its own file, named by appending the
+ * processor rank to the snapshot name. The snapshot contains the local
+ * buses and branches (including ghosts), their indices and neighbor lists,
+ * the reference bus, the data collections and the maps from original
+ * indices to local indices. Component state and exchange buffers are not
+ * saved.
+ * @param name base name of snapshot files
+ */
+void writeSnapshot(const std::string &name)
+{
+  int i, j;
+  int nbus = p_buses.size();
+  int nbranch = p_branches.size();
+  std::vector<char> buf;
+  buf.insert(buf.end(), snapshotMagic(), snapshotMagic()+8);
+  snapPut(buf, static_cast<int>(SNAPSHOT_VERSION));
+  snapPut(buf, this->processor_size());
+  snapPut(buf, this->processor_rank());
+  snapPut(buf, nbus);
+  snapPut(buf, nbranch);
+  snapPut(buf, p_refBus);
+
+  // Data collection keys are only valid on this process, so save the
+  // names of all keys
+  int nkeys = component::DataCollection::numKeys();
+  snapPut(buf, nkeys);
+  for (i=0; i<nkeys; i++) {
+    std::string key = component::DataCollection::keyName(i);
+    int len = key.length();
+    snapPut(buf, len);
+    buf.insert(buf.end(), key.begin(), key.end());
+  }
+
+  for (i=0; i<nbus; i++) {
+    const BusData<_bus> &bus = p_buses[i];
+    int nghbr = bus.p_branchNeighbors.size();
+    snapPut(buf, static_cast<int>(bus.p_activeBus));
+    snapPut(buf, bus.p_originalBusIndex);
+    snapPut(buf, bus.p_globalBusIndex);
+    snapPut(buf, static_cast<int>(bus.p_refFlag));
+    snapPut(buf, nghbr);
+    for (j=0; j<nghbr; j++) {
+      snapPut(buf, bus.p_branchNeighbors[j]);
+    }
+    bus.p_data->pack(buf);
+  }
+  for (i=0; i<nbranch; i++) {
+    const BranchData<_branch> &branch = p_branches[i];
+    snapPut(buf, static_cast<int>(branch.p_activeBranch));
+    snapPut(buf, branch.p_globalBranchIndex);
+    snapPut(buf, branch.p_originalBusIndex1);
+    snapPut(buf, branch.p_originalBusIndex2);
+    snapPut(buf, branch.p_globalBusIndex1);
+    snapPut(buf, branch.p_globalBusIndex2);
+    snapPut(buf, branch.p_localBusIndex1);
+    snapPut(buf, branch.p_localBusIndex2);
+    branch.p_data->pack(buf);
+  }
+
+  // Maps from original indices to local indices (empty if setMap has not
+  // been called)
+  snapPut(buf, static_cast<int>(p_busMap.size()));
+  std::multimap<int,int>::const_iterator bit;
+  for (bit = p_busMap.begin(); bit != p_busMap.end(); bit++) {
+    snapPut(buf, bit->first);
+    snapPut(buf, bit->second);
+  }
+  snapPut(buf, static_cast<int>(p_branchMap.size()));
+  std::multimap<std::pair<int,int>,int>::const_iterator brit;
+  for (brit = p_branchMap.begin(); brit != p_branchMap.end(); brit++) {
+    snapPut(buf, brit->first.first);
+    snapPut(buf, brit->first.second);
+    snapPut(buf, brit->second);
+  }
+
+  std::string fname = snapshotFileName(name);
+  FILE *fp = fopen(fname.c_str(),"wb");
+  if (fp == NULL) {
+    char sbuf[512];
+    sprintf(sbuf,"writeSnapshot: unable to open file %s",fname.c_str());
+    throw gridpack::Exception(sbuf);
+  }
+  size_t nwrite = fwrite(&buf[0],1,buf.size(),fp);
+  fclose(fp);
+  if (nwrite != buf.size()) {
+    char sbuf[512];
+    sprintf(sbuf,"writeSnapshot: error writing file %s",fname.c_str());
+    throw gridpack::Exception(sbuf);
+  }
+}
+
+/**
+ * Restore a network from a snapshot written by writeSnapshot. The
+ * snapshot must have been written with the same number of processors.
+ * Any existing buses and branches are removed. On return the network is
+ * in the same state as after a call to partition, so the factory can be
+ * created and set up as usual. An exception is thrown if the snapshot is
+ * truncated or corrupt, in which case the network is left empty.
+ * @param name base name of snapshot files
+ */
+void readSnapshot(const std::string &name)
+{
+  std::string fname = snapshotFileName(name);
+  char sbuf[512];
+  int fd = open(fname.c_str(), O_RDONLY);
+  if (fd < 0) {
+    sprintf(sbuf,"readSnapshot: unable to open file %s",fname.c_str());
+    throw gridpack::Exception(sbuf);
+  }
+  struct stat st;
+  if (fstat(fd, &st) != 0 || st.st_size < 8) {
+    close(fd);
+    sprintf(sbuf,"readSnapshot: file %s is not a network snapshot",
+        fname.c_str());
+    throw gridpack::Exception(sbuf);
+  }
+  size_t size = st.st_size;
+  void *map = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (map == MAP_FAILED) {
+    sprintf(sbuf,"readSnapshot: unable to map file %s",fname.c_str());
+    throw gridpack::Exception(sbuf);
+  }
+  const char *ptr = static_cast<const char*>(map);
+  const char *end = ptr + size;
+  int version = -1, nprocs = -1, rank = -1;
+  int nbus, nbranch, refBus;
+  bool ok = (memcmp(ptr, snapshotMagic(), 8) == 0);
+  ptr += 8;
+  try {
+    ptr = snapGet(ptr, end, version);
+    ptr = snapGet(ptr, end, nprocs);
+    ptr = snapGet(ptr, end, rank);
+  } catch (const gridpack::Exception &) {
+    ok = false;
+  }
+  if (!ok || version != SNAPSHOT_VERSION || nprocs != this->processor_size()
+      || rank != this->processor_rank()) {
+    munmap(map, size);
+    sprintf(sbuf,"readSnapshot: file %s does not match this run (version %d"
+        " processors %d rank %d)",fname.c_str(),version,nprocs,rank);
+    throw gridpack::Exception(sbuf);
+  }
+
+  int i, j, nkeys, nmap, ival;
+  try {
+    ptr = snapGet(ptr, end, nbus);
+    ptr = snapGet(ptr, end, nbranch);
+    ptr = snapGet(ptr, end, refBus);
+    if (nbus < 0 || nbranch < 0) {
+      throw gridpack::Exception("snapshot contains negative size");
+    }
+
+    // Map keys in file to keys on this process
+    ptr = snapGet(ptr, end, nkeys);
+    snapCheck(ptr, end, nkeys*static_cast<long>(sizeof(int)));
+    std::vector<int> keys(nkeys);
+    for (i=0; i<nkeys; i++) {
+      int len;
+      ptr = snapGet(ptr, end, len);
+      snapCheck(ptr, end, len);
+      std::string key(ptr, len);
+      ptr += len;
+      keys[i] = component::DataCollection::key(key.c_str());
+    }
+
+    clear();
+    // every bus takes at least 5 values and every branch 8
+    snapCheck(ptr, end, (5L*nbus + 8L*nbranch)*static_cast<long>(sizeof(int)));
+    p_buses.reserve(nbus);
+    for (i=0; i<nbus; i++) {
+      // each bus needs its own component and data collection objects
+      p_buses.push_back(BusData<_bus>());
+      BusData<_bus> &bus = p_buses[i];
+      int nghbr;
+      ptr = snapGet(ptr, end, ival);
+      bus.p_activeBus = (ival != 0);
+      ptr = snapGet(ptr, end, bus.p_originalBusIndex);
+      ptr = snapGet(ptr, end, bus.p_globalBusIndex);
+      ptr = snapGet(ptr, end, ival);
+      bus.p_refFlag = (ival != 0);
+      ptr = snapGet(ptr, end, nghbr);
+      snapCheck(ptr, end, nghbr*static_cast<long>(sizeof(int)));
+      bus.p_branchNeighbors.resize(nghbr);
+      for (j=0; j<nghbr; j++) {
+        ptr = snapGet(ptr, end, bus.p_branchNeighbors[j]);
+        snapCheckIndex(bus.p_branchNeighbors[j], nbranch);
+      }
+      ptr = bus.p_data->unpack(ptr, end, keys);
+    }
+    p_branches.reserve(nbranch);
+    for (i=0; i<nbranch; i++) {
+      p_branches.push_back(BranchData<_branch>());
+      BranchData<_branch> &branch = p_branches[i];
+      ptr = snapGet(ptr, end, ival);
+      branch.p_activeBranch = (ival != 0);
+      ptr = snapGet(ptr, end, branch.p_globalBranchIndex);
+      ptr = snapGet(ptr, end, branch.p_originalBusIndex1);
+      ptr = snapGet(ptr, end, branch.p_originalBusIndex2);
+      ptr = snapGet(ptr, end, branch.p_globalBusIndex1);
+      ptr = snapGet(ptr, end, branch.p_globalBusIndex2);
+      ptr = snapGet(ptr, end, branch.p_localBusIndex1);
+      ptr = snapGet(ptr, end, branch.p_localBusIndex2);
+      snapCheckIndex(branch.p_localBusIndex1, nbus);
+      snapCheckIndex(branch.p_localBusIndex2, nbus);
+      ptr = branch.p_data->unpack(ptr, end, keys);
+    }
+
+    // Maps from original indices to local indices
+    p_busMap.clear();
+    ptr = snapGet(ptr, end, nmap);
+    snapCheck(ptr, end, 2L*nmap*static_cast<long>(sizeof(int)));
+    for (i=0; i<nmap; i++) {
+      int idx;
+      ptr = snapGet(ptr, end, idx);
+      ptr = snapGet(ptr, end, ival);
+      snapCheckIndex(ival, nbus);
+      p_busMap.insert(std::pair<int,int>(idx,ival));
+    }
+    p_branchMap.clear();
+    ptr = snapGet(ptr, end, nmap);
+    snapCheck(ptr, end, 3L*nmap*static_cast<long>(sizeof(int)));
+    for (i=0; i<nmap; i++) {
+      int idx1, idx2;
+      ptr = snapGet(ptr, end, idx1);
+      ptr = snapGet(ptr, end, idx2);
+      ptr = snapGet(ptr, end, ival);
+      snapCheckIndex(ival, nbranch);
+      p_branchMap.insert(std::pair<std::pair<int,int>,int>(
+            std::pair<int,int>(idx1,idx2),ival));
+    }
+  } catch (const gridpack::Exception &e) {
+    munmap(map, size);
+    clear();
+    throw gridpack::Exception(std::string("readSnapshot: file ") + fname
+        + " is truncated or corrupt: " + e.what());
+  }
+  munmap(map, size);
+  p_refBus = refBus;
+
+  // set component pointers, as is done at the end of partition
+  for (i=0; i<nbranch; i++) {
+    BranchData<_branch> &branch = p_branches[i];
+    BusPtr bus1 = p_buses[branch.p_localBusIndex1].p_bus;
+    BusPtr bus2 = p_buses[branch.p_localBusIndex2].p_bus;
+    branch.p_branch->setBus1(bus1);
+    branch.p_branch->setBus2(bus2);
+    bus1->addBranch(branch.p_branch);
+    bus1->addBus(bus2);
+    bus2->addBranch(branch.p_branch);
+    bus2->addBus(bus1);
+  }
+  setBoundaryLists();
+  setTopology();
+}
+
 /**
  * Set up multimap data structures on each processor
  */
@@ -2435,6 +3277,382 @@ std::vector<int> getLocalBranchIndices(int idx1, int idx2) {
 
 protected:
 
+/**
+ * Version of the snapshot format written by writeSnapshot. Increment this
+ * whenever the layout changes
+ */
+enum { SNAPSHOT_VERSION = 2 };
+
+/**
+ * Identifier at the start of every snapshot file
+ */
+static const char* snapshotMagic(void)
+{
+  return "GPNETSNP";
+}
+
+/**
+ * Name of snapshot file for this processor
+ * @param name base name of snapshot files
+ * @return file name
+ */
+std::string snapshotFileName(const std::string &name)
+{
+  char buf[32];
+  sprintf(buf,".%d",this->processor_rank());
+  return name + buf;
+}
+
+/**
+ * Append a value to a snapshot buffer
+ * @param buf snapshot buffer
+ * @param value value to append
+ */
+template <typename T> static void snapPut(std::vector<char> &buf, const T &value)
+{
+  const char *ptr = reinterpret_cast<const char*>(&value);
+  buf.insert(buf.end(), ptr, ptr+sizeof(T));
+}
+
+/**
+ * Check that a snapshot contains at least len more bytes. Throws an
+ * exception if it does not or if len is negative
+ * @param ptr current location in snapshot
+ * @param end end of snapshot
+ * @param len number of bytes that must remain
+ */
+static void snapCheck(const char *ptr, const char *end, long len)
+{
+  if (len < 0 || end - ptr < len) {
+    throw gridpack::Exception("snapshot ends before expected data");
+  }
+}
+
+/**
+ * Check that an index read from a snapshot is in range
+ * @param idx index
+ * @param size number of elements that can be indexed
+ */
+static void snapCheckIndex(int idx, int size)
+{
+  if (idx < 0 || idx >= size) {
+    throw gridpack::Exception("snapshot contains index out of range");
+  }
+}
+
+/**
+ * Read a value from a snapshot. The value does not need to be aligned
+ * @param ptr location of value in snapshot
+ * @param end end of snapshot
+ * @param value returns value
+ * @return location of next value in snapshot
+ */
+template <typename T> static const char* snapGet(const char *ptr,
+    const char *end, T &value)
+{
+  snapCheck(ptr, end, sizeof(T));
+  memcpy(&value, ptr, sizeof(T));
+  return ptr+sizeof(T);
+}
+
+/**
+ * Move a list of components into a new arena, in order. The state of each
+ * component is copied by serialization, the same way it is when
+ * components are moved between processes
+ * @param components list of components. On return, each entry points into
+ *                   the arena
+ */
+template <class _component>
+void moveToArena(std::vector<boost::shared_ptr<_component>*> &components)
+{
+  int i;
+  int size = components.size();
+  if (size == 0) return;
+  std::ostringstream ostr(std::ios::binary);
+  {
+    boost::archive::binary_oarchive oarch(ostr);
+    for (i=0; i<size; i++) {
+      const _component &comp = *(*components[i]);
+      oarch << comp;
+    }
+  }
+  boost::shared_ptr<ComponentArena<_component> >
+    arena(new ComponentArena<_component>(size));
+  std::istringstream istr(ostr.str(), std::ios::binary);
+  {
+    boost::archive::binary_iarchive iarch(istr);
+    for (i=0; i<size; i++) {
+      _component *comp = arena->construct();
+      iarch >> *comp;
+      // the new pointer shares ownership of the whole arena
+      *components[i] = boost::shared_ptr<_component>(arena, comp);
+    }
+  }
+}
+
+/**
+ * Move all bus components and all branch components into arenas in local
+ * index order. Component pointers to neighbors are not reset
+ */
+void moveComponentsToArenas(void)
+{
+  std::vector<BusPtr*> buses;
+  buses.reserve(p_buses.size());
+  for (BusIterator b = p_buses.begin(); b != p_buses.end(); ++b) {
+    buses.push_back(&(b->p_bus));
+  }
+  moveToArena(buses);
+  std::vector<BranchPtr*> branches;
+  branches.reserve(p_branches.size());
+  for (BranchIterator b = p_branches.begin(); b != p_branches.end(); ++b) {
+    branches.push_back(&(b->p_branch));
+  }
+  moveToArena(branches);
+}
+
+/**
+ * Distribute buses and branches over processes and create ghost buses and
+ * branches. This does the work for partition and repartition
+ * @param adaptive if true, adapt the current distribution instead of
+ *                 starting over
+ * @param itr ratio of communication to redistribution cost (adaptive only)
+ * @param weights if not NULL, the weight of each local bus; otherwise the
+ *                workload estimate of each bus component is used
+ */
+void partitionNetwork(bool adaptive, double itr, const std::vector<int> *weights)
+{
+  gridpack::utility::CoarseTimer *timer;
+  timer = NULL;
+//  timer = gridpack::utility::CoarseTimer::instance();
+
+  int t_total(0), t_part(0), t_bus_dist(0), t_branch_dist(0);
+
+  if (timer != NULL) {
+    t_total = timer->createCategory("BaseNetwork<>::partition(): Total");
+    t_part = timer->createCategory("BaseNetwork<>::partition(): Partitioner");
+    t_bus_dist = timer->createCategory("BaseNetwork<>::partition(): Bus Distribution");
+    t_branch_dist = timer->createCategory("BaseNetwork<>::partition(): Branch Distribution");
+  }
+
+  if (timer != NULL) timer->start(t_total);
+
+  if (timer != NULL) timer->start(t_part);
+
+  // if (this->processor_size() <= 1) return;
+  GraphPartitioner partitioner(this->communicator(),
+      p_buses.size(), p_branches.size());
+
+  GraphPartitioner::WeightVector nodeweights(p_matrixPartitionWeights ? 2 : 1);
+  int ibus(0);
+  for (BusIterator bus = p_buses.begin(); 
+      bus != p_buses.end(); ++bus, ++ibus) {
+    if (weights != NULL) {
+      nodeweights[0] = (*weights)[ibus];
+    } else {
+      nodeweights[0] = bus->p_bus->getWorkload(bus->p_data);
+    }
+    if (p_matrixPartitionWeights) {
+      nodeweights[1] = bus->p_bus->getMatrixWorkload(bus->p_data);
+    }
+    partitioner.add_node(bus->p_globalBusIndex,bus->p_originalBusIndex,
+        nodeweights);
+  }
+  for (BranchIterator branch = p_branches.begin(); 
+      branch != p_branches.end(); ++branch) {
+    partitioner.add_edge(branch->p_globalBranchIndex, 
+        branch->p_originalBusIndex1,
+        branch->p_originalBusIndex2);
+  }
+  if (adaptive) {
+    partitioner.repartition(itr);
+  } else {
+    partitioner.partition();
+  }
+  partitioner.imbalance(p_partitionImbalance);
+  if (this->processor_rank() == 0 && this->processor_size() > 1) {
+    printf("Partition imbalance (max/average weight): workload %8.4f",
+        p_partitionImbalance[0]);
+    if (p_partitionImbalance.size() > 1) {
+      printf(" matrix rows %8.4f",p_partitionImbalance[1]);
+    }
+    printf("\n");
+  }
+  // Recover global indices for branch ends from partitioner
+  int nbranch = p_branches.size();
+  int idx;
+  unsigned int index1, index2;
+  for (idx=0; idx<nbranch; idx++) {
+    partitioner.get_global_edge_ids(idx, &index1, &index2);
+    p_branches[idx].p_globalBusIndex1 = static_cast<int>(index1);
+    p_branches[idx].p_globalBusIndex2 = static_cast<int>(index2);
+  }
+
+  if (timer != NULL) timer->stop(t_part);
+
+  int me(this->processor_rank());
+  GraphPartitioner::IndexVector dest, gdest;
+
+#if 1
+  typedef parallel::Shuffler<BusData<BusType>, GraphPartitioner::Index> BusShufflerType;
+  typedef parallel::Shuffler<BranchData<BranchType>, GraphPartitioner::Index> BranchShufflerType;
+#else 
+  typedef parallel::gaShuffler<BusData<BusType>, GraphPartitioner::Index> BusShufflerType;
+  typedef parallel::gaShuffler<BranchData<BranchType>, GraphPartitioner::Index> BranchShufflerType;
+#endif
+
+  BusShufflerType bus_shuffler(this->communicator());
+  BranchShufflerType branch_shuffler(this->communicator());
+
+  // Need to make copies of buses and branches that will be ghosted.
+  // After active bus/branch distribution, they may not be on this
+  // processor.
+
+  BusDataVector ghostbuses;
+  GraphPartitioner::MultiIndexVector gnodedest;
+  GraphPartitioner::IndexVector ghostbusdest;
+  BusIterator bus(p_buses.begin());
+  partitioner.ghost_node_destinations(gnodedest);
+
+  for (size_t i = 0; i < gnodedest.size(); ++i, ++bus) {
+    for (GraphPartitioner::IndexVector::iterator d = gnodedest[i].begin();
+        d != gnodedest[i].end(); ++d) {
+      ghostbuses.push_back(*bus);
+      ghostbusdest.push_back(*d);
+    }
+  }
+
+  // Branches can only be ghosted on one other process, so they're
+  // easy.
+
+  partitioner.edge_destinations(dest);
+  partitioner.ghost_edge_destinations(gdest);
+
+  BranchDataVector ghostbranches;
+  BranchIterator branch(p_branches.begin());
+  GraphPartitioner::IndexVector ghostbranchdest;
+
+  for (size_t i = 0; i < dest.size(); ++i, ++branch) {
+    if (dest[i] != gdest[i]) {
+      ghostbranches.push_back(*branch);
+      ghostbranches.back().p_activeBranch = false;
+      ghostbranchdest.push_back(gdest[i]);
+    }
+  }
+
+
+  // distribute active nodes
+
+  // std::cout << me << ": distributing " << p_buses.size() << " active buses" << std::endl;
+
+  if (timer != NULL) timer->start(t_bus_dist);
+  partitioner.node_destinations(dest);
+  bus_shuffler(p_buses, dest);
+  if (timer != NULL) timer->stop(t_bus_dist);
+
+  // distribute active edges
+
+  if (timer != NULL) timer->start(t_branch_dist);
+  partitioner.edge_destinations(dest);
+  branch_shuffler(p_branches, dest);
+  if (timer != NULL) timer->stop(t_branch_dist);
+
+  // At this point, active buses and branches are on the proper
+  // process.  Now, we need to distribute and nodes and edges that
+  // are ghosted.  
+
+  // std::cout << me << ": distributing " << ghostbuses.size() << " ghost buses" << std::endl;
+
+  if (timer != NULL) timer->start(t_bus_dist);
+  bus_shuffler(ghostbuses, ghostbusdest);
+  for (bus = ghostbuses.begin(); bus != ghostbuses.end(); ++bus) {
+    bus->p_activeBus = false;
+    p_buses.push_back(*bus);
+  }
+  ghostbuses.clear();
+  if (timer != NULL) timer->stop(t_bus_dist);
+
+  if (timer != NULL) timer->start(t_branch_dist);
+  branch_shuffler(ghostbranches, ghostbranchdest);
+  std::copy(ghostbranches.begin(), ghostbranches.end(),
+      std::back_inserter(p_branches));
+  ghostbranches.clear();
+  if (timer != NULL) timer->stop(t_branch_dist);
+
+  // At this point, each process should have a self-contained
+  // network, update local and global indexes, etc.
+
+  // move components into contiguous storage now that the ghosts are in
+  // place. Component pointers are set below
+  if (p_arenaStorage) moveComponentsToArenas();
+
+  // make an index of global bus index to local index and update
+  // the branch local bus indexes
+  int active_buses(0), active_branches(0);
+  {
+    std::map<int, int> busindexes;
+    int lidx(0);
+    for (BusIterator b = p_buses.begin(); b != p_buses.end(); ++b, ++lidx) {
+      clearBranchNeighbors(lidx);
+      // components that stayed on this process still point to their old
+      // neighbors if the network is being repartitioned
+      b->p_bus->clearBranches();
+      b->p_bus->clearBuses();
+      busindexes[b->p_globalBusIndex] = lidx;
+      if (b->p_activeBus) active_buses += 1;
+    }
+
+    // go through the branches and set the local bus indexes and pointers
+    lidx = 0;
+    for (BranchIterator b = p_branches.begin(); b != p_branches.end(); ++b, ++lidx) {
+      int gbus, lbus1, lbus2;
+      BusPtr bus1, bus2;
+
+      // set local indexes
+
+      gbus = b->p_globalBusIndex1;
+      lbus1 = busindexes[gbus];
+      bus1 = p_buses[lbus1].p_bus;
+
+      gbus = b->p_globalBusIndex2;
+      lbus2 = busindexes[gbus];
+      bus2 = p_buses[lbus2].p_bus;
+
+      b->p_localBusIndex1 = lbus1;
+      addBranchNeighbor(lbus1, lidx);
+
+      b->p_localBusIndex2 = lbus2;
+      addBranchNeighbor(lbus2, lidx);
+
+      // set component pointers
+
+      b->p_branch->setBus1(bus1);
+      b->p_branch->setBus2(bus2);
+
+      gbus = b->p_globalBusIndex1;
+      bus1->addBranch(b->p_branch);
+      bus1->addBus(bus2);
+      setGlobalBusIndex1(lidx,gbus); 
+      gbus = b->p_globalBusIndex2;
+      bus2->addBranch(b->p_branch);
+      bus2->addBus(bus1);
+      setGlobalBusIndex2(lidx,gbus); 
+
+      if (b->p_activeBranch) active_branches += 1;
+    }
+  }
+
+  std::cout << me << ": "
+    << "I have " 
+    << p_buses.size() << " buses and "
+    << p_branches.size() << " branches"
+    << std::endl;
+
+  setBoundaryLists();
+  setTopology();
+
+  if (timer != NULL) timer->stop(t_total);
+}
+
 /**
  * Protected copy constructor to avoid unwanted copies.
  */
@@ -2454,6 +3672,191 @@ private:
   typedef std::vector< BranchData<BranchType> > BranchDataVector;
   typedef typename BranchDataVector::iterator BranchIterator;
 
+  /**
+   * Message tags used for direct exchange of ghost data
+   */
+  static const int p_busXCTag = 9001;
+  static const int p_branchXCTag = 9002;
+
+  /**
+   * Construct the send and receive lists for a direct exchange of ghost data
+   * between neighboring processes. This is a collective operation.
+   * @param plan exchange plan that is filled by this function
+   * @param activeGlobal global indices of locally owned elements
+   * @param activeLocal local indices of locally owned elements
+   * @param ghostGlobal global indices of ghost elements
+   * @param ghostLocal local indices of ghost elements
+   * @param bufsize size (in bytes) of exchange buffer for each element
+   */
+  void setupExchangePlan(GhostExchangePlan &plan,
+      const std::vector<int> &activeGlobal, const std::vector<int> &activeLocal,
+      const std::vector<int> &ghostGlobal, const std::vector<int> &ghostLocal,
+      int bufsize)
+  {
+    MPI_Comm comm = static_cast<MPI_Comm>(this->communicator());
+    int nprocs = this->processor_size();
+    int me = this->processor_rank();
+    int i, j, p;
+    plan.clear();
+
+    // Find the process that owns each ghost element using a distributed hash
+    // map of global indices to owning processes
+    std::vector<std::pair<int,int> > pairs;
+    int nactive = activeGlobal.size();
+    for (i=0; i<nactive; i++) {
+      pairs.push_back(std::pair<int,int>(activeGlobal[i],me));
+    }
+    gridpack::hash_map::GlobalIndexHashMap hash_map(this->communicator());
+    hash_map.addPairs(pairs);
+    std::vector<int> keys(ghostGlobal);
+    std::vector<int> values;
+    hash_map.getValues(keys,values);
+    std::map<int,int> owners;
+    int nvals = values.size();
+    for (i=0; i<nvals; i++) {
+      owners.insert(std::pair<int,int>(keys[i],values[i]));
+    }
+
+    // Sort ghost elements by owning process
+    std::vector<std::vector<int> > reqGlobal(nprocs);
+    std::vector<std::vector<int> > reqLocal(nprocs);
+    std::map<int,int>::iterator it;
+    int nghost = ghostGlobal.size();
+    for (i=0; i<nghost; i++) {
+      it = owners.find(ghostGlobal[i]);
+      if (it == owners.end()) {
+        char buf[256];
+        sprintf(buf,"BaseNetwork::setupExchangePlan: no owner found for"
+            " global index: %d\n",ghostGlobal[i]);
+        printf("%s",buf);
+        throw gridpack::Exception(buf);
+      }
+      reqGlobal[it->second].push_back(ghostGlobal[i]);
+      reqLocal[it->second].push_back(ghostLocal[i]);
+    }
+
+    // Tell each owning process which of its elements are needed on this
+    // process
+    std::vector<int> nreq(nprocs), nsnd(nprocs);
+    for (p=0; p<nprocs; p++) {
+      nreq[p] = reqGlobal[p].size();
+    }
+    MPI_Alltoall(&nreq[0],1,MPI_INT,&nsnd[0],1,MPI_INT,comm);
+    std::vector<int> r_offsets(nprocs), s_offsets(nprocs);
+    r_offsets[0] = 0;
+    s_offsets[0] = 0;
+    for (p=1; p<nprocs; p++) {
+      r_offsets[p] = r_offsets[p-1]+nreq[p-1];
+      s_offsets[p] = s_offsets[p-1]+nsnd[p-1];
+    }
+    int rtotal = r_offsets[nprocs-1]+nreq[nprocs-1];
+    int stotal = s_offsets[nprocs-1]+nsnd[nprocs-1];
+    std::vector<int> req_buf(rtotal+1), snd_buf(stotal+1);
+    for (p=0; p<nprocs; p++) {
+      for (j=0; j<nreq[p]; j++) {
+        req_buf[r_offsets[p]+j] = reqGlobal[p][j];
+      }
+    }
+    MPI_Alltoallv(&req_buf[0],&nreq[0],&r_offsets[0],MPI_INT,
+        &snd_buf[0],&nsnd[0],&s_offsets[0],MPI_INT,comm);
+
+    // Convert requested global indices to local indices and build send lists
+    std::map<int,int> g2l;
+    for (i=0; i<nactive; i++) {
+      g2l.insert(std::pair<int,int>(activeGlobal[i],activeLocal[i]));
+    }
+    plan.p_sendOffsets.push_back(0);
+    for (p=0; p<nprocs; p++) {
+      if (nsnd[p] == 0) continue;
+      plan.p_sendProcs.push_back(p);
+      for (j=0; j<nsnd[p]; j++) {
+        it = g2l.find(snd_buf[s_offsets[p]+j]);
+        if (it == g2l.end()) {
+          char buf[256];
+          sprintf(buf,"BaseNetwork::setupExchangePlan: requested element is"
+              " not owned by process %d global index: %d\n",me,
+              snd_buf[s_offsets[p]+j]);
+          printf("%s",buf);
+          throw gridpack::Exception(buf);
+        }
+        plan.p_sendIndices.push_back(it->second);
+      }
+      plan.p_sendOffsets.push_back(plan.p_sendIndices.size());
+    }
+
+    // Build receive lists
+    plan.p_recvOffsets.push_back(0);
+    for (p=0; p<nprocs; p++) {
+      if (nreq[p] == 0) continue;
+      plan.p_recvProcs.push_back(p);
+      for (j=0; j<nreq[p]; j++) {
+        plan.p_recvIndices.push_back(reqLocal[p][j]);
+      }
+      plan.p_recvOffsets.push_back(plan.p_recvIndices.size());
+    }
+
+    plan.p_sendBuf.resize(plan.p_sendIndices.size()*bufsize);
+    plan.p_recvBuf.resize(plan.p_recvIndices.size()*bufsize);
+    plan.p_requests.resize(plan.p_sendProcs.size()+plan.p_recvProcs.size());
+  }
+
+  /**
+   * Post receives for ghost data and send data from locally owned elements
+   * to neighboring processes
+   * @param plan exchange plan created by setupExchangePlan
+   * @param buffers exchange buffers for all local elements
+   * @param bufsize size (in bytes) of exchange buffer for each element
+   * @param tag message tag for this exchange
+   */
+  void startExchange(GhostExchangePlan &plan, void **buffers, int bufsize,
+      int tag)
+  {
+    MPI_Comm comm = static_cast<MPI_Comm>(this->communicator());
+    int i, j, lo, hi;
+    int nreq = 0;
+    int nrecv = plan.p_recvProcs.size();
+    for (i=0; i<nrecv; i++) {
+      lo = plan.p_recvOffsets[i];
+      hi = plan.p_recvOffsets[i+1];
+      MPI_Irecv(&plan.p_recvBuf[lo*bufsize],(hi-lo)*bufsize,MPI_BYTE,
+          plan.p_recvProcs[i],tag,comm,&plan.p_requests[nreq]);
+      nreq++;
+    }
+    int nsend = plan.p_sendProcs.size();
+    for (i=0; i<nsend; i++) {
+      lo = plan.p_sendOffsets[i];
+      hi = plan.p_sendOffsets[i+1];
+      for (j=lo; j<hi; j++) {
+        memcpy(&plan.p_sendBuf[j*bufsize],buffers[plan.p_sendIndices[j]],
+            bufsize);
+      }
+      MPI_Isend(&plan.p_sendBuf[lo*bufsize],(hi-lo)*bufsize,MPI_BYTE,
+          plan.p_sendProcs[i],tag,comm,&plan.p_requests[nreq]);
+      nreq++;
+    }
+  }
+
+  /**
+   * Wait for outstanding messages to complete and copy received data into
+   * the exchange buffers of ghost elements
+   * @param plan exchange plan created by setupExchangePlan
+   * @param buffers exchange buffers for all local elements
+   * @param bufsize size (in bytes) of exchange buffer for each element
+   */
+  void finishExchange(GhostExchangePlan &plan, void **buffers, int bufsize)
+  {
+    int nreq = plan.p_requests.size();
+    if (nreq > 0) {
+      MPI_Waitall(nreq,&plan.p_requests[0],MPI_STATUSES_IGNORE);
+    }
+    int i;
+    int nghost = plan.p_recvIndices.size();
+    for (i=0; i<nghost; i++) {
+      memcpy(buffers[plan.p_recvIndices[i]],&plan.p_recvBuf[i*bufsize],
+          bufsize);
+    }
+  }
+
   /**
    * Vector of bus data and objects
    */
@@ -2517,6 +3920,68 @@ private:
   void *p_branchSndBuf;
   void *p_branchRcvBuf;
 
+  /**
+   * Parameters used for direct exchange of ghost data between neighboring
+   * processes. p_neighborXC is the algorithm requested by the user,
+   * p_bus(branch)NeighborXC is the algorithm set up by the last call to
+   * initBus(Branch)Update
+   */
+  bool p_neighborXC;
+  bool p_busNeighborXC;
+  bool p_branchNeighborXC;
+  GhostExchangePlan p_busPlan;
+  GhostExchangePlan p_branchPlan;
+
+  /**
+   * Flags indicating that a split-phase ghost update has been started but
+   * not completed
+   */
+  bool p_busUpdatePending;
+  bool p_branchUpdatePending;
+
+  /**
+   * Flag indicating that matrix rows are balanced along with workload when
+   * the network is partitioned, and the imbalance achieved by partition
+   */
+  bool p_matrixPartitionWeights;
+  std::vector<double> p_partitionImbalance;
+
+  /**
+   * Bus currently being timed by startBusTimer and the time it started
+   */
+  int p_timedBus;
+  double p_busTimerStart;
+
+  /**
+   * Flag indicating that components are moved into arenas by partition
+   */
+  bool p_arenaStorage;
+
+  /**
+   * Local indices of active buses and branches that do not depend on ghost
+   * data (interior) and those that do (boundary)
+   */
+  std::vector<int> p_interiorBuses;
+  std::vector<int> p_boundaryBuses;
+  std::vector<int> p_interiorBranches;
+  std::vector<int> p_boundaryBranches;
+
+  /**
+   * Compressed adjacency lists built by setTopology. The pointer lists are
+   * kept both as the network's component types and as base components,
+   * since the components only know about the base class
+   */
+  std::vector<int> p_busBranchOffsets;
+  std::vector<int> p_busBranchIndices;
+  std::vector<int> p_busBusIndices;
+  std::vector<int> p_branchBusIndices;
+  std::vector<_branch*> p_busBranchPtrs;
+  std::vector<_bus*> p_busBusPtrs;
+  std::vector<_bus*> p_branchBusPtrs;
+  std::vector<component::BaseComponent*> p_busBranchComponents;
+  std::vector<component::BaseComponent*> p_busBusComponents;
+  std::vector<component::BaseComponent*> p_branchBusComponents;
+
   /**
    * Map structures that can map between Original and local indices
    */
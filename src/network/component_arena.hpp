@@ -0,0 +1,111 @@
+// Emacs Mode Line: -*- Mode:c++;-*-
+/*
+ *     Copyright (c) 2013 Battelle Memorial Institute
+ *     Licensed under modified BSD License. A copy of this license can be found
+ *     in the LICENSE file in the top level directory of this distribution.
+ */
+// -------------------------------------------------------------
+/**
+ * @file   component_arena.hpp
+ *
+ * @brief
+ * A fixed size block of memory that holds network components of a single
+ * type next to each other. The network hands out pointers to components
+ * in the arena as shared pointers that share ownership of the whole arena,
+ * so the arena is destroyed when the last of its components is released.
+ *
+ */
+
+// -------------------------------------------------------------
+
+#ifndef _component_arena_hpp_
+#define _component_arena_hpp_
+
+#include <cstdio>
+#include <memory>
+#include <new>
+#include "gridpack/utilities/exception.hpp"
+#include "gridpack/utilities/uncopyable.hpp"
+
+namespace gridpack {
+namespace network {
+
+// -------------------------------------------------------------
+//  class ComponentArena
+// -------------------------------------------------------------
+template <class _component>
+class ComponentArena
+  : private utility::Uncopyable {
+public:
+
+  /**
+   * Constructor
+   * @param capacity maximum number of components held by arena
+   */
+  explicit ComponentArena(size_t capacity)
+    : p_data(NULL), p_size(0), p_capacity(capacity)
+  {
+    if (p_capacity > 0) p_data = p_alloc.allocate(p_capacity);
+  }
+
+  /**
+   * Destructor. Components are destroyed in the reverse order of their
+   * construction
+   */
+  ~ComponentArena(void)
+  {
+    while (p_size > 0) {
+      p_size--;
+      p_data[p_size].~_component();
+    }
+    if (p_data) p_alloc.deallocate(p_data, p_capacity);
+  }
+
+  /**
+   * Construct a default component in the next free slot
+   * @return pointer to new component
+   */
+  _component* construct(void)
+  {
+    if (p_size >= p_capacity) {
+      char buf[256];
+      sprintf(buf,"ComponentArena::construct: arena is full, capacity: %d\n",
+          static_cast<int>(p_capacity));
+      printf("%s",buf);
+      throw gridpack::Exception(buf);
+    }
+    _component *ptr = new(p_data+p_size) _component;
+    p_size++;
+    return ptr;
+  }
+
+  /**
+   * Number of components constructed in arena
+   * @return number of components
+   */
+  size_t size(void) const
+  {
+    return p_size;
+  }
+
+  /**
+   * Maximum number of components held by arena
+   * @return capacity of arena
+   */
+  size_t capacity(void) const
+  {
+    return p_capacity;
+  }
+
+private:
+
+  std::allocator<_component> p_alloc;
+  _component *p_data;
+  size_t p_size;
+  size_t p_capacity;
+};
+
+} // namespace network
+} // namespace gridpack
+
+#endif
@@ -0,0 +1,240 @@
+/*
+ *     Copyright (c) 2013 Battelle Memorial Institute
+ *     Licensed under modified BSD License. A copy of this license can be found
+ *     in the LICENSE file in the top level directory of this distribution.
+ */
+// -------------------------------------------------------------
+/**
+ * @file   arena_benchmark.cpp
+ *
+ * @brief  Time mapper-style iteration over the components of a network,
+ * with components allocated individually and with arena storage
+ *
+ * Usage: arena_benchmark [lattice size] [number of sweeps]
+ *
+ * The network is a square lattice. The default is 316 x 316 buses (about
+ * 100000) and 20 sweeps. Each sweep visits every bus and branch through
+ * getBus(i) and getBranch(i) and asks for the size and values of its
+ * matrix block, the way the mappers do.
+ */
+// -------------------------------------------------------------
+
+#include <cstdio>
+#include <cstdlib>
+#include <ga++.h>
+#include <boost/mpi/collectives.hpp>
+
+#include "gridpack/parallel/parallel.hpp"
+#include "gridpack/component/base_component.hpp"
+#include "base_network.hpp"
+
+// -------------------------------------------------------------
+//  class BenchBus
+// -------------------------------------------------------------
+class BenchBus
+  : public gridpack::component::BaseBusComponent {
+public:
+
+  /// Default constructor.
+  BenchBus(void)
+    : gridpack::component::BaseBusComponent(), p_v(1.0), p_a(0.0)
+  {
+    for (int i = 0; i < 8; ++i) p_state[i] = 0.0;
+  }
+
+  /// Destructor
+  ~BenchBus(void)
+  {}
+
+  bool matrixDiagSize(int *isize, int *jsize) const
+  {
+    *isize = 1;
+    *jsize = 1;
+    return true;
+  }
+
+  bool matrixDiagValues(gridpack::ComplexType *values)
+  {
+    values[0] = gridpack::ComplexType(p_v*p_state[0], p_a*p_state[1]);
+    return true;
+  }
+
+private:
+
+  double p_v, p_a;
+  double p_state[8];
+
+  friend class boost::serialization::access;
+
+  template<class Archive>
+  void serialize(Archive & ar, const unsigned int version)
+  {
+    ar & boost::serialization::base_object<BaseBusComponent>(*this)
+      & p_v & p_a & p_state;
+  }
+};
+
+BOOST_CLASS_EXPORT(BenchBus)
+
+// -------------------------------------------------------------
+//  class BenchBranch
+// -------------------------------------------------------------
+class BenchBranch
+  : public gridpack::component::BaseBranchComponent {
+public:
+
+  /// Default constructor.
+  BenchBranch(void)
+    : gridpack::component::BaseBranchComponent(), p_r(0.01), p_x(0.1)
+  {}
+
+  /// Destructor
+  ~BenchBranch(void)
+  {}
+
+  bool matrixForwardSize(int *isize, int *jsize) const
+  {
+    *isize = 1;
+    *jsize = 1;
+    return true;
+  }
+
+  bool matrixForwardValues(gridpack::ComplexType *values)
+  {
+    values[0] = gridpack::ComplexType(p_r, p_x);
+    return true;
+  }
+
+private:
+
+  double p_r, p_x;
+
+  friend class boost::serialization::access;
+
+  template<class Archive>
+  void serialize(Archive & ar, const unsigned int version)
+  {
+    ar & boost::serialization::base_object<BaseBranchComponent>(*this)
+      & p_r & p_x;
+  }
+};
+
+BOOST_CLASS_EXPORT(BenchBranch)
+
+typedef gridpack::network::BaseNetwork<BenchBus, BenchBranch> BenchNetwork;
+
+// Build a square lattice on process 0. Data collection values are added as
+// each bus is created, the way a parser fills them, so bus components are
+// not allocated next to each other
+void buildLattice(BenchNetwork &net, int n)
+{
+  if (net.processor_rank() != 0) return;
+  int i, j, nbus(0), nbranch(0);
+  for (i = 0; i < n; ++i) {
+    for (j = 0; j < n; ++j) {
+      int idx = i*n + j;
+      net.addBus(idx);
+      net.setGlobalBusIndex(nbus, idx);
+      net.getBusData(nbus)->addValue("BUS_NUMBER", idx);
+      net.getBusData(nbus)->addValue("BUS_BASEKV", 138.0);
+      nbus++;
+    }
+  }
+  for (i = 0; i < n; ++i) {
+    for (j = 0; j < n; ++j) {
+      int idx1 = i*n + j;
+      if (i < n-1) {
+        net.addBranch(idx1, idx1+n);
+        net.setGlobalBranchIndex(nbranch, nbranch);
+        net.setGlobalBusIndex1(nbranch, idx1);
+        net.setGlobalBusIndex2(nbranch, idx1+n);
+        nbranch++;
+      }
+      if (j < n-1) {
+        net.addBranch(idx1, idx1+1);
+        net.setGlobalBranchIndex(nbranch, nbranch);
+        net.setGlobalBusIndex1(nbranch, idx1);
+        net.setGlobalBusIndex2(nbranch, idx1+1);
+        nbranch++;
+      }
+    }
+  }
+}
+
+// Visit every bus and branch the way the mappers do and return the time
+// taken by the slowest process
+double sweep(BenchNetwork &net, int nsweep, double *checksum)
+{
+  int i, k, isize, jsize;
+  gridpack::ComplexType value;
+  double sum(0.0);
+  int nbus = net.numBuses();
+  int nbranch = net.numBranches();
+  net.communicator().barrier();
+  double t0 = MPI_Wtime();
+  for (k = 0; k < nsweep; ++k) {
+    for (i = 0; i < nbus; ++i) {
+      if (net.getBus(i)->matrixDiagSize(&isize, &jsize)) {
+        net.getBus(i)->matrixDiagValues(&value);
+        sum += real(value);
+      }
+    }
+    for (i = 0; i < nbranch; ++i) {
+      if (net.getBranch(i)->matrixForwardSize(&isize, &jsize)) {
+        net.getBranch(i)->matrixForwardValues(&value);
+        sum += imag(value);
+      }
+    }
+  }
+  double t = MPI_Wtime() - t0;
+  double tmax;
+  boost::mpi::all_reduce(net.communicator(), t, tmax,
+      boost::mpi::maximum<double>());
+  *checksum = sum;
+  return tmax;
+}
+
+// -------------------------------------------------------------
+//  Main Program
+// -------------------------------------------------------------
+int
+main(int argc, char **argv)
+{
+  gridpack::parallel::Environment env(argc, argv);
+
+  // Limit scope so that program exits cleanly
+  if (1) {
+    gridpack::parallel::Communicator world;
+    int n = 316;
+    int nsweep = 20;
+    if (argc > 1) n = atoi(argv[1]);
+    if (argc > 2) nsweep = atoi(argv[2]);
+
+    BenchNetwork heap(world);
+    buildLattice(heap, n);
+    heap.partition();
+
+    BenchNetwork arena(world);
+    buildLattice(arena, n);
+    arena.setArenaStorage(true);
+    arena.partition();
+
+    double sum_heap, sum_arena;
+    double t_heap = sweep(heap, nsweep, &sum_heap);
+    double t_arena = sweep(arena, nsweep, &sum_arena);
+
+    if (world.rank() == 0) {
+      printf("Lattice %d x %d on %d processors, %d sweeps\n",
+          n, n, world.size(), nsweep);
+      printf("  individual allocation %10.4f s\n", t_heap);
+      printf("  arena storage         %10.4f s\n", t_arena);
+      printf("  speedup               %10.2f\n", t_heap/t_arena);
+    }
+    if (sum_heap != sum_arena) {
+      printf("p[%d] ERROR: checksums differ (%f, %f)\n",
+          world.rank(), sum_heap, sum_arena);
+    }
+  }
+
+  return 0;
+}
@@ -13,6 +13,7 @@
  * 
  */
 
+#include <algorithm>
 #include <iostream>
 #include <ga++.h>
 #include <boost/mpi/environment.hpp>
@@ -42,6 +43,15 @@ public:
   ~BogusBus(void)
   {}
 
+  /// Workload is taken from the data collection, if there
+  int getWorkload(
+      const boost::shared_ptr<gridpack::component::DataCollection> &data) const
+  {
+    int workload(1);
+    data->getValue("WORKLOAD", &workload);
+    return workload;
+  }
+
 private:
 
   friend class boost::serialization::access;
@@ -426,6 +436,220 @@ BOOST_AUTO_TEST_CASE ( lattice_partition )
   net.writeGraph("lattice-after.dot");
 }
 
+BOOST_AUTO_TEST_CASE ( weighted_partition )
+{
+  gridpack::parallel::Communicator world;
+  static const int rows(6), cols(6);
+  BogusLatticeNetwork net(world, rows, cols);
+
+  // make the buses in the first row much more expensive than the rest
+  for (int b = 0; b < net.numBuses(); ++b) {
+    if (net.getGlobalBusIndex(b) < cols) {
+      net.getBusData(b)->addValue("WORKLOAD", 20);
+    }
+  }
+  net.setMatrixPartitionWeights(true);
+  net.partition();
+
+  std::vector<double> imbalance;
+  net.getPartitionImbalance(imbalance);
+  BOOST_REQUIRE_EQUAL(imbalance.size(), 2);
+  BOOST_CHECK_GE(imbalance[0], 1.0);
+  BOOST_CHECK_GE(imbalance[1], 1.0);
+
+  // check the workload each process ended up with against the imbalance
+  int workload(0), total(0), biggest(0);
+  for (int b = 0; b < net.numBuses(); ++b) {
+    if (net.getActiveBus(b)) {
+      workload += net.getBus(b)->getWorkload(net.getBusData(b));
+    }
+  }
+  boost::mpi::all_reduce(world, workload, total, std::plus<int>());
+  boost::mpi::all_reduce(world, workload, biggest, boost::mpi::maximum<int>());
+  BOOST_CHECK_EQUAL(total, rows*cols + 19*cols);
+  BOOST_CHECK_CLOSE(imbalance[0],
+                    static_cast<double>(biggest*world.size())/total, 1.0e-6);
+}
+
+
+// Sum the cost of the active buses on each process and return the ratio
+// of the maximum sum to the average sum
+static double
+costImbalance(const gridpack::parallel::Communicator& world,
+              BogusLatticeNetwork& net, const std::vector<int>& expensive)
+{
+  double local(0.0);
+  for (int b = 0; b < net.numBuses(); ++b) {
+    if (!net.getActiveBus(b)) continue;
+    int orig(net.getOriginalBusIndex(b));
+    local += (std::binary_search(expensive.begin(), expensive.end(), orig) ?
+              10.0 : 1.0);
+  }
+  double lmax(0.0), lsum(0.0);
+  boost::mpi::all_reduce(world, local, lmax, boost::mpi::maximum<double>());
+  boost::mpi::all_reduce(world, local, lsum, std::plus<double>());
+  return lmax*static_cast<double>(world.size())/lsum;
+}
+
+BOOST_AUTO_TEST_CASE ( lattice_repartition )
+{
+  gridpack::parallel::Communicator world;
+  static const int rows(8), cols(8);
+  BogusLatticeNetwork net(world, rows, cols);
+
+  net.partition();
+
+  // pretend that the buses on process 0 took much longer than the rest
+  std::vector<int> expensive;
+  for (int b = 0; b < net.numBuses(); ++b) {
+    if (net.getActiveBus(b)) {
+      if (world.rank() == 0) expensive.push_back(net.getOriginalBusIndex(b));
+      net.addBusCost(b, (world.rank() == 0 ? 10.0 : 1.0));
+    }
+  }
+  boost::mpi::broadcast(world, expensive, 0);
+  std::sort(expensive.begin(), expensive.end());
+  double before(costImbalance(world, net, expensive));
+
+  net.repartition();
+
+  int active(0), allactive(0);
+  for (int b = 0; b < net.numBuses(); ++b) {
+    if (net.getActiveBus(b)) active += 1;
+    BOOST_CHECK_EQUAL(net.getBusCost(b), 0.0);
+  }
+  boost::mpi::all_reduce(world, active, allactive, std::plus<int>());
+  BOOST_CHECK_EQUAL(allactive, rows*cols);
+
+  // the measured costs should be more evenly spread than before
+  double after(costImbalance(world, net, expensive));
+  if (world.size() > 1) {
+    BOOST_CHECK_LT(after, before);
+  }
+
+  // branches should point to local copies of their buses, and all
+  // lattice neighbors of active buses should be there, as ghosts if
+  // necessary
+  for (int l = 0; l < net.numBranches(); ++l) {
+    int idx1, idx2, orig1, orig2;
+    net.getBranchEndpoints(l, &idx1, &idx2);
+    BOOST_REQUIRE(idx1 >= 0 && idx1 < net.numBuses());
+    BOOST_REQUIRE(idx2 >= 0 && idx2 < net.numBuses());
+    net.getOriginalBranchEndpoints(l, &orig1, &orig2);
+    BOOST_CHECK_EQUAL(net.getOriginalBusIndex(idx1), orig1);
+    BOOST_CHECK_EQUAL(net.getOriginalBusIndex(idx2), orig2);
+    BOOST_CHECK(net.getBranch(l)->getBus1() == net.getBus(idx1));
+    BOOST_CHECK(net.getBranch(l)->getBus2() == net.getBus(idx2));
+    if (net.getActiveBranch(l)) {
+      BOOST_CHECK(net.getActiveBus(idx1) || net.getActiveBus(idx2));
+    }
+  }
+  for (int b = 0; b < net.numBuses(); ++b) {
+    std::vector<int> branches(net.getConnectedBranches(b));
+    std::vector<boost::shared_ptr<gridpack::component::BaseComponent> > nbr;
+    net.getBus(b)->getNeighborBranches(nbr);
+    BOOST_CHECK_EQUAL(nbr.size(), branches.size());
+    if (!net.getActiveBus(b)) continue;
+    int orig(net.getOriginalBusIndex(b));
+    int i(orig/cols), j(orig % cols);
+    size_t degree((i > 0) + (i < rows-1) + (j > 0) + (j < cols-1));
+    BOOST_CHECK_EQUAL(branches.size(), degree);
+    for (size_t k = 0; k < branches.size(); ++k) {
+      BOOST_CHECK(branches[k] >= 0 && branches[k] < net.numBranches());
+    }
+  }
+
+  net.writeGraph("lattice-repartitioned.dot");
+}
+
+BOOST_AUTO_TEST_CASE ( lattice_topology )
+{
+  gridpack::parallel::Communicator world;
+  static const int rows(5), cols(5);
+  BogusLatticeNetwork net(world, rows, cols);
+
+  net.partition();
+
+  // the adjacency lists should match the neighbor lists, both in the
+  // network and in the components
+  const std::vector<int> &offsets(net.getBusBranchOffsets());
+  const std::vector<int> &branchidx(net.getBusBranchIndices());
+  BOOST_REQUIRE_EQUAL(offsets.size(), net.numBuses()+1);
+  for (int b = 0; b < net.numBuses(); ++b) {
+    std::vector<int> branches(net.getConnectedBranches(b));
+    std::vector<int> buses(net.getConnectedBuses(b));
+    gridpack::component::ComponentSpan<BogusBranch> brspan(net.getBranchSpan(b));
+    gridpack::component::ComponentSpan<BogusBus> busspan(net.getBusSpan(b));
+    gridpack::component::ComponentSpan<gridpack::component::BaseComponent>
+      cbrspan(net.getBus(b)->getBranchSpan());
+    gridpack::component::ComponentSpan<gridpack::component::BaseComponent>
+      cbusspan(net.getBus(b)->getBusSpan());
+    BOOST_REQUIRE_EQUAL(brspan.size(), branches.size());
+    BOOST_REQUIRE_EQUAL(busspan.size(), buses.size());
+    BOOST_REQUIRE_EQUAL(cbrspan.size(), branches.size());
+    BOOST_REQUIRE_EQUAL(cbusspan.size(), buses.size());
+    for (size_t i = 0; i < branches.size(); ++i) {
+      BOOST_CHECK_EQUAL(branchidx[offsets[b]+i], branches[i]);
+      BOOST_CHECK(brspan[i] == net.getBranch(branches[i]).get());
+      BOOST_CHECK(busspan[i] == net.getBus(buses[i]).get());
+      BOOST_CHECK(cbrspan.get<BogusBranch>(i) == brspan[i]);
+      BOOST_CHECK(cbusspan.get<BogusBus>(i) == busspan[i]);
+    }
+  }
+  for (int l = 0; l < net.numBranches(); ++l) {
+    gridpack::component::ComponentSpan<gridpack::component::BaseComponent>
+      buses(net.getBranch(l)->getBusSpan());
+    BOOST_REQUIRE_EQUAL(buses.size(), 2);
+    BOOST_CHECK(buses[0] == net.getBranch(l)->getBus1().get());
+    BOOST_CHECK(buses[1] == net.getBranch(l)->getBus2().get());
+    BOOST_CHECK(net.getBranchBusSpan(l)[0] == buses[0]);
+  }
+}
+
+BOOST_AUTO_TEST_CASE ( lattice_arena )
+{
+  gridpack::parallel::Communicator world;
+  static const int rows(5), cols(5);
+  BogusLatticeNetwork net(world, rows, cols);
+
+  net.setArenaStorage(true);
+  net.partition();
+
+  // components should be next to each other in local index order and
+  // still be linked to their neighbors
+  for (int b = 1; b < net.numBuses(); ++b) {
+    BOOST_CHECK_EQUAL(net.getBus(b).get() - net.getBus(b-1).get(), 1);
+  }
+  for (int l = 1; l < net.numBranches(); ++l) {
+    BOOST_CHECK_EQUAL(net.getBranch(l).get() - net.getBranch(l-1).get(), 1);
+  }
+  for (int l = 0; l < net.numBranches(); ++l) {
+    int idx1, idx2;
+    net.getBranchEndpoints(l, &idx1, &idx2);
+    BOOST_CHECK(net.getBranch(l)->getBus1() == net.getBus(idx1));
+    BOOST_CHECK(net.getBranch(l)->getBus2() == net.getBus(idx2));
+    BOOST_CHECK(net.getBranch(l)->getBusSpan()[0] == net.getBus(idx1).get());
+  }
+  for (int b = 0; b < net.numBuses(); ++b) {
+    std::vector<boost::shared_ptr<gridpack::component::BaseComponent> > branches;
+    net.getBus(b)->getNeighborBranches(branches);
+    BOOST_CHECK_EQUAL(branches.size(), net.getConnectedBranches(b).size());
+    BOOST_CHECK_EQUAL(net.getBus(b)->getBranchSpan().size(), branches.size());
+  }
+
+  // compacting again should keep the order and the global indices
+  std::vector<int> global(net.numBuses());
+  for (int b = 0; b < net.numBuses(); ++b) {
+    global[b] = net.getGlobalBusIndex(b);
+  }
+  net.compactComponents();
+  for (int b = 0; b < net.numBuses(); ++b) {
+    BOOST_CHECK_EQUAL(net.getGlobalBusIndex(b), global[b]);
+    if (b > 0) {
+      BOOST_CHECK_EQUAL(net.getBus(b).get() - net.getBus(b-1).get(), 1);
+    }
+  }
+}
 
 BOOST_AUTO_TEST_SUITE_END( )
 
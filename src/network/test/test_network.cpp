@@ -4,6 +4,7 @@
  *     in the LICENSE file in the top level directory of this distribution.
  */
 #include <vector>
+#include <cstdio>
 
 #include <boost/mpi/environment.hpp>
 #include <boost/mpi/communicator.hpp>
@@ -629,6 +630,149 @@ BOOST_AUTO_TEST_CASE( TestNetworkTopology )
   }
   BOOST_CHECK(ok);
 
+  // Repeat ghost update test using direct exchange between neighboring
+  // processes
+  for (i=0; i<nbus; i++) {
+    iptr = (int*)network.getXCBusBuffer(i);
+    if (!network.getActiveBus(i)) {
+      *iptr = -1;
+    }
+  }
+  for (i=0; i<nbranch; i++) {
+    iptr = (int*)network.getXCBranchBuffer(i);
+    if (!network.getActiveBranch(i)) {
+      *iptr = -1;
+    }
+  }
+  network.setNeighborExchange(true);
+  network.initBusUpdate();
+  network.initBranchUpdate();
+
+  network.updateBuses();
+  network.updateBranches();
+
+  ok = true;
+  for (i=0; i<nbus; i++) {
+    iptr = (int*)network.getXCBusBuffer(i);
+    if (!network.getActiveBus(i)) {
+      if (*iptr != network.getGlobalBusIndex(i)) {
+        ok = false;
+      }
+    }
+  }
+  for (i=0; i<nbranch; i++) {
+    iptr = (int*)network.getXCBranchBuffer(i);
+    if (!network.getActiveBranch(i)) {
+      if (*iptr != network.getGlobalBranchIndex(i)) {
+        ok = false;
+      }
+    }
+  }
+  oks = (int)ok;
+  ierr = MPI_Allreduce(&oks, &okr, 1, MPI_INT, MPI_PROD, mpi_world);
+  ok = (bool)okr;
+  if (me == 0 && ok) {
+    printf("\nNeighbor bus and branch update ok\n");
+  } else if (!ok) {
+    printf("\nMismatched neighbor update on %d\n",me);
+  }
+  BOOST_CHECK(ok);
+  network.setNeighborExchange(false);
+
+  // Test split-phase ghost update and the interior/boundary classification of
+  // buses and branches
+  network.setBoundaryLists();
+  for (i=0; i<nbus; i++) {
+    iptr = (int*)network.getXCBusBuffer(i);
+    if (!network.getActiveBus(i)) {
+      *iptr = -1;
+    }
+  }
+  for (i=0; i<nbranch; i++) {
+    iptr = (int*)network.getXCBranchBuffer(i);
+    if (!network.getActiveBranch(i)) {
+      *iptr = -1;
+    }
+  }
+  network.initBusUpdate();
+  network.initBranchUpdate();
+  network.beginBusUpdate();
+  network.beginBranchUpdate();
+  ok = true;
+  std::vector<int> interior = network.getInteriorBuses();
+  std::vector<int> boundary = network.getBoundaryBuses();
+  n = 0;
+  for (i=0; i<nbus; i++) {
+    if (network.getActiveBus(i)) n++;
+  }
+  if (interior.size() + boundary.size() != n) {
+    printf("p[%d] interior and boundary buses do not match active buses\n",me);
+    ok = false;
+  }
+  for (i=0; i<interior.size(); i++) {
+    std::vector<int> buses = network.getConnectedBuses(interior[i]);
+    for (j=0; j<buses.size(); j++) {
+      if (!network.getActiveBus(buses[j])) {
+        printf("p[%d] interior bus %d connected to ghost bus\n",me,interior[i]);
+        ok = false;
+      }
+    }
+  }
+  for (i=0; i<boundary.size(); i++) {
+    std::vector<int> buses = network.getConnectedBuses(boundary[i]);
+    bool ghost = false;
+    for (j=0; j<buses.size(); j++) {
+      if (!network.getActiveBus(buses[j])) ghost = true;
+    }
+    if (!ghost) {
+      printf("p[%d] boundary bus %d has no ghost neighbors\n",me,boundary[i]);
+      ok = false;
+    }
+  }
+  interior = network.getInteriorBranches();
+  boundary = network.getBoundaryBranches();
+  for (i=0; i<interior.size(); i++) {
+    network.getBranchEndpoints(interior[i], &n1, &n2);
+    if (!network.getActiveBus(n1) || !network.getActiveBus(n2)) {
+      printf("p[%d] interior branch %d has ghost endpoint\n",me,interior[i]);
+      ok = false;
+    }
+  }
+  for (i=0; i<boundary.size(); i++) {
+    network.getBranchEndpoints(boundary[i], &n1, &n2);
+    if (network.getActiveBus(n1) && network.getActiveBus(n2)) {
+      printf("p[%d] boundary branch %d has no ghost endpoint\n",me,boundary[i]);
+      ok = false;
+    }
+  }
+  network.endBusUpdate();
+  network.endBranchUpdate();
+  for (i=0; i<nbus; i++) {
+    iptr = (int*)network.getXCBusBuffer(i);
+    if (!network.getActiveBus(i)) {
+      if (*iptr != network.getGlobalBusIndex(i)) {
+        ok = false;
+      }
+    }
+  }
+  for (i=0; i<nbranch; i++) {
+    iptr = (int*)network.getXCBranchBuffer(i);
+    if (!network.getActiveBranch(i)) {
+      if (*iptr != network.getGlobalBranchIndex(i)) {
+        ok = false;
+      }
+    }
+  }
+  oks = (int)ok;
+  ierr = MPI_Allreduce(&oks, &okr, 1, MPI_INT, MPI_PROD, mpi_world);
+  ok = (bool)okr;
+  if (me == 0 && ok) {
+    printf("\nSplit-phase update and boundary lists ok\n");
+  } else if (!ok) {
+    printf("\nMismatched split-phase update on %d\n",me);
+  }
+  BOOST_CHECK(ok);
+
   network.freeXCBus();
   network.freeXCBranch();
 
@@ -739,6 +883,102 @@ BOOST_AUTO_TEST_CASE( TestNetworkTopology )
 #endif
 }
 
+BOOST_AUTO_TEST_CASE( TestNetworkSnapshot )
+{
+  gridpack::parallel::Communicator world;
+  int me = world.rank();
+
+  // Create a chain of buses on each processor. The last bus is a ghost
+  gridpack::network::BaseNetwork<TestBus, TestBranch> network(world);
+  int i, nbus = 5;
+  for (i=0; i<nbus; i++) {
+    network.addBus(2*(me*nbus+i));
+    network.setGlobalBusIndex(i, me*nbus+i);
+    network.setActiveBus(i, i < nbus-1);
+    network.getBusData(i)->addValue("BUS_NUMBER", 2*(me*nbus+i));
+    network.getBusData(i)->addValue("BUS_NAME", "bus");
+    network.getBusData(i)->addValue("GENERATOR_PG", 0.5*i, 1);
+  }
+  for (i=0; i<nbus-1; i++) {
+    network.addBranch(2*(me*nbus+i), 2*(me*nbus+i+1));
+    network.setGlobalBranchIndex(i, me*nbus+i);
+    network.setGlobalBusIndex1(i, me*nbus+i);
+    network.setGlobalBusIndex2(i, me*nbus+i+1);
+    network.setLocalBusIndex1(i, i);
+    network.setLocalBusIndex2(i, i+1);
+    network.addBranchNeighbor(i, i);
+    network.addBranchNeighbor(i+1, i);
+    network.getBranchData(i)->addValue("BRANCH_R", 0.01*i);
+  }
+  network.setReferenceBus(0);
+  network.setMap();
+  network.writeSnapshot("test_snapshot");
+
+  gridpack::network::BaseNetwork<TestBus, TestBranch> restored(world);
+  restored.readSnapshot("test_snapshot");
+
+  // A snapshot that is cut short must be rejected
+  char fname[64], sname[64];
+  sprintf(fname,"test_snapshot.%d",me);
+  sprintf(sname,"test_snapshot_short.%d",me);
+  std::vector<char> bytes;
+  FILE *fp = fopen(fname,"rb");
+  BOOST_REQUIRE(fp != NULL);
+  int c;
+  while ((c = fgetc(fp)) != EOF) bytes.push_back(static_cast<char>(c));
+  fclose(fp);
+  int cut;
+  for (cut = 8; cut < static_cast<int>(bytes.size()); cut += 13) {
+    fp = fopen(sname,"wb");
+    fwrite(&bytes[0],1,cut,fp);
+    fclose(fp);
+    gridpack::network::BaseNetwork<TestBus, TestBranch> truncated(world);
+    BOOST_CHECK_THROW(truncated.readSnapshot("test_snapshot_short"),
+        gridpack::Exception);
+    BOOST_CHECK_EQUAL(truncated.numBuses(), 0);
+  }
+  remove(sname);
+  remove(fname);
+  BOOST_CHECK_EQUAL(restored.numBuses(), nbus);
+  BOOST_CHECK_EQUAL(restored.numBranches(), nbus-1);
+  BOOST_CHECK_EQUAL(restored.getReferenceBus(), 0);
+  for (i=0; i<nbus; i++) {
+    BOOST_CHECK_EQUAL(restored.getOriginalBusIndex(i), 2*(me*nbus+i));
+    BOOST_CHECK_EQUAL(restored.getGlobalBusIndex(i), me*nbus+i);
+    BOOST_CHECK_EQUAL(restored.getActiveBus(i), i < nbus-1);
+    BOOST_CHECK(restored.getConnectedBranches(i) ==
+        network.getConnectedBranches(i));
+    int ival;
+    double rval;
+    std::string sval;
+    BOOST_CHECK(restored.getBusData(i)->getValue("BUS_NUMBER", &ival));
+    BOOST_CHECK_EQUAL(ival, 2*(me*nbus+i));
+    BOOST_CHECK(restored.getBusData(i)->getValue("BUS_NAME", &sval));
+    BOOST_CHECK_EQUAL(sval, std::string("bus"));
+    BOOST_CHECK(restored.getBusData(i)->getValue("GENERATOR_PG", &rval, 1));
+    BOOST_CHECK_CLOSE(rval, 0.5*i, 1.0e-12);
+    std::vector<int> local = restored.getLocalBusIndices(2*(me*nbus+i));
+    BOOST_CHECK_EQUAL(local.size(), 1);
+    if (local.size() == 1) BOOST_CHECK_EQUAL(local[0], i);
+  }
+  for (i=0; i<nbus-1; i++) {
+    int idx1, idx2;
+    double rval;
+    std::vector<int> local = restored.getLocalBranchIndices(2*(me*nbus+i),
+        2*(me*nbus+i+1));
+    BOOST_CHECK_EQUAL(local.size(), 1);
+    if (local.size() == 1) BOOST_CHECK_EQUAL(local[0], i);
+    restored.getBranchEndpoints(i, &idx1, &idx2);
+    BOOST_CHECK_EQUAL(idx1, i);
+    BOOST_CHECK_EQUAL(idx2, i+1);
+    BOOST_CHECK_EQUAL(restored.getGlobalBranchIndex(i), me*nbus+i);
+    BOOST_CHECK(restored.getBranchData(i)->getValue("BRANCH_R", &rval));
+    BOOST_CHECK_CLOSE(rval, 0.01*i, 1.0e-12);
+    BOOST_CHECK(restored.getBranch(i)->getBus1().get() ==
+        restored.getBus(i).get());
+  }
+}
+
 BOOST_AUTO_TEST_SUITE_END( )
 
 bool init_function(void)
@@ -26,11 +26,13 @@
 #ifndef _constraint_renderer_hpp_
 #define _constraint_renderer_hpp_
 
+#include <cmath>
 #include <boost/assert.hpp>
 #include <boost/format.hpp>
 
 #include "gridpack/expression/expression.hpp"
 #include "gridpack/expression/functions.hpp"
+#include "gridpack/expression/compiled_expression.hpp"
 
 namespace gridpack {
 namespace optimization {
@@ -256,7 +258,98 @@ protected:
   
 };
 
+// -------------------------------------------------------------
+//  class CompiledRenderer
+// -------------------------------------------------------------
+/// Write the terms of a CompiledExpression
+/**
+ * Terms are written in the order they are stored, with the sign
+ * separated from the coefficient. The caller chooses how a coefficient
+ * is joined to its variable(s) and how squares are written.
+ */
+class CompiledRenderer
+{
+public:
+
+  /// Default constructor.
+  CompiledRenderer(std::ostream& out,
+                   const std::string& times,
+                   const std::string& product,
+                   const std::string& square)
+    : p_out(out), p_times(times), p_product(product), p_square(square)
+  {}
+
+  /// Destructor
+  virtual ~CompiledRenderer(void)
+  {}
+
+  /// Write the linear terms, return true if any were written
+  bool linear(const CompiledExpression& c, bool first = true)
+  {
+    const std::vector<VariablePtr>& vars(c.variables());
+    const std::vector<double>& coefs(c.coefficients());
+    for (size_t i = 0; i < vars.size(); ++i) {
+      p_coefficient(coefs[i], first, true);
+      p_out << vars[i]->name();
+      first = false;
+    }
+    return !vars.empty();
+  }
+
+  /// Write the quadratic terms, multiplied by factor
+  bool quadratic(const CompiledExpression& c, const double& factor,
+                 bool first = true)
+  {
+    const std::vector<VariablePtr>& v1(c.quadraticVariables1());
+    const std::vector<VariablePtr>& v2(c.quadraticVariables2());
+    const std::vector<double>& coefs(c.quadraticCoefficients());
+    for (size_t k = 0; k < coefs.size(); ++k) {
+      p_coefficient(factor*coefs[k], first, true);
+      p_out << v1[k]->name();
+      if (v1[k].get() == v2[k].get()) {
+        p_out << p_square;
+      } else {
+        p_out << p_product << v2[k]->name();
+      }
+      first = false;
+    }
+    return !coefs.empty();
+  }
+
+  /// Write a constant term
+  void constant(const double& value, bool first)
+  {
+    p_coefficient(value, first, false);
+  }
 
+protected:
+
+  /// The stream to send renderings
+  std::ostream& p_out;
+
+  /// What goes between a coefficient and a variable
+  std::string p_times;
+
+  /// What goes between the variables of a product
+  std::string p_product;
+
+  /// What follows a variable to square it
+  std::string p_square;
+
+  /// Write a coefficient with its sign (a unit coefficient of a term
+  /// is left out)
+  void p_coefficient(const double& c, bool first, bool term)
+  {
+    if (c < 0.0) {
+      p_out << (first ? "-" : " - ");
+    } else if (!first) {
+      p_out << " + ";
+    }
+    if (term && std::abs(c) == 1.0) return;
+    p_out << boost::str(boost::format("%.15g") % std::abs(c));
+    if (term) p_out << p_times;
+  }
+};
 
 } // namespace optimization
 } // namespace gridpack
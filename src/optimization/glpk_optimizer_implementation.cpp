@@ -12,6 +12,7 @@
 
 
 #include <algorithm>
+#include <map>
 #include <fstream>
 #include <glpk.h>
 #include <boost/bind.hpp>
@@ -23,6 +24,93 @@
 namespace gridpack {
 namespace optimization {
 
+// -------------------------------------------------------------
+//  class GLPKColumnLoader
+// -------------------------------------------------------------
+/// Set the bounds and kind of a GLPK column from a variable
+class GLPKColumnLoader 
+  : public VariableVisitor
+{
+public:
+
+  /// Default constructor.
+  GLPKColumnLoader(glp_prob *lp)
+    : VariableVisitor(), column(0), p_lp(lp)
+  {}
+
+  /// Destructor
+  ~GLPKColumnLoader(void)
+  {}
+
+  /// The GLPK column index of the next variable visited
+  int column;
+
+  void visit(Variable& var)
+  {
+    BOOST_ASSERT(false);
+  }
+
+  void visit(RealVariable& var)
+  {
+    glp_set_col_name(p_lp, column, var.name().c_str());
+    glp_set_col_kind(p_lp, column, GLP_CV);
+    if (var.bounded()) {
+      p_bounds(var.lowerBound() > var.veryLowValue, var.lowerBound(),
+               var.upperBound() < var.veryHighValue, var.upperBound());
+    } else {
+      glp_set_col_bnds(p_lp, column, GLP_FR, 0.0, 0.0);
+    }
+  }
+
+  void visit(IntegerVariable& var)
+  {
+    glp_set_col_name(p_lp, column, var.name().c_str());
+    glp_set_col_kind(p_lp, column, GLP_IV);
+    p_bounds(var.lowerBound() > var.veryLowValue, var.lowerBound(),
+             var.upperBound() < var.veryHighValue, var.upperBound());
+  }
+
+  void visit(BinaryVariable& var)
+  {
+    glp_set_col_name(p_lp, column, var.name().c_str());
+    glp_set_col_kind(p_lp, column, GLP_BV);
+  }
+
+protected:
+
+  /// The problem being loaded
+  glp_prob *p_lp;
+
+  /// Set column bounds
+  void p_bounds(const bool& haslo, const double& lo,
+                const bool& hashi, const double& hi)
+  {
+    int type(GLP_FR);
+    if (haslo && hashi) {
+      type = (lo == hi ? GLP_FX : GLP_DB);
+    } else if (haslo) {
+      type = GLP_LO;
+    } else if (hashi) {
+      type = GLP_UP;
+    }
+    glp_set_col_bnds(p_lp, column, type, lo, hi);
+  }
+};
+
+// -------------------------------------------------------------
+// checkLinear
+// -------------------------------------------------------------
+/// GLPK can only handle linear problems
+static void
+checkLinear(const CompiledExpression& c, const std::string& what)
+{
+  if (!c.linear()) {
+    std::string msg = 
+      boost::str(boost::format("GLPK: %s has quadratic terms") % what);
+    throw gridpack::Exception(msg);
+  }
+}
+
 // -------------------------------------------------------------
 //  class GLPKOptimizerImplementation
 // -------------------------------------------------------------
@@ -31,7 +119,8 @@ namespace optimization {
 // GLPKOptimizerImplementation:: constructors / destructor
 // -------------------------------------------------------------
 GLPKOptimizerImplementation::GLPKOptimizerImplementation(const parallel::Communicator& comm)
-  : LPFileOptimizerImplementation(comm)
+  : LPFileOptimizerImplementation(comm), p_useLPFile(false),
+    p_distributed(false)
 {
 }
 
@@ -40,64 +129,199 @@ GLPKOptimizerImplementation::~GLPKOptimizerImplementation(void)
 }
 
 // -------------------------------------------------------------
-// GLPKOptimizerImplementation::p_solve
+// GLPKOptimizerImplementation::p_configure
 // -------------------------------------------------------------
 void
-GLPKOptimizerImplementation::p_solve(const p_optimizeMethod& m)
+GLPKOptimizerImplementation::p_configure(utility::Configuration::CursorPtr props)
+{
+  LPFileOptimizerImplementation::p_configure(props);
+  p_useLPFile = props->get("UseLPFile", p_useLPFile);
+  p_distributed = props->get("DistributedAssembly", p_distributed);
+}
+
+// -------------------------------------------------------------
+// GLPKOptimizerImplementation::p_load
+// -------------------------------------------------------------
+void
+GLPKOptimizerImplementation::p_load(const p_optimizeMethod& m, glp_prob *lp)
+{
+  if (p_distributed) {
+    p_assembleProblem();
+  } else {
+    p_gatherProblem();
+    p_compileProblem();
+  }
+
+  glp_set_prob_name(lp, "GridPACK");
+
+  // columns, numbered in the same order the LP file would list them
+
+  std::map<std::string, int> colidx;
+  int ncol(p_allVariables.size());
+  if (ncol > 0) glp_add_cols(lp, ncol);
+  {
+    GLPKColumnLoader loader(lp);
+    BOOST_FOREACH(VarMap::value_type& i, p_allVariables) {
+      loader.column += 1;
+      colidx[i.first] = loader.column;
+      i.second->accept(loader);
+    }
+  }
+
+  // objective
+
+  switch (m) {
+  case Maximize:
+    glp_set_obj_dir(lp, GLP_MAX);
+    break;
+  case Minimize:
+    glp_set_obj_dir(lp, GLP_MIN);
+    break;
+  default:
+    BOOST_ASSERT(false);
+  }
+  if (p_compiledObjective) {
+    checkLinear(*p_compiledObjective, "objective");
+    glp_set_obj_coef(lp, 0, p_compiledObjective->constant());
+    const std::vector<VariablePtr>& vars(p_compiledObjective->variables());
+    const std::vector<double>& coefs(p_compiledObjective->coefficients());
+    for (size_t k = 0; k < vars.size(); ++k) {
+      std::map<std::string, int>::const_iterator col(colidx.find(vars[k]->name()));
+      if (col == colidx.end()) {
+        std::string msg = 
+          boost::str(boost::format("GLPK: objective uses unknown variable %s") %
+                     vars[k]->name());
+        throw gridpack::Exception(msg);
+      }
+      glp_set_obj_coef(lp, col->second, coefs[k]);
+    }
+  }
+
+  // rows, collected into a sparse matrix (GLPK arrays start at 1)
+
+  std::vector<int> ia(1, 0), ja(1, 0);
+  std::vector<double> ar(1, 0.0);
+  int nrow(p_compiledConstraints.size());
+  if (nrow > 0) glp_add_rows(lp, nrow);
+  int row(0);
+  BOOST_FOREACH(CompiledExpressionPtr c, p_compiledConstraints) {
+    row += 1;
+    checkLinear(*c, c->name());
+    glp_set_row_name(lp, row, c->name().c_str());
+
+    double rhs(-c->constant());
+    const std::string& op(c->op());
+    if (op == "<" || op == "<=") {
+      glp_set_row_bnds(lp, row, GLP_UP, 0.0, rhs);
+    } else if (op == ">" || op == ">=") {
+      glp_set_row_bnds(lp, row, GLP_LO, rhs, 0.0);
+    } else {
+      glp_set_row_bnds(lp, row, GLP_FX, rhs, rhs);
+    }
+
+    const std::vector<VariablePtr>& vars(c->variables());
+    const std::vector<double>& coefs(c->coefficients());
+    for (size_t k = 0; k < vars.size(); ++k) {
+      std::map<std::string, int>::const_iterator col(colidx.find(vars[k]->name()));
+      if (col == colidx.end()) {
+        std::string msg = 
+          boost::str(boost::format("GLPK: constraint %s uses unknown variable %s") %
+                     c->name() % vars[k]->name());
+        throw gridpack::Exception(msg);
+      }
+      ia.push_back(row);
+      ja.push_back(col->second);
+      ar.push_back(coefs[k]);
+    }
+  }
+  glp_load_matrix(lp, ia.size() - 1, &ia[0], &ja[0], &ar[0]);
+}
+
+// -------------------------------------------------------------
+// GLPKOptimizerImplementation::p_run
+// -------------------------------------------------------------
+void
+GLPKOptimizerImplementation::p_run(glp_prob *lp)
 {
   parallel::Communicator comm(this->communicator());
   int nproc(comm.size());
   int me(comm.rank());
-  std::ofstream tmp;
+  int ierr;
 
-  LPFileOptimizerImplementation::p_solve(m);
+  ierr = glp_simplex(lp, NULL);
+    
+  if (ierr != 0) {
+    std::string msg = 
+      boost::str(boost::format("GLPK optimizer failure, code = %d") % ierr);
+    throw gridpack::Exception(msg);
+  }
+    
+  comm.barrier();
+  for (int p = 0; p < nproc; ++p) {
+    if (p == me) {
+      std::cout << "Optimimal variable values (process " << me << "):" << std::endl;
+      
+      int varnum(glp_get_num_cols(lp));
+      for (int idx = 1; idx <= varnum; ++idx) {
+        std::string gname(glp_get_col_name(lp, idx));
+        VariablePtr v(p_allVariables[gname]);
+        std::string vname(v->name());
+        
+        std::cout << gname << " " << vname << " " 
+                  << glp_get_col_prim(lp, idx) << " " 
+                  << glp_get_col_dual(lp, idx) << " "
+                  << std::endl;
+        
+        SetVariableInitial vset(glp_get_col_prim(lp, idx));
+        v->accept(vset);
+      } 
+      VariableTable vtab(std::cout);
+      BOOST_FOREACH(VarMap::value_type& i, p_allVariables) {
+        i.second->accept(vtab);
+      }
+    }
+    comm.barrier();
+  }
+}
+
+// -------------------------------------------------------------
+// GLPKOptimizerImplementation::p_solve
+// -------------------------------------------------------------
+void
+GLPKOptimizerImplementation::p_solve(const p_optimizeMethod& m)
+{
+  // The LP file is still written if asked for, or if the problem is
+  // not going to be solved (i.e. only the file is wanted)
+  if (p_useLPFile || !p_runMaybe) {
+    LPFileOptimizerImplementation::p_solve(m);
+  }
 
   if (p_runMaybe) {
     int ierr;
     glp_prob *lp = glp_create_prob();
-    std::cout << p_outputName << std::endl;
-    ierr = glp_read_lp(lp, NULL, p_outputName.c_str());
-    if (ierr != 0) {
-      std::string msg = 
-        boost::str(boost::format("GLPK LP parse failure, code = %d") % ierr);
-      glp_delete_prob(lp);
-      throw gridpack::Exception(msg);
+    if (p_useLPFile) {
+      std::cout << p_outputName << std::endl;
+      ierr = glp_read_lp(lp, NULL, p_outputName.c_str());
+      if (ierr != 0) {
+        std::string msg = 
+          boost::str(boost::format("GLPK LP parse failure, code = %d") % ierr);
+        glp_delete_prob(lp);
+        throw gridpack::Exception(msg);
+      }
+    } else {
+      try {
+        p_load(m, lp);
+      } catch (const gridpack::Exception& e) {
+        glp_delete_prob(lp);
+        throw;
+      }
     }
 
-    ierr = glp_simplex(lp, NULL);
-    
-    if (ierr != 0) {
-      std::string msg = 
-        boost::str(boost::format("GLPK optimizer failure, code = %d") % ierr);
+    try {
+      p_run(lp);
+    } catch (const gridpack::Exception& e) {
       glp_delete_prob(lp);
-      throw gridpack::Exception(msg);
-    }
-    
-    comm.barrier();
-    for (int p = 0; p < nproc; ++p) {
-      if (p == me) {
-        std::cout << "Optimimal variable values (process " << me << "):" << std::endl;
-      
-        int varnum(glp_get_num_cols(lp));
-        for (int idx = 1; idx <= varnum; ++idx) {
-          std::string gname(glp_get_col_name(lp, idx));
-          VariablePtr v(p_allVariables[gname]);
-          std::string vname(v->name());
-        
-          std::cout << gname << " " << vname << " " 
-                    << glp_get_col_prim(lp, idx) << " " 
-                    << glp_get_col_dual(lp, idx) << " "
-                    << std::endl;
-        
-          SetVariableInitial vset(glp_get_col_prim(lp, idx));
-          v->accept(vset);
-        } 
-        VariableTable vtab(std::cout);
-        BOOST_FOREACH(VarMap::value_type& i, p_allVariables) {
-          i.second->accept(vtab);
-        }
-      }
-      comm.barrier();
+      throw;
     }
     glp_delete_prob(lp);
   }
@@ -21,6 +21,7 @@
 #ifndef _glpk_optimizer_implementation_hpp_
 #define _glpk_optimizer_implementation_hpp_
 
+#include <glpk.h>
 #include "lpfile_optimizer_implementation.hpp"
 
 namespace gridpack {
@@ -42,9 +43,24 @@ public:
 
 protected:
 
+  /// Build the problem through an LP file instead of in memory
+  bool p_useLPFile;
+
+  /// Compile the problem in parallel and merge compiled parts
+  bool p_distributed;
+
+  /// Specialized way to configure from property tree
+  void p_configure(utility::Configuration::CursorPtr props);
+
   /// Do the problem (specialized)
   void p_solve(const p_optimizeMethod& m);
 
+  /// Load the gathered problem directly into a GLPK problem object
+  void p_load(const p_optimizeMethod& m, glp_prob *lp);
+
+  /// Solve a loaded GLPK problem and set variable values from the result
+  void p_run(glp_prob *lp);
+
 };
 
 } // namespace optimization
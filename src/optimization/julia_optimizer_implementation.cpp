@@ -373,10 +373,33 @@ JuliaOptimizerImplementation::p_write(const p_optimizeMethod& m, std::ostream& o
       i.second->accept(v);
     }
   }
+
+  // linear and quadratic problems are written from their compiled
+  // form; anything the compiler rejects (functions, higher powers) is
+  // written from the trees as nonlinear constraints
+  bool compiled(true);
+  try {
+    p_compileProblem();
+  } catch (const gridpack::Exception& e) {
+    compiled = false;
+  }
+
   {
     JuliaConstraintRenderer r(mname, out);
-    BOOST_FOREACH(ConstraintPtr c, p_allConstraints) {
-      c->accept(r);
+    CompiledRenderer cr(out, "*", "*", "^2");
+    for (size_t i = 0; i < p_allConstraints.size(); ++i) {
+      if (!compiled || (p_compiledConstraints[i]->variables().empty() &&
+                        p_compiledConstraints[i]->linear())) {
+        p_allConstraints[i]->accept(r);
+        continue;
+      }
+      const CompiledExpression& c(*p_compiledConstraints[i]);
+      out << "@constraint(" << mname << ", ";
+      bool first(!cr.linear(c));
+      cr.quadratic(c, 1.0, first);
+      double rhs(c.constant() == 0.0 ? 0.0 : -c.constant());
+      out << " " << (c.op() == "=" ? "==" : c.op()) << " "
+          << boost::str(boost::format("%.15g") % rhs) << ")" << std::endl;
     }
   }
   out << "@objective(" << mname << ", ";
@@ -392,7 +415,13 @@ JuliaOptimizerImplementation::p_write(const p_optimizeMethod& m, std::ostream& o
     break;
   }
   out << ", ";
-  {
+  if (compiled && p_compiledObjective) {
+    CompiledRenderer r(out, "*", "*", "^2");
+    const CompiledExpression& c(*p_compiledObjective);
+    bool first(!r.linear(c));
+    if (r.quadratic(c, 1.0, first)) first = false;
+    if (first || c.constant() != 0.0) r.constant(c.constant(), first);
+  } else {
     ConstraintRenderer r(out);
     if (p_fullObjective) {
       p_fullObjective->accept(r);
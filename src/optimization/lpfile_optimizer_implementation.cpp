@@ -344,7 +344,28 @@ LPFileOptimizerImplementation::p_write(const p_optimizeMethod& method, std::ostr
   default:
     BOOST_ASSERT(false);
   }
-  {
+
+  // linear and quadratic problems are written from their compiled
+  // form; anything the compiler rejects is written from the trees
+  bool compiled(true);
+  try {
+    p_compileProblem();
+  } catch (const gridpack::Exception& e) {
+    compiled = false;
+  }
+
+  if (compiled && p_compiledObjective) {
+    CompiledRenderer r(out, " ", " * ", " ^ 2");
+    const CompiledExpression& c(*p_compiledObjective);
+    bool first(!r.linear(c));
+    if (!c.linear()) {
+      out << (first ? "[ " : " + [ ");
+      r.quadratic(c, 2.0);
+      out << " ] / 2";
+      first = false;
+    }
+    if (first || c.constant() != 0.0) r.constant(c.constant(), first);
+  } else {
     LPFileConstraintRenderer r(out);
     p_fullObjective->accept(r);
   }
@@ -353,8 +374,24 @@ LPFileOptimizerImplementation::p_write(const p_optimizeMethod& method, std::ostr
   out << "Subject To" << std::endl;
   {
     LPFileConstraintRenderer r(out);
-    BOOST_FOREACH(ConstraintPtr c, p_allConstraints) {
-      c->accept(r);
+    CompiledRenderer cr(out, " ", " * ", " ^ 2");
+    for (size_t i = 0; i < p_allConstraints.size(); ++i) {
+      if (!compiled || (p_compiledConstraints[i]->variables().empty() &&
+                        p_compiledConstraints[i]->linear())) {
+        p_allConstraints[i]->accept(r);
+        continue;
+      }
+      const CompiledExpression& c(*p_compiledConstraints[i]);
+      out << c.name() << ": ";
+      bool first(!cr.linear(c));
+      if (!c.linear()) {
+        out << (first ? "[ " : " + [ ");
+        cr.quadratic(c, 1.0);
+        out << " ]";
+      }
+      double rhs(c.constant() == 0.0 ? 0.0 : -c.constant());
+      out << " " << c.op() << " "
+          << boost::str(boost::format("%.15g") % rhs) << std::endl;
     }
   }
   out << std::endl;   
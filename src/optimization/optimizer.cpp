@@ -17,7 +17,9 @@
  */
 // -------------------------------------------------------------
 
+#include <cstring>
 #include <sstream>
+#include <mpi.h>
 #include <boost/bind.hpp>
 #include <boost/format.hpp>
 
@@ -119,6 +121,256 @@ protected:
 };
 
 
+// -------------------------------------------------------------
+//  class BlockWriter
+// -------------------------------------------------------------
+/// Pack plain values into a byte buffer
+class BlockWriter
+{
+public:
+
+  /// The packed data
+  std::vector<char> buf;
+
+  /// Append a value
+  template <typename T>
+  void put(const T& v)
+  {
+    const char *c = reinterpret_cast<const char *>(&v);
+    buf.insert(buf.end(), c, c + sizeof(T));
+  }
+
+  /// Append a string
+  void putString(const std::string& str)
+  {
+    put<int>(str.size());
+    buf.insert(buf.end(), str.begin(), str.end());
+  }
+
+  /// Append another buffer
+  void putBlock(const BlockWriter& b)
+  {
+    buf.insert(buf.end(), b.buf.begin(), b.buf.end());
+  }
+};
+
+// -------------------------------------------------------------
+//  class BlockReader
+// -------------------------------------------------------------
+/// Unpack plain values from a byte buffer filled by BlockWriter
+class BlockReader
+{
+public:
+
+  /// Default constructor.
+  BlockReader(const char *data)
+    : p_ptr(data)
+  {}
+
+  /// Get the next value
+  template <typename T>
+  T get(void)
+  {
+    T v;
+    memcpy(&v, p_ptr, sizeof(T));
+    p_ptr += sizeof(T);
+    return v;
+  }
+
+  /// Get the next string
+  std::string getString(void)
+  {
+    int len(get<int>());
+    std::string str(p_ptr, len);
+    p_ptr += len;
+    return str;
+  }
+
+protected:
+
+  /// Current location in buffer
+  const char *p_ptr;
+};
+
+// -------------------------------------------------------------
+//  class VariablePacker
+// -------------------------------------------------------------
+/// Pack the definition of a variable
+class VariablePacker 
+  : public VariableVisitor
+{
+public:
+
+  /// Default constructor.
+  VariablePacker(BlockWriter& out)
+    : VariableVisitor(), p_out(out)
+  {}
+
+  /// Destructor
+  ~VariablePacker(void)
+  {}
+
+  void visit(Variable& var)
+  {
+    BOOST_ASSERT(false);
+  }
+
+  void visit(RealVariable& var)
+  {
+    p_out.putString(var.name());
+    p_out.put<int>(0);
+    p_out.put<double>(var.initial());
+    p_out.put<double>(var.lowerBound());
+    p_out.put<double>(var.upperBound());
+  }
+
+  void visit(IntegerVariable& var)
+  {
+    p_out.putString(var.name());
+    p_out.put<int>(1);
+    p_out.put<double>(var.initial());
+    p_out.put<double>(var.lowerBound());
+    p_out.put<double>(var.upperBound());
+  }
+
+  void visit(BinaryVariable& var)
+  {
+    p_out.putString(var.name());
+    p_out.put<int>(2);
+    p_out.put<double>(var.initial());
+    p_out.put<double>(var.lowerBound());
+    p_out.put<double>(var.upperBound());
+  }
+
+protected:
+
+  /// Where the definition goes
+  BlockWriter& p_out;
+};
+
+/// Make a variable from a definition packed by VariablePacker
+static VariablePtr
+unpackVariable(BlockReader& in)
+{
+  std::string name(in.getString());
+  int kind(in.get<int>());
+  double init(in.get<double>());
+  double lo(in.get<double>());
+  double hi(in.get<double>());
+  VariablePtr v;
+  switch (kind) {
+  case 0:
+    v.reset(new RealVariable(init, lo, hi));
+    break;
+  case 1:
+    v.reset(new IntegerVariable(static_cast<int>(init),
+                                static_cast<int>(lo), static_cast<int>(hi)));
+    break;
+  default:
+    v.reset(new BinaryVariable(static_cast<int>(init)));
+    break;
+  }
+  v->name(name);
+  return v;
+}
+
+// -------------------------------------------------------------
+//  class CompiledPacker
+// -------------------------------------------------------------
+/// Pack compiled expressions with variables replaced by block indexes
+/**
+ * Variables defined on this processor are referred to by their
+ * position in the list of local variables; any other variable is
+ * added to a list of foreign variables, by name, that follows the
+ * local ones.
+ */
+class CompiledPacker
+{
+public:
+
+  /// Default constructor.
+  CompiledPacker(const std::vector<VariablePtr>& local)
+    : p_index()
+  {
+    for (size_t i = 0; i < local.size(); ++i) {
+      p_index[local[i].get()] = i;
+    }
+    p_nlocal = local.size();
+  }
+
+  /// Names of referenced variables that are not local
+  std::vector<std::string> foreign;
+
+  /// Pack a compiled expression (which may be null)
+  void put(BlockWriter& out, CompiledExpressionPtr c)
+  {
+    if (!c) {
+      out.put<double>(0.0);
+      out.put<int>(0);
+      out.put<int>(0);
+      return;
+    }
+    out.put<double>(c->constant());
+    const std::vector<VariablePtr>& vars(c->variables());
+    const std::vector<double>& coefs(c->coefficients());
+    out.put<int>(vars.size());
+    for (size_t i = 0; i < vars.size(); ++i) {
+      out.put<int>(p_ref(vars[i]));
+      out.put<double>(coefs[i]);
+    }
+    const std::vector<VariablePtr>& q1(c->quadraticVariables1());
+    const std::vector<VariablePtr>& q2(c->quadraticVariables2());
+    const std::vector<double>& qc(c->quadraticCoefficients());
+    out.put<int>(qc.size());
+    for (size_t i = 0; i < qc.size(); ++i) {
+      out.put<int>(p_ref(q1[i]));
+      out.put<int>(p_ref(q2[i]));
+      out.put<double>(qc[i]);
+    }
+  }
+
+protected:
+
+  /// Block index of each variable seen so far
+  std::map<Variable *, int> p_index;
+
+  /// Number of local variables
+  int p_nlocal;
+
+  /// Get the block index of a variable
+  int p_ref(const VariablePtr& v)
+  {
+    std::map<Variable *, int>::iterator i(p_index.find(v.get()));
+    if (i != p_index.end()) return i->second;
+    int idx(p_nlocal + foreign.size());
+    foreign.push_back(v->name());
+    p_index[v.get()] = idx;
+    return idx;
+  }
+};
+
+/// Add a compiled expression packed by CompiledPacker to a builder
+static void
+unpackCompiled(BlockReader& in, const std::vector<VariablePtr>& refs,
+               CompiledExpressionBuilder& b, const double& factor)
+{
+  b.addConstant(factor*in.get<double>());
+  int nlin(in.get<int>());
+  for (int i = 0; i < nlin; ++i) {
+    int r(in.get<int>());
+    double coef(in.get<double>());
+    b.addLinear(refs[r], factor*coef);
+  }
+  int nquad(in.get<int>());
+  for (int i = 0; i < nquad; ++i) {
+    int r1(in.get<int>());
+    int r2(in.get<int>());
+    double coef(in.get<double>());
+    b.addQuadratic(refs[r1], refs[r2], factor*coef);
+  }
+}
+
+
 // -------------------------------------------------------------
 //  class OptimizerImplementation
 // -------------------------------------------------------------
@@ -329,6 +581,228 @@ OptimizerImplementation::p_gatherProblem(void)
     std::for_each(p_allConstraints.begin(), p_allConstraints.end(),
                   boost::bind(&Constraint::accept, _1, boost::ref(r)));
   }
+
+  // any compiled form is out of date now
+  p_compiledConstraints.clear();
+  p_compiledObjective.reset();
+}
+
+// -------------------------------------------------------------
+// OptimizerImplementation::p_compileProblem
+// -------------------------------------------------------------
+void
+OptimizerImplementation::p_compileProblem(void)
+{
+  if (p_fullObjective && !p_compiledObjective) {
+    p_compiledObjective = compile(p_fullObjective);
+  }
+  if (p_compiledConstraints.size() != p_allConstraints.size()) {
+    p_compiledConstraints.clear();
+    p_compiledConstraints.reserve(p_allConstraints.size());
+    for (std::vector<ConstraintPtr>::iterator c = p_allConstraints.begin();
+         c != p_allConstraints.end(); ++c) {
+      p_compiledConstraints.push_back(compile(*c));
+    }
+  }
+}
+
+// -------------------------------------------------------------
+// OptimizerImplementation::p_assembleProblem
+// -------------------------------------------------------------
+void
+OptimizerImplementation::p_assembleProblem(void)
+{
+  parallel::Communicator comm(this->communicator());
+  int nproc(comm.size());
+  int me(comm.rank());
+
+  // compile the local part of the problem into a binary block: local
+  // variable definitions, names of variables owned by other
+  // processors, then objective, constraints and global constraint
+  // parts with variables referred to by block index
+
+  BlockWriter body;
+  CompiledPacker packer(p_variables);
+
+  body.put<int>(p_objective ? 1 : 0);
+  if (p_objective) packer.put(body, compile(p_objective));
+
+  body.put<int>(p_constraints.size());
+  for (std::vector<ConstraintPtr>::iterator c = p_constraints.begin();
+       c != p_constraints.end(); ++c) {
+    CompiledExpressionPtr cc(compile(*c));
+    body.putString(cc->name());
+    body.putString(cc->op());
+    packer.put(body, cc);
+  }
+
+  int nglobal(0);
+  ConstraintMap::const_iterator gc;
+  for (gc = p_globalConstraints.begin(); gc != p_globalConstraints.end(); ++gc) {
+    if (gc->second->lhs()) ++nglobal;
+  }
+  body.put<int>(nglobal);
+  for (gc = p_globalConstraints.begin(); gc != p_globalConstraints.end(); ++gc) {
+    ConstraintPtr cons(gc->second);
+    if (!cons->lhs()) continue;
+    body.putString(gc->first);
+    body.putString(cons->op());
+    packer.put(body, compile(cons->lhs()));
+    packer.put(body, compile(cons->rhs()));
+  }
+
+  BlockWriter block;
+  block.put<int>(p_variables.size());
+  {
+    VariablePacker vp(block);
+    for (std::vector<VariablePtr>::iterator v = p_variables.begin();
+         v != p_variables.end(); ++v) {
+      (*v)->accept(vp);
+    }
+  }
+  block.put<int>(packer.foreign.size());
+  for (size_t i = 0; i < packer.foreign.size(); ++i) {
+    block.putString(packer.foreign[i]);
+  }
+  block.putBlock(body);
+
+  // merge the blocks from all processors with a single collective
+
+  MPI_Comm mpi_comm(static_cast<MPI_Comm>(comm));
+  int lsize(block.buf.size());
+  std::vector<int> sizes(nproc), offsets(nproc, 0);
+  MPI_Allgather(&lsize, 1, MPI_INT, &sizes[0], 1, MPI_INT, mpi_comm);
+  for (int p = 1; p < nproc; ++p) {
+    offsets[p] = offsets[p-1] + sizes[p-1];
+  }
+  std::vector<char> gbuf(offsets[nproc-1] + sizes[nproc-1] + 1);
+  MPI_Allgatherv(&(block.buf)[0], lsize, MPI_CHAR, &gbuf[0], &sizes[0],
+                 &offsets[0], MPI_CHAR, mpi_comm);
+
+  // number variables in processor order; there is one variable per
+  // name, and variables defined on this processor (and local copies of
+  // variables owned elsewhere) are used in place of copies made from
+  // the blocks, so the local ones get the solution here
+
+  std::vector<VariablePtr> gvars;
+  std::vector<int> nlocal(nproc);
+  std::vector<BlockReader> readers;
+  for (int p = 0; p < nproc; ++p) {
+    BlockReader in(&gbuf[offsets[p]]);
+    nlocal[p] = in.get<int>();
+    for (int i = 0; i < nlocal[p]; ++i) {
+      VariablePtr v(unpackVariable(in));
+      if (p == me) v = p_variables[i];
+      gvars.push_back(v);
+    }
+    readers.push_back(in);
+  }
+  for (size_t i = 0; i < gvars.size(); ++i) {
+    p_allVariables[gvars[i]->name()] = gvars[i];
+  }
+
+  for (std::vector<VariablePtr>::iterator v = p_variables.begin();
+       v != p_variables.end(); ++v) {
+    p_allVariables[(*v)->name()] = *v;
+    p_exportVariables[(*v)->name()] = *v;
+  }
+  for (std::vector<VariablePtr>::iterator v = p_aux_variables.begin();
+       v != p_aux_variables.end(); ++v) {
+    if (p_allVariables.find((*v)->name()) != p_allVariables.end()) {
+      p_allVariables[(*v)->name()] = *v;
+    }
+  }
+
+  // rebuild the compiled problem from the blocks
+
+  CompiledExpressionBuilder obj;
+  bool hasobj(false);
+  p_compiledConstraints.clear();
+
+  struct GlobalPart {
+    bool first;
+    std::string op;
+    CompiledExpressionBuilder lhs, rhs;
+    GlobalPart(void) : first(true) {}
+  };
+  std::map<std::string, GlobalPart> global;
+
+  int offset(0);
+  for (int p = 0; p < nproc; ++p) {
+    BlockReader& in(readers[p]);
+    // every reference to a name goes to the same variable, so terms
+    // from different processors are merged by the builders
+
+    std::vector<VariablePtr> refs;
+    for (int i = 0; i < nlocal[p]; ++i) {
+      refs.push_back(p_allVariables[gvars[offset + i]->name()]);
+    }
+    offset += nlocal[p];
+    int nforeign(in.get<int>());
+    for (int i = 0; i < nforeign; ++i) {
+      std::string name(in.getString());
+      VarMap::iterator g(p_allVariables.find(name));
+      if (g == p_allVariables.end()) {
+        std::string msg = 
+          boost::str(boost::format("p_assembleProblem: variable \"%s\" is not defined on any processor") %
+                     name);
+        throw gridpack::Exception(msg);
+      }
+      refs.push_back(g->second);
+    }
+
+    if (in.get<int>()) {
+      unpackCompiled(in, refs, obj, 1.0);
+      hasobj = true;
+    }
+
+    int ncons(in.get<int>());
+    for (int i = 0; i < ncons; ++i) {
+      std::string name(in.getString());
+      std::string op(in.getString());
+      CompiledExpressionBuilder b;
+      unpackCompiled(in, refs, b, 1.0);
+      if (nproc > 1) {
+        name = boost::str(boost::format("C%d") % p_compiledConstraints.size());
+      }
+      b.constraint(op, name);
+      p_compiledConstraints.push_back(b.result());
+    }
+
+    int nglob(in.get<int>());
+    for (int i = 0; i < nglob; ++i) {
+      std::string name(in.getString());
+      std::string op(in.getString());
+      GlobalPart& g(global[name]);
+      unpackCompiled(in, refs, g.lhs, 1.0);
+      if (g.first) {
+        g.op = op;
+        unpackCompiled(in, refs, g.rhs, 1.0);
+        g.first = false;
+      } else {
+        CompiledExpressionBuilder ignore;
+        unpackCompiled(in, refs, ignore, 1.0);
+      }
+    }
+  }
+
+  // global constraints go after the others, in name order
+
+  std::map<std::string, GlobalPart>::iterator g;
+  for (g = global.begin(); g != global.end(); ++g) {
+    CompiledExpressionBuilder b;
+    b.add(g->second.lhs, 1.0);
+    b.add(g->second.rhs, -1.0);
+    std::string name(g->first);
+    if (nproc > 1) {
+      name = boost::str(boost::format("C%d") % p_compiledConstraints.size());
+    }
+    b.constraint(g->second.op, name);
+    p_compiledConstraints.push_back(b.result());
+  }
+
+  p_compiledObjective.reset();
+  if (hasobj) p_compiledObjective = obj.result();
 }
 
 
@@ -30,6 +30,7 @@
 #include <gridpack/parallel/distributed.hpp>
 #include <gridpack/expression/expression.hpp>
 #include <gridpack/expression/functions.hpp>
+#include <gridpack/expression/compiled_expression.hpp>
 
 namespace gridpack {
 namespace optimization {
@@ -210,6 +211,12 @@ protected:
   /// The global constraints from all processes
   ConstraintMap p_allGlobalConstraints;
 
+  /// Compiled form of p_allConstraints (same order)
+  std::vector<CompiledExpressionPtr> p_compiledConstraints;
+
+  /// Compiled form of p_fullObjective
+  CompiledExpressionPtr p_compiledObjective;
+
   /// Add a (local) variable to be optimized (specialized)
   void p_addVariable(VariablePtr v)
   {
@@ -254,6 +261,14 @@ protected:
 
   /// Gather the problem to all processors
   void p_gatherProblem(void);
+
+  /// Compile the gathered problem, if not already done
+  void p_compileProblem(void);
+
+  /// Compile the local part of the problem and merge the compiled
+  /// parts from all processors (instead of p_gatherProblem() and
+  /// p_compileProblem())
+  void p_assembleProblem(void);
 };
 
 // -------------------------------------------------------------
@@ -19,7 +19,10 @@
 
 #include <cmath>
 #include <iostream>
+#include <map>
+#include <sstream>
 #include <vector>
+#include <boost/format.hpp>
 
 #include "optimizer.hpp"
 
@@ -33,6 +36,228 @@ namespace gp = gridpack::parallel;
 /// The configuration used for these tests
 static gridpack::utility::Configuration::CursorPtr test_config;
 
+// -------------------------------------------------------------
+// knapsack
+// A small linear problem with a unique solution, solved with the
+// optimizer configured by props. Variable k (1 - 9) is owned by
+// processor k % nproc; it is also defined by the owner of k - 1,
+// which uses it in a constraint. The value of the X variables is
+// carried by variable 0, which everybody defines. Variable 10 is also
+// defined by everybody, and every processor adds a share of it to the
+// objective and to the capacity constraint. On return, values holds
+// the solution for the variables defined on this processor and -1.0
+// for the others.
+// -------------------------------------------------------------
+static const int knapvars(9);
+
+static void
+knapsack(const gp::Communicator& comm,
+         gridpack::utility::Configuration::CursorPtr props,
+         std::vector<double>& values)
+{
+  int nproc(comm.size());
+  int me(comm.rank());
+
+  go::Optimizer opt(comm);
+  opt.configure(props);
+
+  std::vector<bool> iown(knapvars+2, false);
+  for (int k = 1; k <= knapvars; ++k) {
+    iown[k] = ((k % nproc) == me);
+  }
+
+  std::vector<go::VariablePtr> vars(knapvars+2);
+  vars[0].reset(new go::RealVariable(0.0));
+  vars[0]->name("Objective");
+  vars[knapvars+1].reset(new go::RealVariable(0.0, 0.0, 2.0));
+  vars[knapvars+1]->name("Bonus");
+  for (int k = 1; k <= knapvars; ++k) {
+    if (iown[k] || iown[k-1]) {
+      vars[k].reset(new go::RealVariable(0.0, 0.0, k));
+      vars[k]->name(boost::str(boost::format("X%02d") % k));
+    }
+  }
+  for (std::vector<go::VariablePtr>::iterator i = vars.begin();
+       i != vars.end(); ++i) {
+    if (*i) { opt.addVariable(*i); }
+  }
+
+  go::ExpressionPtr empty;
+  go::ConstraintPtr c(empty <= 20.0);
+  opt.createGlobalConstraint("Capacity", c);
+  c = (empty == 0.0);
+  opt.createGlobalConstraint("Value", c);
+
+  if (me == 0) {
+    go::ExpressionPtr v(new go::VariableExpression(vars[0]));
+    opt.addToObjective(v);
+    opt.addToGlobalConstraint("Value", v);
+  }
+  opt.addToObjective((100.0/nproc)*vars[knapvars+1]);
+  opt.addToGlobalConstraint("Capacity", (1.0/nproc)*vars[knapvars+1]);
+  for (int k = 1; k <= knapvars; ++k) {
+    if (!iown[k]) continue;
+    opt.addToGlobalConstraint("Capacity", 1.0*vars[k]);
+    opt.addToGlobalConstraint("Value", (-10.0 - k)*vars[k]);
+    if (k < knapvars) {
+      c = ( vars[k] + vars[k+1] <= 2*k + 2 );
+      c->name(boost::str(boost::format("Sum%02d") % k));
+      opt.addConstraint(c);
+      c = ( vars[k] - vars[k+1] <= 5 );
+      c->name(boost::str(boost::format("Diff%02d") % k));
+      opt.addConstraint(c);
+    }
+  }
+
+  opt.maximize();
+
+  values.assign(knapvars+2, -1.0);
+  for (int k = 0; k <= knapvars+1; ++k) {
+    if (vars[k]) {
+      go::GetVariableInitial g;
+      vars[k]->accept(g);
+      values[k] = g.value();
+    }
+  }
+  comm.barrier();
+}
+
+// -------------------------------------------------------------
+//  class AssemblyTest
+// -------------------------------------------------------------
+/// An optimizer that does not solve, but can compare the problem
+/// gathered as expression trees with the problem assembled in
+/// compiled form
+class AssemblyTest
+  : public go::OptimizerImplementation
+{
+public:
+
+  /// Default constructor.
+  AssemblyTest(const gp::Communicator& comm)
+    : go::OptimizerImplementation(comm)
+  {}
+
+  /// Build a distributed problem with linear and quadratic terms
+  void build(void)
+  {
+    int nproc(this->processor_size());
+    int me(this->processor_rank());
+
+    std::vector<go::VariablePtr> v;
+    for (int i = 0; i < 3; ++i) {
+      go::VariablePtr x;
+      if (i == 2) {
+        x.reset(new go::IntegerVariable(0, 0, 5));
+      } else {
+        x.reset(new go::RealVariable(0.0, -1.0*i, 10.0 + me));
+      }
+      x->name(boost::str(boost::format("X_%d_%d") % me % i));
+      p_addVariable(x);
+      v.push_back(x);
+    }
+
+    // defined on every processor
+    p_shared.reset(new go::RealVariable(1.0, 0.0, 3.0));
+    p_shared->name("Shared");
+    p_addVariable(p_shared);
+
+    // owned by the next processor
+    go::VariablePtr ghost(new go::RealVariable(0.0));
+    ghost->name(boost::str(boost::format("X_%d_%d") % ((me+1) % nproc) % 0));
+    p_addAuxVariable(ghost);
+
+    p_addConstraint( 2.0*v[0] + 3*v[1] - v[0] <= 4.0 + me );
+    p_addConstraint( v[1] - ghost >= -1 );
+    p_addConstraint( v[2] + v[0] == 2*me );
+    p_addConstraint( p_shared + v[0] <= 5 );
+    p_addToObjective( 1.5*v[0] + 2.0*(v[1]^2) - me*v[2] + 1.0 );
+    p_addToObjective( 0.5*p_shared );
+
+    go::ExpressionPtr empty;
+    go::ConstraintPtr c( empty <= 7.0 );
+    p_createGlobalConstraint("Total", c);
+    p_addToGlobalConstraint("Total", (me+1)*v[0] + v[2]);
+    p_addToGlobalConstraint("Total", 0.25*p_shared);
+  }
+
+  /// Gather and compile the problem
+  void gather(void)
+  {
+    p_gatherProblem();
+    p_compileProblem();
+  }
+
+  /// Assemble the problem in compiled form
+  void assemble(void)
+  {
+    p_assembleProblem();
+  }
+
+  /// Is the locally defined shared variable the one that gets the solution?
+  bool sharedIsLocal(void)
+  {
+    return p_allVariables["Shared"].get() == p_shared.get();
+  }
+
+  /// Render the compiled problem with terms in name order (constraint
+  /// names are left out, they are not always the same)
+  std::string render(void)
+  {
+    std::ostringstream out;
+    for (VarMap::iterator i = p_allVariables.begin();
+         i != p_allVariables.end(); ++i) {
+      go::VariableTable vtab(out);
+      i->second->accept(vtab);
+    }
+    out << "objective: " << p_render(p_compiledObjective) << std::endl;
+    for (size_t i = 0; i < p_compiledConstraints.size(); ++i) {
+      out << "constraint: "
+          << p_render(p_compiledConstraints[i]) << " "
+          << p_compiledConstraints[i]->op() << " 0" << std::endl;
+    }
+    return out.str();
+  }
+
+protected:
+
+  /// The variable defined on every processor
+  go::VariablePtr p_shared;
+
+  /// Render a compiled expression with terms in name order; terms are
+  /// not merged, so a variable that appears as more than one term
+  /// shows up more than once
+  std::string p_render(go::CompiledExpressionPtr c)
+  {
+    std::multimap<std::string, double> terms;
+    for (size_t i = 0; i < c->variables().size(); ++i) {
+      terms.insert(std::make_pair(c->variables()[i]->name(),
+                                  c->coefficients()[i]));
+    }
+    for (size_t i = 0; i < c->quadraticCoefficients().size(); ++i) {
+      std::string t(c->quadraticVariables1()[i]->name() + "*" +
+                    c->quadraticVariables2()[i]->name());
+      terms.insert(std::make_pair(t, c->quadraticCoefficients()[i]));
+    }
+    std::ostringstream out;
+    out << c->constant();
+    for (std::multimap<std::string, double>::iterator t = terms.begin();
+         t != terms.end(); ++t) {
+      out << " + " << t->second << " " << t->first;
+    }
+    return out.str();
+  }
+
+  void p_configure(gridpack::utility::Configuration::CursorPtr props)
+  {}
+
+  void p_setFilename(std::string file)
+  {}
+
+  void p_solve(const p_optimizeMethod& m)
+  {}
+};
+
 BOOST_AUTO_TEST_SUITE( Optimization )
 
 // -------------------------------------------------------------
@@ -383,6 +608,62 @@ BOOST_AUTO_TEST_CASE (function)
   world.barrier();
 }  
 
+// -------------------------------------------------------------
+// UNIT TEST: assembly
+// Assembling the compiled problem in parallel should give the same
+// problem as gathering and compiling the expression trees
+// -------------------------------------------------------------
+BOOST_AUTO_TEST_CASE( assembly )
+{
+  gp::Communicator world;
+
+  AssemblyTest gathered(world), assembled(world);
+  gathered.build();
+  assembled.build();
+  gathered.gather();
+  assembled.assemble();
+
+  BOOST_CHECK_EQUAL(gathered.render(), assembled.render());
+  BOOST_CHECK(gathered.sharedIsLocal());
+  BOOST_CHECK(assembled.sharedIsLocal());
+
+  world.barrier();
+}
+
+#if defined(HAVE_GLPK)
+// -------------------------------------------------------------
+// UNIT TEST: glpk_paths
+// GLPK should find the same solution whether the problem is loaded
+// directly or parsed from an LP file, and whether the problem is
+// gathered as expression trees or assembled in compiled form
+// -------------------------------------------------------------
+BOOST_AUTO_TEST_CASE( glpk_paths )
+{
+  gp::Communicator world;
+  BOOST_REQUIRE(world.size() <= knapvars);
+  BOOST_REQUIRE(test_config);
+
+  std::vector<double> direct, lpfile, assembled;
+  knapsack(world, test_config->getCursor("PathTest.Direct"), direct);
+  knapsack(world, test_config->getCursor("PathTest.LPFile"), lpfile);
+  knapsack(world, test_config->getCursor("PathTest.Distributed"), assembled);
+
+  // the greedy solution: fill the most valuable variables first
+  static const double expected[knapvars+2] =
+    { 332.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 1.0, 8.0, 9.0, 2.0 };
+
+  for (int k = 0; k <= knapvars+1; ++k) {
+    BOOST_CHECK_EQUAL(direct[k] < 0.0, lpfile[k] < 0.0);
+    BOOST_CHECK_EQUAL(direct[k] < 0.0, assembled[k] < 0.0);
+    if (direct[k] < 0.0) continue;
+    BOOST_CHECK_SMALL(direct[k] - expected[k], 1.0e-08);
+    BOOST_CHECK_SMALL(lpfile[k] - direct[k], 1.0e-08);
+    BOOST_CHECK_SMALL(assembled[k] - direct[k], 1.0e-08);
+  }
+  world.barrier();
+}
+#endif
+
 BOOST_AUTO_TEST_SUITE_END()
 
 // -------------------------------------------------------------
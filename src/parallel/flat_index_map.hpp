@@ -0,0 +1,180 @@
+// Emacs Mode Line: -*- Mode:c++;-*-
+/*
+ *     Copyright (c) 2013 Battelle Memorial Institute
+ *     Licensed under modified BSD License. A copy of this license can be found
+ *     in the LICENSE file in the top level directory of this distribution.
+ */
+// -------------------------------------------------------------
+/**
+ * @file   flat_index_map.hpp
+ *
+ * @brief
+ * A flat, open-addressing hash table that maps integer (or integer pair)
+ * keys to one or more integer values. Keys and values are stored in
+ * contiguous arrays and collisions are resolved by linear probing, so a
+ * lookup touches a few adjacent slots instead of following the pointers of
+ * a tree. The same key can be inserted more than once (for example,
+ * parallel branches between the same pair of buses) and a lookup returns
+ * all of its values.
+ *
+ */
+
+// -------------------------------------------------------------
+
+#ifndef _flat_index_map_hpp_
+#define _flat_index_map_hpp_
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace gridpack {
+namespace hash_map {
+
+// -------------------------------------------------------------
+//  struct FlatIndexHash
+// -------------------------------------------------------------
+// Hash functions used by FlatIndexMap. Keys that arrive on a processor are
+// usually all congruent modulo the number of processors, so the bits are
+// mixed (Fibonacci hashing) before being reduced to a table slot
+struct FlatIndexHash {
+  size_t operator()(int key) const
+  {
+    return static_cast<size_t>(static_cast<unsigned int>(key)
+        *0x9E3779B97F4A7C15ULL >> 32);
+  }
+  size_t operator()(const std::pair<int,int> &key) const
+  {
+    unsigned long long k =
+      (static_cast<unsigned long long>(static_cast<unsigned int>(key.first))
+       << 32) | static_cast<unsigned int>(key.second);
+    k ^= k >> 33;
+    k *= 0xFF51AFD7ED558CCDULL;
+    k ^= k >> 33;
+    return static_cast<size_t>(k);
+  }
+};
+
+// -------------------------------------------------------------
+//  class FlatIndexMap
+// -------------------------------------------------------------
+template <typename Key>
+class FlatIndexMap {
+public:
+
+  // Default constructor
+  FlatIndexMap(void)
+    : p_size(0), p_mask(0)
+  {
+  }
+
+  // Default destructor
+  ~FlatIndexMap(void)
+  {
+  }
+
+  // remove all entries
+  void clear(void)
+  {
+    p_keys.clear();
+    p_values.clear();
+    p_used.clear();
+    p_size = 0;
+    p_mask = 0;
+  }
+
+  // make room for at least n entries without rehashing
+  // @param n expected number of entries
+  void reserve(size_t n)
+  {
+    if (2*n > p_used.size()) rehash(2*n);
+  }
+
+  // number of entries (counting each value of a repeated key)
+  size_t size(void) const
+  {
+    return p_size;
+  }
+
+  // add a key-value pair. Existing values for key are kept
+  // @param key key
+  // @param value value stored for key
+  void insert(const Key &key, int value)
+  {
+    if (2*(p_size+1) > p_used.size()) rehash(2*(p_size+1));
+    size_t slot = FlatIndexHash()(key) & p_mask;
+    while (p_used[slot]) slot = (slot+1) & p_mask;
+    p_keys[slot] = key;
+    p_values[slot] = value;
+    p_used[slot] = 1;
+    p_size++;
+  }
+
+  // find all values stored for a key
+  // @param key key
+  // @param values values for key are appended to this list
+  // @return number of values found
+  int find(const Key &key, std::vector<int> &values) const
+  {
+    int nfound = 0;
+    if (p_size == 0) return nfound;
+    size_t slot = FlatIndexHash()(key) & p_mask;
+    while (p_used[slot]) {
+      if (p_keys[slot] == key) {
+        values.push_back(p_values[slot]);
+        nfound++;
+      }
+      slot = (slot+1) & p_mask;
+    }
+    return nfound;
+  }
+
+  // count values stored for a key
+  // @param key key
+  // @return number of values stored for key
+  int count(const Key &key) const
+  {
+    int nfound = 0;
+    if (p_size == 0) return nfound;
+    size_t slot = FlatIndexHash()(key) & p_mask;
+    while (p_used[slot]) {
+      if (p_keys[slot] == key) nfound++;
+      slot = (slot+1) & p_mask;
+    }
+    return nfound;
+  }
+
+private:
+
+  // grow the table to a power of two of at least n slots and reinsert all
+  // entries. Load factor is kept at or below one half so that probe
+  // sequences stay short
+  // @param n minimum number of slots
+  void rehash(size_t n)
+  {
+    size_t nslots = 16;
+    while (nslots < n) nslots *= 2;
+    std::vector<Key> keys(nslots);
+    std::vector<int> values(nslots);
+    std::vector<char> used(nslots, 0);
+    p_keys.swap(keys);
+    p_values.swap(values);
+    p_used.swap(used);
+    p_mask = nslots-1;
+    p_size = 0;
+    for (size_t i=0; i<used.size(); i++) {
+      if (used[i]) insert(keys[i], values[i]);
+    }
+  }
+
+  std::vector<Key> p_keys;
+  std::vector<int> p_values;
+  std::vector<char> p_used;
+  size_t p_size;
+  size_t p_mask;
+};
+
+} // namespace hash_map
+} // namespace gridpack
+
+#endif
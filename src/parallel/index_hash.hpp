@@ -22,9 +22,9 @@
 #ifndef _hash_map_hpp_
 #define _hash_map_hpp_
 
-#include <map>
 #include <vector>
 #include "gridpack/parallel/communicator.hpp"
+#include "gridpack/parallel/flat_index_map.hpp"
 
 namespace gridpack {
 namespace hash_map {
@@ -79,13 +79,12 @@ private:
 
   int p_nprocs;
   int p_me;
-  int p_GAgrp;
 
   MPI_Comm p_comm;
 
-  std::multimap<int, int> p_umap;
-  
-  std::multimap<std::pair<int,int>, int> p_pmap;
+  FlatIndexMap<int> p_umap;
+
+  FlatIndexMap<std::pair<int,int> > p_pmap;
 };
 
 
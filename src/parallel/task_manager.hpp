@@ -20,6 +20,10 @@
 #ifndef _task_manager_hpp_
 #define _task_manager_hpp_
 
+#include <vector>
+#include <algorithm>
+#include <cstdio>
+#include "gridpack/utilities/exception.hpp"
 #include "gridpack/parallel/communicator.hpp"
 #include <ga.h>
 
@@ -48,6 +52,8 @@ public:
     }
     GA_Zero(p_GAcounter);
     p_ntasks = 0;
+    p_maxChunk = 64;
+    resetStats();
   }
 
   /**
@@ -67,6 +73,8 @@ public:
     }
     GA_Zero(p_GAcounter);
     p_ntasks = 0;
+    p_maxChunk = 64;
+    resetStats();
   }
 
   /**
@@ -85,7 +93,51 @@ public:
   {
     GA_Zero(p_GAcounter);
     p_ntasks = ntasks;
-    p_task_count = 0;
+    p_order.clear();
+    p_costSum.clear();
+    resetStats();
+  }
+
+  /**
+   * Specify total number of tasks along with an estimate of the cost of each
+   * task and set task manager to zero. Tasks are handed out in order of
+   * decreasing cost so that expensive tasks are started first. The cost
+   * vector must be the same on all processors
+   * @param ntasks total number of tasks
+   * @param cost estimated cost of each task
+   */
+  void set(int ntasks, const std::vector<double> &cost)
+  {
+    if (static_cast<int>(cost.size()) != ntasks) {
+      char buf[256];
+      sprintf(buf,"Size of cost vector %d does not match number of tasks %d"
+          " in TaskManager::set\n",static_cast<int>(cost.size()),ntasks);
+      printf("%s",buf);
+      throw gridpack::Exception(buf);
+    }
+    set(ntasks);
+    p_order.resize(ntasks);
+    int i;
+    for (i=0; i<ntasks; i++) p_order[i] = i;
+    std::stable_sort(p_order.begin(),p_order.end(),CostCompare(cost));
+    p_costSum.resize(ntasks+1);
+    p_costSum[0] = 0.0;
+    for (i=0; i<ntasks; i++) {
+      p_costSum[i+1] = p_costSum[i] + cost[p_order[i]];
+    }
+  }
+
+  /**
+   * Set maximum number of tasks that are claimed from the task counter in a
+   * single operation. The number of tasks actually claimed shrinks as the
+   * remaining number of tasks decreases. Setting the chunk size to 1 claims
+   * a single task at a time
+   * @param chunk maximum number of tasks claimed at one time
+   */
+  void setChunkSize(int chunk)
+  {
+    p_maxChunk = chunk;
+    if (p_maxChunk < 1) p_maxChunk = 1;
   }
   
   /**
@@ -96,15 +148,17 @@ public:
    * @return false if no other tasks are found
    */
   bool nextTask(int *next) {
-    int zero = 0;
-    long one = 1;
-    *next = static_cast<int>(NGA_Read_inc(p_GAcounter,&zero,one));
+    double t0 = startClaim();
+    *next = claim(GA_Pgroup_nnodes(p_grp));
     if (*next < p_ntasks) {
+      endClaim(t0);
       p_task_count++;
+      *next = taskIndex(*next);
       return true;
     } else {
       *next = -1;
       GA_Pgroup_sync(p_grp);
+      endClaim(t0);
       return false;
     }
   }
@@ -120,23 +174,35 @@ public:
    */
 
   bool nextTask(Communicator &comm, int *next) {
-    int zero = 0;
-    long one = 1;
+    double t0 = startClaim();
+    long two = 2;
     int me = comm.rank();
+    // Broadcast the task index and the ID of the process that claimed it
+    // to all processors in comm
+    int buf[2];
     if (me == 0) {
-      *next = static_cast<int>(NGA_Read_inc(p_GAcounter,&zero,one));
+      int ngrp = GA_Pgroup_nnodes(p_grp)/comm.size();
+      if (ngrp < 1) ngrp = 1;
+      buf[0] = claim(ngrp);
+      buf[1] = GA_Pgroup_nodeid(p_grp);
     } else {
-      *next = 0;
+      buf[0] = 0;
+      buf[1] = 0;
     }
     char plus[2];
     strcpy(plus,"+");
-    GA_Pgroup_igop(comm.getGroup(),next,one,plus);
+    GA_Pgroup_igop(comm.getGroup(),buf,two,plus);
+    *next = buf[0];
+    p_leader = buf[1];
     if (*next < p_ntasks) {
+      endClaim(t0);
       p_task_count++;
+      *next = taskIndex(*next);
       return true;
     } else {
       *next = -1;
       GA_Pgroup_sync(p_grp);
+      endClaim(t0);
       return false;
     }
   }
@@ -150,6 +216,7 @@ public:
   void cancel(void) {
     int zero = 0;
     int n = static_cast<int>(NGA_Read_inc(p_GAcounter,&zero, p_ntasks));
+    p_chunkNext = p_chunkEnd;
   }
 
   /**
@@ -159,27 +226,217 @@ public:
     int nprocs = GA_Pgroup_nnodes(p_grp);
     int me = GA_Pgroup_nodeid(p_grp);
     std::vector<int> procs(nprocs);
+    std::vector<int> claims(nprocs);
+    std::vector<int> leaders(nprocs);
+    std::vector<double> busy(nprocs);
+    std::vector<double> idle(nprocs);
     int i;
-    for (i=0; i<nprocs; i++) procs[i] = 0;
-    procs[GA_Pgroup_nodeid(p_grp)] = p_task_count;
+    for (i=0; i<nprocs; i++) {
+      procs[i] = 0;
+      claims[i] = 0;
+      leaders[i] = 0;
+      busy[i] = 0.0;
+      idle[i] = 0.0;
+    }
+    procs[me] = p_task_count;
+    claims[me] = p_claims;
+    leaders[me] = p_leader;
+    if (p_leader < 0) leaders[me] = me;
+    busy[me] = p_busy;
+    idle[me] = p_idle;
     char plus[2];
     strcpy(plus,"+");
     GA_Pgroup_igop(p_grp,&(procs[0]),nprocs,plus);
+    GA_Pgroup_igop(p_grp,&(claims[0]),nprocs,plus);
+    GA_Pgroup_igop(p_grp,&(leaders[0]),nprocs,plus);
+    GA_Pgroup_dgop(p_grp,&(busy[0]),nprocs,plus);
+    GA_Pgroup_dgop(p_grp,&(idle[0]),nprocs,plus);
     // print out number of tasks evaluated on each processor
     if (me == 0) {
       printf("\nNumber of tasks per processors\n");
       for (i=0; i<nprocs; i++) {
         printf("  Number of tasks on process %6d: %6d\n",i,procs[i]);
       }
+      // Statistics for each group of processors that evaluates tasks
+      // together. Groups are labeled by the process that claims tasks
+      printf("\nTask statistics per group\n");
+      printf("   Group  Tasks  Claims     Busy (s)     Idle (s)\n");
+      double bmax = 0.0;
+      double bsum = 0.0;
+      double isum = 0.0;
+      int ngrp = 0;
+      for (i=0; i<nprocs; i++) {
+        if (leaders[i] != i) continue;
+        printf("  %6d %6d %7d %12.4f %12.4f\n",i,procs[i],claims[i],
+            busy[i],idle[i]);
+        if (busy[i] > bmax) bmax = busy[i];
+        bsum += busy[i];
+        isum += idle[i];
+        ngrp++;
+      }
+      if (ngrp > 0 && bsum > 0.0) {
+        printf("  Load imbalance (max/mean busy time): %8.4f\n",
+            bmax*static_cast<double>(ngrp)/bsum);
+        printf("  Mean idle time per group (s): %12.4f\n",
+            isum/static_cast<double>(ngrp));
+      }
     }
   }
 
 protected:
+
+  /**
+   * Compare tasks based on their cost so that more expensive tasks come first
+   */
+  class CostCompare {
+    public:
+      CostCompare(const std::vector<double> &cost)
+        : p_cost(cost)
+      { }
+      bool operator()(int a, int b) const
+      {
+        return p_cost[a] > p_cost[b];
+      }
+    private:
+      const std::vector<double> &p_cost;
+  };
+
+  /**
+   * Evaluate number of tasks to claim starting at position pos. A chunk
+   * covers half the remaining work divided by the number of claimers, so
+   * chunks shrink towards the end of the calculation. If cost estimates are
+   * available the work is measured by cost, otherwise by number of tasks
+   * @param pos position of first task in chunk
+   * @param nclaim number of processes or groups claiming tasks
+   * @return number of tasks in chunk
+   */
+  int chunkSize(int pos, int nclaim) const
+  {
+    if (nclaim < 1) nclaim = 1;
+    if (pos > p_ntasks) pos = p_ntasks;
+    int size;
+    if (p_costSum.size() > 0) {
+      double target = (p_costSum[p_ntasks]-p_costSum[pos])
+        /static_cast<double>(2*nclaim);
+      size = static_cast<int>(std::upper_bound(p_costSum.begin()+pos,
+          p_costSum.end(),p_costSum[pos]+target) - p_costSum.begin()) - 1 - pos;
+    } else {
+      size = (p_ntasks-pos)/(2*nclaim);
+    }
+    if (size > p_maxChunk) size = p_maxChunk;
+    if (size < 1) size = 1;
+    return size;
+  }
+
+  /**
+   * Get next position from the task counter. Tasks are claimed from the
+   * global counter in chunks and handed out locally until the chunk is
+   * exhausted. The size of a chunk is evaluated from the value of the
+   * counter returned by the previous claim on this process. Other processes
+   * may have claimed tasks since then, so chunks may be somewhat larger
+   * than the current remaining work would give, but only one access to the
+   * counter is needed per chunk
+   * @param nclaim number of processes or groups claiming tasks
+   * @return position of next task
+   */
+  int claim(int nclaim)
+  {
+    if (p_chunkNext >= p_chunkEnd) {
+      int zero = 0;
+      long chunk = 1;
+      if (p_maxChunk > 1) chunk = chunkSize(p_counterSeen,nclaim);
+      int start = static_cast<int>(NGA_Read_inc(p_GAcounter,&zero,chunk));
+      p_claims++;
+      p_counterSeen = start + static_cast<int>(chunk);
+      p_chunkNext = start;
+      p_chunkEnd = start + static_cast<int>(chunk);
+      if (p_chunkEnd > p_ntasks) p_chunkEnd = p_ntasks;
+      if (start >= p_ntasks) {
+        p_chunkNext = p_ntasks;
+        p_chunkEnd = p_ntasks;
+        return p_ntasks;
+      }
+    }
+    int ret = p_chunkNext;
+    p_chunkNext++;
+    return ret;
+  }
+
+  /**
+   * Convert position in task sequence to task index
+   * @param pos position in sequence of tasks
+   * @return task index
+   */
+  int taskIndex(int pos) const
+  {
+    if (p_order.size() > 0) return p_order[pos];
+    return pos;
+  }
+
+  /**
+   * Start timing a call to nextTask. Time since the previous call returned
+   * is counted as busy time
+   * @return time at start of call
+   */
+  double startClaim()
+  {
+    double t = MPI_Wtime();
+    if (p_lastReturn > 0.0) p_busy += t - p_lastReturn;
+    return t;
+  }
+
+  /**
+   * Finish timing a call to nextTask. Time spent inside nextTask, including
+   * waiting for other processes after all tasks are gone, is counted as
+   * idle time
+   * @param t0 time at start of call
+   */
+  void endClaim(double t0)
+  {
+    p_lastReturn = MPI_Wtime();
+    p_idle += p_lastReturn - t0;
+  }
+
+  /**
+   * Reset local task chunk and statistics
+   */
+  void resetStats()
+  {
+    p_task_count = 0;
+    p_claims = 0;
+    p_leader = -1;
+    p_busy = 0.0;
+    p_idle = 0.0;
+    p_lastReturn = 0.0;
+    p_chunkNext = 0;
+    p_chunkEnd = 0;
+    p_counterSeen = 0;
+  }
   
   int p_GAcounter;
   int p_ntasks;
   int p_grp;
   int p_task_count;
+
+  // order in which tasks are handed out if cost estimates are available and
+  // cumulative cost of tasks in that order
+  std::vector<int> p_order;
+  std::vector<double> p_costSum;
+
+  // locally claimed chunk of tasks and maximum chunk size
+  int p_chunkNext;
+  int p_chunkEnd;
+  int p_maxChunk;
+
+  // value of the task counter after the last chunk claimed on this process
+  int p_counterSeen;
+
+  // statistics
+  int p_claims;
+  int p_leader;
+  double p_busy;
+  double p_idle;
+  double p_lastReturn;
 };
 
 
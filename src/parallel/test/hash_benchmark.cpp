@@ -0,0 +1,131 @@
+/*
+ *     Copyright (c) 2013 Battelle Memorial Institute
+ *     Licensed under modified BSD License. A copy of this license can be found
+ *     in the LICENSE file in the top level directory of this distribution.
+ */
+// -------------------------------------------------------------
+/**
+ * @file   hash_benchmark.cpp
+ *
+ * @brief  Compare lookup throughput of FlatIndexMap and std::multimap, and
+ * time distributed lookups through GlobalIndexHashMap
+ *
+ * Usage: hash_benchmark [number of keys]
+ *
+ * The default is 1000000 keys. Roughly one key in ten has a second value,
+ * the way parallel branches share a pair of bus indices.
+ */
+// -------------------------------------------------------------
+
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <vector>
+#include <mpi.h>
+#include "gridpack/parallel/parallel.hpp"
+#include "gridpack/parallel/index_hash.hpp"
+
+// -------------------------------------------------------------
+//  Main Program
+// -------------------------------------------------------------
+int
+main(int argc, char **argv)
+{
+  gridpack::parallel::Environment env(argc, argv);
+
+  // Limit scope so that program exits cleanly
+  if (1) {
+    gridpack::parallel::Communicator world;
+    int me = world.rank();
+    int nprocs = world.size();
+    int nkeys = 1000000;
+    if (argc > 1) nkeys = atoi(argv[1]);
+    int i;
+
+    // Build the key-value pairs. Keys are scrambled so that neither table sees
+    // them in order
+    std::vector<std::pair<int,int> > pairs;
+    pairs.reserve(nkeys + nkeys/10);
+    for (i=0; i<nkeys; i++) {
+      int key = static_cast<int>((static_cast<long long>(i)*7919)%nkeys);
+      pairs.push_back(std::pair<int,int>(key,i));
+      if (key%10 == 0) pairs.push_back(std::pair<int,int>(key,-i));
+    }
+    std::vector<int> keys(nkeys);
+    for (i=0; i<nkeys; i++) {
+      keys[i] = static_cast<int>((static_cast<long long>(i)*104729)%nkeys);
+    }
+    int npairs = pairs.size();
+
+    // Serial comparison of the local tables on processor 0
+    if (me == 0) {
+      double t0, tbuild_multi, tfind_multi, tbuild_flat, tfind_flat;
+      long long sum_multi = 0, sum_flat = 0;
+
+      t0 = MPI_Wtime();
+      std::multimap<int,int> mmap;
+      for (i=0; i<npairs; i++) mmap.insert(pairs[i]);
+      tbuild_multi = MPI_Wtime()-t0;
+      t0 = MPI_Wtime();
+      for (i=0; i<nkeys; i++) {
+        std::pair<std::multimap<int,int>::iterator,
+          std::multimap<int,int>::iterator> range = mmap.equal_range(keys[i]);
+        for (; range.first != range.second; range.first++) {
+          sum_multi += range.first->second;
+        }
+      }
+      tfind_multi = MPI_Wtime()-t0;
+
+      t0 = MPI_Wtime();
+      gridpack::hash_map::FlatIndexMap<int> fmap;
+      fmap.reserve(npairs);
+      for (i=0; i<npairs; i++) fmap.insert(pairs[i].first,pairs[i].second);
+      tbuild_flat = MPI_Wtime()-t0;
+      t0 = MPI_Wtime();
+      std::vector<int> found;
+      for (i=0; i<nkeys; i++) {
+        found.clear();
+        int nfound = fmap.find(keys[i], found);
+        for (int j=0; j<nfound; j++) sum_flat += found[j];
+      }
+      tfind_flat = MPI_Wtime()-t0;
+
+      printf("Local tables, %d keys, %d entries\n",nkeys,npairs);
+      printf("  std::multimap   build %10.4f s  lookup %10.4f s  %12.0f lookups/s\n",
+          tbuild_multi,tfind_multi,nkeys/tfind_multi);
+      printf("  FlatIndexMap    build %10.4f s  lookup %10.4f s  %12.0f lookups/s\n",
+          tbuild_flat,tfind_flat,nkeys/tfind_flat);
+      printf("  lookup speedup  %10.2f\n",tfind_multi/tfind_flat);
+      if (sum_multi != sum_flat) {
+        printf("  ERROR: checksums differ (%lld, %lld)\n",sum_multi,sum_flat);
+      }
+    }
+
+    // Distributed lookups. Each processor adds its share of the pairs and
+    // then looks up its share of the keys
+    std::vector<std::pair<int,int> > my_pairs;
+    for (i=me; i<npairs; i+=nprocs) my_pairs.push_back(pairs[i]);
+    std::vector<int> my_keys, my_values;
+    for (i=me; i<nkeys; i+=nprocs) my_keys.push_back(keys[i]);
+    int nlookup = my_keys.size();
+
+    gridpack::hash_map::GlobalIndexHashMap hmap(world);
+    world.barrier();
+    double t0 = MPI_Wtime();
+    hmap.addPairs(my_pairs);
+    world.barrier();
+    double tadd = MPI_Wtime()-t0;
+    t0 = MPI_Wtime();
+    hmap.getValues(my_keys, my_values);
+    world.barrier();
+    double tget = MPI_Wtime()-t0;
+    if (me == 0) {
+      printf("GlobalIndexHashMap on %d processors\n",nprocs);
+      printf("  addPairs  %10.4f s\n",tadd);
+      printf("  getValues %10.4f s  %12.0f lookups/s per processor\n",
+          tget,nlookup/tget);
+    }
+  }
+
+  return 0;
+}
@@ -25,6 +25,7 @@
 // -------------------------------------------------------------
 
 #include <iostream>
+#include <vector>
 #include <ga.h>
 #include "gridpack/parallel/parallel.hpp"
 #include "gridpack/parallel/task_manager.hpp"
@@ -79,6 +80,53 @@ main(int argc, char **argv)
             itask,lcomm.rank(),me,lcomm.size());
       }
     }
+    // Hand out tasks with cost estimates. Every task should be evaluated
+    // exactly once and tasks on each process should come out in order of
+    // decreasing cost
+    std::vector<double> cost(ntasks);
+    for (i=0; i<ntasks; i++) cost[i] = static_cast<double>((7*i)%ntasks);
+    std::vector<int> count(ntasks,0);
+    tskmgr.set(ntasks,cost);
+    double last = static_cast<double>(ntasks);
+    bool ordered = true;
+    while(tskmgr.nextTask(&itask)) {
+      count[itask]++;
+      if (cost[itask] > last) ordered = false;
+      last = cost[itask];
+    }
+    world.sum(&count[0],ntasks);
+    bool complete = true;
+    for (i=0; i<ntasks; i++) {
+      if (count[i] != 1) complete = false;
+    }
+    if (!ordered) {
+      printf("Tasks not in order of decreasing cost on processor %d\n",me);
+    }
+    if (me == 0) {
+      if (complete) {
+        printf("\nAll %d tasks with cost estimates evaluated once\n",ntasks);
+      } else {
+        printf("\nTasks with cost estimates not evaluated correctly\n");
+      }
+    }
+    tskmgr.printStats();
+
+    // A cost vector that does not match the number of tasks is rejected
+    bool rejected = false;
+    try {
+      std::vector<double> short_cost(ntasks-1,1.0);
+      tskmgr.set(ntasks,short_cost);
+    } catch (const gridpack::Exception &e) {
+      rejected = true;
+    }
+    if (me == 0) {
+      if (rejected) {
+        printf("\nMismatched cost vector rejected\n");
+      } else {
+        printf("\nMismatched cost vector not rejected\n");
+      }
+    }
+
     // Check performance of task manager. Create a very large number of tasks.
     ntasks = 1000000*nprocs;
     tskmgr.set(ntasks);
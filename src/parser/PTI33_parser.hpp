@@ -22,6 +22,9 @@
 #endif
 #include <vector>
 #include <map>
+#include <algorithm>
+#include <fstream>
+#include <sstream>
 #include <cstdio>
 #include <cstdlib>
 
@@ -173,7 +176,9 @@ class PTI33_parser : public BasePTIParser<_network>
       this->setCaseID(p_case_id);
       this->setCaseSBase(p_case_sbase);
 
-      if (me == 0) {
+      if (nprocs > 1) {
+        readDistributed(fileName, input);
+      } else if (me == 0) {
         find_buses(input);
         find_loads(input);
         find_fixed_shunts(input);
@@ -234,7 +239,7 @@ class PTI33_parser : public BasePTIParser<_network>
       p_timer->stop(t_case);
     }
 
-    void find_case(std::ifstream & input)
+    void find_case(std::istream & input)
     {
       std::string                                        line;
 
@@ -272,22 +277,22 @@ class PTI33_parser : public BasePTIParser<_network>
       p_base_freq = atof(split_line[5].c_str());
        */
 
+      // Skip the two title lines that follow the case record
+      std::getline(input, line);
+      std::getline(input, line);
     }
 
-    void find_buses(std::ifstream & input)
+    void find_buses(std::istream & input)
     {
       std::string          line;
       int                  index = 0;
       int                  o_idx;
-      std::getline(input, line);
-      std::getline(input, line);
-      std::getline(input, line);
+      std::getline(input, line); //this should be the first line of the block
 
+      std::vector<std::string>  split_line;
       while(test_end(line)) {
-        std::vector<std::string>  split_line;
         this->cleanComment(line);
-        boost::split(split_line, line, boost::algorithm::is_any_of(","),
-            boost::token_compress_off);
+        splitLine(line, split_line);
         boost::shared_ptr<gridpack::component::DataCollection>
           data(new gridpack::component::DataCollection);
         int nstr = split_line.size();
@@ -339,16 +344,15 @@ class PTI33_parser : public BasePTIParser<_network>
       }
     }
 
-    void find_loads(std::ifstream & input)
+    void find_loads(std::istream & input)
     {
       std::string          line;
       std::getline(input, line); //this should be the first line of the block
 
+      std::vector<std::string>  split_line;
       while(test_end(line)) {
-        std::vector<std::string>  split_line;
         this->cleanComment(line);
-        boost::split(split_line, line, boost::algorithm::is_any_of(","),
-            boost::token_compress_off);
+        splitLine(line, split_line);
 
         // LOAD_BUSNUMBER               "I"                   integer
         int l_idx, o_idx;
@@ -440,16 +444,15 @@ class PTI33_parser : public BasePTIParser<_network>
       }
     }
 
-    void find_fixed_shunts(std::ifstream & input)
+    void find_fixed_shunts(std::istream & input)
     {
       std::string          line;
       std::getline(input, line); //this should be the first line of the block
 
+      std::vector<std::string>  split_line;
       while(test_end(line)) {
-        std::vector<std::string>  split_line;
         this->cleanComment(line);
-        boost::split(split_line, line, boost::algorithm::is_any_of(","),
-            boost::token_compress_off);
+        splitLine(line, split_line);
 
         // SHUNT_BUSNUMBER               "I"                   integer
         int l_idx, o_idx;
@@ -515,15 +518,14 @@ class PTI33_parser : public BasePTIParser<_network>
       }
     }
 
-    void find_generators(std::ifstream & input)
+    void find_generators(std::istream & input)
     {
       std::string          line;
       std::getline(input, line); //this should be the first line of the block
+      std::vector<std::string>  split_line;
       while(test_end(line)) {
-        std::vector<std::string>  split_line;
         this->cleanComment(line);
-        boost::split(split_line, line, boost::algorithm::is_any_of(","),
-            boost::token_compress_off);
+        splitLine(line, split_line);
 
         // GENERATOR_BUSNUMBER               "I"                   integer
         int l_idx, o_idx;
@@ -705,7 +707,7 @@ class PTI33_parser : public BasePTIParser<_network>
       }
     }
 
-    void find_branches(std::ifstream & input)
+    void find_branches(std::istream & input)
     {
       std::string line;
       int  o_idx1, o_idx2;
@@ -714,12 +716,11 @@ class PTI33_parser : public BasePTIParser<_network>
       std::getline(input, line); //this should be the first line of the block
 
       int nelems;
+      std::vector<std::string>  split_line;
       while(test_end(line)) {
         std::pair<int, int> branch_pair;
-        std::vector<std::string>  split_line;
         this->cleanComment(line);
-        boost::split(split_line, line, boost::algorithm::is_any_of(","),
-            boost::token_compress_off);
+        splitLine(line, split_line);
 
         o_idx1 = getBusIndex(split_line[0]);
         o_idx2 = getBusIndex(split_line[1]);
@@ -857,7 +858,7 @@ class PTI33_parser : public BasePTIParser<_network>
     // This code is NOT handling these elements correctly. Need to bring
     // it in line with find_branch routine and the definitions in the
     // ex_pti_file
-    void find_transformer(std::ifstream & input)
+    void find_transformer(std::istream & input)
     {
       std::string          line;
 
@@ -870,11 +871,14 @@ class PTI33_parser : public BasePTIParser<_network>
 
       bool wind3X = true;
 
+      std::vector<std::string>  split_line;
+      std::vector<std::string>  split_line2;
+      std::vector<std::string>  split_line3;
+      std::vector<std::string>  split_line4;
+      std::vector<std::string>  split_line5;
       while(test_end(line)) {
-        std::vector<std::string>  split_line;
         this->cleanComment(line);
-        boost::split(split_line, line, boost::algorithm::is_any_of(","),
-            boost::token_compress_off);
+        splitLine(line, split_line);
         int o_idx1, o_idx2;
         o_idx1 = getBusIndex(split_line[0]);
         o_idx2 = getBusIndex(split_line[1]);
@@ -885,10 +889,8 @@ class PTI33_parser : public BasePTIParser<_network>
           if (wind3X) {
             int o_idx3 = k;
             std::getline(input, line);
-            std::vector<std::string>  split_line2;
             this->cleanComment(line);
-            boost::split(split_line2, line, boost::algorithm::is_any_of(","),
-                boost::token_compress_off);
+            splitLine(line, split_line2);
             // Check to see if transformer is active
             int stat;
             stat = atoi(split_line[11].c_str());
@@ -899,25 +901,29 @@ class PTI33_parser : public BasePTIParser<_network>
               std::getline(input, line);
               continue;
             }
-            // Get internal indices corresponding to buses 1,2,3
-            int l_idx1, l_idx2, l_idx3;
+            // Get internal indices corresponding to buses 1,2,3. If the
+            // file is read in parallel, these buses may live on another
+            // processor
+            int l_idx1 = -1;
+            int l_idx2 = -1;
+            int l_idx3 = -1;
             std::map<int,int>::iterator it;
             it = p_busMap.find(o_idx1);
             if (it != p_busMap.end()) {
               l_idx1 = it->second;
-            } else {
+            } else if (p_busOwner.find(o_idx1) == p_busOwner.end()) {
               printf("No match found for bus %s\n",split_line[0].c_str());
             }
             it = p_busMap.find(o_idx2);
             if (it != p_busMap.end()) {
               l_idx2 = it->second;
-            } else {
+            } else if (p_busOwner.find(o_idx2) == p_busOwner.end()) {
               printf("No match found for bus %s\n",split_line[1].c_str());
             }
             it = p_busMap.find(o_idx3);
             if (it != p_busMap.end()) {
               l_idx3 = it->second;
-            } else {
+            } else if (p_busOwner.find(o_idx3) == p_busOwner.end()) {
               printf("No match found for bus %s\n",split_line[2].c_str());
             }
             // Create a new bus and three new branches. No need to check
@@ -936,28 +942,39 @@ class PTI33_parser : public BasePTIParser<_network>
             data->addValue(BUS_NAME,cbuf);
             data->addValue(BUS_BASEKV,0.0);
             data->addValue(BUS_TYPE,1);
-            int ival;
-            p_busData[l_idx1]->getValue(BUS_AREA,&ival);
+            int ival = 0;
+            int jval = 0;
+            if (l_idx1 >= 0) {
+              p_busData[l_idx1]->getValue(BUS_AREA,&ival);
+              p_busData[l_idx1]->getValue(BUS_OWNER,&jval);
+            } else {
+              std::map<int,std::pair<int,int> >::iterator rit;
+              rit = p_remoteBusInfo.find(o_idx1);
+              if (rit != p_remoteBusInfo.end()) {
+                ival = rit->second.first;
+                jval = rit->second.second;
+              }
+            }
             data->addValue(BUS_AREA,ival);
-            p_busData[l_idx1]->getValue(BUS_OWNER,&ival);
-            data->addValue(BUS_OWNER, ival);
+            data->addValue(BUS_OWNER, jval);
             double rval = 0.0;
-            double rvol;
-            p_busData[l_idx1]->getValue(BUS_VOLTAGE_MAG,&rvol);
+            double rvol = 0.0;
+            if (l_idx1 >= 0) p_busData[l_idx1]->getValue(BUS_VOLTAGE_MAG,&rvol);
             rval += rvol;
-            p_busData[l_idx2]->getValue(BUS_VOLTAGE_MAG,&rvol);
+            if (l_idx2 >= 0) p_busData[l_idx2]->getValue(BUS_VOLTAGE_MAG,&rvol);
             rval += rvol;
-            p_busData[l_idx3]->getValue(BUS_VOLTAGE_MAG,&rvol);
+            if (l_idx3 >= 0) p_busData[l_idx3]->getValue(BUS_VOLTAGE_MAG,&rvol);
             rval += rvol;
             rval = rval/3.0;
             rval = 1.0;
             data->addValue(BUS_VOLTAGE_MAG,rval);
             rval = 0.0;
-            p_busData[l_idx1]->getValue(BUS_VOLTAGE_ANG,&rvol);
+            rvol = 0.0;
+            if (l_idx1 >= 0) p_busData[l_idx1]->getValue(BUS_VOLTAGE_ANG,&rvol);
             rval += rvol;
-            p_busData[l_idx2]->getValue(BUS_VOLTAGE_ANG,&rvol);
+            if (l_idx2 >= 0) p_busData[l_idx2]->getValue(BUS_VOLTAGE_ANG,&rvol);
             rval += rvol;
-            p_busData[l_idx3]->getValue(BUS_VOLTAGE_ANG,&rvol);
+            if (l_idx3 >= 0) p_busData[l_idx3]->getValue(BUS_VOLTAGE_ANG,&rvol);
             rval += rvol;
             rval = rval/3.0;
             rval = 0.0;
@@ -1012,10 +1029,8 @@ class PTI33_parser : public BasePTIParser<_network>
               data1(new gridpack::component::DataCollection);
             p_branchData.push_back(data1);
             std::getline(input, line);
-            std::vector<std::string> split_line3;
             this->cleanComment(line);
-            boost::split(split_line3, line, boost::algorithm::is_any_of(","),
-                boost::token_compress_off);
+            splitLine(line, split_line3);
             double windv, ang, ratea, rateb, ratec;
             parse3WindXForm(split_line3, &windv, &ang, &ratea, &rateb, &ratec);
             data1->addValue(BRANCH_INDEX,index);
@@ -1048,10 +1063,8 @@ class PTI33_parser : public BasePTIParser<_network>
               data2(new gridpack::component::DataCollection);
             p_branchData.push_back(data2);
             std::getline(input, line);
-            std::vector<std::string> split_line4;
             this->cleanComment(line);
-            boost::split(split_line4, line, boost::algorithm::is_any_of(","),
-                boost::token_compress_off);
+            splitLine(line, split_line4);
             parse3WindXForm(split_line4, &windv, &ang, &ratea, &rateb, &ratec);
             data2->addValue(BRANCH_INDEX,index);
             data2->addValue(BRANCH_FROMBUS,o_idx2);
@@ -1083,10 +1096,8 @@ class PTI33_parser : public BasePTIParser<_network>
               data3(new gridpack::component::DataCollection);
             p_branchData.push_back(data3);
             std::getline(input, line);
-            std::vector<std::string> split_line5;
             this->cleanComment(line);
-            boost::split(split_line5, line, boost::algorithm::is_any_of(","),
-                boost::token_compress_off);
+            splitLine(line, split_line5);
             parse3WindXForm(split_line5, &windv, &ang, &ratea, &rateb, &ratec);
             data3->addValue(BRANCH_INDEX,index);
             data3->addValue(BRANCH_FROMBUS,o_idx3);
@@ -1121,22 +1132,16 @@ class PTI33_parser : public BasePTIParser<_network>
           }
         } else {
           std::getline(input, line);
-          std::vector<std::string>  split_line2;
           this->cleanComment(line);
-          boost::split(split_line2, line, boost::algorithm::is_any_of(","),
-              boost::token_compress_off);
+          splitLine(line, split_line2);
 
           std::getline(input, line);
-          std::vector<std::string>  split_line3;
           this->cleanComment(line);
-          boost::split(split_line3, line, boost::algorithm::is_any_of(","),
-              boost::token_compress_off);
+          splitLine(line, split_line3);
 
           std::getline(input, line);
-          std::vector<std::string>  split_line4;
           this->cleanComment(line);
-          boost::split(split_line4, line, boost::algorithm::is_any_of(","),
-              boost::token_compress_off);
+          splitLine(line, split_line4);
           // find branch corresponding to this transformer line. If it doesn't
           // exist, create one
           int l_idx = 0;
@@ -1307,17 +1312,16 @@ class PTI33_parser : public BasePTIParser<_network>
       }
     }
 
-    void find_area(std::ifstream & input)
+    void find_area(std::istream & input)
     {
       std::string          line;
 
       std::getline(input, line); //this should be the first line of the block
 
+      std::vector<std::string>  split_line;
       while(test_end(line)) {
-        std::vector<std::string>  split_line;
         this->cleanComment(line);
-        boost::split(split_line, line, boost::algorithm::is_any_of(","),
-            boost::token_compress_off);
+        splitLine(line, split_line);
 
         // AREAINTG_ISW           "ISW"                  integer
         int l_idx, o_idx;
@@ -1352,17 +1356,16 @@ class PTI33_parser : public BasePTIParser<_network>
       }
     }
 
-    void find_2term(std::ifstream & input)
+    void find_2term(std::istream & input)
     {
       std::string          line;
 
       std::getline(input, line); //this should be the first line of the block
 
+      std::vector<std::string>  split_line;
       while(test_end(line)) {
-        std::vector<std::string>  split_line;
         this->cleanComment(line);
-        boost::split(split_line, line, boost::algorithm::is_any_of(","),
-            boost::token_compress_off);
+        splitLine(line, split_line);
         int l_idx, o_idx;
         o_idx = atoi(split_line[1].c_str());
 #ifdef OLD_MAP
@@ -1382,17 +1385,16 @@ class PTI33_parser : public BasePTIParser<_network>
       }
     }
 
-    void find_vsc_line(std::ifstream & input)
+    void find_vsc_line(std::istream & input)
     {
       std::string          line;
 
       std::getline(input, line); //this should be the first line of the block
 
+      std::vector<std::string>  split_line;
       while(test_end(line)) {
-        std::vector<std::string>  split_line;
         this->cleanComment(line);
-        boost::split(split_line, line, boost::algorithm::is_any_of(","),
-            boost::token_compress_off);
+        splitLine(line, split_line);
 
         std::getline(input, line);
       }
@@ -1402,16 +1404,15 @@ class PTI33_parser : public BasePTIParser<_network>
     /*
 
      */
-    void find_switched_shunt(std::ifstream & input)
+    void find_switched_shunt(std::istream & input)
     {
       std::string          line;
 
       std::getline(input, line); //this should be the first line of the block
+      std::vector<std::string>  split_line;
       while(test_end(line)) {
-        std::vector<std::string>  split_line;
         this->cleanComment(line);
-        boost::split(split_line, line, boost::algorithm::is_any_of(","),
-            boost::token_compress_off);
+        splitLine(line, split_line);
 
         /*
          * type: integer
@@ -1601,17 +1602,16 @@ class PTI33_parser : public BasePTIParser<_network>
       }
     }
 
-    void find_imped_corr(std::ifstream & input)
+    void find_imped_corr(std::istream & input)
     {
       std::string          line;
 
       std::getline(input, line); //this should be the first line of the block
 
+      std::vector<std::string>  split_line;
       while(test_end(line)) {
-        std::vector<std::string>  split_line;
         this->cleanComment(line);
-        boost::split(split_line, line, boost::algorithm::is_any_of(","),
-            boost::token_compress_off);
+        splitLine(line, split_line);
         int nval = split_line.size();
         int entries = nval-1;
         entries =  entries - entries%2;
@@ -1651,7 +1651,7 @@ class PTI33_parser : public BasePTIParser<_network>
       }
     }
 
-    void find_multi_term(std::ifstream & input)
+    void find_multi_term(std::istream & input)
     {
       std::string          line;
 
@@ -1663,17 +1663,16 @@ class PTI33_parser : public BasePTIParser<_network>
       }
     }
 
-    void find_multi_section(std::ifstream & input)
+    void find_multi_section(std::istream & input)
     {
       std::string          line;
 
       std::getline(input, line); //this should be the first line of the block
 
+      std::vector<std::string>  split_line;
       while(test_end(line)) {
-        std::vector<std::string>  split_line;
         this->cleanComment(line);
-        boost::split(split_line, line, boost::algorithm::is_any_of(","),
-            boost::token_compress_off);
+        splitLine(line, split_line);
         int o_idx1, o_idx2;
         o_idx1 = getBusIndex(split_line[0]);
         o_idx2 = getBusIndex(split_line[1]);
@@ -1741,7 +1740,7 @@ class PTI33_parser : public BasePTIParser<_network>
      * ZONE_I          "I"                       integer
      * ZONE_NAME       "NAME"                    string
      */
-    void find_zone(std::ifstream & input)
+    void find_zone(std::istream & input)
     {
       std::string          line;
 
@@ -1752,7 +1751,7 @@ class PTI33_parser : public BasePTIParser<_network>
       }
     }
 
-    void find_interarea(std::ifstream & input)
+    void find_interarea(std::istream & input)
     {
       std::string          line;
 
@@ -1806,7 +1805,7 @@ class PTI33_parser : public BasePTIParser<_network>
      * type: integer
      * #define OWNER_NAME "OWNER_NAME"
      */
-    void find_owner(std::ifstream & input)
+    void find_owner(std::istream & input)
     {
       std::string          line;
       std::getline(input, line); //this should be the first line of the block
@@ -1830,7 +1829,7 @@ class PTI33_parser : public BasePTIParser<_network>
       }
     }
 
-    void find_facts(std::ifstream & input)
+    void find_facts(std::istream & input)
     {
       std::string          line;
       std::getline(input, line); //this should be the first line of the block
@@ -1840,6 +1839,498 @@ class PTI33_parser : public BasePTIParser<_network>
       }
     }
 
+    /**
+     * Read the body of a RAW file on all processors. Rank 0 scans the file
+     * once to find the records in each section and broadcasts the byte
+     * range of every processor's share. Each processor then reads its share
+     * of a section, routes the records to the processor that owns the
+     * buses they refer to and parses what it receives with the find_*
+     * functions used for serial reads. Records that are not tied to a bus
+     * are parsed on rank 0. The file must be visible to all processors.
+     * The scan is still serial, so rank 0 reads every line of the file
+     * once without parsing it. The PTI23 parser does not use this path.
+     * @param fileName name of RAW file
+     * @param input stream positioned after the case header on rank 0
+     */
+    void readDistributed(const std::string &fileName, std::ifstream &input)
+    {
+      int t_dist = p_timer->createCategory("Parser:readDistributed");
+      p_timer->start(t_dist);
+      MPI_Comm comm = static_cast<MPI_Comm>(p_network->communicator());
+      int me(p_network->communicator().rank());
+      int nprocs(p_network->communicator().size());
+      std::vector<long long> splits(RAW_NSECTIONS*(nprocs+1));
+      if (me == 0) {
+        scanSections(input, nprocs, splits);
+        input.close();
+      }
+      MPI_Bcast(&splits[0],splits.size(),MPI_LONG_LONG,0,comm);
+
+      std::ifstream file(fileName.c_str(), std::ios::in | std::ios::binary);
+      if (!file.is_open()) {
+        char buf[512];
+        sprintf(buf,"Failed to open network configuration file: %s\n\n",
+            fileName.c_str());
+        throw gridpack::Exception(buf);
+      }
+      int section;
+      for (section = 0; section < RAW_NSECTIONS; section++) {
+        parseSection(file, section, splits);
+        if (section == RAW_BUS) exchangeBuses();
+      }
+      file.close();
+      p_timer->stop(t_dist);
+    }
+
+    /**
+     * Scan the sections of a RAW file and divide the records in each
+     * section evenly between processors. A record is a single line, except
+     * for transformers, which take 4 lines (2-winding) or 5 lines
+     * (3-winding). This runs on rank 0 only, before any other processor
+     * starts reading, so it is a serial prefix of the distributed read:
+     * every line of the file passes through rank 0 once. It only finds
+     * line boundaries and record counts, which is much cheaper than
+     * parsing, but it still bounds the speedup of readDistributed for
+     * very large files.
+     * @param input stream positioned after the case header
+     * @param nprocs number of processors
+     * @param splits returns nprocs+1 byte offsets per section. Processor p
+     *        reads bytes [splits[s*(nprocs+1)+p],splits[s*(nprocs+1)+p+1])
+     *        of section s
+     */
+    void scanSections(std::istream &input, int nprocs,
+        std::vector<long long> &splits)
+    {
+      std::string line, field;
+      std::vector<long long> starts;
+      long long pos = input.tellg();
+      bool eof = false;
+      int section, p, i;
+      for (section = 0; section < RAW_NSECTIONS; section++) {
+        starts.clear();
+        long long end = pos;
+        while (!eof) {
+          if (!std::getline(input, line)) {
+            eof = true;
+            break;
+          }
+          long long next = pos + line.length() + 1;
+          if (!test_end(line)) {
+            pos = next;
+            break;
+          }
+          starts.push_back(pos);
+          pos = next;
+          if (section == RAW_TRANSFORMER) {
+            this->cleanComment(line);
+            getField(line, 2, field);
+            int nextra = (getBusIndex(field) != 0) ? 4 : 3;
+            for (i=0; i<nextra; i++) {
+              if (!std::getline(input, line)) {
+                eof = true;
+                break;
+              }
+              pos += line.length() + 1;
+            }
+          }
+          end = pos;
+        }
+        long long *split = &splits[section*(nprocs+1)];
+        long long nrec = starts.size();
+        for (p=0; p<nprocs; p++) {
+          long long irec = (nrec*p)/nprocs;
+          split[p] = (irec < nrec) ? starts[irec] : end;
+        }
+        split[nprocs] = end;
+      }
+    }
+
+    /**
+     * Read this processor's share of a section, route it to the processors
+     * that need it and parse the result
+     * @param file RAW file opened on all processors
+     * @param section section index
+     * @param splits byte offsets returned by scanSections
+     */
+    void parseSection(std::istream &file, int section,
+        const std::vector<long long> &splits)
+    {
+      int me(p_network->communicator().rank());
+      int nprocs(p_network->communicator().size());
+      const long long *split = &splits[section*(nprocs+1)];
+      std::string text;
+      if (section == RAW_BUS) {
+        readRange(file, split[me], split[me+1], text);
+      } else if (section == RAW_LOAD || section == RAW_FIXED_SHUNT ||
+          section == RAW_GENERATOR || section == RAW_BRANCH ||
+          section == RAW_TRANSFORMER || section == RAW_AREA ||
+          section == RAW_MULTI_SECTION || section == RAW_SWITCHED_SHUNT) {
+        readRange(file, split[me], split[me+1], text);
+        routeRecords(section, text);
+      } else if (me == 0) {
+        readRange(file, split[0], split[nprocs], text);
+      }
+      text.append("0 /\n");
+      std::istringstream stream(text);
+      switch (section) {
+        case RAW_BUS: find_buses(stream); break;
+        case RAW_LOAD: find_loads(stream); break;
+        case RAW_FIXED_SHUNT: find_fixed_shunts(stream); break;
+        case RAW_GENERATOR: find_generators(stream); break;
+        case RAW_BRANCH: find_branches(stream); break;
+        case RAW_TRANSFORMER: find_transformer(stream); break;
+        case RAW_AREA: find_area(stream); break;
+        case RAW_2TERM: find_2term(stream); break;
+        case RAW_VSC_LINE: find_vsc_line(stream); break;
+        case RAW_IMPED_CORR: find_imped_corr(stream); break;
+        case RAW_MULTI_TERM: find_multi_term(stream); break;
+        case RAW_MULTI_SECTION: find_multi_section(stream); break;
+        case RAW_ZONE: find_zone(stream); break;
+        case RAW_INTERAREA: find_interarea(stream); break;
+        case RAW_OWNER: find_owner(stream); break;
+        case RAW_FACTS: find_facts(stream); break;
+        case RAW_SWITCHED_SHUNT: find_switched_shunt(stream); break;
+        default: break;
+      }
+    }
+
+    /**
+     * Read a range of bytes from a file
+     * @param file input file
+     * @param begin offset of first byte
+     * @param end offset one past the last byte
+     * @param text returns contents of range, terminated by a newline
+     */
+    void readRange(std::istream &file, long long begin, long long end,
+        std::string &text)
+    {
+      text.clear();
+      if (end <= begin) return;
+      text.resize(end-begin);
+      file.clear();
+      file.seekg(begin);
+      file.read(&text[0], end-begin);
+      text.resize(file.gcount());
+      if (!text.empty() && text[text.length()-1] != '\n') text.push_back('\n');
+    }
+
+    /**
+     * Send each record in text to the processor that should parse it. Bus
+     * attached records go to the owner of the bus, branches and 2-winding
+     * transformers go to a processor determined by the pair of buses so
+     * that parallel elements end up together, everything else goes to rank
+     * 0. Records are received in file order.
+     * @param section section index
+     * @param text records read by this processor. Returns records that
+     *        should be parsed on this processor
+     */
+    void routeRecords(int section, std::string &text)
+    {
+      int nprocs(p_network->communicator().size());
+      std::vector<std::vector<char> > outgoing(nprocs);
+      std::vector<std::vector<int> > requests(nprocs);
+      std::string line, field;
+      size_t len = text.length();
+      size_t pos = 0;
+      while (pos < len) {
+        size_t next = nextLine(text, pos);
+        line.assign(text, pos, next-pos);
+        this->cleanComment(line);
+        int dest = 0;
+        if (section == RAW_AREA) {
+          getField(line, 1, field);
+          dest = busOwner(atoi(field.c_str()));
+        } else if (section == RAW_BRANCH || section == RAW_MULTI_SECTION) {
+          getField(line, 0, field);
+          int o_idx1 = getBusIndex(field);
+          getField(line, 1, field);
+          int o_idx2 = getBusIndex(field);
+          dest = pairOwner(o_idx1, o_idx2);
+        } else if (section == RAW_TRANSFORMER) {
+          getField(line, 0, field);
+          int o_idx1 = getBusIndex(field);
+          getField(line, 1, field);
+          int o_idx2 = getBusIndex(field);
+          getField(line, 2, field);
+          int nextra = 3;
+          if (getBusIndex(field) != 0) {
+            // 3-winding transformers create a new bus so they are all
+            // handled on rank 0. Ask the owner of the first bus to send its
+            // area and owner to rank 0
+            nextra = 4;
+            dest = 0;
+            requests[busOwner(o_idx1)].push_back(o_idx1);
+          } else {
+            dest = pairOwner(o_idx1, o_idx2);
+          }
+          int i;
+          for (i=0; i<nextra && next < len; i++) {
+            next = nextLine(text, next);
+          }
+        } else {
+          getField(line, 0, field);
+          dest = busOwner(getBusIndex(field));
+        }
+        outgoing[dest].insert(outgoing[dest].end(),text.begin()+pos,
+            text.begin()+next);
+        pos = next;
+      }
+      std::vector<char> incoming;
+      exchange(outgoing, incoming, MPI_CHAR);
+      text.assign(incoming.begin(), incoming.end());
+      if (section == RAW_TRANSFORMER) sendBusInfo(requests);
+    }
+
+    /**
+     * Return area and owner of buses requested by other processors to rank
+     * 0. Used by 3-winding transformers whose first bus is not on rank 0.
+     * @param requests bus indices to request from each processor
+     */
+    void sendBusInfo(const std::vector<std::vector<int> > &requests)
+    {
+      MPI_Comm comm = static_cast<MPI_Comm>(p_network->communicator());
+      int me(p_network->communicator().rank());
+      int nprocs(p_network->communicator().size());
+      std::vector<int> buses;
+      exchange(requests, buses, MPI_INT);
+      std::vector<int> info;
+      int i, p;
+      for (i=0; i<buses.size(); i++) {
+#ifdef OLD_MAP
+        std::map<int, int>::iterator it;
+#else
+        boost::unordered_map<int, int>::iterator it;
+#endif
+        it = p_busMap.find(buses[i]);
+        if (it == p_busMap.end()) continue;
+        int area = 0;
+        int owner = 0;
+        p_busData[it->second]->getValue(BUS_AREA,&area);
+        p_busData[it->second]->getValue(BUS_OWNER,&owner);
+        info.push_back(buses[i]);
+        info.push_back(area);
+        info.push_back(owner);
+      }
+      int nsend = info.size();
+      std::vector<int> counts(nprocs);
+      MPI_Gather(&nsend,1,MPI_INT,&counts[0],1,MPI_INT,0,comm);
+      std::vector<int> offsets(nprocs,0);
+      int total = 0;
+      for (p=0; p<nprocs; p++) {
+        offsets[p] = total;
+        total += counts[p];
+      }
+      std::vector<int> all(total+1);
+      info.push_back(0);
+      MPI_Gatherv(&info[0],nsend,MPI_INT,&all[0],&counts[0],&offsets[0],
+          MPI_INT,0,comm);
+      if (me == 0) {
+        for (i=0; i<total; i += 3) {
+          p_remoteBusInfo.insert(std::pair<int,std::pair<int,int> >(all[i],
+                std::pair<int,int>(all[i+1],all[i+2])));
+        }
+      }
+    }
+
+    /**
+     * Share bus indices and names between processors after the bus section
+     * has been read, so that every processor can resolve bus names and
+     * knows which processor owns each bus
+     */
+    void exchangeBuses(void)
+    {
+      MPI_Comm comm = static_cast<MPI_Comm>(p_network->communicator());
+      int nprocs(p_network->communicator().size());
+      std::vector<int> numbers;
+      std::vector<char> names;
+      int i, j, p;
+      for (i=0; i<p_busData.size(); i++) {
+        int idx;
+        std::string name;
+        p_busData[i]->getValue(BUS_NUMBER,&idx);
+        p_busData[i]->getValue(BUS_NAME,&name);
+        numbers.push_back(idx);
+        names.insert(names.end(),name.begin(),name.end());
+        names.push_back('\0');
+      }
+      std::vector<int> nbus, nchar;
+      std::vector<int> all_numbers;
+      std::vector<char> all_names;
+      allGather(numbers, all_numbers, nbus, MPI_INT);
+      allGather(names, all_names, nchar, MPI_CHAR);
+      p_nameMap.clear();
+      p_busOwner.clear();
+      int ibus = 0;
+      int ichar = 0;
+      for (p=0; p<nprocs; p++) {
+        for (j=0; j<nbus[p]; j++) {
+          int idx = abs(all_numbers[ibus]);
+          std::string name(&all_names[ichar]);
+          p_busOwner.insert(std::pair<int,int>(idx,p));
+          p_nameMap.insert(std::pair<std::string,int>(name,idx));
+          ichar += name.length()+1;
+          ibus++;
+        }
+      }
+      int maxIndex = p_maxBusIndex;
+      MPI_Allreduce(&maxIndex,&p_maxBusIndex,1,MPI_INT,MPI_MAX,comm);
+    }
+
+    /**
+     * Processor that owns a bus. Unknown buses are assigned to rank 0.
+     * @param idx original bus index
+     * @return owning processor
+     */
+    int busOwner(int idx) const
+    {
+#ifdef OLD_MAP
+      std::map<int,int>::const_iterator it;
+#else
+      boost::unordered_map<int,int>::const_iterator it;
+#endif
+      it = p_busOwner.find(idx);
+      if (it != p_busOwner.end()) return it->second;
+      return 0;
+    }
+
+    /**
+     * Processor that parses elements between two buses. The result does
+     * not depend on the order of the buses.
+     * @param idx1, idx2 original bus indices
+     * @return processor
+     */
+    int pairOwner(int idx1, int idx2) const
+    {
+      int nprocs(p_network->communicator().size());
+      unsigned long lo = static_cast<unsigned long>(std::min(idx1,idx2));
+      unsigned long hi = static_cast<unsigned long>(std::max(idx1,idx2));
+      unsigned long hash = (lo*2654435761UL)^(hi+0x9e3779b9UL+(lo<<6));
+      return static_cast<int>(hash%static_cast<unsigned long>(nprocs));
+    }
+
+    /**
+     * Offset of the line following the one that starts at pos
+     */
+    size_t nextLine(const std::string &text, size_t pos) const
+    {
+      size_t eol = text.find('\n',pos);
+      if (eol == std::string::npos) return text.length();
+      return eol+1;
+    }
+
+    /**
+     * Copy a comma separated field from a line
+     * @param line line from RAW file
+     * @param idx index of field
+     * @param field returns field. Empty if line has fewer fields
+     */
+    void getField(const std::string &line, int idx, std::string &field) const
+    {
+      size_t start = 0;
+      int i;
+      for (i=0; i<idx; i++) {
+        start = line.find(',',start);
+        if (start == std::string::npos) {
+          field.clear();
+          return;
+        }
+        start++;
+      }
+      size_t end = line.find(',',start);
+      if (end == std::string::npos) end = line.length();
+      field.assign(line, start, end-start);
+    }
+
+    /**
+     * Split a line into comma separated fields. Gives the same fields as
+     * boost::split with token_compress_off, but the fields are assigned in
+     * place so a vector that is reused for every record of a section does
+     * not allocate new strings once it has seen the longest record
+     * @param line line from RAW file
+     * @param fields returns fields of line
+     */
+    void splitLine(const std::string &line,
+        std::vector<std::string> &fields) const
+    {
+      size_t nfields = std::count(line.begin(), line.end(), ',') + 1;
+      if (fields.size() != nfields) fields.resize(nfields);
+      size_t start = 0;
+      size_t i;
+      for (i=0; i<nfields; i++) {
+        size_t end = line.find(',',start);
+        if (end == std::string::npos) end = line.length();
+        fields[i].assign(line, start, end-start);
+        start = end+1;
+      }
+    }
+
+    /**
+     * Send a list of values to each processor and receive the values sent
+     * to this processor, ordered by source processor
+     * @param outgoing values to send to each processor
+     * @param incoming returns values received
+     * @param type MPI type of values
+     */
+    template <typename T>
+    void exchange(const std::vector<std::vector<T> > &outgoing,
+        std::vector<T> &incoming, MPI_Datatype type)
+    {
+      MPI_Comm comm = static_cast<MPI_Comm>(p_network->communicator());
+      int nprocs(p_network->communicator().size());
+      std::vector<int> scount(nprocs), sdispl(nprocs);
+      std::vector<int> rcount(nprocs), rdispl(nprocs);
+      std::vector<T> sbuf;
+      int p;
+      for (p=0; p<nprocs; p++) {
+        scount[p] = outgoing[p].size();
+        sdispl[p] = sbuf.size();
+        sbuf.insert(sbuf.end(),outgoing[p].begin(),outgoing[p].end());
+      }
+      MPI_Alltoall(&scount[0],1,MPI_INT,&rcount[0],1,MPI_INT,comm);
+      int total = 0;
+      for (p=0; p<nprocs; p++) {
+        rdispl[p] = total;
+        total += rcount[p];
+      }
+      // pad buffers so that they can always be addressed
+      sbuf.push_back(T());
+      incoming.resize(total+1);
+      MPI_Alltoallv(&sbuf[0],&scount[0],&sdispl[0],type,&incoming[0],
+          &rcount[0],&rdispl[0],type,comm);
+      incoming.resize(total);
+    }
+
+    /**
+     * Gather a list of values from all processors, ordered by processor
+     * @param local values on this processor
+     * @param global returns values from all processors
+     * @param counts returns number of values from each processor
+     * @param type MPI type of values
+     */
+    template <typename T>
+    void allGather(const std::vector<T> &local, std::vector<T> &global,
+        std::vector<int> &counts, MPI_Datatype type)
+    {
+      MPI_Comm comm = static_cast<MPI_Comm>(p_network->communicator());
+      int nprocs(p_network->communicator().size());
+      int nlocal = local.size();
+      counts.resize(nprocs);
+      MPI_Allgather(&nlocal,1,MPI_INT,&counts[0],1,MPI_INT,comm);
+      std::vector<int> offsets(nprocs);
+      int total = 0;
+      int p;
+      for (p=0; p<nprocs; p++) {
+        offsets[p] = total;
+        total += counts[p];
+      }
+      std::vector<T> sbuf(local);
+      sbuf.push_back(T());
+      global.resize(total+1);
+      MPI_Allgatherv(&sbuf[0],nlocal,type,&global[0],&counts[0],&offsets[0],
+          type,comm);
+      global.resize(total);
+    }
+
     // Distribute data uniformly on processors
     void brdcst_data(void)
     {
@@ -2174,6 +2665,22 @@ class PTI33_parser : public BasePTIParser<_network>
     boost::unordered_map<std::pair<int, int>, int> p_branchMap;
 #endif
 
+    // Map of PTI indices to the processor that read the bus
+#ifdef OLD_MAP
+    std::map<int,int> p_busOwner;
+#else
+    boost::unordered_map<int, int> p_busOwner;
+#endif
+    // Area and owner of buses on other processors that are referenced by
+    // 3-winding transformers
+    std::map<int,std::pair<int,int> > p_remoteBusInfo;
+
+    // Sections of a RAW file in the order in which they appear
+    enum RawSection {RAW_BUS, RAW_LOAD, RAW_FIXED_SHUNT, RAW_GENERATOR,
+      RAW_BRANCH, RAW_TRANSFORMER, RAW_AREA, RAW_2TERM, RAW_VSC_LINE,
+      RAW_IMPED_CORR, RAW_MULTI_TERM, RAW_MULTI_SECTION, RAW_ZONE,
+      RAW_INTERAREA, RAW_OWNER, RAW_FACTS, RAW_SWITCHED_SHUNT, RAW_NSECTIONS};
+
     // Global variables that apply to whole network
     int p_case_id;
     int p_maxBusIndex;
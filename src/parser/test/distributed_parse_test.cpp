@@ -0,0 +1,246 @@
+/*
+ *     Copyright (c) 2013 Battelle Memorial Institute
+ *     Licensed under modified BSD License. A copy of this license can be found
+ *     in the LICENSE file in the top level directory of this distribution.
+ */
+// -------------------------------------------------------------
+/**
+ * @file   distributed_parse_test.cpp
+ *
+ * @brief  Check that a PSS/E v33 file read on all processors gives the
+ *         same bus and branch data as the same file read on a single
+ *         processor. The file is given on the command line. The ctest
+ *         runs use 118_PTIv33.raw and three_winding_PTIv33.raw, which has
+ *         3-winding transformers whose first bus is read by a processor
+ *         other than rank 0
+ *
+ */
+
+// -------------------------------------------------------------
+// -------------------------------------------------------------
+// Battelle Memorial Institute
+// Pacific Northwest Laboratory
+// -------------------------------------------------------------
+
+#include <iostream>
+#include <algorithm>
+#include <string>
+#include <vector>
+#include <cstdio>
+#include <ga.h>
+#include "gridpack/parallel/communicator.hpp"
+#include "gridpack/component/base_component.hpp"
+#include "gridpack/network/base_network.hpp"
+#include "gridpack/parser/PTI33_parser.hpp"
+
+class TestBus
+  : public gridpack::component::BaseBusComponent {
+  public:
+
+  TestBus(void) {
+  }
+
+  ~TestBus(void) {
+  }
+};
+
+class TestBranch
+  : public gridpack::component::BaseBranchComponent {
+  public:
+
+  TestBranch(void) {
+  }
+
+  ~TestBranch(void) {
+  }
+};
+
+typedef gridpack::network::BaseNetwork<TestBus, TestBranch> TestNetwork;
+
+// Fields compared on buses. Indexed fields are compared for every
+// element counted by the number field that precedes them
+static const char *busFields[] = {BUS_NUMBER, BUS_NAME, BUS_BASEKV,
+  BUS_TYPE, BUS_AREA, BUS_ZONE, BUS_OWNER, BUS_VOLTAGE_MAG, BUS_VOLTAGE_ANG,
+  BUS_SHUNT_GL, BUS_SHUNT_BL};
+static const char *loadFields[] = {LOAD_ID, LOAD_STATUS, LOAD_PL,
+  LOAD_QL};
+static const char *generatorFields[] = {GENERATOR_ID, GENERATOR_PG,
+  GENERATOR_QG, GENERATOR_QMAX, GENERATOR_QMIN, GENERATOR_VS,
+  GENERATOR_STAT};
+static const char *shuntFields[] = {SHUNT_ID, SHUNT_STATUS, BUS_SHUNT_GL,
+  BUS_SHUNT_BL};
+static const char *switchedShuntFields[] = {SHUNT_BUSNUMBER, SHUNT_MODSW,
+  SHUNT_BINIT};
+static const char *branchFields[] = {BRANCH_FROMBUS, BRANCH_TOBUS};
+static const char *elementFields[] = {BRANCH_CKT, BRANCH_R, BRANCH_X,
+  BRANCH_B, BRANCH_TAP, BRANCH_SHIFT, BRANCH_RATING_A, BRANCH_STATUS};
+
+#define NFIELDS(list) (sizeof(list)/sizeof(list[0]))
+
+// Append a value of any type to a text record
+void appendValue(gridpack::component::DataCollection &data,
+    const char *name, int idx, std::string &record)
+{
+  char buf[256];
+  int ival;
+  double rval;
+  bool bval;
+  std::string sval;
+  bool indexed = (idx >= 0);
+  if (indexed ? data.getValue(name,&ival,idx) : data.getValue(name,&ival)) {
+    sprintf(buf," %s=%d",name,ival);
+  } else if (indexed ? data.getValue(name,&rval,idx) :
+      data.getValue(name,&rval)) {
+    sprintf(buf," %s=%.12g",name,rval);
+  } else if (indexed ? data.getValue(name,&bval,idx) :
+      data.getValue(name,&bval)) {
+    sprintf(buf," %s=%d",name,static_cast<int>(bval));
+  } else if (indexed ? data.getValue(name,&sval,idx) :
+      data.getValue(name,&sval)) {
+    snprintf(buf,sizeof(buf)," %s=%s",name,sval.c_str());
+  } else {
+    sprintf(buf," %s=none",name);
+  }
+  record.append(buf);
+}
+
+// Append a list of fields to a record. If count is not NULL, the fields
+// are indexed and appended for each element counted by count
+void appendFields(gridpack::component::DataCollection &data,
+    const char *count, const char **fields, int nfields,
+    std::string &record)
+{
+  int i, j;
+  if (count == NULL) {
+    for (i=0; i<nfields; i++) appendValue(data,fields[i],-1,record);
+    return;
+  }
+  int nelem = 0;
+  data.getValue(count,&nelem);
+  appendValue(data,count,-1,record);
+  for (j=0; j<nelem; j++) {
+    for (i=0; i<nfields; i++) appendValue(data,fields[i],j,record);
+  }
+}
+
+// Describe every bus and branch on this processor as a line of text
+void describeNetwork(TestNetwork &network, std::vector<std::string> &records)
+{
+  int i;
+  records.clear();
+  for (i=0; i<network.numBuses(); i++) {
+    gridpack::component::DataCollection &data = *network.getBusData(i);
+    std::string record("bus");
+    appendFields(data,NULL,busFields,NFIELDS(busFields),record);
+    appendFields(data,LOAD_NUMBER,loadFields,NFIELDS(loadFields),record);
+    appendFields(data,GENERATOR_NUMBER,generatorFields,
+        NFIELDS(generatorFields),record);
+    appendFields(data,SHUNT_NUMBER,shuntFields,NFIELDS(shuntFields),record);
+    appendFields(data,NULL,switchedShuntFields,NFIELDS(switchedShuntFields),
+        record);
+    records.push_back(record);
+  }
+  for (i=0; i<network.numBranches(); i++) {
+    gridpack::component::DataCollection &data = *network.getBranchData(i);
+    std::string record("branch");
+    appendFields(data,NULL,branchFields,NFIELDS(branchFields),record);
+    appendFields(data,BRANCH_NUM_ELEMENTS,elementFields,
+        NFIELDS(elementFields),record);
+    records.push_back(record);
+  }
+}
+
+// -------------------------------------------------------------
+//  Main Program
+// -------------------------------------------------------------
+int
+main(int argc, char **argv)
+{
+  gridpack::parallel::Environment env(argc, argv);
+  GA_Initialize();
+  int rchk = 0;
+  // Create an artificial scope so that all objects call their destructors
+  // before GA_Terminate is called
+  if (1) {
+    gridpack::parallel::Communicator world;
+    MPI_Comm comm = static_cast<MPI_Comm>(world);
+    int me = world.rank();
+    int nprocs = world.size();
+    std::string filename("118_PTIv33.raw");
+    if (argc > 1) filename = argv[1];
+
+    // Parse file on all processors
+    boost::shared_ptr<TestNetwork> network(new TestNetwork(world));
+    gridpack::parser::PTI33_parser<TestNetwork> parser(network);
+    parser.parse(filename.c_str());
+    std::vector<std::string> records;
+    describeNetwork(*network, records);
+
+    // Parse the same file on each processor by itself
+    gridpack::parallel::Communicator self = world.self();
+    boost::shared_ptr<TestNetwork> serialNetwork(new TestNetwork(self));
+    gridpack::parser::PTI33_parser<TestNetwork> serialParser(serialNetwork);
+    serialParser.parse(filename.c_str());
+    std::vector<std::string> serialRecords;
+    describeNetwork(*serialNetwork, serialRecords);
+
+    // Gather the records of the distributed parse on process 0
+    std::vector<char> text;
+    int i, p;
+    for (i=0; i<records.size(); i++) {
+      text.insert(text.end(),records[i].begin(),records[i].end());
+      text.push_back('\n');
+    }
+    int nsend = text.size();
+    std::vector<int> counts(nprocs), offsets(nprocs);
+    MPI_Gather(&nsend,1,MPI_INT,&counts[0],1,MPI_INT,0,comm);
+    int total = 0;
+    for (p=0; p<nprocs; p++) {
+      offsets[p] = total;
+      total += counts[p];
+    }
+    std::vector<char> all(total+1);
+    text.push_back('\0');
+    MPI_Gatherv(&text[0],nsend,MPI_CHAR,&all[0],&counts[0],&offsets[0],
+        MPI_CHAR,0,comm);
+
+    if (me == 0) {
+      records.clear();
+      size_t pos = 0;
+      while (pos < total) {
+        size_t eol = pos;
+        while (all[eol] != '\n') eol++;
+        records.push_back(std::string(&all[pos],eol-pos));
+        pos = eol+1;
+      }
+      std::sort(records.begin(),records.end());
+      std::sort(serialRecords.begin(),serialRecords.end());
+      if (records.size() != serialRecords.size()) {
+        printf("\nDistributed parse found %d buses and branches, serial"
+            " parse found %d\n",static_cast<int>(records.size()),
+            static_cast<int>(serialRecords.size()));
+        rchk = 1;
+      } else {
+        for (i=0; i<records.size(); i++) {
+          if (records[i] != serialRecords[i]) {
+            printf("\nDistributed: %s\nSerial:      %s\n",
+                records[i].c_str(),serialRecords[i].c_str());
+            rchk = 1;
+          }
+        }
+      }
+      if (rchk == 0) {
+        printf("\nDistributed parse of %s matches serial parse"
+            " (%d buses and branches)\n",filename.c_str(),
+            static_cast<int>(records.size()));
+      } else {
+        printf("\nError: distributed parse of %s does not match serial"
+            " parse\n",filename.c_str());
+      }
+    }
+    MPI_Bcast(&rchk,1,MPI_INT,0,comm);
+  }
+
+  GA_Terminate();
+  return rchk;
+}
@@ -19,6 +19,7 @@
 // Last Change: 2013-05-03 12:23:12 d3g096
 // -------------------------------------------------------------
 
+#include <algorithm>
 #include <iostream>
 #include <iterator>
 #include <list>
@@ -47,7 +48,8 @@ const AdjacencyList::Index AdjacencyList::bogus(-1);
 AdjacencyList::AdjacencyList(const parallel::Communicator& comm)
   : parallel::Distributed(comm),
     utility::Uncopyable(),
-    p_global_nodes(), p_original_nodes(), p_edges(), p_adjacency()
+    p_global_nodes(), p_original_nodes(), p_node_weights(),
+    p_weight_count(1), p_edges(), p_adjacency()
 {
   // empty
 }
@@ -56,10 +58,12 @@ AdjacencyList::AdjacencyList(const parallel::Communicator& comm,
                              const int& local_nodes, const int& local_edges)
   : parallel::Distributed(comm),
     utility::Uncopyable(),
-    p_global_nodes(), p_original_nodes(), p_edges(), p_adjacency()
+    p_global_nodes(), p_original_nodes(), p_node_weights(),
+    p_weight_count(1), p_edges(), p_adjacency()
 {
   p_global_nodes.reserve(local_nodes);
   p_original_nodes.reserve(local_nodes);
+  p_node_weights.reserve(local_nodes);
   p_edges.reserve(local_edges);
   p_adjacency.reserve(local_nodes);
 }
@@ -100,12 +104,34 @@ AdjacencyList::edge(const int& local_index, Index& node1, Index& node2) const
   node2 = p_edges[local_index].global_conn.second;
 }
 
+// -------------------------------------------------------------
+// AdjacencyList::node_weights
+// -------------------------------------------------------------
+void
+AdjacencyList::node_weights(const int& local_index, WeightVector& weights) const
+{
+  BOOST_ASSERT(local_index < this->nodes());
+  const WeightVector& w(p_node_weights[local_index]);
+  weights.assign(p_weight_count, 1);
+  std::copy(w.begin(), w.begin() + std::min(w.size(), p_weight_count),
+            weights.begin());
+}
+
 // -------------------------------------------------------------
 // AdjacencyList::ready
 // -------------------------------------------------------------
 void
 AdjacencyList::ready(void)
 {
+  // all processors need to agree on the number of node weights
+  size_t nweight(1);
+  for (std::vector<WeightVector>::const_iterator w = p_node_weights.begin();
+       w != p_node_weights.end(); ++w) {
+    nweight = std::max(nweight, w->size());
+  }
+  boost::mpi::all_reduce(this->communicator(), nweight, p_weight_count,
+                         boost::mpi::maximum<size_t>());
+
 #if 1
   int grp = this->communicator().getGroup();
   int me = GA_Pgroup_nodeid(grp);
@@ -64,6 +64,9 @@ public:
   /// A thing to hold Indexes
   typedef std::vector<Index> IndexVector;
 
+  /// A thing to hold node weights (one for each partitioning constraint)
+  typedef std::vector<int> WeightVector;
+
   /// The index that means unconnected
   static const Index bogus;
 
@@ -82,6 +85,16 @@ public:
   {
     p_global_nodes.push_back(global_index);
     p_original_nodes.push_back(original_index);
+    p_node_weights.push_back(WeightVector());
+  }
+
+  /// Add the global index, original index, and weights of a local node
+  void add_node(const Index& global_index, const Index& original_index,
+                const WeightVector& weights)
+  {
+    p_global_nodes.push_back(global_index);
+    p_original_nodes.push_back(original_index);
+    p_node_weights.push_back(weights);
   }
   
   /// Add the global index of a local edge and what it connects using the
@@ -134,6 +147,19 @@ public:
   /// Get the number of neighbors of the specified (local) node
   size_t node_neighbors(const int& local_index) const;
 
+  /// Get the number of weights per node (the same on all processors, after ready())
+  size_t node_weight_count(void) const
+  {
+    return p_weight_count;
+  }
+
+  /// Get the weights of the specified (local) node
+  /**
+   * Nodes added without weights, or with fewer weights than
+   * node_weight_count(), have a weight of 1 for each missing entry.
+   */
+  void node_weights(const int& local_index, WeightVector& weights) const;
+
 protected:
 
   typedef std::pair<Index, Index> p_NodeConnect;
@@ -155,6 +181,12 @@ protected:
 
   /// The list of original indices for local nodes
   IndexVector p_original_nodes;
+
+  /// The list of weights for local nodes
+  std::vector<WeightVector> p_node_weights;
+
+  /// The number of weights per node on all processors
+  size_t p_weight_count;
   
   /// The list of local edges
   p_EdgeVector p_edges;
@@ -38,6 +38,7 @@ public:
   typedef GraphPartitionerImplementation::Index Index;
   typedef GraphPartitionerImplementation::IndexVector IndexVector;
   typedef GraphPartitionerImplementation::MultiIndexVector MultiIndexVector;
+  typedef GraphPartitionerImplementation::WeightVector WeightVector;
 
   /// Default constructor.
   GraphPartitioner(const parallel::Communicator& comm);
@@ -54,6 +55,18 @@ public:
   {
     p_impl->add_node(global_index, original_index);
   }
+
+  /// Add the global index, original index, and weights of a local node
+  /**
+   * Weights are used by the partitioner to balance the load on each
+   * processor. If more than one weight is given, the partitioner
+   * tries to balance each one (multi-constraint partitioning).
+   */
+  void add_node(const Index& global_index, const Index& original_index,
+                const WeightVector& weights)
+  {
+    p_impl->add_node(global_index, original_index, weights);
+  }
   
   /// Add the global index of a local edge and what it connects using the original
   /// indices of the buses at either end of the node 
@@ -100,6 +113,12 @@ public:
     p_impl->partition();
   }
 
+  /// Repartition a graph that is already distributed, starting from the current distribution
+  void repartition(const double& itr)
+  {
+    p_impl->repartition(itr);
+  }
+
   /// Get the node destinations
   void node_destinations(IndexVector& dest) const
   {
@@ -124,6 +143,12 @@ public:
     p_impl->ghost_edge_destinations(dest);
   }
 
+  /// Get the load imbalance achieved by partition(), for each node weight
+  void imbalance(std::vector<double>& imbal) const
+  {
+    p_impl->imbalance(imbal);
+  }
+
 protected:
 
   /// The actual implementation
@@ -46,7 +46,9 @@ GraphPartitionerImplementation::GraphPartitionerImplementation(const parallel::C
   : parallel::Distributed(comm), utility::Uncopyable(),
     p_adjacency_list(comm), 
     p_node_destinations(),
-    p_edge_destinations()
+    p_edge_destinations(),
+    p_imbalance(),
+    p_adaptive(false), p_itr(1000.0)
 {
   // empty
 }
@@ -57,7 +59,9 @@ GraphPartitionerImplementation::GraphPartitionerImplementation(const parallel::C
   : parallel::Distributed(comm), utility::Uncopyable(),
     p_adjacency_list(comm, local_nodes, local_edges), 
     p_node_destinations(local_nodes),
-    p_edge_destinations(local_edges)
+    p_edge_destinations(local_edges),
+    p_imbalance(),
+    p_adaptive(false), p_itr(1000.0)
 {
   // empty
 }
@@ -112,6 +116,57 @@ GraphPartitionerImplementation::ghost_edge_destinations(GraphPartitionerImplemen
             std::back_inserter(dest));
 }
 
+// -------------------------------------------------------------
+// GraphPartitionerImplementation::repartition
+// -------------------------------------------------------------
+void
+GraphPartitionerImplementation::repartition(const double& itr)
+{
+  p_adaptive = true;
+  p_itr = itr;
+  try {
+    this->partition();
+  } catch (...) {
+    p_adaptive = false;
+    throw;
+  }
+  p_adaptive = false;
+}
+
+// -------------------------------------------------------------
+// GraphPartitionerImplementation::p_evaluate_imbalance
+// -------------------------------------------------------------
+void
+GraphPartitionerImplementation::p_evaluate_imbalance(void)
+{
+  int nparts(this->processor_size());
+  int ncon(p_adjacency_list.node_weight_count());
+  int locnodes(p_adjacency_list.nodes());
+
+  std::vector<double> lsum(nparts*ncon, 0.0), gsum(nparts*ncon, 0.0);
+  WeightVector w;
+  for (int n = 0; n < locnodes; ++n) {
+    p_adjacency_list.node_weights(n, w);
+    for (int c = 0; c < ncon; ++c) {
+      lsum[p_node_destinations[n]*ncon + c] += w[c];
+    }
+  }
+  boost::mpi::all_reduce(communicator(), &lsum[0], lsum.size(), 
+                         &gsum[0], std::plus<double>());
+
+  p_imbalance.assign(ncon, 1.0);
+  for (int c = 0; c < ncon; ++c) {
+    double total(0.0), biggest(0.0);
+    for (int p = 0; p < nparts; ++p) {
+      total += gsum[p*ncon + c];
+      biggest = std::max(biggest, gsum[p*ncon + c]);
+    }
+    if (total > 0.0) {
+      p_imbalance[c] = biggest*static_cast<double>(nparts)/total;
+    }
+  }
+}
+
 // -------------------------------------------------------------
 // GraphPartitionerImplementation::partition
 // -------------------------------------------------------------
@@ -173,6 +228,8 @@ GraphPartitionerImplementation::partition(void)
 
   this->p_partition();          // fills p_node_destinations
 
+  this->p_evaluate_imbalance();
+
   if (timer != NULL) timer->stop(t_part);
 
   // make two GAs, one that holds the node source and another that
@@ -43,6 +43,9 @@ public:
   /// A vector of IndexVectors
   typedef std::vector<IndexVector> MultiIndexVector;
 
+  /// Node weights, one for each partitioning constraint
+  typedef AdjacencyList::WeightVector WeightVector;
+
   /// Default constructor.
   GraphPartitionerImplementation(const parallel::Communicator& comm);
 
@@ -58,6 +61,13 @@ public:
   {
     p_adjacency_list.add_node(global_index, original_index);
   }
+
+  /// Add the global index, original index, and weights of a local node
+  void add_node(const Index& global_index, const Index& original_index,
+                const WeightVector& weights)
+  {
+    p_adjacency_list.add_node(global_index, original_index, weights);
+  }
   
   /// Add the global index of a local edge and what it connects using the
   /// original indices of buses at either end
@@ -101,6 +111,18 @@ public:
   /// Partition the graph
   void partition(void);
 
+  /// Repartition a graph that is already distributed
+  /**
+   * The current distribution of nodes is used as the starting point
+   * and nodes are only moved if that improves the balance enough to
+   * pay for moving them.
+   *
+   * @param itr ratio of the cost of communication during computation
+   * to the cost of moving a node (larger values favor balance over
+   * keeping nodes in place)
+   */
+  void repartition(const double& itr);
+
   /// Get the node destinations
   void node_destinations(IndexVector& dest) const;
 
@@ -113,6 +135,16 @@ public:
   /// Get the destinations of ghosted edges
   void ghost_edge_destinations(IndexVector& dest) const;
 
+  /// Get the load imbalance achieved by partition(), for each node weight
+  /**
+   * The imbalance is the largest total node weight assigned to any
+   * processor divided by the average, so 1.0 is perfect balance.
+   */
+  void imbalance(std::vector<double>& imbal) const
+  {
+    imbal = p_imbalance;
+  }
+
 protected:
 
   /// Adjacency list builder
@@ -130,6 +162,18 @@ protected:
   /// A list of processors where local edges should go
   IndexVector p_ghost_edge_destinations;
 
+  /// The load imbalance for each node weight
+  std::vector<double> p_imbalance;
+
+  /// Is the current partition being adapted (see repartition())?
+  bool p_adaptive;
+
+  /// Ratio of communication to redistribution cost when adapting
+  double p_itr;
+
+  /// Evaluate the load imbalance of p_node_destinations
+  void p_evaluate_imbalance(void);
+
   /// Partition the graph (specialized)
   virtual void p_partition(void) = 0;
 
@@ -83,7 +83,11 @@ ParMETISGraphPartitionerImpl::p_partition(void)
 
   ParMETISGraphWrapper wrap(p_adjacency_list);
 
-  wrap.get_csr_local(vtxdist, xadj, adjncy);
+  // An existing partition can only be adapted if every processor has
+  // some of the graph; otherwise, start over
+  bool adaptive(p_adaptive && wrap.current_distribution_ok());
+
+  wrap.get_csr_local(vtxdist, xadj, adjncy, adaptive);
 
   int nnodes(vtxdist[me+1] - vtxdist[me]);
 
@@ -116,13 +120,17 @@ ParMETISGraphPartitionerImpl::p_partition(void)
 
   int status;
 
+  // vertex weights come from the adjacency list (all 1 if none were
+  // given); there may be more than one per vertex (multi-constraint)
   idx_t ncon(1);
+  std::vector<idx_t> vwgt;
+  wrap.get_weights_local(vtxdist, ncon, vwgt);
+
   idx_t wgtflag(3), numflag(0);
   idx_t nparts(this->processor_size());
-  std::vector<idx_t> vwgt(nnodes, 1);
   std::vector<idx_t> adjwgt(adjncy.size(), 2);
   std::vector<real_t> tpwgts(nparts*ncon, 1.0/static_cast<real_t>(nparts));
-  real_t ubvec(1.05);
+  std::vector<real_t> ubvec(ncon, 1.05);
   std::vector<idx_t> options(3);
   options[0] = 1;
   options[1] = 127;
@@ -130,21 +138,44 @@ ParMETISGraphPartitionerImpl::p_partition(void)
   MPI_Comm comm(this->communicator());
 
   idx_t edgecut;
-  std::vector<idx_t> part(nnodes);
-  status = ParMETIS_V3_PartKway(&vtxdist[0], 
-                                &xadj[0], 
-                                &adjncy[0],
-                                &vwgt[0],
-                                &adjwgt[0],
-                                &wgtflag,
-                                &numflag,
-                                &ncon,
-                                &nparts,
-                                &tpwgts[0],
-                                &ubvec,
-                                &options[0],
-                                &edgecut, &part[0],
-                                &comm);
+  std::vector<idx_t> part(nnodes, me);
+  if (adaptive) {
+    // the cost of moving a node is taken to be the same for all nodes
+    std::vector<idx_t> vsize(nnodes, 1);
+    real_t itr(p_itr);
+    options.push_back(PARMETIS_PSR_COUPLED);
+    status = ParMETIS_V3_AdaptiveRepart(&vtxdist[0], 
+                                        &xadj[0], 
+                                        &adjncy[0],
+                                        &vwgt[0],
+                                        &vsize[0],
+                                        &adjwgt[0],
+                                        &wgtflag,
+                                        &numflag,
+                                        &ncon,
+                                        &nparts,
+                                        &tpwgts[0],
+                                        &ubvec[0],
+                                        &itr,
+                                        &options[0],
+                                        &edgecut, &part[0],
+                                        &comm);
+  } else {
+    status = ParMETIS_V3_PartKway(&vtxdist[0], 
+                                  &xadj[0], 
+                                  &adjncy[0],
+                                  &vwgt[0],
+                                  &adjwgt[0],
+                                  &wgtflag,
+                                  &numflag,
+                                  &ncon,
+                                  &nparts,
+                                  &tpwgts[0],
+                                  &ubvec[0],
+                                  &options[0],
+                                  &edgecut, &part[0],
+                                  &comm);
+  }
   if (status != 0) {
     // FIXME: throw an exception
   }
@@ -45,7 +45,7 @@ ParMETISGraphWrapper::ParMETISGraphWrapper(const AdjacencyList& alist)
   : parallel::Distributed(alist.communicator()),
     utility::Uncopyable(),
     p_adjacency(alist), 
-    p_global_nodes(0), p_global_edges(0),
+    p_global_nodes(0), p_node_dist(), p_global_edges(0),
     p_node_data(), p_local_node_id(), 
     p_node_lo(-1), p_node_hi(-1), 
     p_xadj_gbl(), p_adjncy_gbl()
@@ -228,6 +228,7 @@ ParMETISGraphWrapper::p_initialize(void)
     
     p_node_lo = oldnodedist[this->processor_rank()];
     p_node_hi = oldnodedist[this->processor_rank() + 1] - 1;
+    p_node_dist.swap(oldnodedist);
   }
 
   int localedges(p_adjacency.edges());
@@ -243,10 +244,20 @@ ParMETISGraphWrapper::p_initialize(void)
 // -------------------------------------------------------------
 // ParMETISGraphWrapper::get_csr_local
 // -------------------------------------------------------------
+bool
+ParMETISGraphWrapper::current_distribution_ok(void) const
+{
+  for (size_t p = 0; p + 1 < p_node_dist.size(); ++p) {
+    if (p_node_dist[p+1] <= p_node_dist[p]) return false;
+  }
+  return true;
+}
+
 void
 ParMETISGraphWrapper::get_csr_local(std::vector<idx_t>& vtxdist,
                                     std::vector<idx_t>& xadj,
-                                    std::vector<idx_t>& adjncy) const
+                                    std::vector<idx_t>& adjncy,
+                                    const bool& current) const
 {
   BOOST_ASSERT(p_node_data);
   BOOST_ASSERT(p_local_node_id);
@@ -261,19 +272,25 @@ ParMETISGraphWrapper::get_csr_local(std::vector<idx_t>& vtxdist,
                                 // build the node distribution vector
 
   vtxdist.clear();
-  vtxdist.resize(nproc+1, 0);
-  for (int i = 0; i < p_global_nodes; ++i) {
-    int p(i % nproc);
-    vtxdist[p] += 1;
-  }
-  int localnodes(vtxdist[me]);
   int sum(0);
-  for (int p = 0; p < nproc; ++p) {
-    int tmp(vtxdist[p]);
-    vtxdist[p] = sum;
-    sum += tmp;
+  if (current) {
+    BOOST_ASSERT(current_distribution_ok());
+    std::copy(p_node_dist.begin(), p_node_dist.end(), 
+              std::back_inserter(vtxdist));
+  } else {
+    vtxdist.resize(nproc+1, 0);
+    for (int i = 0; i < p_global_nodes; ++i) {
+      int p(i % nproc);
+      vtxdist[p] += 1;
+    }
+    for (int p = 0; p < nproc; ++p) {
+      int tmp(vtxdist[p]);
+      vtxdist[p] = sum;
+      sum += tmp;
+    }
+    vtxdist[nproc] = sum;
   }
-  vtxdist[nproc] = sum;
+  int localnodes(vtxdist[me+1] - vtxdist[me]);
 
                                 // extract adjacency index
 
@@ -319,6 +336,70 @@ ParMETISGraphWrapper::get_csr_local(std::vector<idx_t>& vtxdist,
   communicator().sync();
 }
 
+// -------------------------------------------------------------
+// ParMETISGraphWrapper::get_weights_local
+// -------------------------------------------------------------
+/** 
+ * Node weights are moved from the AdjacencyList distribution to the
+ * ParMETIS distribution, through a GA indexed the same way as
+ * ::p_node_data.
+ * 
+ * @param vtxdist ParMETIS graph node distribution (from ::get_csr_local)
+ * @param ncon number of weights per node
+ * @param vwgt weights of the local ParMETIS graph nodes, ncon per node
+ */
+void
+ParMETISGraphWrapper::get_weights_local(const std::vector<idx_t>& vtxdist,
+                                        idx_t& ncon,
+                                        std::vector<idx_t>& vwgt) const
+{
+  int me(this->processor_rank());
+  int nw(p_adjacency.node_weight_count());
+  int locnodes(p_adjacency.nodes());
+  int lo[2], hi[2], ld[2];
+  int dims[2];
+  ld[0] = nw; ld[1] = 1;
+
+  int theGAgroup(communicator().getGroup());
+  int oldGAgroup = GA_Pgroup_get_default();
+  GA_Pgroup_set_default(theGAgroup);
+
+  dims[0] = p_global_nodes; dims[1] = nw;
+  boost::scoped_ptr<GA::GlobalArray> 
+    weights(new GA::GlobalArray(MT_C_INT, two, dims, 
+                                "ParMETIS Wrapper Node Weights", NULL));
+
+  if (locnodes > 0) {
+    std::vector<int> tmp(locnodes*nw);
+    AdjacencyList::WeightVector w;
+    for (int n = 0; n < locnodes; ++n) {
+      p_adjacency.node_weights(n, w);
+      std::copy(w.begin(), w.end(), tmp.begin() + n*nw);
+    }
+    lo[0] = p_node_lo; lo[1] = 0;
+    hi[0] = p_node_hi; hi[1] = nw - 1;
+    weights->put(lo, hi, &tmp[0], ld);
+  }
+  communicator().sync();
+
+  ncon = nw;
+  vwgt.clear();
+  int nnodes(vtxdist[me+1] - vtxdist[me]);
+  if (nnodes > 0) {
+    std::vector<int> tmp(nnodes*nw);
+    lo[0] = vtxdist[me];   lo[1] = 0;
+    hi[0] = vtxdist[me+1]-1; hi[1] = nw - 1;
+    weights->get(lo, hi, &tmp[0], ld);
+
+    // idx_t may not be same as int
+    vwgt.reserve(tmp.size());
+    std::copy(tmp.begin(), tmp.end(), std::back_inserter(vwgt));
+  }
+  communicator().sync();
+
+  GA_Pgroup_set_default(oldGAgroup);
+}
+
 // -------------------------------------------------------------
 // ParMETISGraphWrapper::set_partition
 // -------------------------------------------------------------
@@ -67,9 +67,25 @@ public:
   ~ParMETISGraphWrapper(void);
 
   /// Get the local part of the "Distributed CSR graph" (used by ParMETIS)
+  /**
+   * Normally graph nodes are dealt out evenly to processors. If @c
+   * current is true, each processor gets the nodes it has in the
+   * AdjacencyList instead, which is what ParMETIS needs to adapt an
+   * existing partition.  This is only possible if every processor has
+   * at least one node.
+   */
   void get_csr_local(std::vector<idx_t>& vtxdist,
                      std::vector<idx_t>& xadj,
-                     std::vector<idx_t>& adjncy) const;
+                     std::vector<idx_t>& adjncy,
+                     const bool& current = false) const;
+
+  /// Can get_csr_local() use the current node distribution?
+  bool current_distribution_ok(void) const;
+
+  /// Get the weights of the local ParMETIS graph nodes
+  void get_weights_local(const std::vector<idx_t>& vtxdist,
+                         idx_t& ncon,
+                         std::vector<idx_t>& vwgt) const;
 
   /// Assign partition number for local ParMETIS graph nodes
   void set_partition(const std::vector<idx_t>& vtxdist, 
@@ -86,6 +102,9 @@ protected:
   /// The total number of nodes involved
   int p_global_nodes;
 
+  /// The current distribution of nodes (like ParMETIS vtxdist)
+  std::vector<int> p_node_dist;
+
   /// The total number of edges
   int p_global_edges;
 
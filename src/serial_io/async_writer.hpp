@@ -0,0 +1,287 @@
+/*
+ *     Copyright (c) 2013 Battelle Memorial Institute
+ *     Licensed under modified BSD License. A copy of this license can be found
+ *     in the LICENSE file in the top level directory of this distribution.
+ */
+// -------------------------------------------------------------
+/**
+ * @file   async_writer.hpp
+ *
+ * @brief  File output from a background writer thread with a bounded
+ * queue of buffers
+ *
+ * Data passed to AsyncFileWriter is already formatted. It is copied into a
+ * buffer, the buffer is put on a queue and the call returns. A writer
+ * thread owned by the AsyncFileWriter takes buffers off the queue and
+ * writes them to the file, so the caller can return to the simulation
+ * while the data moves to the file. When the queue holds the maximum number
+ * of buffers, or the amount of data that has not been written exceeds a
+ * limit, the caller waits until the writer thread has emptied a buffer.
+ * This keeps the memory used for output bounded.
+ *
+ * The writer thread does not make any MPI calls, so MPI does not need to
+ * be initialized with thread support. The file is opened collectively with
+ * MPI-IO, which is also available through handle() for synchronous
+ * writes, and the writer thread writes its buffers through a separate
+ * POSIX descriptor for the same file. Synchronous and queued writes should
+ * go to different parts of the file, or wait() should be called first.
+ */
+// -------------------------------------------------------------
+
+#ifndef _async_writer_h_
+#define _async_writer_h_
+
+#include <cstdio>
+#include <cstring>
+#include <cerrno>
+#include <deque>
+#include <string>
+#include <vector>
+#include <fcntl.h>
+#include <unistd.h>
+#include <mpi.h>
+#include <boost/shared_ptr.hpp>
+#include <boost/thread/thread.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/condition_variable.hpp>
+#include "gridpack/utilities/exception.hpp"
+
+namespace gridpack {
+namespace serial_io {
+
+class AsyncFileWriter {
+  public:
+
+  /**
+   * Simple constructor
+   * @param nbuffers number of buffers that can be held, counting the one
+   *                 the writer thread is writing. The default of 2 allows
+   *                 one buffer to be queued while the previous one is
+   *                 being written
+   * @param max_bytes maximum number of bytes that can be waiting to be
+   *                 written. A single write larger than this is still
+   *                 accepted but the queue must be empty before it is added
+   */
+  AsyncFileWriter(int nbuffers = 2, long long max_bytes = 67108864)
+    : p_open(false), p_fd(-1), p_end(0), p_maxBuffers(nbuffers),
+      p_pending(0), p_maxBytes(max_bytes), p_busy(false), p_stop(false)
+  {
+    if (p_maxBuffers < 1) p_maxBuffers = 1;
+  }
+
+  /**
+   * Simple destructor
+   */
+  ~AsyncFileWriter(void)
+  {
+    try {
+      this->close();
+    } catch (...) {
+    }
+  }
+
+  /**
+   * Open file and start writer thread. Any existing file of the same name
+   * is truncated. This is a collective operation over comm
+   * @param comm communicator containing all processors that access file.
+   *             Use MPI_COMM_SELF if file is written by a single processor
+   * @param filename name of file
+   */
+  void open(MPI_Comm comm, const char *filename)
+  {
+    this->close();
+    int ierr = MPI_File_open(comm, const_cast<char*>(filename),
+        MPI_MODE_CREATE | MPI_MODE_WRONLY, MPI_INFO_NULL, &p_file);
+    if (ierr != MPI_SUCCESS) {
+      char buf[256];
+      sprintf(buf,"AsyncFileWriter::open: unable to open file %s\n",
+          filename);
+      throw gridpack::Exception(buf);
+    }
+    MPI_File_set_size(p_file, 0);
+    MPI_Barrier(comm);
+    p_fd = ::open(filename, O_WRONLY);
+    if (p_fd < 0) {
+      MPI_File_close(&p_file);
+      char buf[256];
+      sprintf(buf,"AsyncFileWriter::open: unable to open file %s for"
+          " writer thread\n",filename);
+      throw gridpack::Exception(buf);
+    }
+    p_open = true;
+    p_end = 0;
+    p_pending = 0;
+    p_busy = false;
+    p_stop = false;
+    p_error.clear();
+    p_thread.reset(new boost::thread(&AsyncFileWriter::run, this));
+  }
+
+  /**
+   * Complete all queued writes, stop writer thread and close file. This is
+   * a collective operation over the communicator used to open the file
+   */
+  void close(void)
+  {
+    if (p_open) {
+      std::string error;
+      {
+        boost::mutex::scoped_lock lock(p_mutex);
+        while (!p_queue.empty() || p_busy) p_done.wait(lock);
+        p_stop = true;
+        error = p_error;
+      }
+      p_work.notify_all();
+      p_thread->join();
+      p_thread.reset();
+      ::close(p_fd);
+      p_fd = -1;
+      MPI_File_close(&p_file);
+      p_open = false;
+      if (!error.empty()) throw gridpack::Exception(error);
+    }
+  }
+
+  /**
+   * Return handle of open file. This can be used for synchronous writes
+   * to parts of the file that are not being written by the writer thread
+   * @return MPI file handle
+   */
+  MPI_File handle(void) const
+  {
+    return p_file;
+  }
+
+  /**
+   * Queue a block of data to be written at a given location in the file.
+   * The data is copied, so the caller can reuse it as soon as this returns
+   * @param offset location in file in bytes
+   * @param data pointer to data
+   * @param len number of bytes in data
+   */
+  void writeAt(long long offset, const char *data, long long len)
+  {
+    if (!p_open || len <= 0) return;
+    Block block;
+    block.offset = offset;
+    block.data.assign(data, data+len);
+    {
+      boost::mutex::scoped_lock lock(p_mutex);
+      // Apply back-pressure if the queue is full or too much data is
+      // waiting
+      while (p_error.empty() &&
+          (static_cast<int>(p_queue.size()) + (p_busy ? 1 : 0) >=
+          p_maxBuffers ||
+          (p_pending > 0 && p_pending + len > p_maxBytes))) {
+        p_done.wait(lock);
+      }
+      if (!p_error.empty()) throw gridpack::Exception(p_error);
+      p_queue.push_back(Block());
+      p_queue.back().offset = block.offset;
+      p_queue.back().data.swap(block.data);
+      p_pending += len;
+    }
+    p_work.notify_one();
+    if (offset + len > p_end) p_end = offset + len;
+  }
+
+  /**
+   * Queue a string to be written at the end of the data that has been
+   * written by this processor. This is only meaningful if a single
+   * processor writes the file
+   * @param str string to be written
+   */
+  void append(const std::string &str)
+  {
+    this->writeAt(p_end, str.data(), str.size());
+  }
+
+  /**
+   * Wait until the writer thread has written all queued data
+   */
+  void wait(void)
+  {
+    if (!p_open) return;
+    boost::mutex::scoped_lock lock(p_mutex);
+    while (!p_queue.empty() || p_busy) p_done.wait(lock);
+    if (!p_error.empty()) throw gridpack::Exception(p_error);
+  }
+
+  private:
+
+  /// Formatted data waiting to be written
+  struct Block {
+    long long offset;
+    std::vector<char> data;
+  };
+
+  /**
+   * Writer thread: take blocks off the queue and write them until the
+   * file is closed
+   */
+  void run(void)
+  {
+    Block block;
+    while (true) {
+      {
+        boost::mutex::scoped_lock lock(p_mutex);
+        while (p_queue.empty() && !p_stop) p_work.wait(lock);
+        if (p_queue.empty()) return;
+        block.offset = p_queue.front().offset;
+        block.data.swap(p_queue.front().data);
+        p_queue.pop_front();
+        p_busy = true;
+      }
+      std::string error = this->writeBlock(block);
+      {
+        boost::mutex::scoped_lock lock(p_mutex);
+        p_pending -= block.data.size();
+        p_busy = false;
+        if (!error.empty() && p_error.empty()) p_error = error;
+      }
+      p_done.notify_all();
+    }
+  }
+
+  /**
+   * Write a block to the file, return an error message if it fails
+   */
+  std::string writeBlock(const Block &block)
+  {
+    size_t done = 0;
+    size_t len = block.data.size();
+    while (done < len) {
+      ssize_t n = ::pwrite(p_fd, &block.data[done], len-done,
+          static_cast<off_t>(block.offset+done));
+      if (n < 0 && errno == EINTR) continue;
+      if (n <= 0) {
+        char buf[256];
+        sprintf(buf,"AsyncFileWriter: write of %ld bytes at offset %lld"
+            " failed\n",static_cast<long>(len),block.offset);
+        return std::string(buf);
+      }
+      done += n;
+    }
+    return std::string();
+  }
+
+    MPI_File p_file;
+    bool p_open;
+    int p_fd;
+    long long p_end;
+    int p_maxBuffers;
+    long long p_pending;
+    long long p_maxBytes;
+    std::deque<Block> p_queue;
+    bool p_busy;
+    bool p_stop;
+    std::string p_error;
+    boost::mutex p_mutex;
+    boost::condition_variable p_work;
+    boost::condition_variable p_done;
+    boost::shared_ptr<boost::thread> p_thread;
+};
+
+}   // serial_io
+}   // gridpack
+#endif  // _async_writer_h_
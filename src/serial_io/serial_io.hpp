@@ -18,12 +18,17 @@
 #ifndef _serial_io_h_
 #define _serial_io_h_
 
+#include <cstring>
+#include <string>
+#include <sstream>
 #include <boost/smart_ptr/shared_ptr.hpp>
 #include <ga.h>
+#include <mpi.h>
 #include "gridpack/parallel/distributed.hpp"
 #include "gridpack/network/base_network.hpp"
 #include "gridpack/component/base_component.hpp"
 #include "gridpack/utilities/exception.hpp"
+#include "gridpack/serial_io/async_writer.hpp"
 #ifdef USE_GOSS
 #include "gridpack/serial_io/goss_utils.hpp"
 #endif
@@ -31,6 +36,107 @@
 namespace gridpack {
 namespace serial_io {
 
+// -------------------------------------------------------------
+// Helper class used by the bus and branch IO modules to write a
+// single file from all processors. Each processor contributes a
+// block of text and the blocks are written in processor order at
+// computed offsets using collective MPI-IO, so no processor needs
+// to hold the entire output. In asynchronous mode the blocks are
+// handed to the writer thread of an AsyncFileWriter and the collective
+// operations are limited to finding the offsets
+// -------------------------------------------------------------
+class ParallelFileWriter {
+  public:
+
+  /**
+   * Simple constructor
+   * @param comm communicator containing all processors that write to file
+   * @param async if true, return from write before data reaches the file
+   */
+  ParallelFileWriter(const gridpack::parallel::Communicator &comm,
+      bool async = false)
+    : p_comm(comm), p_async(async), p_open(false), p_offset(0)
+  {
+  }
+
+  /**
+   * Simple destructor
+   */
+  ~ParallelFileWriter(void)
+  {
+    this->close();
+  }
+
+  /**
+   * Open file. Any existing file of the same name is truncated. This is a
+   * collective operation
+   * @param filename name of file
+   */
+  void open(const char *filename)
+  {
+    this->close();
+    p_file.open(static_cast<MPI_Comm>(p_comm), filename);
+    p_open = true;
+    p_offset = 0;
+  }
+
+  /**
+   * Close file. This is a collective operation
+   */
+  void close(void)
+  {
+    if (p_open) {
+      p_file.close();
+      p_open = false;
+    }
+  }
+
+  /**
+   * Append a block of text from each processor to the file. Blocks are
+   * written in the order of processor rank. This is a collective operation
+   * @param block text contributed by this processor (can be empty)
+   */
+  void write(const std::string &block)
+  {
+    MPI_Comm comm = static_cast<MPI_Comm>(p_comm);
+    long long len = block.size();
+    long long offset = 0;
+    long long total = 0;
+    MPI_Exscan(&len, &offset, 1, MPI_LONG_LONG, MPI_SUM, comm);
+    if (p_comm.rank() == 0) offset = 0;
+    MPI_Allreduce(&len, &total, 1, MPI_LONG_LONG, MPI_SUM, comm);
+    if (p_async) {
+      p_file.writeAt(p_offset+offset, block.data(), len);
+    } else {
+      MPI_Status status;
+      MPI_File_write_at_all(p_file.handle(),
+          static_cast<MPI_Offset>(p_offset+offset),
+          const_cast<char*>(block.data()), static_cast<int>(len), MPI_CHAR,
+          &status);
+    }
+    p_offset += total;
+  }
+
+  /**
+   * Append a string from processor 0 to the file. This is a collective
+   * operation
+   * @param str character string to be written
+   */
+  void header(const char *str)
+  {
+    std::string block;
+    if (p_comm.rank() == 0) block = str;
+    this->write(block);
+  }
+
+  private:
+    gridpack::parallel::Communicator p_comm;
+    AsyncFileWriter p_file;
+    bool p_async;
+    bool p_open;
+    long long p_offset;
+};
+
 // -------------------------------------------------------------
 // A set of classes to support output of information from buses
 // and branches to standard output. Each bus or branch is
@@ -88,13 +194,30 @@ class SerialBusIO {
   /**
    * Redirect output to a file instead of standard out
    * @param filename name of file that output goes to
+   * @param parallel if true, all processors write their own part of the
+   *                 file using MPI-IO instead of sending all output
+   *                 through process 0. The contents and ordering of the
+   *                 file are the same in both modes. Must be called on
+   *                 all processors.
+   * @param async if true, file writes are done by a background writer
+   *                 thread while the calculation continues. At most
+   *                 two blocks of output are held in memory at any time
    */
-  void open(const char *filename)
+  void open(const char *filename, bool parallel = false, bool async = false)
   {
-    if (GA_Pgroup_nodeid(p_GAgrp) == 0) {
-      this->close();
-      p_fout.reset(new std::ofstream);
-      p_fout->open(filename);
+    this->close();
+    if (parallel) {
+      p_pfile.reset(new ParallelFileWriter(p_network->communicator(),
+            async));
+      p_pfile->open(filename);
+    } else if (GA_Pgroup_nodeid(p_GAgrp) == 0) {
+      if (async) {
+        p_afile.reset(new AsyncFileWriter);
+        p_afile->open(MPI_COMM_SELF, filename);
+      } else {
+        p_fout.reset(new std::ofstream);
+        p_fout->open(filename);
+      }
     }
   }
 
@@ -116,6 +239,25 @@ class SerialBusIO {
     p_fout = stream;
   }
 
+  /**
+   * return asynchronous writer for a file opened with async set to true
+   * and parallel set to false. This is only set on process 0
+   * @return asynchronous file writer
+   */
+  boost::shared_ptr<AsyncFileWriter> getAsyncWriter()
+  {
+    return p_afile;
+  }
+
+  /**
+   * Set asynchronous writer to point to existing file
+   * @param writer asynchronous file writer
+   */
+  void setAsyncWriter(boost::shared_ptr<AsyncFileWriter> writer)
+  {
+    p_afile = writer;
+  }
+
   /**
    * Close file and redirect output to standard out 
    */
@@ -125,8 +267,11 @@ class SerialBusIO {
       if (p_fout) {
         if (p_fout->is_open()) p_fout->close();
       }
+      if (p_afile) p_afile->close();
     }
     p_fout.reset();
+    p_afile.reset();
+    p_pfile.reset();
   }
 
   /**
@@ -136,8 +281,14 @@ class SerialBusIO {
    */
   void write(const char *signal = NULL)
   {
-    if (p_fout) {
+    if (p_pfile) {
+      writeParallel(signal);
+    } else if (p_fout) {
       write(*p_fout, signal);
+    } else if (p_afile) {
+      std::ostringstream out;
+      write(out, signal);
+      p_afile->append(out.str());
     } else {
       write(std::cout, signal);
     }
@@ -188,8 +339,12 @@ class SerialBusIO {
    */
   void header(const char *str)
   {
-    if (p_fout) {
+    if (p_pfile) {
+      p_pfile->header(str);
+    } else if (p_fout) {
       header(*p_fout, str);
+    } else if (p_afile) {
+      p_afile->append(str);
     } else {
       header(std::cout, str);
     }
@@ -340,57 +495,14 @@ class SerialBusIO {
    */
   std::vector<std::string> writeStrings(const char *signal = NULL)
   {
-    int nBus = p_network->numBuses();
-    char *string;
-    int nwrites = 0;
     int i;
     int one = 1;
-    std::vector<std::string> ret;
-    string = (char*)malloc(p_size*sizeof(char));
-
-    // Count up total strings being written from this processor
-    for (i=0; i<nBus; i++) {
-      if (p_network->getActiveBus(i) &&
-          p_network->getBus(i)->serialWrite(string,p_size,signal)) {
-        nwrites++;
-      }
-    }
-    free(string);
-
-    // Set up buffers to scatter strings to global buffer
+    int nwrites;
     int *iptr;
     char *ptr;
-    GA_Zero(p_maskGA);
-    if (nwrites > 0) {
-      std::vector<int*> index(nwrites);
-      std::vector<int> indexbuf(nwrites);
-      iptr = &indexbuf[0];
-      std::vector<int> ones(nwrites);
-      char *strbuf = NULL;
-      if (nwrites*p_size > 0) strbuf = new char[nwrites*p_size];
-      ptr = strbuf;
-      int ncnt = 0;
-      for (i=0; i<nBus; i++) {
-        if (ncnt >= nwrites) break;
-        if (p_network->getActiveBus(i) &&
-            p_network->getBus(i)->serialWrite(ptr,p_size,signal)) {
-          index[ncnt] = iptr;
-          *(index[ncnt]) = p_network->getGlobalBusIndex(i);
-          ones[ncnt] = 1;
-          ncnt++;
-          ptr += p_size;
-          iptr++;
-        }
-      }
+    std::vector<std::string> ret;
 
-      // Scatter data to global buffer and set mask array
-      if (ncnt > 0) {
-        NGA_Scatter(p_stringGA,strbuf,&index[0],nwrites);
-        NGA_Scatter(p_maskGA,&ones[0],&index[0],nwrites);
-      }
-      if (nwrites*p_size > 0) delete [] strbuf;
-    }
-    GA_Pgroup_sync(p_GAgrp);
+    scatterStrings(signal);
 
     // String data is now stored on global array. Process 0 now retrieves data
     // from each successive processor and writes it to standard out  
@@ -456,56 +568,13 @@ class SerialBusIO {
    */
   void write(std::ostream & out, const char *signal = NULL)
   {
-    int nBus = p_network->numBuses();
-    char *string;
-    int nwrites = 0;
     int i;
     int one = 1;
-    string = (char*)malloc(p_size*sizeof(char));
-
-    // Count up total strings being written from this processor
-    for (i=0; i<nBus; i++) {
-      if (p_network->getActiveBus(i) &&
-          p_network->getBus(i)->serialWrite(string,p_size,signal)) {
-        nwrites++;
-      }
-    }
-    free(string);
-
-    // Set up buffers to scatter strings to global buffer
+    int nwrites;
     int *iptr;
     char *ptr;
-    GA_Zero(p_maskGA);
-    if (nwrites > 0) {
-      std::vector<int*> index(nwrites);
-      std::vector<int> indexbuf(nwrites);
-      iptr = &indexbuf[0];
-      std::vector<int> ones(nwrites);
-      char *strbuf = NULL;
-      if (nwrites*p_size > 0) strbuf = new char[nwrites*p_size];
-      ptr = strbuf;
-      int ncnt = 0;
-      for (i=0; i<nBus; i++) {
-        if (ncnt >= nwrites) break;
-        if (p_network->getActiveBus(i) &&
-            p_network->getBus(i)->serialWrite(ptr,p_size,signal)) {
-          index[ncnt] = iptr;
-          *(index[ncnt]) = p_network->getGlobalBusIndex(i);
-          ones[ncnt] = 1;
-          ncnt++;
-          ptr += p_size;
-          iptr++;
-        }
-      }
 
-      // Scatter data to global buffer and set mask array
-      if (ncnt > 0) {
-        NGA_Scatter(p_stringGA,strbuf,&index[0],nwrites);
-        NGA_Scatter(p_maskGA,&ones[0],&index[0],nwrites);
-      }
-      if (nwrites*p_size > 0) delete [] strbuf;
-    }
-    GA_Pgroup_sync(p_GAgrp);
+    scatterStrings(signal);
 
     // String data is now stored on global array. Process 0 now retrieves data
     // from each successive processor and writes it to standard out  
@@ -588,6 +657,100 @@ class SerialBusIO {
     }
   }
 
+  /**
+   * Write output from buses to a file opened in parallel mode. Each
+   * processor writes the strings stored in its own block of the global
+   * string array. The blocks are ordered by global bus index, so writing
+   * them in processor order gives the same ordering as write(out)
+   * @param signal an optional character string used to control contents of
+   *                output
+   */
+  void writeParallel(const char *signal = NULL)
+  {
+    int one = 1;
+    std::string block;
+
+    scatterStrings(signal);
+
+    int lo, hi;
+    NGA_Distribution(p_maskGA, GA_Pgroup_nodeid(p_GAgrp), &lo, &hi);
+    if (lo >= 0 && hi >= lo) {
+      int ld = hi - lo + 1;
+      std::vector<int> imask(ld);
+      NGA_Get(p_maskGA,&lo,&hi,&imask[0],&one);
+      std::vector<char> iobuf(p_size*ld);
+      NGA_Get(p_stringGA,&lo,&hi,&iobuf[0],&one);
+      int j;
+      for (j=0; j<ld; j++) {
+        if (imask[j] == 1) {
+          const char *ptr = &iobuf[j*p_size];
+          block.append(ptr, strnlen(ptr, p_size));
+        }
+      }
+    }
+    p_pfile->write(block);
+    GA_Pgroup_sync(p_GAgrp);
+  }
+
+  /**
+   * Copy the output strings from all buses on this processor to the
+   * global string array and mark their locations in the mask array
+   * @param signal an optional character string used to control contents of
+   *                output
+   */
+  void scatterStrings(const char *signal)
+  {
+    int nBus = p_network->numBuses();
+    char *string;
+    int nwrites = 0;
+    int i;
+    string = (char*)malloc(p_size*sizeof(char));
+
+    // Count up total strings being written from this processor
+    for (i=0; i<nBus; i++) {
+      if (p_network->getActiveBus(i) &&
+          p_network->getBus(i)->serialWrite(string,p_size,signal)) {
+        nwrites++;
+      }
+    }
+    free(string);
+
+    // Set up buffers to scatter strings to global buffer
+    int *iptr;
+    char *ptr;
+    GA_Zero(p_maskGA);
+    if (nwrites > 0) {
+      std::vector<int*> index(nwrites);
+      std::vector<int> indexbuf(nwrites);
+      iptr = &indexbuf[0];
+      std::vector<int> ones(nwrites);
+      char *strbuf = NULL;
+      if (nwrites*p_size > 0) strbuf = new char[nwrites*p_size];
+      ptr = strbuf;
+      int ncnt = 0;
+      for (i=0; i<nBus; i++) {
+        if (ncnt >= nwrites) break;
+        if (p_network->getActiveBus(i) &&
+            p_network->getBus(i)->serialWrite(ptr,p_size,signal)) {
+          index[ncnt] = iptr;
+          *(index[ncnt]) = p_network->getGlobalBusIndex(i);
+          ones[ncnt] = 1;
+          ncnt++;
+          ptr += p_size;
+          iptr++;
+        }
+      }
+
+      // Scatter data to global buffer and set mask array
+      if (ncnt > 0) {
+        NGA_Scatter(p_stringGA,strbuf,&index[0],nwrites);
+        NGA_Scatter(p_maskGA,&ones[0],&index[0],nwrites);
+      }
+      if (nwrites*p_size > 0) delete [] strbuf;
+    }
+    GA_Pgroup_sync(p_GAgrp);
+  }
+
   private:
     int p_GA_type;
     boost::shared_ptr<_network> p_network;
@@ -595,6 +758,8 @@ class SerialBusIO {
     int p_maskGA;
     int p_size;
     boost::shared_ptr<std::ofstream> p_fout;
+    boost::shared_ptr<ParallelFileWriter> p_pfile;
+    boost::shared_ptr<AsyncFileWriter> p_afile;
     int p_GAgrp;
 #ifdef USE_GOSS
     gridpack::goss::GOSSUtils *p_goss;
@@ -648,13 +813,30 @@ class SerialBranchIO {
   /**
    * Redirect output to a file instead of standard out
    * @param filename name of file that output goes to
+   * @param parallel if true, all processors write their own part of the
+   *                 file using MPI-IO instead of sending all output
+   *                 through process 0. The contents and ordering of the
+   *                 file are the same in both modes. Must be called on
+   *                 all processors.
+   * @param async if true, file writes are done by a background writer
+   *                 thread while the calculation continues. At most
+   *                 two blocks of output are held in memory at any time
    */
-  void open(const char *filename)
+  void open(const char *filename, bool parallel = false, bool async = false)
   {
-    if (GA_Pgroup_nodeid(p_GAgrp) == 0) {
-      this->close();
-      p_fout.reset(new std::ofstream);
-      p_fout->open(filename);
+    this->close();
+    if (parallel) {
+      p_pfile.reset(new ParallelFileWriter(p_network->communicator(),
+            async));
+      p_pfile->open(filename);
+    } else if (GA_Pgroup_nodeid(p_GAgrp) == 0) {
+      if (async) {
+        p_afile.reset(new AsyncFileWriter);
+        p_afile->open(MPI_COMM_SELF, filename);
+      } else {
+        p_fout.reset(new std::ofstream);
+        p_fout->open(filename);
+      }
     }
   }
 
@@ -676,6 +858,25 @@ class SerialBranchIO {
     p_fout = stream;
   }
 
+  /**
+   * return asynchronous writer for a file opened with async set to true
+   * and parallel set to false. This is only set on process 0
+   * @return asynchronous file writer
+   */
+  boost::shared_ptr<AsyncFileWriter> getAsyncWriter()
+  {
+    return p_afile;
+  }
+
+  /**
+   * Set asynchronous writer to point to existing file
+   * @param writer asynchronous file writer
+   */
+  void setAsyncWriter(boost::shared_ptr<AsyncFileWriter> writer)
+  {
+    p_afile = writer;
+  }
+
   /**
    * Close file and redirect output to standard out 
    */
@@ -685,8 +886,11 @@ class SerialBranchIO {
       if (p_fout) {
         if (p_fout->is_open()) p_fout->close();
       }
+      if (p_afile) p_afile->close();
     }
     p_fout.reset();
+    p_afile.reset();
+    p_pfile.reset();
   }
 
   /**
@@ -696,8 +900,14 @@ class SerialBranchIO {
    */
   void write(const char *signal = NULL)
   {
-    if (p_fout) {
+    if (p_pfile) {
+      writeParallel(signal);
+    } else if (p_fout) {
       write(*p_fout, signal);
+    } else if (p_afile) {
+      std::ostringstream out;
+      write(out, signal);
+      p_afile->append(out.str());
     } else {
       write(std::cout, signal);
     }
@@ -711,8 +921,12 @@ class SerialBranchIO {
    */
   void header(const char *str)
   {
-    if (p_fout) {
+    if (p_pfile) {
+      p_pfile->header(str);
+    } else if (p_fout) {
       header(*p_fout, str);
+    } else if (p_afile) {
+      p_afile->append(str);
     } else {
       header(std::cout, str);
     }
@@ -848,55 +1062,14 @@ class SerialBranchIO {
    */
   std::vector<std::string> writeStrings(const char *signal = NULL)
   {
-    int nBranch = p_network->numBranches();
-    char *string;
-    string = new char[p_size];
-    int nwrites = 0;
     int i;
     int one = 1;
-    std::vector<std::string> ret;
-
-    // Count up total strings being written from this processor
-    for (i=0; i<nBranch; i++) {
-      if (p_network->getActiveBranch(i) &&
-          p_network->getBranch(i)->serialWrite(string,p_size,signal)) nwrites++;
-    }
-    delete [] string;
-
-    // Set up buffers to scatter strings to global buffer
+    int nwrites;
     int *iptr;
     char *ptr;
-    GA_Zero(p_maskGA);
-    if (nwrites > 0) {
-      std::vector<int*> index(nwrites);
-      std::vector<int> indexbuf(nwrites);
-      iptr = &indexbuf[0];
-      std::vector<int> ones(nwrites);
-      char *strbuf;
-      if (nwrites*p_size > 0) strbuf = new char[nwrites*p_size];
-      ptr = strbuf;
-      int ncnt = 0;
-      for (i=0; i<nBranch; i++) {
-        if (ncnt >= nwrites) break;
-        if (p_network->getActiveBranch(i) &&
-            p_network->getBranch(i)->serialWrite(ptr,p_size,signal)) {
-          index[ncnt] = iptr;
-          *(index[ncnt]) = p_network->getGlobalBranchIndex(i);
-          ones[ncnt] = 1;
-          ncnt++;
-          ptr += p_size;
-          iptr++;
-        }
-      }
+    std::vector<std::string> ret;
 
-      // Scatter data to global buffer and set mask array
-      if (ncnt > 0) {
-        NGA_Scatter(p_stringGA,strbuf,&index[0],nwrites);
-        NGA_Scatter(p_maskGA,&ones[0],&index[0],nwrites);
-      }
-      if (nwrites*p_size > 0) delete [] strbuf;
-    }
-    GA_Pgroup_sync(p_GAgrp);
+    scatterStrings(signal);
 
     // String data is now stored on global array. Process 0 now retrieves data
     // from each successive processor and writes it to standard out  
@@ -960,54 +1133,13 @@ class SerialBranchIO {
    */
   void write(std::ostream & out, const char *signal = NULL)
   {
-    int nBranch = p_network->numBranches();
-    char *string;
-    string = new char[p_size];
-    int nwrites = 0;
     int i;
     int one = 1;
-
-    // Count up total strings being written from this processor
-    for (i=0; i<nBranch; i++) {
-      if (p_network->getActiveBranch(i) &&
-          p_network->getBranch(i)->serialWrite(string,p_size,signal)) nwrites++;
-    }
-    delete [] string;
-
-    // Set up buffers to scatter strings to global buffer
+    int nwrites;
     int *iptr;
     char *ptr;
-    GA_Zero(p_maskGA);
-    if (nwrites > 0) {
-      std::vector<int*> index(nwrites);
-      std::vector<int> indexbuf(nwrites);
-      iptr = &indexbuf[0];
-      std::vector<int> ones(nwrites);
-      char *strbuf;
-      if (nwrites*p_size > 0) strbuf = new char[nwrites*p_size];
-      ptr = strbuf;
-      int ncnt = 0;
-      for (i=0; i<nBranch; i++) {
-        if (ncnt >= nwrites) break;
-        if (p_network->getActiveBranch(i) &&
-            p_network->getBranch(i)->serialWrite(ptr,p_size,signal)) {
-          index[ncnt] = iptr;
-          *(index[ncnt]) = p_network->getGlobalBranchIndex(i);
-          ones[ncnt] = 1;
-          ncnt++;
-          ptr += p_size;
-          iptr++;
-        }
-      }
 
-      // Scatter data to global buffer and set mask array
-      if (ncnt > 0) {
-        NGA_Scatter(p_stringGA,strbuf,&index[0],nwrites);
-        NGA_Scatter(p_maskGA,&ones[0],&index[0],nwrites);
-      }
-      if (nwrites*p_size > 0) delete [] strbuf;
-    }
-    GA_Pgroup_sync(p_GAgrp);
+    scatterStrings(signal);
 
     // String data is now stored on global array. Process 0 now retrieves data
     // from each successive processor and writes it to standard out  
@@ -1074,6 +1206,98 @@ class SerialBranchIO {
     }
   }
 
+  /**
+   * Write output from branches to a file opened in parallel mode. Each
+   * processor writes the strings stored in its own block of the global
+   * string array. The blocks are ordered by global branch index, so writing
+   * them in processor order gives the same ordering as write(out)
+   * @param signal an optional character string used to control contents of
+   *                output
+   */
+  void writeParallel(const char *signal = NULL)
+  {
+    int one = 1;
+    std::string block;
+
+    scatterStrings(signal);
+
+    int lo, hi;
+    NGA_Distribution(p_maskGA, GA_Pgroup_nodeid(p_GAgrp), &lo, &hi);
+    if (lo >= 0 && hi >= lo) {
+      int ld = hi - lo + 1;
+      std::vector<int> imask(ld);
+      NGA_Get(p_maskGA,&lo,&hi,&imask[0],&one);
+      std::vector<char> iobuf(p_size*ld);
+      NGA_Get(p_stringGA,&lo,&hi,&iobuf[0],&one);
+      int j;
+      for (j=0; j<ld; j++) {
+        if (imask[j] == 1) {
+          const char *ptr = &iobuf[j*p_size];
+          block.append(ptr, strnlen(ptr, p_size));
+        }
+      }
+    }
+    p_pfile->write(block);
+    GA_Pgroup_sync(p_GAgrp);
+  }
+
+  /**
+   * Copy the output strings from all branches on this processor to the
+   * global string array and mark their locations in the mask array
+   * @param signal an optional character string used to control contents of
+   *                output
+   */
+  void scatterStrings(const char *signal)
+  {
+    int nBranch = p_network->numBranches();
+    char *string;
+    string = new char[p_size];
+    int nwrites = 0;
+    int i;
+
+    // Count up total strings being written from this processor
+    for (i=0; i<nBranch; i++) {
+      if (p_network->getActiveBranch(i) &&
+          p_network->getBranch(i)->serialWrite(string,p_size,signal)) nwrites++;
+    }
+    delete [] string;
+
+    // Set up buffers to scatter strings to global buffer
+    int *iptr;
+    char *ptr;
+    GA_Zero(p_maskGA);
+    if (nwrites > 0) {
+      std::vector<int*> index(nwrites);
+      std::vector<int> indexbuf(nwrites);
+      iptr = &indexbuf[0];
+      std::vector<int> ones(nwrites);
+      char *strbuf;
+      if (nwrites*p_size > 0) strbuf = new char[nwrites*p_size];
+      ptr = strbuf;
+      int ncnt = 0;
+      for (i=0; i<nBranch; i++) {
+        if (ncnt >= nwrites) break;
+        if (p_network->getActiveBranch(i) &&
+            p_network->getBranch(i)->serialWrite(ptr,p_size,signal)) {
+          index[ncnt] = iptr;
+          *(index[ncnt]) = p_network->getGlobalBranchIndex(i);
+          ones[ncnt] = 1;
+          ncnt++;
+          ptr += p_size;
+          iptr++;
+        }
+      }
+
+      // Scatter data to global buffer and set mask array
+      if (ncnt > 0) {
+        NGA_Scatter(p_stringGA,strbuf,&index[0],nwrites);
+        NGA_Scatter(p_maskGA,&ones[0],&index[0],nwrites);
+      }
+      if (nwrites*p_size > 0) delete [] strbuf;
+    }
+    GA_Pgroup_sync(p_GAgrp);
+  }
+
   private:
     int p_GA_type;
     boost::shared_ptr<_network> p_network;
@@ -1081,6 +1305,8 @@ class SerialBranchIO {
     int p_maskGA;
     int p_size;
     boost::shared_ptr<std::ofstream> p_fout;
+    boost::shared_ptr<ParallelFileWriter> p_pfile;
+    boost::shared_ptr<AsyncFileWriter> p_afile;
     int p_GAgrp;
 };
 
@@ -6,6 +6,8 @@
 
 #include "mpi.h"
 #include <vector>
+#include <fstream>
+#include <iterator>
 #include <macdecls.h>
 #include "gridpack/utilities/complex.hpp"
 #include "gridpack/network/base_network.hpp"
@@ -13,6 +15,7 @@
 #include "gridpack/factory/base_factory.hpp"
 #include "gridpack/math/math.hpp"
 #include "gridpack/serial_io/serial_io.hpp"
+#include "gridpack/serial_io/time_series.hpp"
 
 #define XDIM 10
 #define YDIM 10
@@ -126,6 +129,33 @@ void factor_grid(int nproc, int xsize, int ysize, int *pdx, int *pdy)
 
 typedef gridpack::network::BaseNetwork<TestBus, TestBranch> TestNetwork;
 
+/**
+ * Check contents of a time series file written by run. Each process
+ * owns two columns p<n>_a and p<n>_b with values 100*n+i and -(100*n+i)
+ * at step i
+ * @param filename name of time series file
+ * @param nprocs number of processes that wrote file
+ * @param nsteps expected number of time steps
+ * @return true if file contents are correct
+ */
+bool checkTimeSeries(const char *filename, int nprocs, int nsteps)
+{
+  gridpack::serial_io::TimeSeriesReader tsr(filename);
+  bool ok = (tsr.numColumns() == 2*nprocs && tsr.numSteps() == nsteps);
+  char buf[32];
+  int i, p;
+  for (i=0; i<nsteps && ok; i++) {
+    if (tsr.time(i) != 0.005*static_cast<double>(i)) ok = false;
+    for (p=0; p<nprocs; p++) {
+      sprintf(buf,"p%d_a",p);
+      if (tsr.columnName(2*p) != buf) ok = false;
+      if (tsr.value(i,2*p) != static_cast<double>(100*p+i)) ok = false;
+      if (tsr.value(i,2*p+1) != -static_cast<double>(100*p+i)) ok = false;
+    }
+  }
+  return ok;
+}
+
 void run (const int &me, const int &nprocs)
 {
   // Create network
@@ -337,6 +367,125 @@ void run (const int &me, const int &nprocs)
       printf("\n    Values of gathered data on branches are ok\n");
     }
   }
+
+  // Test parallel and asynchronous file output. Write the same data to one
+  // file using the default ordered output and to others using parallel
+  // and asynchronous output and check that the files are identical
+  busIO.header("\n Test parallel file output\n");
+  busIO.open("serial_io_ordered.txt");
+  busIO.header("\n  Bus Properties\n");
+  busIO.write();
+  busIO.close();
+  branchIO.open("serial_io_ordered.txt.br");
+  branchIO.header("\n  Branch Properties\n");
+  branchIO.write();
+  branchIO.close();
+  busIO.open("serial_io_parallel.txt",true);
+  busIO.header("\n  Bus Properties\n");
+  busIO.write();
+  busIO.close();
+  branchIO.open("serial_io_parallel.txt.br",true);
+  branchIO.header("\n  Branch Properties\n");
+  branchIO.write();
+  branchIO.close();
+  busIO.open("serial_io_async.txt",false,true);
+  busIO.header("\n  Bus Properties\n");
+  busIO.write();
+  busIO.close();
+  branchIO.open("serial_io_async.txt.br",false,true);
+  branchIO.header("\n  Branch Properties\n");
+  branchIO.write();
+  branchIO.close();
+  busIO.open("serial_io_parasync.txt",true,true);
+  busIO.header("\n  Bus Properties\n");
+  busIO.write();
+  busIO.close();
+  branchIO.open("serial_io_parasync.txt.br",true,true);
+  branchIO.header("\n  Branch Properties\n");
+  branchIO.write();
+  branchIO.close();
+  if (me == 0) {
+    const char *files[6][2] = {
+      {"serial_io_ordered.txt","serial_io_parallel.txt"},
+      {"serial_io_ordered.txt.br","serial_io_parallel.txt.br"},
+      {"serial_io_ordered.txt","serial_io_async.txt"},
+      {"serial_io_ordered.txt.br","serial_io_async.txt.br"},
+      {"serial_io_ordered.txt","serial_io_parasync.txt"},
+      {"serial_io_ordered.txt.br","serial_io_parasync.txt.br"}};
+    const char *modes[3] = {"Parallel","Asynchronous","Parallel asynchronous"};
+    for (i=0; i<6; i++) {
+      std::ifstream fin1(files[i][0]);
+      std::ifstream fin2(files[i][1]);
+      std::string str1((std::istreambuf_iterator<char>(fin1)),
+          std::istreambuf_iterator<char>());
+      std::string str2((std::istreambuf_iterator<char>(fin2)),
+          std::istreambuf_iterator<char>());
+      if (str1.length() > 0 && str1 == str2) {
+        printf("\n    %s output for %s is ok\n",modes[i/2],
+            i%2==0?"buses":"branches");
+      } else {
+        printf("\n    %s output for %s does not match ordered output\n",
+            modes[i/2],i%2==0?"buses":"branches");
+      }
+    }
+  }
+
+  // Test binary time series output. Each process owns two columns
+  // and writes enough steps to fill more than one chunk. A partially
+  // filled chunk is flushed and checked in the middle of the run, so it is
+  // rewritten when more steps are added. The test is run with synchronous
+  // and asynchronous writes
+  busIO.header("\n Test binary time series output\n");
+  int iasync;
+  for (iasync=0; iasync<2; iasync++) {
+    int nprocs = network->communicator().size();
+    int chunk = 4;
+    int nsteps = 10;
+    std::vector<std::string> names;
+    char buf[32];
+    sprintf(buf,"p%d_a",me);
+    names.push_back(buf);
+    sprintf(buf,"p%d_b",me);
+    names.push_back(buf);
+    gridpack::serial_io::TimeSeriesWriter tsw(network->communicator(),chunk,
+        iasync==1);
+    tsw.open("serial_io_series.bin",names);
+    std::vector<double> vals(2);
+    int npartial = chunk + chunk/2;
+    bool partial_ok = true;
+    for (i=0; i<nsteps; i++) {
+      vals[0] = static_cast<double>(100*me+i);
+      vals[1] = -static_cast<double>(100*me+i);
+      tsw.write(0.005*static_cast<double>(i),vals);
+      if (i == npartial-1) {
+        tsw.flush();
+        network->communicator().barrier();
+        if (me == 0) {
+          partial_ok = checkTimeSeries("serial_io_series.bin",nprocs,
+              npartial);
+        }
+        network->communicator().barrier();
+      }
+    }
+    tsw.close();
+    if (me == 0) {
+      if (partial_ok) {
+        printf("\n    Partial chunk of time series (%s) is ok\n",
+            iasync==1?"asynchronous":"synchronous");
+      } else {
+        printf("\n    Partial chunk of time series (%s) is wrong\n",
+            iasync==1?"asynchronous":"synchronous");
+      }
+      bool ok = checkTimeSeries("serial_io_series.bin",nprocs,nsteps);
+      if (ok) {
+        printf("\n    Binary time series output (%s) is ok\n",
+            iasync==1?"asynchronous":"synchronous");
+      } else {
+        printf("\n    Binary time series output (%s) is wrong\n",
+            iasync==1?"asynchronous":"synchronous");
+      }
+    }
+  }
 }
 
 int
@@ -0,0 +1,471 @@
+/*
+ *     Copyright (c) 2013 Battelle Memorial Institute
+ *     Licensed under modified BSD License. A copy of this license can be found
+ *     in the LICENSE file in the top level directory of this distribution.
+ */
+// -------------------------------------------------------------
+/**
+ * @file   time_series.hpp
+ *
+ * @brief  Binary columnar storage of time series data
+ *
+ * A time series file contains a fixed set of named columns and a time
+ * column. Data is stored in chunks of a fixed number of time steps.
+ * Within a chunk, the values for each column are contiguous so that a
+ * single column can be read without reading the others. All values are
+ * stored as native doubles and all integers as native 64 bit integers.
+ *
+ * File layout
+ *
+ *   char    magic[8]     "GPTSERS1"
+ *   int64   ncols        number of data columns (not including time)
+ *   int64   chunk        number of time steps in each chunk
+ *   int64   nsteps       number of time steps in the file
+ *   int64   data_offset  offset in bytes of the first chunk
+ *   names                for each column, int64 length followed by
+ *                        characters (no terminating null)
+ *   chunks               starting at data_offset. Chunk k contains
+ *                        double time[chunk] followed by
+ *                        double column_i[chunk] for i = 0..ncols-1
+ *
+ * The value for time step n and column i is at byte offset
+ * data_offset + 8*((n/chunk)*chunk*(ncols+1) + (i+1)*chunk + n%chunk)
+ */
+// -------------------------------------------------------------
+
+#ifndef _time_series_h_
+#define _time_series_h_
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <ostream>
+#include <mpi.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "gridpack/parallel/communicator.hpp"
+#include "gridpack/utilities/exception.hpp"
+#include "gridpack/serial_io/async_writer.hpp"
+
+namespace gridpack {
+namespace serial_io {
+
+// -------------------------------------------------------------
+// Write a time series file from all processors. Each processor
+// owns a set of columns. Columns are numbered in processor order,
+// so the columns from process 0 come first, followed by the
+// columns from process 1, etc. Time steps are accumulated in
+// memory and a complete chunk is written using a single collective
+// MPI-IO call. In asynchronous mode complete chunks are handed to the
+// writer thread of an AsyncFileWriter, so the next chunk can be filled
+// while the previous one is being written
+// -------------------------------------------------------------
+class TimeSeriesWriter {
+  public:
+
+  /**
+   * Simple constructor
+   * @param comm communicator containing all processors that write to file
+   * @param chunk number of time steps in each chunk
+   * @param async if true, return from write before a complete chunk
+   *              reaches the file
+   */
+  TimeSeriesWriter(const gridpack::parallel::Communicator &comm,
+      int chunk = 256, bool async = false)
+    : p_comm(comm), p_chunk(chunk), p_async(async), p_open(false), p_ncols(0),
+      p_nlocal(0), p_colStart(0), p_dataOffset(0), p_chunkIndex(0),
+      p_nbuf(0)
+  {
+    if (p_chunk < 1) p_chunk = 1;
+  }
+
+  /**
+   * Simple destructor
+   */
+  ~TimeSeriesWriter(void)
+  {
+    try {
+      this->close();
+    } catch (...) {
+      // just eat it
+    }
+  }
+
+  /**
+   * Open file and write header. This is a collective operation
+   * @param filename name of file
+   * @param names names of columns owned by this processor
+   */
+  void open(const char *filename, const std::vector<std::string> &names)
+  {
+    this->close();
+    MPI_Comm comm = static_cast<MPI_Comm>(p_comm);
+    int me = p_comm.rank();
+    int nprocs = p_comm.size();
+    p_file.open(comm, filename);
+    p_open = true;
+
+    // Find global column numbering
+    long long nlocal = names.size();
+    long long start = 0;
+    long long total = 0;
+    MPI_Exscan(&nlocal, &start, 1, MPI_LONG_LONG, MPI_SUM, comm);
+    if (me == 0) start = 0;
+    MPI_Allreduce(&nlocal, &total, 1, MPI_LONG_LONG, MPI_SUM, comm);
+    p_nlocal = nlocal;
+    p_colStart = start;
+    p_ncols = total;
+
+    // Pack names on this processor and gather them on process 0
+    std::string packed;
+    int i;
+    for (i=0; i<static_cast<int>(names.size()); i++) {
+      long long len = names[i].length();
+      packed.append(reinterpret_cast<const char*>(&len), sizeof(len));
+      packed.append(names[i]);
+    }
+    int nbytes = packed.size();
+    std::vector<int> sizes(nprocs), displ(nprocs);
+    MPI_Gather(&nbytes, 1, MPI_INT, &sizes[0], 1, MPI_INT, 0, comm);
+    std::string allnames;
+    if (me == 0) {
+      int tbytes = 0;
+      for (i=0; i<nprocs; i++) {
+        displ[i] = tbytes;
+        tbytes += sizes[i];
+      }
+      allnames.resize(tbytes);
+    }
+    MPI_Gatherv(const_cast<char*>(packed.data()), nbytes, MPI_CHAR,
+        (me == 0 && !allnames.empty() ? &allnames[0] : NULL), &sizes[0],
+        &displ[0], MPI_CHAR, 0, comm);
+
+    // Process 0 writes the header
+    if (me == 0) {
+      std::string header("GPTSERS1");
+      long long ival[4];
+      ival[0] = p_ncols;
+      ival[1] = p_chunk;
+      ival[2] = 0;
+      long long hsize = header.length() + sizeof(ival) + allnames.size();
+      ival[3] = ((hsize + 7)/8)*8;
+      header.append(reinterpret_cast<const char*>(ival), sizeof(ival));
+      header.append(allnames);
+      header.resize(ival[3], '\0');
+      p_dataOffset = ival[3];
+      MPI_Status status;
+      MPI_File_write_at(p_file.handle(), 0, const_cast<char*>(header.data()),
+          header.size(), MPI_CHAR, &status);
+    }
+    MPI_Bcast(&p_dataOffset, 1, MPI_LONG_LONG, 0, comm);
+
+    // Allocate buffer for one chunk. Process 0 also holds the time column
+    p_chunkIndex = 0;
+    p_nbuf = 0;
+    p_buffer.assign(p_chunk*(p_nlocal + (me == 0 ? 1 : 0)), 0.0);
+  }
+
+  /**
+   * Add values for one time step. The chunk is written to the file when
+   * it is full, so this must be called on all processors
+   * @param time time of this step
+   * @param values values of columns owned by this processor, in the same
+   *               order as the names passed to open
+   */
+  void write(double time, const std::vector<double> &values)
+  {
+    if (!p_open) return;
+    if (static_cast<long long>(values.size()) != p_nlocal) {
+      char buf[256];
+      sprintf(buf,"TimeSeriesWriter::write: number of values %d does not"
+          " match number of columns %d\n",static_cast<int>(values.size()),
+          static_cast<int>(p_nlocal));
+      throw gridpack::Exception(buf);
+    }
+    int offset = 0;
+    if (p_comm.rank() == 0) {
+      p_buffer[p_nbuf] = time;
+      offset = p_chunk;
+    }
+    int i;
+    for (i=0; i<p_nlocal; i++) {
+      p_buffer[offset + i*p_chunk + p_nbuf] = values[i];
+    }
+    p_nbuf++;
+    if (p_nbuf == p_chunk) this->flush();
+  }
+
+  /**
+   * Write current chunk and update number of steps in the header. A
+   * partially filled chunk is rewritten on the next flush. This is a
+   * collective operation
+   */
+  void flush(void)
+  {
+    if (!p_open) return;
+    long long chunkBytes = 8*p_chunk*(p_ncols+1);
+    long long offset = p_dataOffset + p_chunkIndex*chunkBytes;
+    if (p_comm.rank() != 0) offset += 8*p_chunk*(p_colStart+1);
+    MPI_Status status;
+    if (p_async && p_nbuf == p_chunk) {
+      // A complete chunk is never written again, so it can be handed off
+      p_file.writeAt(offset, reinterpret_cast<const char*>(
+            p_buffer.empty() ? NULL : &p_buffer[0]), 8*p_buffer.size());
+    } else {
+      // A partial chunk may be rewritten, so complete earlier writes
+      // first. In asynchronous mode each processor writes its own part of
+      // the file independently, since a collective write could place data
+      // from this processor using a different processor and the two
+      // writes would not be ordered
+      p_file.wait();
+      if (p_async) {
+        MPI_File_write_at(p_file.handle(), static_cast<MPI_Offset>(offset),
+            (p_buffer.empty() ? NULL : &p_buffer[0]), p_buffer.size(),
+            MPI_DOUBLE, &status);
+      } else {
+        MPI_File_write_at_all(p_file.handle(),
+            static_cast<MPI_Offset>(offset),
+            (p_buffer.empty() ? NULL : &p_buffer[0]), p_buffer.size(),
+            MPI_DOUBLE, &status);
+      }
+    }
+    if (p_comm.rank() == 0) {
+      long long nsteps = p_chunkIndex*p_chunk + p_nbuf;
+      MPI_File_write_at(p_file.handle(), 24, &nsteps, 1, MPI_LONG_LONG,
+          &status);
+    }
+    if (p_nbuf == p_chunk) {
+      p_chunkIndex++;
+      p_nbuf = 0;
+      std::fill(p_buffer.begin(), p_buffer.end(), 0.0);
+    }
+  }
+
+  /**
+   * Write any remaining data and close file. This is a collective operation
+   */
+  void close(void)
+  {
+    if (p_open) {
+      if (p_nbuf > 0) this->flush();
+      p_file.close();
+      p_open = false;
+    }
+  }
+
+  /**
+   * Return total number of columns in file (not including time)
+   * @return number of columns
+   */
+  int numColumns(void) const
+  {
+    return p_ncols;
+  }
+
+  private:
+    gridpack::parallel::Communicator p_comm;
+    AsyncFileWriter p_file;
+    int p_chunk;
+    bool p_async;
+    bool p_open;
+    long long p_ncols;
+    long long p_nlocal;
+    long long p_colStart;
+    long long p_dataOffset;
+    long long p_chunkIndex;
+    int p_nbuf;
+    std::vector<double> p_buffer;
+};
+
+// -------------------------------------------------------------
+// Read a time series file using memory mapping. This is a serial
+// class and can be used from utilities that do not run under MPI
+// -------------------------------------------------------------
+class TimeSeriesReader {
+  public:
+
+  /**
+   * Open and map a time series file
+   * @param filename name of file
+   */
+  TimeSeriesReader(const char *filename)
+    : p_map(NULL), p_size(0), p_ncols(0), p_chunk(0), p_nsteps(0),
+      p_dataOffset(0)
+  {
+    char buf[256];
+    int fd = ::open(filename, O_RDONLY);
+    if (fd < 0) {
+      sprintf(buf,"TimeSeriesReader: unable to open file %s\n",filename);
+      throw gridpack::Exception(buf);
+    }
+    struct stat st;
+    fstat(fd, &st);
+    p_size = st.st_size;
+    if (p_size >= 40) {
+      p_map = static_cast<char*>(mmap(NULL, p_size, PROT_READ, MAP_SHARED,
+            fd, 0));
+      if (p_map == MAP_FAILED) p_map = NULL;
+    }
+    ::close(fd);
+    if (p_map == NULL || strncmp(p_map, "GPTSERS1", 8) != 0) {
+      this->unmap();
+      sprintf(buf,"TimeSeriesReader: %s is not a time series file\n",
+          filename);
+      throw gridpack::Exception(buf);
+    }
+    const long long *ival = reinterpret_cast<const long long*>(p_map+8);
+    p_ncols = ival[0];
+    p_chunk = ival[1];
+    p_nsteps = ival[2];
+    p_dataOffset = ival[3];
+    long long chunkBytes = 8*p_chunk*(p_ncols+1);
+    long long nchunk = (p_nsteps + p_chunk - 1)/p_chunk;
+    if (p_chunk < 1 || p_ncols < 0 || p_nsteps < 0 || p_dataOffset < 40
+        || p_dataOffset > p_size
+        || p_dataOffset + nchunk*chunkBytes > p_size) {
+      this->unmap();
+      sprintf(buf,"TimeSeriesReader: file %s is truncated\n",filename);
+      throw gridpack::Exception(buf);
+    }
+    // Column names must lie between the header and the start of the data
+    const char *ptr = p_map + 40;
+    const char *end = p_map + p_dataOffset;
+    long long i;
+    for (i=0; i<p_ncols; i++) {
+      long long len;
+      if (end - ptr < static_cast<long long>(sizeof(len))) break;
+      memcpy(&len, ptr, sizeof(len));
+      ptr += sizeof(len);
+      if (len < 0 || len > end - ptr) break;
+      p_names.push_back(std::string(ptr, len));
+      ptr += len;
+    }
+    if (i < p_ncols) {
+      this->unmap();
+      sprintf(buf,"TimeSeriesReader: column names in file %s are corrupt\n",
+          filename);
+      throw gridpack::Exception(buf);
+    }
+  }
+
+  /**
+   * Simple destructor
+   */
+  ~TimeSeriesReader(void)
+  {
+    this->unmap();
+  }
+
+  /**
+   * @return number of data columns (not including time)
+   */
+  int numColumns(void) const
+  {
+    return p_ncols;
+  }
+
+  /**
+   * @return number of time steps
+   */
+  int numSteps(void) const
+  {
+    return p_nsteps;
+  }
+
+  /**
+   * @param col column index
+   * @return name of column
+   */
+  std::string columnName(int col) const
+  {
+    return p_names[col];
+  }
+
+  /**
+   * @param step time step index
+   * @return time at step
+   */
+  double time(int step) const
+  {
+    return *p_address(step, -1);
+  }
+
+  /**
+   * @param step time step index
+   * @param col column index
+   * @return value of column at step
+   */
+  double value(int step, int col) const
+  {
+    return *p_address(step, col);
+  }
+
+  /**
+   * Write contents of file as comma separated values. The first line
+   * contains the column names
+   * @param out stream for output
+   */
+  void writeCSV(std::ostream &out) const
+  {
+    char buf[32];
+    int i, j;
+    out << "time";
+    for (j=0; j<p_ncols; j++) out << ", " << p_names[j];
+    out << "\n";
+    for (i=0; i<p_nsteps; i++) {
+      sprintf(buf,"%.10g",time(i));
+      out << buf;
+      for (j=0; j<p_ncols; j++) {
+        sprintf(buf,", %.10g",value(i,j));
+        out << buf;
+      }
+      out << "\n";
+    }
+  }
+
+  private:
+
+  /**
+   * Return location of a value in the mapped file
+   * @param step time step index
+   * @param col column index (-1 for time column)
+   */
+  const double* p_address(int step, int col) const
+  {
+    if (step < 0 || step >= p_nsteps || col < -1 || col >= p_ncols) {
+      char buf[128];
+      sprintf(buf,"TimeSeriesReader: step %d or column %d out of range\n",
+          step,col);
+      throw gridpack::Exception(buf);
+    }
+    long long chunk = step/p_chunk;
+    long long idx = chunk*p_chunk*(p_ncols+1)
+      + (col+1)*p_chunk + step%p_chunk;
+    return reinterpret_cast<const double*>(p_map + p_dataOffset) + idx;
+  }
+
+  /**
+   * Release mapped file
+   */
+  void unmap(void)
+  {
+    if (p_map) munmap(p_map, p_size);
+    p_map = NULL;
+  }
+
+  char *p_map;
+  long long p_size;
+  long long p_ncols;
+  long long p_chunk;
+  long long p_nsteps;
+  long long p_dataOffset;
+  std::vector<std::string> p_names;
+};
+
+}   // serial_io
+}   // gridpack
+#endif  // _time_series_h_
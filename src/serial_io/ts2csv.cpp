@@ -0,0 +1,48 @@
+/*
+ *     Copyright (c) 2013 Battelle Memorial Institute
+ *     Licensed under modified BSD License. A copy of this license can be found
+ *     in the LICENSE file in the top level directory of this distribution.
+ */
+// -------------------------------------------------------------
+/**
+ * @file   ts2csv.cpp
+ *
+ * @brief  Convert a binary time series file to comma separated values
+ *
+ * Usage: ts2csv input_file [output_file]
+ *
+ * If no output file is given, the values are written to standard out
+ */
+// -------------------------------------------------------------
+
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include "gridpack/serial_io/time_series.hpp"
+
+int
+main (int argc, char **argv)
+{
+  if (argc < 2 || argc > 3) {
+    printf("Usage: %s input_file [output_file]\n",argv[0]);
+    return 1;
+  }
+  try {
+    gridpack::serial_io::TimeSeriesReader reader(argv[1]);
+    if (argc == 3) {
+      std::ofstream fout(argv[2]);
+      if (!fout.is_open()) {
+        printf("Unable to open output file %s\n",argv[2]);
+        return 1;
+      }
+      reader.writeCSV(fout);
+      fout.close();
+    } else {
+      reader.writeCSV(std::cout);
+    }
+  } catch (const gridpack::Exception &e) {
+    printf("%s",e.what());
+    return 1;
+  }
+  return 0;
+}